@@ -3,6 +3,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <errno.h>
 #include <chrono>
 #include <filesystem>
 #include <iostream>
@@ -22,6 +23,8 @@ typedef std::wstring string_t;
 #define DIR_SEPARATOR L'\\'
 
 #define string_compare wcscmp
+#define string_ncompare wcsncmp
+#define string_to_ull wcstoull
 
 #else
 #include <dlfcn.h>
@@ -33,9 +36,11 @@ typedef std::wstring string_t;
 #define MAX_PATH PATH_MAX
 
 #define string_compare strcmp
+#define string_ncompare strncmp
+#define string_to_ull strtoull
 
-typedef char_t char;
-typedef string_t std::string
+typedef char char_t;
+typedef std::string string_t;
 
 #endif
 
@@ -55,6 +60,9 @@ CoreLayerStartUp coreStartup = nullptr;
 uint16_t windowWidth = 1280;
 uint16_t windowHeight = 720;
 void* windowPtr = nullptr;
+bool headless = false;
+uint32_t tickRate = 0;
+const char* renderer = nullptr;
 
 extern "C" uint8_t PlaygroundCoreMain(const PlaygroundConfig&);
 extern "C" void PlaygroundMain(Startup start);
@@ -68,6 +76,8 @@ hostfxr_run_app_fn run_app_fptr;
 hostfxr_close_fn close_fptr;
 load_assembly_and_get_function_pointer_fn load_assembly_and_get_function_pointer = nullptr;
 string_t get_full_path(int argc, char_t** argv);
+bool parse_tick_rate(const char_t* value, uint32_t* rate);
+bool parse_renderer(const char_t* value, const char** name);
 int run_engine_dot_net_assembly(const string_t& root_path);
 bool load_hostfxr(const char_t *assembly_path);
 void *load_library(const char_t *);
@@ -93,7 +103,10 @@ void StartUpEngine(LookupTableDelegate lookup, ScriptStartupCallback startup) {
         true,
         "Test",
         workDir.c_str(),
-        nullptr
+        nullptr,
+        headless,
+        tickRate,
+        renderer
     };
 
     PlaygroundCoreMain(config);
@@ -112,6 +125,28 @@ int wmain(int argc, char_t** argv)
 int main(int argc, char_t** argv)
 #endif
 {
+    // --headless [--tick-rate <ticks per second>] runs the simulation without window, renderer and audio.
+    // --renderer=<d3d12|null> picks the render backend, headless runs selecting null still render.
+    for (int x = 1; x < argc; x++) {
+        if (string_compare(argv[x], STR("--headless")) == 0) {
+            headless = true;
+        }
+        else if (string_compare(argv[x], STR("--tick-rate")) == 0) {
+            if (x + 1 >= argc || !parse_tick_rate(argv[++x], &tickRate)) {
+                std::cerr << "--tick-rate expects a positive whole number of ticks per second" << std::endl;
+
+                return EXIT_FAILURE;
+            }
+        }
+        else if (string_ncompare(argv[x], STR("--renderer="), 11) == 0) {
+            if (!parse_renderer(argv[x] + 11, &renderer)) {
+                std::cerr << "--renderer expects d3d12 or null" << std::endl;
+
+                return EXIT_FAILURE;
+            }
+        }
+    }
+
     auto coreClr = run_engine_dot_net_assembly(get_full_path(argc, argv));
     if (coreClr != EXIT_SUCCESS)
     {
@@ -130,6 +165,52 @@ int main(int argc, char_t** argv)
 	return 0;
 }
 
+// Digits only, in range and above zero. Leave --tick-rate out to tick as fast as possible
+bool parse_tick_rate(const char_t* value, uint32_t* rate)
+{
+    if (*value == CH('\0'))
+    {
+        return false;
+    }
+
+    for (auto c = value; *c != CH('\0'); c++)
+    {
+        if (*c < CH('0') || *c > CH('9'))
+        {
+            return false;
+        }
+    }
+
+    errno = 0;
+    auto parsed = string_to_ull(value, nullptr, 10);
+    if (errno == ERANGE || parsed == 0 || parsed > UINT32_MAX)
+    {
+        return false;
+    }
+
+    *rate = static_cast<uint32_t>(parsed);
+
+    return true;
+}
+
+// Maps the argument to the engine's backend name, the engine config takes a narrow string on every platform
+bool parse_renderer(const char_t* value, const char** name)
+{
+    if (string_compare(value, STR("d3d12")) == 0)
+    {
+        *name = "d3d12";
+        return true;
+    }
+
+    if (string_compare(value, STR("null")) == 0)
+    {
+        *name = "null";
+        return true;
+    }
+
+    return false;
+}
+
 string_t get_full_path(int argc, char_t** argv)
 {
     char_t host_path[MAX_PATH];
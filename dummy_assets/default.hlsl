@@ -1,10 +1,27 @@
 #pragma pack_matrix(row_major)
 
 struct PointLight {
-    float4 position;
-    float4 colour;
+    float3 position;
+    float3 colour;
+    float intensity;
+    float radius;
+};
+
+struct SpotLight {
+    float3 position;
     float range;
-    float2 padding;
+    float3 direction;
+    float cosOuter;
+    float3 colour;
+    float intensity;
+    float cosInner;
+    float3 padding;
+};
+
+// Point light indices start at offset, the spot light indices follow them
+struct LightCluster {
+    uint offset;
+    uint counts;
 };
 
 struct DirectionalLight
@@ -19,6 +36,9 @@ struct ShadowCaster {
     float4x4 viewMatrix;
     float4x4 projectionMatrix;
     uint shadowMapIndex;
+    // Sun cascades only, the view depth the cascade covers up to. Casters with 0 apply everywhere.
+    float splitDistance;
+    float texelSize;
 };
 
 cbuffer Globals: register(b0)
@@ -43,19 +63,39 @@ cbuffer CameraBuffer : register(b2)
     float4x4 invProjMatrix;
 };
 
-cbuffer MaterialData : register(b3)
+// Packed like MaterialConstants::Pack, textures first, then cubemaps, then floats
+struct MaterialData {
+    uint values[128];
+};
+
+cbuffer MaterialIndex : register(b3)
 {
-    uint diffuseTextureId;
+    uint materialId;
 };
 
 cbuffer ShadowCastersCount: register(b4) {
     uint shadowCastersCount;
 };
 
+cbuffer ClusterParameters : register(b5) {
+    uint clusterTilesX;
+    uint clusterTilesY;
+    uint clusterSlices;
+    float clusterSliceScale;
+    float clusterSliceBias;
+    float clusterTileScaleX;
+    float clusterTileScaleY;
+};
+
 Texture2D textures[] : register(t0, space0);
 TextureCube cubeMaps[] : register(t0, space1);
 Texture2D shadowMaps[] : register(t0, space2);
 StructuredBuffer<ShadowCaster> shadowCasters : register(t0, space3);
+StructuredBuffer<LightCluster> lightClusters : register(t0, space4);
+StructuredBuffer<uint> lightIndices : register(t0, space5);
+StructuredBuffer<PointLight> pointLights : register(t0, space6);
+StructuredBuffer<SpotLight> spotLights : register(t0, space7);
+StructuredBuffer<MaterialData> materials : register(t0, space8);
 
 SamplerState defaultSampler : register(s0);
 SamplerComparisonState shadowSampler : register(s1);
@@ -65,8 +105,8 @@ struct VSInput {
     float4 color : COLOR;
     float3 normal : NORMAL;
     float2 uv : TEXCOORD0;
-    float4x4 modelMatrix : INSTANCE_TRANSFORM;
-    float4x4 normalMatrix: INSTANCE_NORMALS;
+    // Columns of the affine model matrix, the translation is stored in w
+    float4 modelColumns[3] : INSTANCE_TRANSFORM;
 };
 
 struct VSOutput {
@@ -97,7 +137,7 @@ float SampleShadowMapPCF(float4 worldPos, ShadowCaster sc)
 
     // PCF: 3x3 kernel
     float shadow = 0.0f;
-    float2 texelSize = 1.0f / float2(4096, 4096); // replace with actual shadow map size if needed
+    float2 texelSize = float2(sc.texelSize, sc.texelSize);
 
     for (int x = -1; x <= 1; ++x)
     for (int y = -1; y <= 1; ++y)
@@ -112,17 +152,74 @@ float SampleShadowMapPCF(float4 worldPos, ShadowCaster sc)
     return shadow;
 }
 
+// Smooth window so lights reach exactly zero at their range
+float Attenuation(float distance, float range)
+{
+    float ratio = distance / range;
+    float window = saturate(1.0f - ratio * ratio * ratio * ratio);
+    return window * window / (distance * distance + 1.0f);
+}
+
+// Sum of the local lights of the pixel's cluster, the cost depends on the lights nearby and not on the total count
+float3 ClusteredLights(float4 screenPos, float3 worldPos, float3 N)
+{
+    if (clusterSlices == 0) {
+        return float3(0, 0, 0);
+    }
+
+    float viewZ = mul(float4(worldPos, 1.0f), viewMatrix).z;
+    uint tileX = min((uint)(screenPos.x * clusterTileScaleX), clusterTilesX - 1);
+    uint tileY = min((uint)(screenPos.y * clusterTileScaleY), clusterTilesY - 1);
+    uint slice = (uint)clamp(log(max(viewZ, 1e-4f)) * clusterSliceScale + clusterSliceBias, 0.0f, (float)(clusterSlices - 1));
+
+    LightCluster cluster = lightClusters[(slice * clusterTilesY + tileY) * clusterTilesX + tileX];
+    uint pointCount = cluster.counts & 0xFFFF;
+    uint spotCount = cluster.counts >> 16;
+
+    float3 result = float3(0, 0, 0);
+
+    for (uint i = 0; i < pointCount; ++i)
+    {
+        PointLight light = pointLights[lightIndices[cluster.offset + i]];
+        float3 toLight = light.position - worldPos;
+        float distance = length(toLight);
+        float3 L = toLight / max(distance, 1e-4f);
+
+        result += light.colour * light.intensity * saturate(dot(N, L)) * Attenuation(distance, light.radius);
+    }
+
+    for (uint j = 0; j < spotCount; ++j)
+    {
+        SpotLight light = spotLights[lightIndices[cluster.offset + pointCount + j]];
+        float3 toLight = light.position - worldPos;
+        float distance = length(toLight);
+        float3 L = toLight / max(distance, 1e-4f);
+        float cone = smoothstep(light.cosOuter, max(light.cosInner, light.cosOuter + 1e-4f), dot(-L, light.direction));
+
+        result += light.colour * light.intensity * saturate(dot(N, L)) * Attenuation(distance, light.range) * cone;
+    }
+
+    return result;
+}
+
 VSOutput VSMain(VSInput vin)
 {
     VSOutput vout;
 
-    float4 worldPos = mul(float4(vin.position, 1.0f), vin.modelMatrix);
+    float4 localPos = float4(vin.position, 1.0f);
+    float4 worldPos = float4(dot(localPos, vin.modelColumns[0]), dot(localPos, vin.modelColumns[1]), dot(localPos, vin.modelColumns[2]), 1.0f);
     float snapAmount = 0.05f; // adjust for more/less chunk
     float4 snappedPos = floor(worldPos / snapAmount + 0.5f) * snapAmount;
     float4 viewPos  = mul(snappedPos, viewMatrix);
     float4 clipPos  = mul(viewPos, projectionMatrix);
 
-    float3 normalW = mul(vin.normal, (float3x3)vin.normalMatrix);
+    // The cofactor matrix of the model's 3x3 part is its inverse transpose scaled by the determinant,
+    // the pixel shader normalises so only the sign of the determinant matters
+    float3 r0 = float3(vin.modelColumns[0].x, vin.modelColumns[1].x, vin.modelColumns[2].x);
+    float3 r1 = float3(vin.modelColumns[0].y, vin.modelColumns[1].y, vin.modelColumns[2].y);
+    float3 r2 = float3(vin.modelColumns[0].z, vin.modelColumns[1].z, vin.modelColumns[2].z);
+    float3x3 cofactor = float3x3(cross(r1, r2), cross(r2, r0), cross(r0, r1));
+    float3 normalW = mul(vin.normal, cofactor) * sign(dot(r0, cross(r1, r2)));
 
     vout.position = clipPos;
     vout.worldPos = worldPos;
@@ -135,6 +232,7 @@ VSOutput VSMain(VSInput vin)
 
 float4 PSMain(VSOutput pin) : SV_TARGET
 {
+    uint diffuseTextureId = materials[materialId].values[0];
     Texture2D diffuseTexture = textures[diffuseTextureId];
     // Sample texture
     float4 texColor = diffuseTexture.Sample(defaultSampler, pin.uv);
@@ -144,10 +242,22 @@ float4 PSMain(VSOutput pin) : SV_TARGET
     float3 lightColor = directionalLight.colour.rgb;
     float  lightIntensity = directionalLight.colour.a;
 
+    // Cascades are sorted near to far, a pixel only samples the first one reaching past it
+    float viewZ = mul(pin.worldPos, viewMatrix).z;
+    bool cascadeSampled = false;
     float shadowFactor = 1.0f;
     for (uint i = 0; i < shadowCastersCount; ++i)
     {
-        shadowFactor *= SampleShadowMapPCF(pin.worldPos, shadowCasters[i]);
+        ShadowCaster sc = shadowCasters[i];
+        if (sc.splitDistance > 0.0f)
+        {
+            if (cascadeSampled || viewZ > sc.splitDistance)
+                continue;
+
+            cascadeSampled = true;
+        }
+
+        shadowFactor *= SampleShadowMapPCF(pin.worldPos, sc);
     }
 
     // Surface normal
@@ -158,7 +268,7 @@ float4 PSMain(VSOutput pin) : SV_TARGET
 
     float shade = NdotL;
 
-    float3 diffuse = lightColor * lightIntensity * shade * shadowFactor;
+    float3 diffuse = lightColor * lightIntensity * shade * shadowFactor + ClusteredLights(pin.position, pin.worldPos.xyz, N);
 
     // Ambient light
     float3 ambient = float3(0.1, 0.1, 0.12);
@@ -18,8 +18,8 @@ struct VSInput {
     float4 color : COLOR;
     float3 normal : NORMAL;
     float2 uv : TEXCOORD;
-    float4x4 modelMatrix : INSTANCE_TRANSFORM;
-    float4x4 normalMatrix: INSTANCE_NORMALS;
+    // Columns of the affine model matrix, the translation is stored in w
+    float4 modelColumns[3] : INSTANCE_TRANSFORM;
 };
 
 struct VSOutput
@@ -31,7 +31,8 @@ VSOutput VSMain(VSInput input)
 {
     VSOutput output;
 
-    float4 worldPos = mul(float4(input.position, 1.0f), input.modelMatrix);
+    float4 localPos = float4(input.position, 1.0f);
+    float4 worldPos = float4(dot(localPos, input.modelColumns[0]), dot(localPos, input.modelColumns[1]), dot(localPos, input.modelColumns[2]), 1.0f);
     // Transform world position to light clip space
     float4 lightViewPos = mul(worldPos, directionalLight.viewMatrix);
     float4 clipPos = mul(lightViewPos, directionalLight.projectionMatrix);
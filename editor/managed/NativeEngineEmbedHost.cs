@@ -32,6 +32,11 @@ public class NativeEngineEmbedHost : NativeControlHost
         [MarshalAs(UnmanagedType.LPStr)]
         public string Path;
         public IntPtr WindowHandle;
+        [MarshalAs(UnmanagedType.U1)]
+        public bool Headless;
+        public UInt32 TickRate;
+        [MarshalAs(UnmanagedType.LPStr)]
+        public string Renderer;
     }
     
     [DllImport("PlaygroundCoreEditor.dll", CallingConvention = CallingConvention.Cdecl)]
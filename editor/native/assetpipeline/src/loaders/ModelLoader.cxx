@@ -1,13 +1,89 @@
 #include "assetpipeline/loaders/ModelLoader.hxx"
+#include <charconv>
+#include <cmath>
 #include <filesystem>
+#include <map>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_set>
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
 #include <glm/glm.hpp>
 #include <rendering/Mesh.hxx>
 
 namespace playground::editor::assetpipeline::loaders::modelloader {
-    void ProcessNode(aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform, std::vector<assetloader::RawMeshData>& outMeshes, std::unordered_set<uint32_t>& processedMeshes) {
+    // Mesh of a node, the node's name decides whether it is a LOD of another mesh
+    struct NodeMesh {
+        std::string node;
+        unsigned int index;
+    };
+
+    // Splits "<base>_LOD<n>" into base and n, names without the suffix are LOD 0
+    std::pair<std::string_view, uint32_t> ParseLodName(std::string_view name) {
+        auto suffix = name.rfind("_LOD");
+        if (suffix == std::string_view::npos || suffix + 4 == name.size()) {
+            return { name, 0 };
+        }
+
+        uint32_t lod = 0;
+        auto digits = name.substr(suffix + 4);
+        auto [end, error] = std::from_chars(digits.data(), digits.data() + digits.size(), lod);
+        if (error != std::errc() || end != digits.data() + digits.size()) {
+            return { name, 0 };
+        }
+
+        return { name.substr(0, suffix), lod };
+    }
+
+    // Moves meshes of "<base>_LOD<n>" nodes into the LOD chain of the matching mesh of the <base> (or <base>_LOD0) node.
+    // LOD n takes over below a screen size of 0.5^n, LODs without a base mesh are kept as regular meshes.
+    void GroupLods(std::vector<assetloader::RawMeshData>& meshes, const std::vector<NodeMesh>& nodes) {
+        std::map<std::pair<std::string_view, unsigned int>, size_t> bases;
+        for (size_t x = 0; x < meshes.size(); x++) {
+            auto [base, lod] = ParseLodName(nodes[x].node);
+            if (lod == 0) {
+                bases.emplace(std::make_pair(base, nodes[x].index), x);
+            }
+        }
+
+        std::map<size_t, std::map<uint32_t, size_t>> chains;
+        for (size_t x = 0; x < meshes.size(); x++) {
+            auto [base, lod] = ParseLodName(nodes[x].node);
+            auto it = bases.find(std::make_pair(base, nodes[x].index));
+            if (lod == 0 || lod > rendering::MAX_MESH_LODS || it == bases.end()) {
+                continue;
+            }
+
+            chains[it->second].emplace(lod, x);
+        }
+
+        std::vector<bool> merged(meshes.size(), false);
+        for (auto& [base, chain] : chains) {
+            for (auto& [lod, x] : chain) {
+                meshes[base].lods.push_back(assetloader::RawMeshLod{
+                    .screenSize = std::pow(0.5f, static_cast<float>(lod)),
+                    .vertices = std::move(meshes[x].vertices),
+                    .indices = std::move(meshes[x].indices),
+                });
+                merged[x] = true;
+            }
+        }
+
+        size_t kept = 0;
+        for (size_t x = 0; x < meshes.size(); x++) {
+            if (merged[x]) {
+                continue;
+            }
+
+            if (kept != x) {
+                meshes[kept] = std::move(meshes[x]);
+            }
+            kept++;
+        }
+        meshes.resize(kept);
+    }
+
+    void ProcessNode(aiNode* node, const aiScene* scene, const aiMatrix4x4& parentTransform, std::vector<assetloader::RawMeshData>& outMeshes, std::vector<NodeMesh>& outNodes, std::unordered_set<uint32_t>& processedMeshes) {
         aiMatrix4x4 localTransform = node->mTransformation;
         aiMatrix4x4 worldTransform = parentTransform * localTransform;
 
@@ -89,6 +165,7 @@ namespace playground::editor::assetpipeline::loaders::modelloader {
             meshData.vertices = vertices;
             meshData.indices = indices;
             outMeshes.push_back(meshData);
+            outNodes.push_back(NodeMesh{ node->mName.C_Str(), i });
 
             // Clear vectors
             vertices.clear();
@@ -96,7 +173,7 @@ namespace playground::editor::assetpipeline::loaders::modelloader {
         }
 
         for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-            ProcessNode(node->mChildren[i], scene, worldTransform, outMeshes, processedMeshes);
+            ProcessNode(node->mChildren[i], scene, worldTransform, outMeshes, outNodes, processedMeshes);
         }
     }
 
@@ -104,6 +181,7 @@ namespace playground::editor::assetpipeline::loaders::modelloader {
         std::filesystem::path path
     ) -> std::vector<assetloader::RawMeshData> {
         std::vector<assetloader::RawMeshData> meshes = {};
+        std::vector<NodeMesh> nodes = {};
         std::unordered_set<uint32_t> processedMeshes;
 
         Assimp::Importer importer;
@@ -114,7 +192,8 @@ namespace playground::editor::assetpipeline::loaders::modelloader {
             throw std::runtime_error(err);
         }
 
-        ProcessNode(scene->mRootNode, scene, aiMatrix4x4(), meshes, processedMeshes);
+        ProcessNode(scene->mRootNode, scene, aiMatrix4x4(), meshes, nodes, processedMeshes);
+        GroupLods(meshes, nodes);
 
         return meshes;
     }
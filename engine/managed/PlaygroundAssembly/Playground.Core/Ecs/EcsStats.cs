@@ -0,0 +1,97 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Playground.Core.Ecs;
+
+/// Times are in milliseconds
+[StructLayout(LayoutKind.Sequential)]
+public struct EcsSystemStats
+{
+    public ulong System;
+    public ulong Phase;
+    private IntPtr _name;
+    public float LastTime;
+    public float AverageTime;
+    public float MaxTime;
+    public int Tables;
+    public int Entities;
+    public uint FanOut;
+
+    public string Name => Marshal.PtrToStringUTF8(_name) ?? string.Empty;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct EcsPhaseStats
+{
+    public ulong Phase;
+    private IntPtr _name;
+    public float LastTime;
+    public float AverageTime;
+    public uint SystemCount;
+
+    public string Name => Marshal.PtrToStringUTF8(_name) ?? string.Empty;
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct EcsFrameStats
+{
+    public ulong Frame;
+    public float TickTime;
+    public float SystemTime;
+    public uint Jobs;
+    public uint SystemCount;
+}
+
+public static class EcsStats
+{
+    /// Per system timings of the last tick together with the tables and entities the system currently matches
+    public static unsafe EcsSystemStats[] GetSystemStats()
+    {
+        var count = EcsStatsApi.GetSystemStatsPtr(null, 0);
+        var stats = new EcsSystemStats[count];
+
+        fixed (EcsSystemStats* statsPtr = stats)
+        {
+            count = EcsStatsApi.GetSystemStatsPtr(statsPtr, (nuint)stats.Length);
+        }
+
+        Array.Resize(ref stats, (int)count);
+
+        return stats;
+    }
+
+    /// Summed system timings per pipeline phase
+    public static unsafe EcsPhaseStats[] GetPhaseStats()
+    {
+        var count = EcsStatsApi.GetPhaseStatsPtr(null, 0);
+        var stats = new EcsPhaseStats[count];
+
+        fixed (EcsPhaseStats* statsPtr = stats)
+        {
+            count = EcsStatsApi.GetPhaseStatsPtr(statsPtr, (nuint)stats.Length);
+        }
+
+        Array.Resize(ref stats, (int)count);
+
+        return stats;
+    }
+
+    public static unsafe EcsFrameStats GetFrameStats()
+    {
+        EcsFrameStats stats;
+        EcsStatsApi.GetFrameStatsPtr(&stats);
+
+        return stats;
+    }
+
+    /// Collection is on by default, disabling it also stops flecs from timing systems
+    public static unsafe void SetEnabled(bool enabled)
+    {
+        EcsStatsApi.SetEnabledPtr(enabled);
+    }
+
+    /// Clears the max times and averages
+    public static unsafe void Reset()
+    {
+        EcsStatsApi.ResetPtr();
+    }
+}
@@ -0,0 +1,33 @@
+﻿namespace Playground.Core.Ecs;
+
+internal static class EcsStatsApi
+{
+    internal static unsafe delegate* unmanaged[Cdecl]<EcsSystemStats*, nuint, nuint> GetSystemStatsPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<EcsPhaseStats*, nuint, nuint> GetPhaseStatsPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<EcsFrameStats*, void> GetFrameStatsPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<bool, void> SetEnabledPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<void> ResetPtr;
+
+    internal static unsafe void Setup()
+    {
+        GetSystemStatsPtr =
+            (delegate* unmanaged[Cdecl]<EcsSystemStats*, nuint, nuint>)
+            NativeLookupTable.GetFunctionPointer("ECS_GetSystemStats");
+
+        GetPhaseStatsPtr =
+            (delegate* unmanaged[Cdecl]<EcsPhaseStats*, nuint, nuint>)
+            NativeLookupTable.GetFunctionPointer("ECS_GetPhaseStats");
+
+        GetFrameStatsPtr =
+            (delegate* unmanaged[Cdecl]<EcsFrameStats*, void>)
+            NativeLookupTable.GetFunctionPointer("ECS_GetFrameStats");
+
+        SetEnabledPtr =
+            (delegate* unmanaged[Cdecl]<bool, void>)
+            NativeLookupTable.GetFunctionPointer("ECS_SetStatsEnabled");
+
+        ResetPtr =
+            (delegate* unmanaged[Cdecl]<void>)
+            NativeLookupTable.GetFunctionPointer("ECS_ResetStats");
+    }
+}
@@ -0,0 +1,33 @@
+﻿namespace Playground.Core.Prefabs;
+
+internal static class PrefabApi
+{
+    internal static unsafe delegate* unmanaged[Cdecl]<byte*, uint> LoadPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<ulong, uint> CreateFromEntityPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<uint, uint> RootCountPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<uint, uint, PrefabTransform*, ulong*, uint> InstantiatePtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<uint, void> ReleasePtr;
+
+    internal static unsafe void Setup()
+    {
+        LoadPtr =
+            (delegate* unmanaged[Cdecl]<byte*, uint>)
+            NativeLookupTable.GetFunctionPointer("Prefabs_Load");
+
+        CreateFromEntityPtr =
+            (delegate* unmanaged[Cdecl]<ulong, uint>)
+            NativeLookupTable.GetFunctionPointer("Prefabs_CreateFromEntity");
+
+        RootCountPtr =
+            (delegate* unmanaged[Cdecl]<uint, uint>)
+            NativeLookupTable.GetFunctionPointer("Prefabs_RootCount");
+
+        InstantiatePtr =
+            (delegate* unmanaged[Cdecl]<uint, uint, PrefabTransform*, ulong*, uint>)
+            NativeLookupTable.GetFunctionPointer("Prefabs_Instantiate");
+
+        ReleasePtr =
+            (delegate* unmanaged[Cdecl]<uint, void>)
+            NativeLookupTable.GetFunctionPointer("Prefabs_Release");
+    }
+}
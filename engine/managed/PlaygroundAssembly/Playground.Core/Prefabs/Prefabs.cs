@@ -0,0 +1,73 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Playground.Core.Prefabs;
+
+/// Placement of a prefab instance, matches the native transform component layout
+[StructLayout(LayoutKind.Explicit, Pack = 16, Size = 48)]
+public struct PrefabTransform
+{
+    [FieldOffset(0)] public float PositionX;
+    [FieldOffset(4)] public float PositionY;
+    [FieldOffset(8)] public float PositionZ;
+    [FieldOffset(12)] public float RotationX;
+    [FieldOffset(16)] public float RotationY;
+    [FieldOffset(20)] public float RotationZ;
+    [FieldOffset(24)] public float RotationW;
+    [FieldOffset(28)] public float ScaleX;
+    [FieldOffset(32)] public float ScaleY;
+    [FieldOffset(36)] public float ScaleZ;
+}
+
+public static class Prefabs
+{
+    /// Loads a cooked prefab by name, returns 0 if it couldn't be loaded
+    public static unsafe uint Load(string name)
+    {
+        var utf8 = System.Text.Encoding.UTF8.GetBytes(name + '\0');
+
+        fixed (byte* namePtr = utf8)
+        {
+            return PrefabApi.LoadPtr(namePtr);
+        }
+    }
+
+    /// Turns an entity and its children into a prefab
+    public static unsafe uint CreateFromEntity(ulong entity)
+    {
+        return PrefabApi.CreateFromEntityPtr(entity);
+    }
+
+    /// Creates count copies of a prefab in one go and returns their root entities. Must not be called from within a system.
+    public static unsafe ulong[] Instantiate(uint prefab, uint count)
+    {
+        return Instantiate(prefab, count, null);
+    }
+
+    /// Creates one copy per transform, the roots of each copy are placed relative to its transform
+    public static unsafe ulong[] Instantiate(uint prefab, PrefabTransform[] transforms)
+    {
+        fixed (PrefabTransform* transformsPtr = transforms)
+        {
+            return Instantiate(prefab, (uint)transforms.Length, transformsPtr);
+        }
+    }
+
+    /// Drops the reference taken by Load or CreateFromEntity, instances stay alive
+    public static unsafe void Release(uint prefab)
+    {
+        PrefabApi.ReleasePtr(prefab);
+    }
+
+    private static unsafe ulong[] Instantiate(uint prefab, uint count, PrefabTransform* transforms)
+    {
+        var roots = new ulong[PrefabApi.RootCountPtr(prefab) * count];
+
+        fixed (ulong* rootsPtr = roots)
+        {
+            var created = PrefabApi.InstantiatePtr(prefab, count, transforms, rootsPtr);
+            Array.Resize(ref roots, (int)created);
+        }
+
+        return roots;
+    }
+}
@@ -0,0 +1,80 @@
+﻿namespace Playground.Core.Spatial;
+
+public static class Spatial
+{
+    /// Returns the entities whose bounds overlap the box
+    public static unsafe ulong[] QueryAABB(float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+    {
+        var min = new SpatialVector { X = minX, Y = minY, Z = minZ };
+        var max = new SpatialVector { X = maxX, Y = maxY, Z = maxZ };
+
+        return Collect((results, capacity) => SpatialApi.QueryAABBPtr(min, max, results, capacity));
+    }
+
+    /// Returns the entities whose bounds overlap the sphere
+    public static unsafe ulong[] QuerySphere(float x, float y, float z, float radius)
+    {
+        var center = new SpatialVector { X = x, Y = y, Z = z };
+
+        return Collect((results, capacity) => SpatialApi.QuerySpherePtr(center, radius, results, capacity));
+    }
+
+    /// Returns the entities inside the frustum of a row-major view-projection matrix
+    public static unsafe ulong[] QueryFrustum(float[] viewProjection)
+    {
+        if (viewProjection.Length != 16)
+        {
+            throw new ArgumentException("View projection matrix must have 16 elements", nameof(viewProjection));
+        }
+
+        fixed (float* matrix = viewProjection)
+        {
+            var matrixPtr = matrix;
+
+            return Collect((results, capacity) => SpatialApi.QueryFrustumPtr(matrixPtr, results, capacity));
+        }
+    }
+
+    /// Returns up to count entities, closest first
+    public static unsafe ulong[] QueryNearest(float x, float y, float z, uint count)
+    {
+        var point = new SpatialVector { X = x, Y = y, Z = z };
+        var results = new ulong[count];
+
+        fixed (ulong* resultsPtr = results)
+        {
+            var found = SpatialApi.QueryNearestPtr(point, resultsPtr, count);
+            Array.Resize(ref results, (int)found);
+        }
+
+        return results;
+    }
+
+    private unsafe delegate uint Query(ulong* results, uint capacity);
+
+    private static unsafe ulong[] Collect(Query query)
+    {
+        // First pass sizes the result, a second one is only needed when the guess was too small
+        var results = new ulong[64];
+        uint count;
+
+        fixed (ulong* resultsPtr = results)
+        {
+            count = query(resultsPtr, (uint)results.Length);
+        }
+
+        if (count > results.Length)
+        {
+            results = new ulong[count];
+
+            fixed (ulong* resultsPtr = results)
+            {
+                count = query(resultsPtr, (uint)results.Length);
+            }
+        }
+
+        Array.Resize(ref results, (int)System.Math.Min(count, (uint)results.Length));
+
+        return results;
+    }
+}
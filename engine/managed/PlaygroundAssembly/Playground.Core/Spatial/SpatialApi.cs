@@ -0,0 +1,38 @@
+﻿using System.Runtime.InteropServices;
+
+namespace Playground.Core.Spatial;
+
+[StructLayout(LayoutKind.Sequential)]
+internal struct SpatialVector
+{
+    public float X;
+    public float Y;
+    public float Z;
+}
+
+internal static class SpatialApi
+{
+    internal static unsafe delegate* unmanaged[Cdecl]<SpatialVector, SpatialVector, ulong*, uint, uint> QueryAABBPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<SpatialVector, float, ulong*, uint, uint> QuerySpherePtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<float*, ulong*, uint, uint> QueryFrustumPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<SpatialVector, ulong*, uint, uint> QueryNearestPtr;
+
+    internal static unsafe void Setup()
+    {
+        QueryAABBPtr =
+            (delegate* unmanaged[Cdecl]<SpatialVector, SpatialVector, ulong*, uint, uint>)
+            NativeLookupTable.GetFunctionPointer("Spatial_QueryAABB");
+
+        QuerySpherePtr =
+            (delegate* unmanaged[Cdecl]<SpatialVector, float, ulong*, uint, uint>)
+            NativeLookupTable.GetFunctionPointer("Spatial_QuerySphere");
+
+        QueryFrustumPtr =
+            (delegate* unmanaged[Cdecl]<float*, ulong*, uint, uint>)
+            NativeLookupTable.GetFunctionPointer("Spatial_QueryFrustum");
+
+        QueryNearestPtr =
+            (delegate* unmanaged[Cdecl]<SpatialVector, ulong*, uint, uint>)
+            NativeLookupTable.GetFunctionPointer("Spatial_QueryNearest");
+    }
+}
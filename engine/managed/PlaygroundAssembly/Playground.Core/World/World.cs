@@ -0,0 +1,63 @@
+﻿namespace Playground.Core.World;
+
+public static class World
+{
+    /// Serialises the current world into the binary snapshot format
+    public static unsafe byte[] SaveSnapshot()
+    {
+        nuint size = 0;
+        WorldApi.SaveSnapshotPtr(null, &size);
+
+        var snapshot = new byte[size];
+
+        fixed (byte* snapshotPtr = snapshot)
+        {
+            WorldApi.SaveSnapshotPtr(snapshotPtr, &size);
+        }
+
+        return snapshot;
+    }
+
+    /// Adds the entities of a snapshot to the world. Must not be called from within a system.
+    public static unsafe bool LoadSnapshot(byte[] snapshot)
+    {
+        fixed (byte* snapshotPtr = snapshot)
+        {
+            return WorldApi.LoadSnapshotPtr(snapshotPtr, (nuint)snapshot.Length);
+        }
+    }
+
+    /// Loads a cooked world asset by name
+    public static unsafe bool Load(string name)
+    {
+        var utf8 = System.Text.Encoding.UTF8.GetBytes(name + '\0');
+
+        fixed (byte* namePtr = utf8)
+        {
+            return WorldApi.LoadWorldPtr(namePtr);
+        }
+    }
+
+    /// Opens a cooked streamed world, its cells are loaded and unloaded around the cameras
+    public static unsafe bool OpenStreamed(string name)
+    {
+        var utf8 = System.Text.Encoding.UTF8.GetBytes(name + '\0');
+
+        fixed (byte* namePtr = utf8)
+        {
+            return WorldApi.OpenStreamedPtr(namePtr);
+        }
+    }
+
+    /// Destroys all streamed cells
+    public static unsafe void CloseStreamed()
+    {
+        WorldApi.CloseStreamedPtr();
+    }
+
+    /// Cells load within loadRadius of a camera and unload once all cameras are farther away than unloadRadius
+    public static unsafe void SetStreamingRadii(float loadRadius, float unloadRadius)
+    {
+        WorldApi.SetStreamingRadiiPtr(loadRadius, unloadRadius);
+    }
+}
@@ -0,0 +1,38 @@
+﻿namespace Playground.Core.World;
+
+internal static class WorldApi
+{
+    internal static unsafe delegate* unmanaged[Cdecl]<byte*, nuint*, void> SaveSnapshotPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<byte*, nuint, bool> LoadSnapshotPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<byte*, bool> LoadWorldPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<byte*, bool> OpenStreamedPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<void> CloseStreamedPtr;
+    internal static unsafe delegate* unmanaged[Cdecl]<float, float, void> SetStreamingRadiiPtr;
+
+    internal static unsafe void Setup()
+    {
+        SaveSnapshotPtr =
+            (delegate* unmanaged[Cdecl]<byte*, nuint*, void>)
+            NativeLookupTable.GetFunctionPointer("World_SaveSnapshot");
+
+        LoadSnapshotPtr =
+            (delegate* unmanaged[Cdecl]<byte*, nuint, bool>)
+            NativeLookupTable.GetFunctionPointer("World_LoadSnapshot");
+
+        LoadWorldPtr =
+            (delegate* unmanaged[Cdecl]<byte*, bool>)
+            NativeLookupTable.GetFunctionPointer("World_LoadWorldByName");
+
+        OpenStreamedPtr =
+            (delegate* unmanaged[Cdecl]<byte*, bool>)
+            NativeLookupTable.GetFunctionPointer("World_OpenStreamed");
+
+        CloseStreamedPtr =
+            (delegate* unmanaged[Cdecl]<void>)
+            NativeLookupTable.GetFunctionPointer("World_CloseStreamed");
+
+        SetStreamingRadiiPtr =
+            (delegate* unmanaged[Cdecl]<float, float, void>)
+            NativeLookupTable.GetFunctionPointer("World_SetStreamingRadii");
+    }
+}
@@ -8,10 +8,12 @@ public struct CameraComponent(
     byte order,
     float fov,
     float nearPlane,
-    float farPlane)
+    float farPlane,
+    float lodBias = 0)
 {
     public byte Order = order;
     public float Fov = fov;
     public float NearPlane = nearPlane;
     public float FarPlane = farPlane;
+    public float LodBias = lodBias;
 }
@@ -0,0 +1,12 @@
+﻿using Playground.Core.Ecs;
+using Vector3 = PlaygroundAssembly.Math.Vector3;
+
+namespace PlaygroundAssembly.ECS.Rendering;
+
+// Local space box that hides what is behind it, it has to fit inside the entity's mesh
+[EcsComponent]
+public struct OccluderComponent(Vector3 center, Vector3 extents)
+{
+    public Vector3 Center = center;
+    public Vector3 Extents = extents;
+}
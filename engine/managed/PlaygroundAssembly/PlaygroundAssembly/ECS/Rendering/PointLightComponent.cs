@@ -0,0 +1,12 @@
+﻿using Playground.Core.Ecs;
+using PlaygroundAssembly.Rendering;
+
+namespace PlaygroundAssembly.ECS.Rendering;
+
+[EcsComponent]
+public struct PointLightComponent(Colour colour, float intensity, float radius)
+{
+    public Colour Colour = colour;
+    public float Intensity = intensity;
+    public float Radius = radius;
+}
@@ -0,0 +1,15 @@
+﻿using Playground.Core.Ecs;
+using PlaygroundAssembly.Rendering;
+
+namespace PlaygroundAssembly.ECS.Rendering;
+
+// Shines along the entity's forward axis, angles are half angles of the cone in degrees
+[EcsComponent]
+public struct SpotLightComponent(Colour colour, float intensity, float range, float innerAngle, float outerAngle)
+{
+    public Colour Colour = colour;
+    public float Intensity = intensity;
+    public float Range = range;
+    public float InnerAngle = innerAngle;
+    public float OuterAngle = outerAngle;
+}
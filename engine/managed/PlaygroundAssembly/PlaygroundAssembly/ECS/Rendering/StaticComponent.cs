@@ -0,0 +1,12 @@
+﻿using System.Runtime.InteropServices;
+using Playground.Core.Ecs;
+
+namespace PlaygroundAssembly.ECS.Rendering;
+
+// Marks an entity that rarely moves, its draw call is cached across frames instead of being rebuilt every frame
+[EcsComponent]
+[StructLayout(LayoutKind.Sequential, Size = 1)]
+public struct StaticComponent
+{
+    internal byte Reserved;
+}
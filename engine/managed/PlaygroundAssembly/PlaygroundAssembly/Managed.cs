@@ -4,6 +4,9 @@ using Playground.Core;
 using Playground.Core.Assets;
 using Playground.Core.Ecs;
 using Playground.Core.Logging;
+using Playground.Core.Prefabs;
+using Playground.Core.Spatial;
+using Playground.Core.World;
 
 namespace PlaygroundAssembly;
 
@@ -34,7 +37,11 @@ internal static class Managed
         
         LoggerApi.Setup();
         EcsApi.Setup();
+        EcsStatsApi.Setup();
         AssetApi.Setup();
+        SpatialApi.Setup();
+        WorldApi.Setup();
+        PrefabApi.Setup();
     }
     
     internal static void SetupEcs(System.Reflection.Assembly assembly)
@@ -8,7 +8,9 @@
 #include <rendering/Mesh.hxx>
 #include <rendering/Shader.hxx>
 #include <rendering/Texture.hxx>
+#include <rendering/UploadPriority.hxx>
 #include <audio/AudioClip.hxx>
+#include <math/Bounds.hxx>
 #include <shared/Job.hxx>
 #include <shared/JobHandle.hxx>
 #include <shared/JobSystem.hxx>
@@ -41,6 +43,7 @@ namespace playground::assetmanager {
         std::atomic<uint32_t> externalRefs; // ECS/components
         std::atomic<uint32_t> internalRefs;
         std::vector<playground::rendering::Mesh> meshes;
+        std::vector<math::BoundingBox> bounds; // Local space bounds per mesh, available before the upload finished
         std::vector<assetloader::RawMeshData> rawMeshData;
     };
 
@@ -104,6 +107,9 @@ namespace playground::assetmanager {
         uint32_t material;
     };
 
+    /// Headless mode skips all audio work. Without rendering only the CPU side of assets (bounds, physics materials) is kept.
+    void Init(bool headless, bool rendering);
+
     ModelHandle* GetModel(uint32_t handle);
     TextureHandle* GetTexture(uint32_t handle);
     CubemapHandle* GetCubemap(uint32_t handle);
@@ -112,12 +118,13 @@ namespace playground::assetmanager {
     AudioHandle* GetAudio(uint32_t handle);
     PhysicsMaterialHandle* GetPhysicsMaterial(uint32_t handle);
 
-    uint32_t LoadModel(uint64_t hash);
-    uint32_t LoadMaterial(uint64_t hash, void (*onCompletion)(uint32_t) = nullptr);
+    /// priority orders the GPU upload against other streamed resources, resources already loading keep theirs
+    uint32_t LoadModel(uint64_t hash, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
+    uint32_t LoadMaterial(uint64_t hash, void (*onCompletion)(uint32_t) = nullptr, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
     uint32_t LoadShader(uint64_t hash);
-    uint32_t LoadTexture(uint64_t hash);
+    uint32_t LoadTexture(uint64_t hash, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
     uint32_t LoadPhysicsMaterial(uint64_t hash);
-    uint32_t LoadCubemap(uint64_t hash);
+    uint32_t LoadCubemap(uint64_t hash, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
     uint32_t LoadAudio(uint64_t hash, std::string name);
     void LoadSceneData(uint64_t hash, char* data, size_t* size);
 
@@ -129,6 +136,11 @@ namespace playground::assetmanager {
     uint32_t LoadCubemapByName(const char* name);
     void LoadSceneDataByName(const char* name, char* data, size_t* size);
 
+    // Adds references to an already loaded handle, used by bulk instantiation to resolve an asset once for many entities
+    void RetainModel(uint32_t handle, uint32_t count = 1);
+    void RetainMaterial(uint32_t handle, uint32_t count = 1);
+    void RetainPhysicsMaterial(uint32_t handle, uint32_t count = 1);
+
     void ReleaseModel(uint32_t handle);
     void ReleaseMaterial(uint32_t handle);
     void ReleaseShader(uint32_t handle);
@@ -11,12 +11,40 @@ namespace playground::drawcallbatcher {
     struct DrawCall {
         uint32_t modelHandle;
         uint16_t meshId;
+        // Mesh LOD to draw, static draw calls get theirs picked by the cache
+        uint8_t lod;
         uint32_t materialHandle;
-        math::Matrix4x4 transform;
+        // World transform, the batcher builds the instance matrices for whole batches at once
+        math::Vector3 position;
+        math::Quaternion rotation;
+        math::Vector3 scale;
     };
 
     void Batch(DrawCall*, uint16_t count);
+
+    /// Picks the LOD of a dynamic draw call from its projected size in the cameras of the last Submit, the finest LOD any camera needs wins.
+    /// current is the LOD the instance was drawn with before. Safe to call from any thread between Submits.
+    uint8_t SelectLod(const DrawCall& drawCall, uint8_t current);
+
+    // Static cache, draw calls that stay in the cache until removed and are only rebatched when they change. Main thread only.
+    uint32_t AddStatic(const DrawCall& drawCall);
+    void UpdateStatic(uint32_t slot, const DrawCall& drawCall);
+    void RemoveStatic(uint32_t slot);
+
+    /// Box proxy rasterized into the occlusion buffer of the main camera for the next Submit. Main thread only.
+    void AddOccluder(const math::Vector3& position, const math::Quaternion& rotation, const math::Vector3& scale, const math::Vector3& center, const math::Vector3& extents);
+
+    /// Local lights of the next Submit, they get assigned to the froxel clusters of every camera. Main thread only.
+    void AddPointLight(const math::Vector3& position, const math::Vector4& colour, float intensity, float radius);
+    /// Angles are the cone's half angles in degrees, the light shines along the rotation's forward axis
+    void AddSpotLight(const math::Vector3& position, const math::Quaternion& rotation, const math::Vector4& colour, float intensity, float range, float innerAngle, float outerAngle);
+
     void SetSun(math::Vector3 direction, math::Vector4 colour, float intensity);
-    void AddCamera(uint8_t order, float fov, float nearPlane, float farPlane, const math::Vector3& position, const math::Quaternion& rotation);
+    /// lodBias scales the screen size LODs are picked with by 2^-lodBias
+    void AddCamera(uint8_t order, float fov, float nearPlane, float farPlane, const math::Vector3& position, const math::Quaternion& rotation, float lodBias = 0.0f);
+    /// Size of the main view, cameras are culled with its aspect ratio
+    void SetViewport(uint32_t width, uint32_t height);
     void Submit();
+    /// Drops the static cache, must run before the renderer shuts down as the cache holds one of its instance buffers
+    void Shutdown();
 }
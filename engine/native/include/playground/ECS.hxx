@@ -30,7 +30,7 @@ namespace playground::ecs {
     typedef void (*DestroyEntityHook)(uint64_t);
     typedef void (*SetParentHook)(uint64_t, uint64_t);
 
-    void Init(bool debugServer);
+    void Init(bool debugServer, bool headless = false, bool rendering = true);
     void Update(double deltaTime);
     void Clear();
     void Shutdown();
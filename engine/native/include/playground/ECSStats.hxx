@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace flecs {
+    struct world;
+}
+
+namespace playground::ecs::stats {
+    /// Times are in milliseconds
+    struct SystemStats {
+        uint64_t system;
+        uint64_t phase;
+        const char* name;
+        float lastTime;
+        /// Exponential moving average over roughly the last 20 frames
+        float averageTime;
+        /// Highest time since the last reset
+        float maxTime;
+        int32_t tables;
+        int32_t entities;
+        /// Number of workers the system is split across, 1 for systems running on the game thread only
+        uint32_t fanOut;
+    };
+
+    struct PhaseStats {
+        uint64_t phase;
+        const char* name;
+        float lastTime;
+        float averageTime;
+        uint32_t systemCount;
+    };
+
+    struct FrameStats {
+        uint64_t frame;
+        /// Wall time of the whole ECS tick, including merges and pipeline syncs
+        float tickTime;
+        /// Sum of the time spent inside systems
+        float systemTime;
+        /// Worker tasks the pipeline spawned this frame
+        uint32_t jobs;
+        uint32_t systemCount;
+    };
+
+    void Init(flecs::world& world);
+    void Shutdown();
+    /// Samples the system timers of the last tick. Called after every world progress.
+    void Collect(float tickTime, uint32_t jobs);
+    void SetEnabled(bool enabled);
+    bool IsEnabled();
+    void Reset();
+
+    /// Matched tables and entities are counted on read so collecting stays proportional to the number of systems only
+    size_t GetSystemStats(SystemStats* stats, size_t capacity);
+    size_t GetPhaseStats(PhaseStats* stats, size_t capacity);
+    FrameStats GetFrameStats();
+
+    // Scripting
+    void GetFrameStats_C(FrameStats* stats);
+}
@@ -2,6 +2,13 @@
 
 #include <cstdint>
 
+#ifdef _WIN32
+#define PLAYGROUND_API __declspec(dllexport)
+#else
+#define PLAYGROUND_API __attribute__((visibility("default")))
+#define __cdecl
+#endif
+
 extern "C" {
     typedef void (__cdecl *LookupTableDelegate)(const char*, void*);
     typedef void(__cdecl *ScriptStartupCallback)();
@@ -18,8 +25,15 @@ extern "C" {
         const char* Name;
         const char* Path;
         void* WindowHandle;
+        /// Runs without window, renderer, audio and input devices
+        bool Headless;
+        /// Fixed ticks per second when running headless, 0 ticks as fast as possible
+        uint32_t TickRate;
+        /// Render backend, "d3d12" or "null". Null or empty picks the platform's default.
+        /// The null backend needs no window, headless runs selecting it still render.
+        const char* Renderer;
 
 	} typedef PlaygroundConfig;
 
-	__declspec(dllexport) uint8_t PlaygroundCoreMain(const PlaygroundConfig& config);
+	PLAYGROUND_API uint8_t PlaygroundCoreMain(const PlaygroundConfig& config);
 }
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct TransformComponent;
+
+namespace playground::prefabs {
+    /// Loads a cooked prefab and resolves its assets once. Loading the same prefab again returns the same id with an extra reference.
+    uint32_t LoadPrefab(uint64_t hash);
+    /// Builds a prefab from a live entity and its children. External parents and the root names are not part of the prefab.
+    uint32_t CreatePrefab(uint64_t root);
+    /// Serialises a live entity and its children into the cooked prefab format
+    bool SavePrefab(uint64_t root, std::vector<uint8_t>& data);
+    /// Creates count copies of a prefab in bulk. Must not be called while the world is progressing.
+    /// When transforms is set the roots of copy i are placed relative to transforms[i]. roots receives RootCount * count ids, grouped by copy.
+    bool InstantiatePrefab(uint32_t prefabId, uint32_t count, const TransformComponent* transforms, std::vector<uint64_t>* roots = nullptr);
+    uint32_t RootCount(uint32_t prefabId);
+    /// Drops a reference, the template and its assets are released with the last one. Instances stay alive.
+    void ReleasePrefab(uint32_t prefabId);
+    void Shutdown();
+
+    // Scripting
+    uint32_t LoadPrefabByName(const char* name);
+    uint32_t Instantiate_C(uint32_t prefabId, uint32_t count, const TransformComponent* transforms, uint64_t* roots);
+}
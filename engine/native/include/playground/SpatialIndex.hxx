@@ -0,0 +1,37 @@
+#pragma once
+
+#include <math/Bounds.hxx>
+#include <math/Vector3.hxx>
+#include <cstdint>
+#include <vector>
+
+namespace playground::spatialindex {
+    constexpr int32_t NULL_PROXY = -1;
+
+    void Init();
+    void Shutdown();
+
+    /// Adds an entity with its world space bounds and returns the proxy that represents it in the tree
+    int32_t CreateProxy(uint64_t entityId, const math::BoundingBox& bounds);
+    /// Returns false if the bounds still fit into the fattened proxy and the tree was left untouched
+    bool MoveProxy(int32_t proxyId, const math::BoundingBox& bounds);
+    void DestroyProxy(int32_t proxyId);
+    size_t ProxyCount();
+
+    void QueryAABB(const math::BoundingBox& box, std::vector<uint64_t>& results);
+    void QuerySphere(const math::BoundingSphere& sphere, std::vector<uint64_t>& results);
+    void QueryFrustum(const math::Frustum& frustum, std::vector<uint64_t>& results);
+    /// Returns up to count entities ordered by the distance of their bounds, without the proxy margin, to the point
+    void QueryNearest(const math::Vector3& point, uint32_t count, std::vector<uint64_t>& results);
+
+    // Batched queries, the individual queries are spread over the job system
+    void QueryAABBs(const math::BoundingBox* boxes, size_t count, std::vector<uint64_t>* results);
+    void QuerySpheres(const math::BoundingSphere* spheres, size_t count, std::vector<uint64_t>* results);
+    void QueryFrustums(const math::Frustum* frustums, size_t count, std::vector<uint64_t>* results);
+
+    // Scripting entry points. They write up to capacity entities and return the total number of hits.
+    uint32_t QueryAABB_C(math::Vector3 min, math::Vector3 max, uint64_t* results, uint32_t capacity);
+    uint32_t QuerySphere_C(math::Vector3 center, float radius, uint64_t* results, uint32_t capacity);
+    uint32_t QueryFrustum_C(const float* viewProjection, uint64_t* results, uint32_t capacity);
+    uint32_t QueryNearest_C(math::Vector3 point, uint64_t* results, uint32_t count);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <rendering/UploadPriority.hxx>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace playground::worldsnapshot {
+    constexpr uint32_t SNAPSHOT_MAGIC = 0x50475753; // PGWS
+    constexpr uint32_t SNAPSHOT_VERSION = 1;
+
+    /// One archetype of a parsed snapshot with its column data ready to be copied into the world
+    struct SnapshotTable {
+        std::vector<uint64_t> ids;
+        /// Per id the index of the relationship target inside the snapshot, -1 for ids that don't target a snapshot entity
+        std::vector<int32_t> targets;
+        std::vector<uint32_t> entities;
+        std::vector<std::pair<uint64_t, std::vector<uint8_t>>> columns;
+        /// Index into columns and offset of every registered entity field, they hold a snapshot entity index + 1 or 0
+        std::vector<std::pair<size_t, uint32_t>> entityFields;
+        bool hasTargets = false;
+    };
+
+    /// Snapshot with its types, runtime data and assets resolved. It can be instantiated any number of times.
+    struct Snapshot {
+        uint32_t entityCount = 0;
+        std::vector<SnapshotTable> tables;
+        std::vector<std::pair<uint32_t, std::string>> names;
+        /// Entities without a parent inside the snapshot
+        std::vector<uint32_t> roots;
+        /// References a single instance holds per asset handle
+        std::unordered_map<uint32_t, uint32_t> modelRefs;
+        std::unordered_map<uint32_t, uint32_t> materialRefs;
+        std::unordered_map<uint32_t, uint32_t> physicsMaterialRefs;
+    };
+
+    /// Declares that the component holds an entity id at offset. Snapshots store the referenced entity by its snapshot index
+    /// and every instance points it at its own copy. References to entities outside the snapshot are cleared.
+    bool RegisterEntityField(uint64_t component, uint32_t offset);
+
+    /// Serialises all user entities (or only the ones carrying withTag) into the binary world format.
+    /// Layout: header, component type table, archetype tables with one contiguous blob per column, entity names, strings.
+    bool Save(std::vector<uint8_t>& data, uint64_t withTag = 0);
+    /// Bulk creates the entities of a snapshot. Must not be called while the world is progressing.
+    /// When addTag is set it is added to every created entity, entities receives the created ids in snapshot order.
+    /// Assets the snapshot loads are uploaded with priority.
+    bool Load(const uint8_t* data, size_t size, uint64_t addTag = 0, std::vector<uint64_t>* entities = nullptr, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
+    /// Loads a cooked world asset
+    bool LoadWorld(uint64_t hash, uint64_t addTag = 0, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
+
+    /// Resolves types and loads every referenced asset once. The snapshot keeps these references until it is released.
+    bool Parse(const uint8_t* data, size_t size, Snapshot& snapshot, rendering::UploadPriority priority = rendering::UploadPriority::Visible);
+    /// Creates count copies of the snapshot. entities receives count * entityCount ids, grouped by copy.
+    bool Instantiate(const Snapshot& snapshot, uint32_t count, uint64_t addTag = 0, std::vector<uint64_t>* entities = nullptr);
+    void Release(Snapshot& snapshot);
+
+    // Scripting
+    void Save_C(uint8_t* data, size_t* size);
+    bool Load_C(const uint8_t* data, size_t size);
+    bool LoadWorldByName(const char* name);
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace playground::worldstreaming {
+    constexpr uint32_t MANIFEST_MAGIC = 0x50475743; // PGWC
+    constexpr uint32_t MANIFEST_VERSION = 1;
+
+    struct StreamingSettings {
+        /// Cells closer than this to any camera get loaded
+        float loadRadius = 150.0f;
+        /// Assets of cells closer than this upload ahead of other cells' assets. Clamped to loadRadius.
+        float visibleRadius = 75.0f;
+        /// Loaded cells only get unloaded once every camera is farther away than this. Must be larger than loadRadius.
+        float unloadRadius = 200.0f;
+        /// Upper bound of cells that are loading or loaded at the same time
+        uint32_t maxResidentCells = 64;
+        /// Cells whose file reads are in flight on the job system
+        uint32_t maxConcurrentLoads = 4;
+        /// Cells instantiated into the world per frame
+        uint32_t maxInstantiationsPerFrame = 1;
+    };
+
+    struct CookedCell {
+        int32_t x;
+        int32_t z;
+        std::string name;
+        uint64_t hash;
+        std::vector<uint8_t> data;
+    };
+
+    void Init();
+    void Shutdown();
+
+    /// Splits all entities with a world transform into cells of cellSize on the XZ plane.
+    /// Hierarchies stay together in the cell of their root. Produces the manifest and one world snapshot per cell named <worldName>.<x>.<z>.cell.
+    bool Cook(const std::string& worldName, float cellSize, std::vector<uint8_t>& manifest, std::vector<CookedCell>& cells);
+
+    /// Opens a cooked world manifest. Cells are streamed in by Update.
+    bool Open(uint64_t manifestHash);
+    /// Destroys all streamed entities and forgets the manifest
+    void Close();
+    /// Loads and unloads cells around the active cameras. Must be called outside of the ECS tick.
+    void Update();
+
+    void SetSettings(const StreamingSettings& settings);
+    const StreamingSettings& GetSettings();
+    size_t ResidentCellCount();
+
+    // Scripting
+    bool OpenByName(const char* name);
+    void SetRadii(float loadRadius, float unloadRadius);
+}
@@ -7,4 +7,6 @@ struct CameraComponent {
     float Fov;
     float NearPlane;
     float FarPlane;
+    // Scales the screen size LODs are picked with by 2^-LodBias, positive values switch to coarser LODs earlier
+    float LodBias;
 };
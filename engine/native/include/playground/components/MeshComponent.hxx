@@ -15,5 +15,7 @@ struct MeshRuntimeComponent
 {
     uint32_t HandleId;
     uint16_t MeshId;
+    // LOD drawn last frame, the next selection only leaves it once the hysteresis band is crossed
+    uint8_t Lod;
 };
 
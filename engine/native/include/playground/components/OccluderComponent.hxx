@@ -0,0 +1,10 @@
+#pragma once
+
+#include <math/Vector3.hxx>
+
+/// Box proxy the batcher rasterizes into its CPU occlusion buffer, in the entity's local space.
+/// It must fit inside the geometry it stands for, a proxy sticking out hides things that are actually visible.
+struct OccluderComponent {
+    playground::math::Vector3 Center{ 0.0f, 0.0f, 0.0f };
+    playground::math::Vector3 Extents{ 0.5f, 0.5f, 0.5f };
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <math/Vector4.hxx>
+
+struct PointLightComponent {
+    playground::math::Vector4 Colour;
+    float Intensity;
+    /// Distance at which the light has faded out completely
+    float Radius;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "playground/components/WorldTransformComponent.hxx"
+#include <cstdint>
+
+/// Runtime link between an entity and its leaf in the spatial index
+struct SpatialProxyComponent {
+    int32_t ProxyId = -1;
+    // Mesh and transform the proxy's bounds were built from
+    uint32_t ModelHandle = 0;
+    uint16_t MeshId = 0;
+    WorldTransformComponent LastTransform = {};
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <math/Vector4.hxx>
+
+/// Shines along the entity's forward axis
+struct SpotLightComponent {
+    playground::math::Vector4 Colour;
+    float Intensity;
+    float Range;
+    /// Half angles of the cone in degrees, the light fades out between the inner and the outer one
+    float InnerAngle;
+    float OuterAngle;
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "playground/components/WorldTransformComponent.hxx"
+#include <cstdint>
+
+/// Runtime link between a static entity and its slot in the batcher's static cache
+struct StaticBatchComponent {
+    uint32_t Slot = UINT32_MAX;
+    uint32_t ModelHandle = 0;
+    uint32_t MaterialHandle = 0;
+    uint16_t MeshId = 0;
+    WorldTransformComponent LastTransform = {};
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+/// Marks an entity that rarely moves, its draw call lives in the batcher's static cache instead of being rebuilt every frame.
+/// Entities with a StaticBodyComponent are static without it.
+struct StaticComponent {
+    // Keeps the size in line with the managed struct, flecs would register an empty type as a tag
+    uint8_t Reserved = 0;
+};
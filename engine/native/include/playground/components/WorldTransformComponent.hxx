@@ -8,3 +8,10 @@ struct alignas(16) WorldTransformComponent {
     playground::math::Quaternion Rotation;
     playground::math::Vector3 Scale;
 };
+
+// Compared by value, freshly built transforms have undefined padding
+inline bool IsSameTransform(const WorldTransformComponent& lhs, const WorldTransformComponent& rhs) {
+    return lhs.Position == rhs.Position && lhs.Scale == rhs.Scale &&
+        lhs.Rotation.X == rhs.Rotation.X && lhs.Rotation.Y == rhs.Rotation.Y &&
+        lhs.Rotation.Z == rhs.Rotation.Z && lhs.Rotation.W == rhs.Rotation.W;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <flecs.h>
+
+namespace playground::ecs::spatialindexsystem {
+    void Init(flecs::world world);
+}
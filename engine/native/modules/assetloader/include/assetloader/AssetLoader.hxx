@@ -12,6 +12,8 @@
 #include <assetloader/RawAudioData.hxx>
 
 #include "RawSceneData.hxx"
+#include "RawWorldData.hxx"
+#include "RawPrefabData.hxx"
 
 namespace playground::assetloader {
     constexpr const char* ASSET_LOADER_VERSION = "01";
@@ -24,6 +26,8 @@ namespace playground::assetloader {
         PHYSICS_MATERIAL = 0x50584D41,
         CUBEMAP = 0x43554245,
         AUDIO = 0x41554449,
+        WORLD = 0x574F524C,
+        PREFAB = 0x50524642,
     };
 
     struct AssetMappingsFile
@@ -48,6 +52,10 @@ namespace playground::assetloader {
             return "0x43554245";
         case playground::assetloader::MAGIC_NUMBERS::AUDIO:
             return "0x41554449";
+        case playground::assetloader::MAGIC_NUMBERS::WORLD:
+            return "0x574F524C";
+        case playground::assetloader::MAGIC_NUMBERS::PREFAB:
+            return "0x50524642";
         default:
             break;
         }
@@ -66,5 +74,7 @@ namespace playground::assetloader {
     RawCubemapData LoadCubemap(uint64_t hash);
     RawAudioData LoadAudio(uint64_t hash);
     RawSceneData LoadScene(uint64_t hash);
+    RawWorldData LoadWorld(uint64_t hash);
+    RawPrefabData LoadPrefab(uint64_t hash);
     AssetMappingsFile LoadMappingsFile(uint64_t hash);
 }
@@ -50,6 +50,19 @@ namespace playground::assetloader
         }
     };
 
+    // Coarser version of a mesh, drawn once the mesh covers less than screenSize of the view's height
+    struct RawMeshLod {
+        float screenSize;
+        std::vector<RawVertex> vertices;
+        std::vector<uint32_t> indices;
+
+        template <class Archive>
+        void serialize(Archive& ar)
+        {
+            ar(screenSize, vertices, indices);
+        }
+    };
+
     struct RawMeshData {
         float posX;
         float posY;
@@ -65,11 +78,13 @@ namespace playground::assetloader
         std::vector<RawBone> bones;
         std::vector<RawVertex> vertices;
         std::vector<uint32_t> indices;
+        // Ordered from fine to coarse
+        std::vector<RawMeshLod> lods;
 
         template <class Archive>
         void serialize(Archive& ar)
         {
-            ar(posX, posY, posZ, rotX, rotY, rotZ, rotW, scaleX, scaleY, scaleZ, name, vertices, indices);
+            ar(posX, posY, posZ, rotX, rotY, rotZ, rotW, scaleX, scaleY, scaleZ, name, vertices, indices, lods);
         }
     };
 }
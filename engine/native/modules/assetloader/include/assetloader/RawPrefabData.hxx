@@ -1 +1,11 @@
 #pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace playground::assetloader {
+    /// Cooked prefab, a world snapshot of a single hierarchy that gets parsed into an archetype template once
+    struct RawPrefabData {
+        std::vector<uint8_t> prefabData;
+    };
+}
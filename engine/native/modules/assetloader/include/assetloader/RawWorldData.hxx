@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace playground::assetloader {
+    /// Cooked binary world snapshot, the bytes are consumed as is by the world snapshot loader
+    struct RawWorldData {
+        std::vector<uint8_t> worldData;
+    };
+}
@@ -244,4 +244,24 @@ namespace playground::assetloader {
 
         return RawSceneData { .sceneData = data };
     }
+
+    RawWorldData LoadWorld(uint64_t hash)
+    {
+        auto data = TryLoadFile(hash);
+        if (data.empty()) {
+            throw std::runtime_error("Failed to load data for world: " + std::to_string(hash));
+        }
+
+        return RawWorldData{ .worldData = std::move(data) };
+    }
+
+    RawPrefabData LoadPrefab(uint64_t hash)
+    {
+        auto data = TryLoadFile(hash);
+        if (data.empty()) {
+            throw std::runtime_error("Failed to load data for prefab: " + std::to_string(hash));
+        }
+
+        return RawPrefabData{ .prefabData = std::move(data) };
+    }
 }
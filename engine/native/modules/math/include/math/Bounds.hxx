@@ -0,0 +1,129 @@
+#pragma once
+
+#include "math/Vector3.hxx"
+#include "math/Quaternion.hxx"
+#include "math/Matrix4x4.hxx"
+#include <array>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+namespace playground::math {
+    struct BoundingBox {
+        Vector3 Min;
+        Vector3 Max;
+
+        BoundingBox() : Min(), Max() {}
+
+        BoundingBox(const Vector3& min, const Vector3& max) : Min(min), Max(max) {}
+
+        static BoundingBox Empty() {
+            constexpr float max = std::numeric_limits<float>::max();
+            return BoundingBox(Vector3(max, max, max), Vector3(-max, -max, -max));
+        }
+
+        static BoundingBox FromCenterExtents(const Vector3& center, const Vector3& extents) {
+            return BoundingBox(center - extents, center + extents);
+        }
+
+        inline Vector3 Center() const {
+            return (Min + Max) * 0.5f;
+        }
+
+        inline Vector3 Extents() const {
+            return (Max - Min) * 0.5f;
+        }
+
+        inline bool IsValid() const {
+            return Min.X <= Max.X && Min.Y <= Max.Y && Min.Z <= Max.Z;
+        }
+
+        inline float SurfaceArea() const {
+            Vector3 d = Max - Min;
+            return 2.0f * (d.X * d.Y + d.Y * d.Z + d.Z * d.X);
+        }
+
+        inline void Encapsulate(const Vector3& point) {
+            Min = Vector3(std::min(Min.X, point.X), std::min(Min.Y, point.Y), std::min(Min.Z, point.Z));
+            Max = Vector3(std::max(Max.X, point.X), std::max(Max.Y, point.Y), std::max(Max.Z, point.Z));
+        }
+
+        inline bool Contains(const BoundingBox& other) const {
+            return Min.X <= other.Min.X && Min.Y <= other.Min.Y && Min.Z <= other.Min.Z &&
+                Max.X >= other.Max.X && Max.Y >= other.Max.Y && Max.Z >= other.Max.Z;
+        }
+
+        inline bool Intersects(const BoundingBox& other) const {
+            return Min.X <= other.Max.X && Max.X >= other.Min.X &&
+                Min.Y <= other.Max.Y && Max.Y >= other.Min.Y &&
+                Min.Z <= other.Max.Z && Max.Z >= other.Min.Z;
+        }
+
+        /// Squared distance from the point to the closest point of the box, zero when inside
+        inline float DistanceSquared(const Vector3& point) const {
+            float dx = std::max(std::max(Min.X - point.X, 0.0f), point.X - Max.X);
+            float dy = std::max(std::max(Min.Y - point.Y, 0.0f), point.Y - Max.Y);
+            float dz = std::max(std::max(Min.Z - point.Z, 0.0f), point.Z - Max.Z);
+            return dx * dx + dy * dy + dz * dz;
+        }
+
+        static BoundingBox Merge(const BoundingBox& a, const BoundingBox& b) {
+            return BoundingBox(
+                Vector3(std::min(a.Min.X, b.Min.X), std::min(a.Min.Y, b.Min.Y), std::min(a.Min.Z, b.Min.Z)),
+                Vector3(std::max(a.Max.X, b.Max.X), std::max(a.Max.Y, b.Max.Y), std::max(a.Max.Z, b.Max.Z))
+            );
+        }
+    };
+
+    struct BoundingSphere {
+        Vector3 Center;
+        float Radius;
+
+        BoundingSphere() : Center(), Radius(0.0f) {}
+
+        BoundingSphere(const Vector3& center, float radius) : Center(center), Radius(radius) {}
+
+        inline bool Intersects(const BoundingBox& box) const {
+            return box.DistanceSquared(Center) <= Radius * Radius;
+        }
+    };
+
+    /// Plane in the form dot(Normal, p) + Distance = 0, the positive half space is "inside"
+    struct Plane {
+        Vector3 Normal;
+        float Distance;
+
+        inline float SignedDistance(const Vector3& point) const {
+            return Normal.Dot(point) + Distance;
+        }
+    };
+
+    struct Frustum {
+        enum Side : uint8_t {
+            Left = 0,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far
+        };
+
+        std::array<Plane, 6> Planes;
+
+        /// Extracts the planes of a row-vector (v * M) view-projection matrix with a [0, 1] depth range
+        static Frustum FromViewProjection(const Matrix4x4& viewProjection);
+
+        bool Intersects(const BoundingBox& box) const;
+        bool Intersects(const BoundingSphere& sphere) const;
+    };
+
+    /// Transforms a local space box by a row-vector affine matrix and returns the enclosing world space box
+    BoundingBox TransformBounds(const BoundingBox& local, const Matrix4x4& world);
+
+    /// Sphere enclosing a local space box placed with the same transform Mat4FromPRS builds, without building the matrix
+    BoundingSphere TransformBounds(const BoundingBox& local, const Vector3& position, const Quaternion& rotation, const Vector3& scale);
+
+    /// Tests count spheres given as structure of arrays against the frustum, four at a time.
+    /// Every sphere that intersects gets mask OR-ed into its entry in masks, the others are left untouched.
+    void CullSpheres(const Frustum& frustum, const float* centerX, const float* centerY, const float* centerZ, const float* radius, size_t count, uint8_t mask, uint8_t* masks);
+}
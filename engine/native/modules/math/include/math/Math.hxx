@@ -13,6 +13,25 @@ namespace playground::math {
 
     void Mat4FromPRSBulk(const Vector3* position, const Quaternion* rotation, const Vector3* scale, size_t count, Matrix4x4* mats);
 
+    /// Structure of arrays view over transforms, every stream holds one component of count transforms
+    struct TransformStreams {
+        const float* positionX;
+        const float* positionY;
+        const float* positionZ;
+        const float* rotationX;
+        const float* rotationY;
+        const float* rotationZ;
+        const float* rotationW;
+        const float* scaleX;
+        const float* scaleY;
+        const float* scaleZ;
+    };
+
+    /// Builds the affine part of the world matrix (same as Mat4FromPRS) of count transforms as three columns per instance.
+    /// Column j holds world[0..2][j] with the translation world[3][j] in W, so a point transforms as dot(float4(p, 1), column).
+    /// Outputs are written stride bytes apart so they can land directly in interleaved instance data.
+    void InstanceTransformsBulk(const TransformStreams& transforms, size_t count, Vector4* columns, size_t stride);
+
     void GetViewMatrix(const Vector3* position, const Quaternion* rotation, Matrix4x4* outMat);
 
     void LookAtLH(const Vector3& eye, const Vector3& target, const Vector3& up, Matrix4x4* out);
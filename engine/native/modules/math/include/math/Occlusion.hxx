@@ -0,0 +1,47 @@
+#pragma once
+
+#include "math/Vector3.hxx"
+#include "math/Matrix4x4.hxx"
+#include "math/Bounds.hxx"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace playground::math {
+    /// Low resolution depth buffer occluders get rasterized into on the CPU, candidates are tested against a max depth hierarchy of it.
+    /// Depth follows the D3D convention of the engine, 0 at the near plane and 1 at the far plane.
+    class OcclusionBuffer {
+    public:
+        OcclusionBuffer(uint32_t width, uint32_t height);
+
+        inline uint32_t Width() const { return width; }
+        inline uint32_t Height() const { return height; }
+
+        void Clear();
+
+        /// Rasterizes indexed triangles given in object space (v * M) into the rows [firstRow, lastRow), four pixels at a time.
+        /// Disjoint row ranges touch disjoint memory, so a buffer can be split into bands that are rasterized in parallel.
+        /// Triangles crossing the near plane are skipped, which only ever makes the buffer less occluding.
+        void Rasterize(const Vector3* vertices, const uint32_t* indices, size_t indexCount, const Matrix4x4& worldViewProjection, uint32_t firstRow, uint32_t lastRow);
+        /// Rasterizes the twelve triangles of a box, the usual shape of cooked occluder proxies
+        void RasterizeBox(const BoundingBox& box, const Matrix4x4& worldViewProjection, uint32_t firstRow, uint32_t lastRow);
+
+        /// Builds the max depth hierarchy, must run after rasterizing and before testing
+        void BuildHierarchy();
+
+        /// Tests a world space box. Returns false only when every pixel it could cover lies behind an occluder.
+        bool IsVisible(const BoundingBox& box, const Matrix4x4& viewProjection) const;
+
+        /// Depth of a level 0 pixel
+        inline float Depth(uint32_t x, uint32_t y) const { return levels[0][y * stride + x]; }
+
+    private:
+        uint32_t width;
+        uint32_t height;
+        // Level 0 rows are padded to a multiple of four so the rasterizer never needs a scalar tail
+        uint32_t stride;
+        std::vector<std::vector<float>> levels;
+        std::vector<uint32_t> levelWidths;
+        std::vector<uint32_t> levelHeights;
+    };
+}
@@ -0,0 +1,150 @@
+#include "math/Bounds.hxx"
+#include <cmath>
+#include <simde/x86/avx.h>
+
+namespace playground::math {
+    Frustum Frustum::FromViewProjection(const Matrix4x4& m) {
+        Frustum frustum;
+
+        auto column = [&m](int col, float sign, int baseCol) {
+            Vector3 normal(
+                m.elements[0][baseCol] + sign * m.elements[0][col],
+                m.elements[1][baseCol] + sign * m.elements[1][col],
+                m.elements[2][baseCol] + sign * m.elements[2][col]
+            );
+            float distance = m.elements[3][baseCol] + sign * m.elements[3][col];
+
+            float length = normal.Length();
+            if (length > 0.0f) {
+                normal = normal / length;
+                distance /= length;
+            }
+
+            return Plane{ normal, distance };
+        };
+
+        frustum.Planes[Left] = column(0, 1.0f, 3);
+        frustum.Planes[Right] = column(0, -1.0f, 3);
+        frustum.Planes[Bottom] = column(1, 1.0f, 3);
+        frustum.Planes[Top] = column(1, -1.0f, 3);
+        frustum.Planes[Far] = column(2, -1.0f, 3);
+
+        // D3D style depth: 0 <= z, so the near plane is the z column alone
+        Vector3 nearNormal(m.elements[0][2], m.elements[1][2], m.elements[2][2]);
+        float nearDistance = m.elements[3][2];
+        float nearLength = nearNormal.Length();
+        if (nearLength > 0.0f) {
+            nearNormal = nearNormal / nearLength;
+            nearDistance /= nearLength;
+        }
+        frustum.Planes[Near] = Plane{ nearNormal, nearDistance };
+
+        return frustum;
+    }
+
+    bool Frustum::Intersects(const BoundingBox& box) const {
+        Vector3 center = box.Center();
+        Vector3 extents = box.Extents();
+
+        for (const auto& plane : Planes) {
+            float radius = extents.X * std::fabs(plane.Normal.X) +
+                extents.Y * std::fabs(plane.Normal.Y) +
+                extents.Z * std::fabs(plane.Normal.Z);
+
+            if (plane.SignedDistance(center) < -radius) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool Frustum::Intersects(const BoundingSphere& sphere) const {
+        for (const auto& plane : Planes) {
+            if (plane.SignedDistance(sphere.Center) < -sphere.Radius) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    BoundingBox TransformBounds(const BoundingBox& local, const Matrix4x4& world) {
+        // Arvo: project the extents onto each world axis instead of transforming all eight corners
+        Vector3 center = local.Center();
+        Vector3 extents = local.Extents();
+
+        Vector3 worldCenter(
+            center.X * world.elements[0][0] + center.Y * world.elements[1][0] + center.Z * world.elements[2][0] + world.elements[3][0],
+            center.X * world.elements[0][1] + center.Y * world.elements[1][1] + center.Z * world.elements[2][1] + world.elements[3][1],
+            center.X * world.elements[0][2] + center.Y * world.elements[1][2] + center.Z * world.elements[2][2] + world.elements[3][2]
+        );
+
+        Vector3 worldExtents(
+            extents.X * std::fabs(world.elements[0][0]) + extents.Y * std::fabs(world.elements[1][0]) + extents.Z * std::fabs(world.elements[2][0]),
+            extents.X * std::fabs(world.elements[0][1]) + extents.Y * std::fabs(world.elements[1][1]) + extents.Z * std::fabs(world.elements[2][1]),
+            extents.X * std::fabs(world.elements[0][2]) + extents.Y * std::fabs(world.elements[1][2]) + extents.Z * std::fabs(world.elements[2][2])
+        );
+
+        return BoundingBox::FromCenterExtents(worldCenter, worldExtents);
+    }
+
+    BoundingSphere TransformBounds(const BoundingBox& local, const Vector3& position, const Quaternion& rotation, const Vector3& scale) {
+        const float x = rotation.X, y = rotation.Y, z = rotation.Z, w = rotation.W;
+        const float xx = x * x, yy = y * y, zz = z * z;
+        const float xy = x * y, xz = x * z, yz = y * z;
+        const float wx = w * x, wy = w * y, wz = w * z;
+
+        Vector3 c = local.Center();
+
+        // Row-vector c * R with the rotation rows of Mat4FromPRS, then scaled per column like the world matrix
+        Vector3 rotated(
+            c.X * (1.0f - 2.0f * (yy + zz)) + c.Y * (2.0f * (xy - wz)) + c.Z * (2.0f * (xz + wy)),
+            c.X * (2.0f * (xy + wz)) + c.Y * (1.0f - 2.0f * (xx + zz)) + c.Z * (2.0f * (yz - wx)),
+            c.X * (2.0f * (xz - wy)) + c.Y * (2.0f * (yz + wx)) + c.Z * (1.0f - 2.0f * (xx + yy))
+        );
+
+        float maxScale = std::max(std::fabs(scale.X), std::max(std::fabs(scale.Y), std::fabs(scale.Z)));
+
+        return BoundingSphere(rotated * scale + position, local.Extents().Length() * maxScale);
+    }
+
+    void CullSpheres(const Frustum& frustum, const float* centerX, const float* centerY, const float* centerZ, const float* radius, size_t count, uint8_t mask, uint8_t* masks) {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            simde__m128 cx = simde_mm_loadu_ps(centerX + i);
+            simde__m128 cy = simde_mm_loadu_ps(centerY + i);
+            simde__m128 cz = simde_mm_loadu_ps(centerZ + i);
+            simde__m128 negativeRadius = simde_mm_sub_ps(simde_mm_setzero_ps(), simde_mm_loadu_ps(radius + i));
+
+            simde__m128 inside = simde_mm_castsi128_ps(simde_mm_set1_epi32(-1));
+            for (const auto& plane : frustum.Planes) {
+                simde__m128 distance = simde_mm_add_ps(
+                    simde_mm_add_ps(
+                        simde_mm_mul_ps(cx, simde_mm_set1_ps(plane.Normal.X)),
+                        simde_mm_mul_ps(cy, simde_mm_set1_ps(plane.Normal.Y))
+                    ),
+                    simde_mm_add_ps(
+                        simde_mm_mul_ps(cz, simde_mm_set1_ps(plane.Normal.Z)),
+                        simde_mm_set1_ps(plane.Distance)
+                    )
+                );
+
+                inside = simde_mm_and_ps(inside, simde_mm_cmpge_ps(distance, negativeRadius));
+            }
+
+            int visible = simde_mm_movemask_ps(inside);
+            for (size_t lane = 0; lane < 4; lane++) {
+                if (visible & (1 << lane)) {
+                    masks[i + lane] |= mask;
+                }
+            }
+        }
+
+        for (; i < count; i++) {
+            if (frustum.Intersects(BoundingSphere(Vector3(centerX[i], centerY[i], centerZ[i]), radius[i]))) {
+                masks[i] |= mask;
+            }
+        }
+    }
+}
@@ -71,6 +71,134 @@ namespace playground::math {
         }
     }
 
+    // Lane width abstractions for the instance kernel. AVX is only used when the build targets it, SSE is always available.
+    struct Lanes4 {
+        using V = simde__m128;
+        static constexpr size_t Width = 4;
+
+        static V Load(const float* p) { return simde_mm_loadu_ps(p); }
+        static V Set(float v) { return simde_mm_set1_ps(v); }
+        static V Zero() { return simde_mm_setzero_ps(); }
+        static V Add(V a, V b) { return simde_mm_add_ps(a, b); }
+        static V Sub(V a, V b) { return simde_mm_sub_ps(a, b); }
+        static V Mul(V a, V b) { return simde_mm_mul_ps(a, b); }
+
+        // Transposes four component vectors into one 16 byte row per instance and stores it
+        static void StoreRows(V a, V b, V c, V d, uint8_t* base, size_t stride, size_t row) {
+            V t0 = simde_mm_unpacklo_ps(a, b);
+            V t1 = simde_mm_unpackhi_ps(a, b);
+            V t2 = simde_mm_unpacklo_ps(c, d);
+            V t3 = simde_mm_unpackhi_ps(c, d);
+
+            size_t offset = row * 4 * sizeof(float);
+            simde_mm_storeu_ps(reinterpret_cast<float*>(base + offset), simde_mm_movelh_ps(t0, t2));
+            simde_mm_storeu_ps(reinterpret_cast<float*>(base + stride + offset), simde_mm_movehl_ps(t2, t0));
+            simde_mm_storeu_ps(reinterpret_cast<float*>(base + 2 * stride + offset), simde_mm_movelh_ps(t1, t3));
+            simde_mm_storeu_ps(reinterpret_cast<float*>(base + 3 * stride + offset), simde_mm_movehl_ps(t3, t1));
+        }
+    };
+
+#if defined(SIMDE_X86_AVX_NATIVE)
+    struct Lanes8 {
+        using V = simde__m256;
+        static constexpr size_t Width = 8;
+
+        static V Load(const float* p) { return simde_mm256_loadu_ps(p); }
+        static V Set(float v) { return simde_mm256_set1_ps(v); }
+        static V Zero() { return simde_mm256_setzero_ps(); }
+        static V Add(V a, V b) { return simde_mm256_add_ps(a, b); }
+        static V Sub(V a, V b) { return simde_mm256_sub_ps(a, b); }
+        static V Mul(V a, V b) { return simde_mm256_mul_ps(a, b); }
+
+        // Same transpose as the 4 wide path, the low half holds instances 0-3 and the high half 4-7
+        static void StoreRows(V a, V b, V c, V d, uint8_t* base, size_t stride, size_t row) {
+            V t0 = simde_mm256_unpacklo_ps(a, b);
+            V t1 = simde_mm256_unpackhi_ps(a, b);
+            V t2 = simde_mm256_unpacklo_ps(c, d);
+            V t3 = simde_mm256_unpackhi_ps(c, d);
+
+            V rows[4] = {
+                simde_mm256_shuffle_ps(t0, t2, SIMDE_MM_SHUFFLE(1, 0, 1, 0)),
+                simde_mm256_shuffle_ps(t0, t2, SIMDE_MM_SHUFFLE(3, 2, 3, 2)),
+                simde_mm256_shuffle_ps(t1, t3, SIMDE_MM_SHUFFLE(1, 0, 1, 0)),
+                simde_mm256_shuffle_ps(t1, t3, SIMDE_MM_SHUFFLE(3, 2, 3, 2)),
+            };
+
+            size_t offset = row * 4 * sizeof(float);
+            for (size_t x = 0; x < 4; x++) {
+                simde_mm_storeu_ps(reinterpret_cast<float*>(base + x * stride + offset), simde_mm256_castps256_ps128(rows[x]));
+                simde_mm_storeu_ps(reinterpret_cast<float*>(base + (x + 4) * stride + offset), simde_mm256_extractf128_ps(rows[x], 1));
+            }
+        }
+    };
+#endif
+
+    template<typename L>
+    void InstanceTransformsLanes(const TransformStreams& t, size_t i, uint8_t* columns, size_t stride) {
+        using V = typename L::V;
+
+        V x = L::Load(t.rotationX + i);
+        V y = L::Load(t.rotationY + i);
+        V z = L::Load(t.rotationZ + i);
+        V w = L::Load(t.rotationW + i);
+
+        V one = L::Set(1.0f);
+        V two = L::Set(2.0f);
+
+        V xx = L::Mul(x, x), yy = L::Mul(y, y), zz = L::Mul(z, z);
+        V xy = L::Mul(x, y), xz = L::Mul(x, z), yz = L::Mul(y, z);
+        V wx = L::Mul(w, x), wy = L::Mul(w, y), wz = L::Mul(w, z);
+
+        // Rotation rows, identical to Mat4FromPRS
+        V r00 = L::Sub(one, L::Mul(two, L::Add(yy, zz)));
+        V r01 = L::Mul(two, L::Add(xy, wz));
+        V r02 = L::Mul(two, L::Sub(xz, wy));
+        V r10 = L::Mul(two, L::Sub(xy, wz));
+        V r11 = L::Sub(one, L::Mul(two, L::Add(xx, zz)));
+        V r12 = L::Mul(two, L::Add(yz, wx));
+        V r20 = L::Mul(two, L::Add(xz, wy));
+        V r21 = L::Mul(two, L::Sub(yz, wx));
+        V r22 = L::Sub(one, L::Mul(two, L::Add(xx, yy)));
+
+        V sx = L::Load(t.scaleX + i);
+        V sy = L::Load(t.scaleY + i);
+        V sz = L::Load(t.scaleZ + i);
+
+        // Columns of the world matrix, the translation lands in W
+        uint8_t* base = columns + i * stride;
+        L::StoreRows(L::Mul(r00, sx), L::Mul(r10, sx), L::Mul(r20, sx), L::Load(t.positionX + i), base, stride, 0);
+        L::StoreRows(L::Mul(r01, sy), L::Mul(r11, sy), L::Mul(r21, sy), L::Load(t.positionY + i), base, stride, 1);
+        L::StoreRows(L::Mul(r02, sz), L::Mul(r12, sz), L::Mul(r22, sz), L::Load(t.positionZ + i), base, stride, 2);
+    }
+
+    void InstanceTransformsBulk(const TransformStreams& transforms, size_t count, Vector4* columns, size_t stride) {
+        auto bytes = reinterpret_cast<uint8_t*>(columns);
+
+        size_t i = 0;
+#if defined(SIMDE_X86_AVX_NATIVE)
+        for (; i + Lanes8::Width <= count; i += Lanes8::Width) {
+            InstanceTransformsLanes<Lanes8>(transforms, i, bytes, stride);
+        }
+#endif
+        for (; i + Lanes4::Width <= count; i += Lanes4::Width) {
+            InstanceTransformsLanes<Lanes4>(transforms, i, bytes, stride);
+        }
+
+        for (; i < count; i++) {
+            Vector3 position(transforms.positionX[i], transforms.positionY[i], transforms.positionZ[i]);
+            Quaternion rotation(transforms.rotationX[i], transforms.rotationY[i], transforms.rotationZ[i], transforms.rotationW[i]);
+            Vector3 scale(transforms.scaleX[i], transforms.scaleY[i], transforms.scaleZ[i]);
+
+            Matrix4x4 world;
+            Mat4FromPRS(&position, &rotation, &scale, &world);
+
+            auto out = reinterpret_cast<Vector4*>(bytes + i * stride);
+            for (int column = 0; column < 3; column++) {
+                out[column] = Vector4(world.elements[0][column], world.elements[1][column], world.elements[2][column], world.elements[3][column]);
+            }
+        }
+    }
+
     void GetViewMatrix(const Vector3* position, const Quaternion* rotation, Matrix4x4* outMat) {
         // First compute the rotation matrix from the *normalised* quaternion (no inverse)
         const float x = rotation->X;
@@ -23,7 +23,7 @@ namespace playground::math {
     }
 
     Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const {
-        Matrix4x4 result;
+        auto result = Zero();
         for (int row = 0; row < 4; ++row) {
             for (int col = 0; col < 4; ++col) {
                 for (int k = 0; k < 4; ++k) {
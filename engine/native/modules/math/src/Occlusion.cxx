@@ -0,0 +1,281 @@
+#include "math/Occlusion.hxx"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <simde/x86/avx.h>
+
+namespace playground::math {
+    namespace {
+        constexpr float MIN_CLIP_W = 1e-5f;
+
+        struct ScreenVertex {
+            float x;
+            float y;
+            float z;
+        };
+
+        // Projects an object space point to pixel coordinates, fails for points behind the near plane
+        inline bool ToScreen(const Vector3& v, const Matrix4x4& m, float width, float height, ScreenVertex& out) {
+            const auto& e = m.elements;
+            float x = v.X * e[0][0] + v.Y * e[1][0] + v.Z * e[2][0] + e[3][0];
+            float y = v.X * e[0][1] + v.Y * e[1][1] + v.Z * e[2][1] + e[3][1];
+            float z = v.X * e[0][2] + v.Y * e[1][2] + v.Z * e[2][2] + e[3][2];
+            float w = v.X * e[0][3] + v.Y * e[1][3] + v.Z * e[2][3] + e[3][3];
+
+            if (w < MIN_CLIP_W || z < 0.0f) {
+                return false;
+            }
+
+            float invW = 1.0f / w;
+            out.x = (x * invW * 0.5f + 0.5f) * width;
+            out.y = (0.5f - y * invW * 0.5f) * height;
+            out.z = z * invW;
+
+            return true;
+        }
+
+        inline std::array<Vector3, 8> Corners(const BoundingBox& box) {
+            return {
+                Vector3(box.Min.X, box.Min.Y, box.Min.Z),
+                Vector3(box.Max.X, box.Min.Y, box.Min.Z),
+                Vector3(box.Min.X, box.Max.Y, box.Min.Z),
+                Vector3(box.Max.X, box.Max.Y, box.Min.Z),
+                Vector3(box.Min.X, box.Min.Y, box.Max.Z),
+                Vector3(box.Max.X, box.Min.Y, box.Max.Z),
+                Vector3(box.Min.X, box.Max.Y, box.Max.Z),
+                Vector3(box.Max.X, box.Max.Y, box.Max.Z),
+            };
+        }
+
+        // Two triangles per face of the corners above, the rasterizer is two sided so the winding doesn't matter
+        constexpr std::array<uint32_t, 36> BOX_INDICES = {
+            0, 2, 1, 1, 2, 3,
+            4, 5, 6, 5, 7, 6,
+            0, 1, 4, 1, 5, 4,
+            2, 6, 3, 3, 6, 7,
+            0, 4, 2, 2, 4, 6,
+            1, 3, 5, 3, 7, 5,
+        };
+    }
+
+    OcclusionBuffer::OcclusionBuffer(uint32_t width, uint32_t height) : width(std::max(width, 1u)), height(std::max(height, 1u)) {
+        stride = (this->width + 3) & ~3u;
+
+        uint32_t levelWidth = stride;
+        uint32_t levelHeight = this->height;
+        uint32_t usedWidth = this->width;
+        while (true) {
+            levels.emplace_back(static_cast<size_t>(levelWidth) * levelHeight, 1.0f);
+            levelWidths.push_back(levelWidth);
+            levelHeights.push_back(levelHeight);
+
+            if (usedWidth == 1 && levelHeight == 1) {
+                break;
+            }
+
+            usedWidth = (usedWidth + 1) / 2;
+            levelWidth = usedWidth;
+            levelHeight = (levelHeight + 1) / 2;
+        }
+    }
+
+    void OcclusionBuffer::Clear() {
+        std::fill(levels[0].begin(), levels[0].end(), 1.0f);
+    }
+
+    void OcclusionBuffer::Rasterize(const Vector3* vertices, const uint32_t* indices, size_t indexCount, const Matrix4x4& worldViewProjection, uint32_t firstRow, uint32_t lastRow) {
+        lastRow = std::min(lastRow, height);
+        if (firstRow >= lastRow) {
+            return;
+        }
+
+        float fw = static_cast<float>(width);
+        float fh = static_cast<float>(height);
+        float* depth = levels[0].data();
+
+        const simde__m128 laneOffsets = simde_mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const simde__m128 zero = simde_mm_setzero_ps();
+
+        for (size_t t = 0; t + 2 < indexCount; t += 3) {
+            ScreenVertex v[3];
+            if (!ToScreen(vertices[indices[t]], worldViewProjection, fw, fh, v[0]) ||
+                !ToScreen(vertices[indices[t + 1]], worldViewProjection, fw, fh, v[1]) ||
+                !ToScreen(vertices[indices[t + 2]], worldViewProjection, fw, fh, v[2])) {
+                continue;
+            }
+
+            // Edge functions in the form A * x + B * y + C, edge i is opposite of vertex i
+            float a[3];
+            float b[3];
+            float c[3];
+            for (int i = 0; i < 3; i++) {
+                const auto& from = v[(i + 1) % 3];
+                const auto& to = v[(i + 2) % 3];
+                a[i] = from.y - to.y;
+                b[i] = to.x - from.x;
+                c[i] = -(a[i] * from.x + b[i] * from.y);
+            }
+
+            float area = a[2] * v[2].x + b[2] * v[2].y + c[2];
+            if (std::abs(area) < 1e-6f) {
+                continue;
+            }
+
+            // Both windings are rasterized, flipping the edges keeps the inside positive
+            if (area < 0.0f) {
+                for (int i = 0; i < 3; i++) {
+                    a[i] = -a[i];
+                    b[i] = -b[i];
+                    c[i] = -c[i];
+                }
+                area = -area;
+            }
+
+            // Depth is linear in screen space, precompute its plane
+            float invArea = 1.0f / area;
+            float zx = (a[0] * v[0].z + a[1] * v[1].z + a[2] * v[2].z) * invArea;
+            float zy = (b[0] * v[0].z + b[1] * v[1].z + b[2] * v[2].z) * invArea;
+            float z0 = (c[0] * v[0].z + c[1] * v[1].z + c[2] * v[2].z) * invArea;
+
+            float minX = std::min({ v[0].x, v[1].x, v[2].x });
+            float maxX = std::max({ v[0].x, v[1].x, v[2].x });
+            float minY = std::min({ v[0].y, v[1].y, v[2].y });
+            float maxY = std::max({ v[0].y, v[1].y, v[2].y });
+
+            if (maxX < 0.0f || maxY < 0.0f || minX >= fw || minY >= fh) {
+                continue;
+            }
+
+            auto xBegin = static_cast<uint32_t>(std::max(minX, 0.0f)) & ~3u;
+            auto xEnd = std::min(static_cast<uint32_t>(std::ceil(maxX)), width);
+            auto yBegin = std::max(static_cast<uint32_t>(std::max(minY, 0.0f)), firstRow);
+            auto yEnd = std::min(static_cast<uint32_t>(std::ceil(maxY)), lastRow);
+
+            const simde__m128 xLimit = simde_mm_set1_ps(static_cast<float>(xEnd));
+            simde__m128 step[3];
+            simde__m128 edgeA[3];
+            for (int i = 0; i < 3; i++) {
+                step[i] = simde_mm_set1_ps(a[i] * 4.0f);
+                edgeA[i] = simde_mm_set1_ps(a[i]);
+            }
+            const simde__m128 zStep = simde_mm_set1_ps(zx * 4.0f);
+
+            for (uint32_t y = yBegin; y < yEnd; y++) {
+                float py = static_cast<float>(y) + 0.5f;
+                simde__m128 px = simde_mm_add_ps(simde_mm_set1_ps(static_cast<float>(xBegin)), laneOffsets);
+
+                simde__m128 w[3];
+                for (int i = 0; i < 3; i++) {
+                    w[i] = simde_mm_add_ps(simde_mm_mul_ps(edgeA[i], px), simde_mm_set1_ps(b[i] * py + c[i]));
+                }
+                simde__m128 z = simde_mm_add_ps(simde_mm_mul_ps(simde_mm_set1_ps(zx), px), simde_mm_set1_ps(zy * py + z0));
+
+                float* row = depth + static_cast<size_t>(y) * stride;
+                for (uint32_t x = xBegin; x < xEnd; x += 4) {
+                    // Pixel centers strictly inside, so neighbouring occluders never grow past their edges
+                    simde__m128 inside = simde_mm_and_ps(
+                        simde_mm_and_ps(simde_mm_cmpgt_ps(w[0], zero), simde_mm_cmpgt_ps(w[1], zero)),
+                        simde_mm_and_ps(simde_mm_cmpgt_ps(w[2], zero), simde_mm_cmplt_ps(px, xLimit))
+                    );
+
+                    if (simde_mm_movemask_ps(inside) != 0) {
+                        simde__m128 current = simde_mm_loadu_ps(row + x);
+                        simde__m128 nearer = simde_mm_min_ps(current, z);
+                        simde_mm_storeu_ps(row + x, simde_mm_blendv_ps(current, nearer, inside));
+                    }
+
+                    for (int i = 0; i < 3; i++) {
+                        w[i] = simde_mm_add_ps(w[i], step[i]);
+                    }
+                    z = simde_mm_add_ps(z, zStep);
+                    px = simde_mm_add_ps(px, simde_mm_set1_ps(4.0f));
+                }
+            }
+        }
+    }
+
+    void OcclusionBuffer::RasterizeBox(const BoundingBox& box, const Matrix4x4& worldViewProjection, uint32_t firstRow, uint32_t lastRow) {
+        auto corners = Corners(box);
+        Rasterize(corners.data(), BOX_INDICES.data(), BOX_INDICES.size(), worldViewProjection, firstRow, lastRow);
+    }
+
+    void OcclusionBuffer::BuildHierarchy() {
+        for (size_t level = 1; level < levels.size(); level++) {
+            const auto& source = levels[level - 1];
+            auto& target = levels[level];
+            auto sourceWidth = level == 1 ? width : levelWidths[level - 1];
+            auto sourceStride = levelWidths[level - 1];
+            auto sourceHeight = levelHeights[level - 1];
+
+            for (uint32_t y = 0; y < levelHeights[level]; y++) {
+                auto y0 = y * 2;
+                auto y1 = std::min(y0 + 1, sourceHeight - 1);
+
+                for (uint32_t x = 0; x < levelWidths[level]; x++) {
+                    auto x0 = x * 2;
+                    auto x1 = std::min(x0 + 1, sourceWidth - 1);
+
+                    // The farthest depth of the four keeps the test conservative
+                    target[y * levelWidths[level] + x] = std::max(
+                        std::max(source[y0 * sourceStride + x0], source[y0 * sourceStride + x1]),
+                        std::max(source[y1 * sourceStride + x0], source[y1 * sourceStride + x1])
+                    );
+                }
+            }
+        }
+    }
+
+    bool OcclusionBuffer::IsVisible(const BoundingBox& box, const Matrix4x4& viewProjection) const {
+        float fw = static_cast<float>(width);
+        float fh = static_cast<float>(height);
+
+        float minX = fw;
+        float maxX = 0.0f;
+        float minY = fh;
+        float maxY = 0.0f;
+        float minZ = 1.0f;
+
+        for (const auto& corner : Corners(box)) {
+            ScreenVertex v;
+
+            // Boxes reaching behind the near plane are too close to reason about
+            if (!ToScreen(corner, viewProjection, fw, fh, v)) {
+                return true;
+            }
+
+            minX = std::min(minX, v.x);
+            maxX = std::max(maxX, v.x);
+            minY = std::min(minY, v.y);
+            maxY = std::max(maxY, v.y);
+            minZ = std::min(minZ, v.z);
+        }
+
+        // Off screen boxes are the frustum test's business
+        if (maxX < 0.0f || maxY < 0.0f || minX >= fw || minY >= fh) {
+            return true;
+        }
+
+        auto x0 = static_cast<uint32_t>(std::max(minX, 0.0f));
+        auto x1 = std::min(static_cast<uint32_t>(maxX), width - 1);
+        auto y0 = static_cast<uint32_t>(std::max(minY, 0.0f));
+        auto y1 = std::min(static_cast<uint32_t>(maxY), height - 1);
+
+        // Coarsest level where the box covers at most 2x2 texels
+        size_t level = 0;
+        while (level + 1 < levels.size() && (((x1 >> level) - (x0 >> level)) > 1 || ((y1 >> level) - (y0 >> level)) > 1)) {
+            level++;
+        }
+
+        const auto& depth = levels[level];
+        auto levelStride = levelWidths[level];
+        for (uint32_t y = y0 >> level; y <= (y1 >> level); y++) {
+            for (uint32_t x = x0 >> level; x <= (x1 >> level); x++) {
+                if (minZ <= depth[y * levelStride + x]) {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,50 @@
+#include <GTest/GTest.h>
+
+#include <math/Math.hxx>
+#include <math/Bounds.hxx>
+
+using namespace playground::math;
+
+namespace {
+    // Camera ten units behind the origin looking down +Z, so the view matrix carries a translation
+    Frustum CameraFrustum() {
+        Matrix4x4 view;
+        LookAtLH(Vector3(0, 0, -10), Vector3(0, 0, 0), Vector3(0, 1, 0), &view);
+        Matrix4x4 projection;
+        GetProjectionMatrix(60.0f, 16.0f / 9.0f, 0.1f, 100.0f, &projection);
+
+        return Frustum::FromViewProjection(view * projection);
+    }
+}
+
+TEST(Frustum, KeepsSpheresInFrontOfTheCamera) {
+    auto frustum = CameraFrustum();
+
+    EXPECT_TRUE(frustum.Intersects(BoundingSphere(Vector3(0, 0, 0), 1.0f)));
+    EXPECT_TRUE(frustum.Intersects(BoundingSphere(Vector3(3, 2, 20), 1.0f)));
+}
+
+TEST(Frustum, CullsSpheresBehindAndBesideTheCamera) {
+    auto frustum = CameraFrustum();
+
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere(Vector3(0, 0, -20), 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere(Vector3(50, 0, 0), 1.0f)));
+    EXPECT_FALSE(frustum.Intersects(BoundingSphere(Vector3(0, 0, 200), 1.0f)));
+}
+
+TEST(Frustum, SimdCullingMatchesTheScalarTest) {
+    auto frustum = CameraFrustum();
+    float x[] = { 0, 0, 50, 3, 0 };
+    float y[] = { 0, 0, 0, 2, 0 };
+    float z[] = { 0, -20, 0, 20, 200 };
+    float radius[] = { 1, 1, 1, 1, 1 };
+    uint8_t masks[5] = {};
+
+    CullSpheres(frustum, x, y, z, radius, 5, 1, masks);
+
+    for (size_t i = 0; i < 5; i++) {
+        EXPECT_EQ(masks[i] != 0, frustum.Intersects(BoundingSphere(Vector3(x[i], y[i], z[i]), radius[i]))) << i;
+    }
+    EXPECT_EQ(masks[0], 1);
+    EXPECT_EQ(masks[1], 0);
+}
@@ -0,0 +1,113 @@
+#include <GTest/GTest.h>
+
+#include <math/Math.hxx>
+#include <math/Occlusion.hxx>
+#include <chrono>
+
+using namespace playground::math;
+
+namespace {
+    // Camera at the origin looking down +Z, world space is view space
+    Matrix4x4 Projection() {
+        Matrix4x4 projection;
+        GetProjectionMatrix(60.0f, 2.0f, 0.1f, 100.0f, &projection);
+        return projection;
+    }
+
+    BoundingBox Box(const Vector3& center, const Vector3& extents) {
+        return BoundingBox::FromCenterExtents(center, extents);
+    }
+
+    OcclusionBuffer WallAt(float distance) {
+        OcclusionBuffer buffer(256, 128);
+        buffer.RasterizeBox(Box(Vector3(0, 0, distance), Vector3(4, 4, 0.1f)), Projection(), 0, buffer.Height());
+        buffer.BuildHierarchy();
+        return buffer;
+    }
+}
+
+TEST(OcclusionBuffer, ClearedBufferOccludesNothing) {
+    OcclusionBuffer buffer(256, 128);
+    buffer.BuildHierarchy();
+
+    EXPECT_TRUE(buffer.IsVisible(Box(Vector3(0, 0, 50), Vector3(1, 1, 1)), Projection()));
+}
+
+TEST(OcclusionBuffer, WallOccludesBoxBehindIt) {
+    auto buffer = WallAt(10);
+
+    EXPECT_FALSE(buffer.IsVisible(Box(Vector3(0, 0, 20), Vector3(1, 1, 1)), Projection()));
+}
+
+TEST(OcclusionBuffer, BoxInFrontOfWallIsVisible) {
+    auto buffer = WallAt(10);
+
+    EXPECT_TRUE(buffer.IsVisible(Box(Vector3(0, 0, 5), Vector3(1, 1, 1)), Projection()));
+}
+
+TEST(OcclusionBuffer, BoxPeekingAroundWallIsVisible) {
+    auto buffer = WallAt(10);
+
+    EXPECT_TRUE(buffer.IsVisible(Box(Vector3(6, 0, 20), Vector3(3, 1, 1)), Projection()));
+}
+
+TEST(OcclusionBuffer, BoxCrossingNearPlaneIsVisible) {
+    auto buffer = WallAt(10);
+
+    EXPECT_TRUE(buffer.IsVisible(Box(Vector3(0, 0, 0), Vector3(1, 1, 1)), Projection()));
+}
+
+TEST(OcclusionBuffer, WallDepthMatchesProjection) {
+    auto buffer = WallAt(10);
+
+    // The wall's front face sits at z = 9.9 in view space
+    float n = 0.1f;
+    float f = 100.0f;
+    float z = 9.9f;
+    float expected = (f / (f - n)) - (n * f / (f - n)) / z;
+
+    EXPECT_NEAR(buffer.Depth(buffer.Width() / 2, buffer.Height() / 2), expected, 1e-4f);
+    EXPECT_FLOAT_EQ(buffer.Depth(0, 0), 1.0f);
+}
+
+TEST(OcclusionBuffer, BandsMatchWholeBuffer) {
+    OcclusionBuffer whole(250, 120);
+    OcclusionBuffer banded(250, 120);
+
+    auto occluder = Box(Vector3(1, -1, 12), Vector3(3, 2, 2));
+    whole.RasterizeBox(occluder, Projection(), 0, whole.Height());
+    for (uint32_t row = 0; row < banded.Height(); row += 16) {
+        banded.RasterizeBox(occluder, Projection(), row, row + 16);
+    }
+
+    for (uint32_t y = 0; y < whole.Height(); y++) {
+        for (uint32_t x = 0; x < whole.Width(); x++) {
+            ASSERT_EQ(whole.Depth(x, y), banded.Depth(x, y));
+        }
+    }
+}
+
+TEST(OcclusionBuffer, BenchmarkRasterizeAndTest) {
+    OcclusionBuffer buffer(256, 128);
+    auto projection = Projection();
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    buffer.Clear();
+    for (int x = 0; x < 256; x++) {
+        float offset = static_cast<float>(x % 16) - 8.0f;
+        buffer.RasterizeBox(Box(Vector3(offset * 2, offset, 10.0f + x * 0.1f), Vector3(1, 1, 1)), projection, 0, buffer.Height());
+    }
+    buffer.BuildHierarchy();
+
+    size_t visible = 0;
+    for (int x = 0; x < 10000; x++) {
+        float offset = static_cast<float>(x % 32) - 16.0f;
+        visible += buffer.IsVisible(Box(Vector3(offset, offset * 0.5f, 40.0f), Vector3(0.5f, 0.5f, 0.5f)), projection);
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    RecordProperty("Milliseconds", std::to_string(elapsed));
+
+    EXPECT_LT(visible, 10000u);
+}
@@ -5,6 +5,8 @@ namespace playground::rendering {
 		Graphics,
 		Compute,
 		Copy,
-        Transfer
+        Transfer,
+        // Secondary list the graphics lists execute, recorded on worker threads
+        Bundle
 	};
 }
\ No newline at end of file
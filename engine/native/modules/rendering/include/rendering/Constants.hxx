@@ -1,12 +1,40 @@
 #pragma once
 
+#include <cstdint>
+
 namespace playground::rendering {
     constexpr uint8_t MAX_CAMERA_COUNT = 16;
     constexpr uint16_t MAX_POINT_LIGHTS = 1024;
+    constexpr uint16_t MAX_SPOT_LIGHTS = 1024;
+
+    // Froxel grid of the clustered light assignment, exponential depth slices between the camera's near and far plane
+    constexpr uint32_t CLUSTER_TILES_X = 16;
+    constexpr uint32_t CLUSTER_TILES_Y = 9;
+    constexpr uint32_t CLUSTER_SLICES = 24;
+    constexpr uint32_t CLUSTER_COUNT = CLUSTER_TILES_X * CLUSTER_TILES_Y * CLUSTER_SLICES;
+    // Lights past the limit are dropped from the cluster, this bounds the per pixel cost
+    constexpr uint32_t MAX_LIGHTS_PER_CLUSTER = 64;
+    constexpr uint32_t MAX_LIGHT_INDICES = 65536;
 
     constexpr uint16_t MAX_SRV_HEAP_SIZE = 8192;
     constexpr uint16_t MAX_BATCH_SIZE = 1024;
     constexpr uint32_t MAX_DRAW_CALLS_PER_FRAME = 131072;
+    // Entries of the materials buffer the opaque pass indexes by material id
+    constexpr uint32_t MAX_MATERIALS = 4096;
+    // Last entry stays zeroed, materials whose id doesn't fit the buffer read it instead
+    constexpr uint32_t FALLBACK_MATERIAL_SLOT = MAX_MATERIALS - 1;
+
+    // Mesh LODs, a model carries at most this many coarser versions per mesh
+    constexpr uint8_t MAX_MESH_LODS = 7;
+    constexpr float LOD_HYSTERESIS = 0.15f;
+
+    // Draw call visibility, one bit per culled camera and one for the sun's cascades. Cameras past the last bit share it.
+    constexpr uint8_t CULLED_CAMERA_COUNT = 7;
+    constexpr uint8_t SHADOW_VISIBILITY_MASK = 1 << CULLED_CAMERA_COUNT;
+
+    inline constexpr uint8_t CameraVisibilityMask(uint8_t camera) {
+        return 1 << (camera < CULLED_CAMERA_COUNT ? camera : CULLED_CAMERA_COUNT - 1);
+    }
 
     // Root Signature Bindings Post Skybox Shaders
     constexpr uint8_t SB_BINDLESS_CUBEMAPS_SLOT = 6;
@@ -26,6 +54,14 @@ namespace playground::rendering {
     constexpr uint8_t BINDLESS_CUBEMAPS_SLOT = 6;
     constexpr uint8_t BINDLESS_SHADOW_MAPS_SLOT = 7;
     constexpr uint8_t SHADOW_CASTERS_BUFFER_BINDING = 8;
+    constexpr uint8_t CLUSTER_PARAMETERS_BINDING = 9;
+    constexpr uint8_t LIGHT_CLUSTERS_BUFFER_BINDING = 10;
+    constexpr uint8_t LIGHT_INDICES_BUFFER_BINDING = 11;
+    constexpr uint8_t POINT_LIGHTS_BUFFER_BINDING = 12;
+    constexpr uint8_t SPOT_LIGHTS_BUFFER_BINDING = 13;
+    // Takes the material buffer's slot, opaque materials are read from the materials buffer by id
+    constexpr uint8_t MATERIAL_INDEX_BINDING = 3;
+    constexpr uint8_t MATERIALS_BUFFER_BINDING = 14;
     constexpr uint8_t POINT_LIGHT_SRV_BINDING = 0;
 
     // Root Signature Bindings Post Process Shaders
@@ -37,6 +73,8 @@ namespace playground::rendering {
 
     // Shadow constants
     constexpr uint16_t MAX_SHADOW_RES_DIRECTIONAL_LIGHT = 4096;
+    constexpr uint16_t MIN_SHADOW_RES_DIRECTIONAL_LIGHT = 256;
+    constexpr uint8_t MAX_SHADOW_CASCADES = 4;
     constexpr uint16_t MAX_SHADOW_RES_POINT_AND_SPOT_LIGHT = 1024;
     constexpr uint8_t MAX_SHADOW_MAPS_PER_FRAME = 32;
     constexpr uint16_t SUN_SIZE = 500;
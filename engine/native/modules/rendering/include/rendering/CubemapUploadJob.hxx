@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rendering/Cubemap.hxx"
+#include "rendering/UploadPriority.hxx"
 #include <assetloader/RawCubemapData.hxx>
 #include <cstdint>
 #include <string>
@@ -13,6 +14,7 @@ namespace playground::rendering {
         uint32_t handle;
         std::shared_ptr<assetloader::RawCubemapData> cubemapData;
         std::function<void(uint32_t, uint32_t)> callback;
+        UploadPriority priority = UploadPriority::Visible;
 
         ~CubemapUploadJob() {
         }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace playground::rendering {
+    /// Slots of one resource class in a descriptor heap, e.g. the Texture2D slots of the SRV heap
+    struct DescriptorRange {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /// Hands out descriptor heap slots per range in O(1). A freed slot is retired with the fence of the frame being recorded
+    /// and only handed out again once that fence completed, as the GPU may still read the descriptor until then.
+    class DescriptorAllocator {
+    public:
+        static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+
+        /// Ranges must not overlap, they are referred to by their position in the list
+        explicit DescriptorAllocator(std::vector<DescriptorRange> ranges);
+
+        /// Slot in the heap, the lowest slots are handed out first. Throws if the range has no slot left.
+        auto Allocate(uint32_t range) -> uint32_t;
+        /// Throws if the slot isn't allocated
+        auto Free(uint32_t slot) -> void;
+        /// Frees from here on retire with fence, slots retired with a fence up to completedFence are reused.
+        /// Fences must not decrease, fence 0 is complete from the start.
+        auto BeginFrame(uint64_t fence, uint64_t completedFence) -> void;
+
+        /// Range the slot belongs to, INVALID_SLOT if it is in none
+        auto RangeOf(uint32_t slot) const -> uint32_t;
+        auto First(uint32_t range) const -> uint32_t;
+        auto Capacity(uint32_t range) const -> uint32_t;
+        /// Slots of the range that are allocated or still waiting for their fence
+        auto Used(uint32_t range) -> uint32_t;
+        /// Slots waiting for their fence
+        auto Retired() -> size_t;
+
+    private:
+        enum class SlotState : uint8_t {
+            Free,
+            Allocated,
+            Retired,
+        };
+
+        struct Range {
+            DescriptorRange slots;
+            // Slots past this one were never handed out, so the free list only holds slots that were
+            uint32_t untouched;
+            uint32_t freeHead;
+            uint32_t used;
+        };
+
+        struct RetiredSlot {
+            uint32_t slot;
+            uint64_t fence;
+        };
+
+        std::vector<Range> _ranges;
+        // Per heap slot, the free lists are linked through _nextFree so freeing never allocates
+        std::vector<uint32_t> _slotRanges;
+        std::vector<uint32_t> _nextFree;
+        std::vector<SlotState> _states;
+        // Ordered by fence as fences never decrease
+        std::deque<RetiredSlot> _retired;
+        uint64_t _fence = 0;
+        std::mutex _mutex;
+    };
+}
@@ -21,6 +21,7 @@
 #include "rendering/IndexBuffer.hxx"
 #include "rendering/VertexBuffer.hxx"
 #include "rendering/InstanceBuffer.hxx"
+#include "rendering/StagingBuffer.hxx"
 #include "rendering/DepthBuffer.hxx"
 #include "rendering/Sampler.hxx"
 #include "rendering/Cubemap.hxx"
@@ -73,8 +74,10 @@ namespace playground::rendering {
         virtual auto CreateConstantBuffer(const void* data, size_t size, size_t itemSize, ConstantBuffer::BindingMode mode, std::string name) -> std::shared_ptr<ConstantBuffer> = 0;
         virtual auto CreateStructuredBuffer(void* data, size_t size, size_t itemSize, std::string name) -> std::shared_ptr<StructuredBuffer> = 0;
         virtual auto CreateInstanceBuffer(uint64_t count, uint64_t stride) -> std::shared_ptr<InstanceBuffer> = 0;
-        virtual auto CreateTexture(uint32_t width, uint32_t height, std::vector<std::vector<uint8_t>> mips, Allocator& allocator) -> std::shared_ptr<Texture> = 0;
-        virtual auto CreateCubemap(uint32_t width, uint32_t height, std::vector<std::vector<std::vector<uint8_t>>> faces, Allocator& allocator) -> std::shared_ptr<Cubemap> = 0;
+        virtual auto CreateStagingBuffer(uint64_t size) -> std::shared_ptr<StagingBuffer> = 0;
+        /// Textures and cubemaps are created empty, their data is uploaded region by region
+        virtual auto CreateTexture(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Texture> = 0;
+        virtual auto CreateCubemap(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Cubemap> = 0;
         virtual auto CreateSampler(TextureFiltering filtering, TextureWrapping wrapping) -> std::shared_ptr<Sampler> = 0;
         virtual auto CreateShadowMap(uint32_t width, uint32_t height, std::string name) -> std::shared_ptr<ShadowMap> = 0;
         virtual auto CreateSwapchain(uint8_t bufferCount, uint16_t width, uint16_t height, void* window) -> std::shared_ptr<Swapchain> = 0;
@@ -85,8 +88,16 @@ namespace playground::rendering {
 		// Deleting resources
 		virtual auto DestroyShader(uint64_t shaderHandle) -> void = 0;
         virtual auto WaitForIdleGPU() -> void = 0;
+        /// Called before a frame is recorded, frames are numbered from 1.
+        /// Descriptors freed while recording a frame are reused once the GPU finished it.
+        virtual auto BeginFrame(uint64_t frame) -> void = 0;
 
     protected:
         uint8_t _frameCount;
+
+        /// Last frame the GPU is known to have finished when frame begins, the swapchain's frames in flight are still running
+        auto CompletedFrame(uint64_t frame) const -> uint64_t {
+            return frame > _frameCount ? frame - _frameCount : 0;
+        }
 	};
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "RenderBackendType.hxx"
+#include "null/NullDevice.hxx"
+#if _WIN32
 #include "d3d12/D3D12Device.hxx"
+#endif
 
 namespace playground::rendering {
 	class DeviceFactory {
@@ -11,9 +14,14 @@ namespace playground::rendering {
 			{
 			case playground::rendering::RenderBackendType::Vulkan:
 				break;
+#if _WIN32
 			case playground::rendering::RenderBackendType::D3D12:
 				return std::make_shared<d3d12::D3D12Device>(frameCount);
 				break;
+#endif
+			case playground::rendering::RenderBackendType::Null:
+				return std::make_shared<null::NullDevice>(frameCount);
+				break;
 			default:
 				break;
 			}
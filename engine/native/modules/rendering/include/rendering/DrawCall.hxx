@@ -4,19 +4,23 @@
 #include "rendering/IndexBufferHandle.hxx"
 #include "rendering/MaterialHandle.hxx"
 #include "rendering/Constants.hxx"
-#include <math/Matrix3x3.hxx>
-#include <math/Matrix4x4.hxx>
-#include <EASTL/vector.h>
+#include <math/Vector4.hxx>
+#include <cstdint>
 
 namespace playground::rendering {
 	struct DrawCall {
+        // Affine world matrix as three columns with the translation in W, see math::InstanceTransformsBulk.
+        // The fourth column is always (0, 0, 0, 1) and the shaders derive the normal matrix from the other three.
         struct InstanceData {
-            math::Matrix4x4 transform;
-            math::Matrix4x4 normals;
+            math::Vector4 transform[3];
         };
         VertexBufferHandle vertexBuffer;
         IndexBufferHandle indexBuffer;
         MaterialHandle material;
-        eastl::vector<InstanceData> instanceData;
+        // Cameras every instance of the call is visible in, see CameraVisibilityMask. Shadow calls only carry SHADOW_VISIBILITY_MASK.
+        uint8_t visibility = 0xFF;
+        // Range of the frame's instance buffer the call draws
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
 	};
 }
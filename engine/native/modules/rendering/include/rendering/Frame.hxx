@@ -37,7 +37,8 @@ namespace playground::rendering
             const std::shared_ptr<DepthBuffer>& depth,
             std::shared_ptr<GraphicsContext> graphicsContext,
             std::shared_ptr<UploadContext> uploadContext,
-            std::shared_ptr<InstanceBuffer> instanceBuffer
+            uint8_t cascadeCount,
+            uint16_t cascadeResolution
         ) :
             // Alloc 128 mb per frame (used for upload staging containers)
             _tempArena(128 * 1024 * 1024),
@@ -45,7 +46,7 @@ namespace playground::rendering
             // Alloc 4 mb per frame (Used for permanent frame data)
             _arena(4 * 1024 * 1024),
             _allocator(&_arena),
-            _shadowMaps(_allocator),
+            _cascadeShadowMaps(_allocator),
             _index(index),
             _device(device),
             _modelUploadQueue(_tempAllocator),
@@ -56,19 +57,13 @@ namespace playground::rendering
             _depth = depth;
             _graphicsContext = graphicsContext;
             _uploadContext = uploadContext;
-            _instanceBuffer = instanceBuffer;
 
             std::stringstream ss;
-            ss << "FRAME_" << +index << "_" << "DIRECTIONAL_LIGHT_SHADOW_MAP";
 
-            _directionalLightShadowMap = device->CreateShadowMap(MAX_SHADOW_RES_DIRECTIONAL_LIGHT, MAX_SHADOW_RES_DIRECTIONAL_LIGHT, ss.str());
-            ss.clear();
-            ss = std::stringstream();
-
-            for (int x = 0; x < MAX_SHADOW_MAPS_PER_FRAME; x++) {
+            for (int x = 0; x < cascadeCount; x++) {
                 ss = std::stringstream();
-                ss << "FRAME_" << +index << "_" << "SPOT_POINT_LIGHT_SHADOW_MAP_" << +x;
-                _shadowMaps.push_back(device->CreateShadowMap(MAX_SHADOW_RES_POINT_AND_SPOT_LIGHT, MAX_SHADOW_RES_POINT_AND_SPOT_LIGHT, ss.str()));
+                ss << "FRAME_" << +index << "_" << "DIRECTIONAL_LIGHT_SHADOW_MAP_" << +x;
+                _cascadeShadowMaps.push_back(device->CreateShadowMap(cascadeResolution, cascadeResolution, ss.str()));
                 ss.clear();
             }
         }
@@ -78,7 +73,6 @@ namespace playground::rendering
             _graphicsContext.reset();
             _uploadContext.reset();
             _renderTarget.reset();
-            _instanceBuffer.reset();
             _depth.reset();
         }
 
@@ -92,8 +86,9 @@ namespace playground::rendering
             return _depth;
         }
 
-        auto DirectionalLightShadowMap() const -> std::shared_ptr<rendering::ShadowMap> {
-            return _directionalLightShadowMap;
+        /// One map per shadow cascade of the sun, nearest cascade first
+        auto CascadeShadowMaps() const -> const eastl::fixed_vector<std::shared_ptr<ShadowMap>, MAX_SHADOW_CASCADES, false, VirtualAllocator>& {
+            return _cascadeShadowMaps;
         }
 
         auto ModelUploadQueue() -> eastl::deque<ModelUploadJob, Allocator>&
@@ -136,9 +131,15 @@ namespace playground::rendering
             return _uploadContext;
         }
 
-        auto InstanceBuffer() -> std::shared_ptr<InstanceBuffer>
+        /// Packet the frame was last recorded from. It may only be recycled once the GPU finished this frame.
+        auto RenderFrame() const -> rendering::RenderFrame*
+        {
+            return _renderFrame;
+        }
+
+        void SetRenderFrame(rendering::RenderFrame* frame)
         {
-            return _instanceBuffer;
+            _renderFrame = frame;
         }
 
         auto Alloc() -> VirtualAllocator& {
@@ -170,10 +171,9 @@ namespace playground::rendering
         eastl::deque<CubemapUploadJob, VirtualAllocator> _cubemapUploadQueue;
         std::shared_ptr<rendering::GraphicsContext> _graphicsContext;
         std::shared_ptr<rendering::UploadContext> _uploadContext;
-        std::shared_ptr<rendering::InstanceBuffer> _instanceBuffer;
+        rendering::RenderFrame* _renderFrame = nullptr;
 
-        std::shared_ptr<ShadowMap> _directionalLightShadowMap;
-        eastl::fixed_vector<std::shared_ptr<ShadowMap>, MAX_SHADOW_MAPS_PER_FRAME, false, VirtualAllocator> _shadowMaps;
+        eastl::fixed_vector<std::shared_ptr<ShadowMap>, MAX_SHADOW_CASCADES, false, VirtualAllocator> _cascadeShadowMaps;
 
         std::vector<uint32_t> _texturesToTransition;
         std::vector<uint32_t> _cubemapsToTransition;
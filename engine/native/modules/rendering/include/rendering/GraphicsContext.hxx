@@ -6,6 +6,7 @@
 #include "rendering/Material.hxx"
 #include "rendering/ReadbackBuffer.hxx"
 #include "rendering/RenderPass.hxx"
+#include "rendering/RenderPassChunk.hxx"
 #include "rendering/RenderTarget.hxx"
 #include "rendering/ShadowCaster.hxx"
 #include "rendering/Swapchain.hxx"
@@ -17,8 +18,12 @@
 #include "rendering/Texture.hxx"
 #include "rendering/DirectionalLight.hxx"
 #include "rendering/Cubemap.hxx"
+#include "rendering/LightClusters.hxx"
+#include "rendering/PointLight.hxx"
+#include "rendering/SpotLight.hxx"
 #include <array>
 #include <memory>
+#include <vector>
 
 namespace playground::rendering {
     class UploadContext;
@@ -29,12 +34,20 @@ namespace playground::rendering {
         virtual auto EndRenderPass() -> void = 0;
         virtual auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void = 0;
         virtual auto Draw(uint32_t numVertices) -> void = 0;
+        /// Replaces chunks with count chunks of the open render pass. They can be recorded on any thread and stay valid until the next Begin.
+        virtual auto AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void = 0;
+        /// Executes finished chunks of the open render pass in the given order. Buffers and the pipeline have to be bound again afterwards.
+        virtual auto SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void = 0;
         virtual auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void = 0;
         virtual auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void = 0;
         virtual auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void = 0;
         virtual auto BindCamera(uint8_t index) -> void = 0;
+        /// Binds the view of one shadow cascade for the shadow pass that was just started
+        virtual auto BindShadowCascade(uint8_t index) -> void = 0;
         virtual auto SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void = 0;
         virtual auto SetShadowCastersData(std::vector<ShadowCaster>& shadowCasters) -> void = 0;
+        /// Local lights and their cluster assignment for the opaque pass, an empty grid disables local lighting
+        virtual auto SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void = 0;
         virtual auto BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void = 0;
         virtual auto BindMaterial(std::shared_ptr<Material> material) -> void = 0;
         virtual auto BindShadowMaterial(std::shared_ptr<Material> material) -> void = 0;
@@ -50,10 +63,15 @@ namespace playground::rendering {
         virtual auto TransitionDepthBufferToPixelShader(std::shared_ptr<DepthBuffer> depth) -> void = 0;
         virtual auto CopyToSwapchainBackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<Swapchain> swapchain) -> void = 0;
         virtual auto CopyToReadbackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<ReadbackBuffer> target) -> void = 0;
+        /// Constants of a single material, for the passes that bind them directly (skybox and post processing)
         virtual auto SetMaterialData(std::shared_ptr<Material> material) -> void = 0;
+        /// Writes count packed entries of MAX_MATERIAL_SIZE_BYTES, starting at material id first, into the buffer the opaque pass indexes by id
+        virtual auto SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void = 0;
         virtual auto SetDirectionalLight(
             DirectionalLight& light
         ) -> void = 0;
+        /// One entry per cascade, each holding the sun with the cascade's view and projection
+        virtual auto SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void = 0;
         virtual auto SetViewport(
             uint32_t startX,
             uint32_t startY,
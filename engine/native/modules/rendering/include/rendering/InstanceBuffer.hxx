@@ -11,6 +11,8 @@ namespace playground::rendering {
         virtual ~InstanceBuffer() = default;
         virtual auto Id() const -> uint64_t = 0;
         virtual void SetData(const void* data, size_t count, size_t offset) = 0;
+        /// CPU visible memory backing the buffer, Size() instances of the stride the buffer was created with
+        virtual auto Data() -> void* = 0;
         virtual void Bind() const = 0;
     };
 }
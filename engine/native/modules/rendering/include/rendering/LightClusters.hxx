@@ -0,0 +1,97 @@
+#pragma once
+
+#include "rendering/Camera.hxx"
+#include "rendering/Constants.hxx"
+#include "rendering/PointLight.hxx"
+#include "rendering/SpotLight.hxx"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace playground::rendering {
+    /// Range of the index list a cluster owns, its point lights come first and its spot lights follow
+    struct LightCluster {
+        uint32_t offset;
+        uint16_t pointCount;
+        uint16_t spotCount;
+    };
+
+    /// Root constants the shaders use to find the cluster of a pixel
+    struct ClusterParameters {
+        uint32_t tilesX;
+        uint32_t tilesY;
+        uint32_t slices;
+        // slice = log(viewZ) * sliceScale + sliceBias
+        float sliceScale;
+        float sliceBias;
+        // tile = pixel * tileScale
+        float tileScaleX;
+        float tileScaleY;
+        uint32_t padding;
+    };
+
+    struct LightClusterGrid {
+        ClusterParameters parameters = {};
+        std::vector<LightCluster> clusters;
+        std::vector<uint32_t> indices;
+    };
+
+    /// Assigns point and spot lights to the froxels of a camera. Keeps its scratch memory between builds.
+    class LightClusterBuilder {
+    public:
+        /// Builds the cluster grid of the camera for a viewport of width x height pixels.
+        /// Slices are tested in parallel on the job system, each one against four clusters at a time.
+        void Build(
+            const Camera& camera,
+            uint32_t width,
+            uint32_t height,
+            const PointLight* pointLights,
+            size_t pointCount,
+            const SpotLight* spotLights,
+            size_t spotCount,
+            LightClusterGrid& grid
+        );
+
+    private:
+        static constexpr uint32_t TILES_PER_SLICE = CLUSTER_TILES_X * CLUSTER_TILES_Y;
+
+        // Cluster bounds of one slice as streams, padded to a multiple of four
+        struct SliceBounds {
+            alignas(16) std::array<float, (TILES_PER_SLICE + 3) & ~3u> minX;
+            alignas(16) std::array<float, (TILES_PER_SLICE + 3) & ~3u> minY;
+            alignas(16) std::array<float, (TILES_PER_SLICE + 3) & ~3u> maxX;
+            alignas(16) std::array<float, (TILES_PER_SLICE + 3) & ~3u> maxY;
+            float minZ;
+            float maxZ;
+        };
+
+        struct SliceLights {
+            std::array<uint16_t, TILES_PER_SLICE> pointCounts;
+            std::array<uint16_t, TILES_PER_SLICE> spotCounts;
+            std::array<std::array<uint32_t, MAX_LIGHTS_PER_CLUSTER>, TILES_PER_SLICE> points;
+            std::array<std::array<uint32_t, MAX_LIGHTS_PER_CLUSTER>, TILES_PER_SLICE> spots;
+        };
+
+        // View space lights as streams
+        struct LightStreams {
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> z;
+            std::vector<float> radius;
+            // Spot lights only
+            std::vector<float> directionX;
+            std::vector<float> directionY;
+            std::vector<float> directionZ;
+            std::vector<float> cosOuter;
+            std::vector<float> sinOuter;
+
+            void Resize(size_t count);
+        };
+
+        std::vector<SliceBounds> bounds;
+        std::vector<SliceLights> lights;
+        LightStreams points;
+        LightStreams spots;
+    };
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "rendering/Constants.hxx"
+#include "rendering/Material.hxx"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include <EASTL/vector.h>
+
+namespace playground::rendering {
+    /// Constants of one material, packed the way the shaders read them
+    struct MaterialEntry {
+        uint32_t id;
+        std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES> data;
+    };
+
+    /// Packed constants of every material. Updates are staged and reach the entries with the next frame packet,
+    /// so the render thread never uploads an entry that is being written.
+    /// Each frame slot has its own dirty bits, so a change reaches the buffers of all frames in flight exactly once.
+    class MaterialConstants {
+    public:
+        explicit MaterialConstants(uint8_t frameCount);
+
+        /// Packs the material's properties and stages them for the next frame packet. A later update of the same material replaces it.
+        /// Materials without an entry of their own are reported once and draw with the fallback entry.
+        void Update(const Material& material);
+        /// Moves the entries staged since the last call into changes, which must be empty. Called when a frame packet is submitted.
+        void TakeStaged(eastl::vector<MaterialEntry>& changes);
+        /// Writes a packet's changes into the entries and marks them dirty for every frame slot. Render thread only.
+        void Apply(const eastl::vector<MaterialEntry>& changes);
+
+        /// Entry the material's constants live in, FALLBACK_MATERIAL_SLOT for ids past the last own entry
+        static constexpr auto Slot(uint32_t id) -> uint32_t {
+            return id < FALLBACK_MATERIAL_SLOT ? id : FALLBACK_MATERIAL_SLOT;
+        }
+
+        /// Calls upload(first, count, data) once per run of consecutive entries changed since the slot last uploaded. Render thread only.
+        template<typename F>
+        void UploadDirty(uint8_t frame, F&& upload) {
+            auto& dirty = _dirty[frame];
+
+            uint32_t runStart = 0;
+            uint32_t runLength = 0;
+            for (uint32_t word = 0; word < DIRTY_WORDS; word++) {
+                uint64_t bits = dirty[word];
+                dirty[word] = 0;
+
+                while (bits != 0) {
+                    uint32_t id = word * 64 + std::countr_zero(bits);
+                    bits &= bits - 1;
+
+                    if (runLength > 0 && id == runStart + runLength) {
+                        runLength++;
+                        continue;
+                    }
+
+                    if (runLength > 0) {
+                        upload(runStart, runLength, Entry(runStart));
+                    }
+                    runStart = id;
+                    runLength = 1;
+                }
+            }
+
+            if (runLength > 0) {
+                upload(runStart, runLength, Entry(runStart));
+            }
+        }
+
+        auto Entry(uint32_t id) const -> const uint8_t* {
+            return _data.data() + static_cast<size_t>(id) * MAX_MATERIAL_SIZE_BYTES;
+        }
+
+        /// Writes textures, cubemaps and floats in that order, properties past MAX_MATERIAL_SIZE_BYTES are dropped.
+        /// Returns the bytes the properties needed.
+        static auto Pack(const Material& material, std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES>& entry) -> size_t;
+
+    private:
+        static constexpr uint32_t DIRTY_WORDS = (MAX_MATERIALS + 63) / 64;
+        static constexpr uint32_t NOT_STAGED = UINT32_MAX;
+
+        // Read and written by the render thread only
+        std::vector<uint8_t> _data;
+        std::vector<std::array<uint64_t, DIRTY_WORDS>> _dirty;
+
+        // Updates waiting for the next packet, per material the position of its staged entry
+        std::mutex _stagingMutex;
+        eastl::vector<MaterialEntry> _staged;
+        std::vector<uint32_t> _stagedIndex;
+        std::atomic<bool> _reportedOverflow = false;
+    };
+}
@@ -1,9 +1,12 @@
 #pragma once
 
+#include "rendering/Constants.hxx"
 #include "rendering/Vertex.hxx"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace playground::rendering {
@@ -13,8 +16,47 @@ namespace playground::rendering {
 		std::vector<uint32_t> indices;
 	};
 
+	struct MeshLod {
+		uint32_t vertexBuffer;
+		uint32_t indexBuffer;
+		/// Projected size (fraction of the view's height) below which the LOD takes over
+		float screenSize;
+	};
+
 	struct Mesh {
 		uint32_t vertexBuffer;
 		uint32_t indexBuffer;
+		/// Coarser versions of the mesh ordered by decreasing screen size, LOD n is lods[n - 1]
+		std::vector<MeshLod> lods;
 	};
+
+	/// Picks the LOD for a projected screen size. Going back to a finer LOD than the current one needs the size to grow past the threshold by LOD_HYSTERESIS, so objects sitting on a threshold don't flicker between two LODs.
+	inline uint8_t SelectLod(const Mesh& mesh, float screenSize, uint8_t current) {
+		uint8_t lod = 0;
+		for (size_t x = 0; x < mesh.lods.size(); x++) {
+			float threshold = mesh.lods[x].screenSize;
+			if (x < current) {
+				threshold *= 1.0f + LOD_HYSTERESIS;
+			}
+
+			if (screenSize >= threshold) {
+				break;
+			}
+
+			lod = static_cast<uint8_t>(x + 1);
+		}
+
+		return lod;
+	}
+
+	/// Geometry of a LOD, LODs past the end of the chain fall back to the coarsest one
+	inline std::pair<uint32_t, uint32_t> LodBuffers(const Mesh& mesh, uint8_t lod) {
+		if (lod == 0 || mesh.lods.empty()) {
+			return { mesh.vertexBuffer, mesh.indexBuffer };
+		}
+
+		const auto& entry = mesh.lods[std::min<size_t>(lod, mesh.lods.size()) - 1];
+
+		return { entry.vertexBuffer, entry.indexBuffer };
+	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rendering/Mesh.hxx"
+#include "rendering/UploadPriority.hxx"
 #include <assetloader/RawMeshData.hxx>
 #include <cstdint>
 #include <functional>
@@ -11,5 +12,6 @@ namespace playground::rendering {
         uint32_t handle;
         std::vector<assetloader::RawMeshData> meshes;
         std::function<void(uint32_t, std::vector<Mesh>)> callback;
+        UploadPriority priority = UploadPriority::Visible;
     };
 }
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "rendering/GraphicsContext.hxx"
+#include "rendering/RenderPassChunk.hxx"
+#include <cstddef>
+#include <functional>
+
+namespace playground::rendering {
+    /// Draws below which waking another worker costs more than recording them on the caller
+    constexpr size_t MIN_DRAWS_PER_CHUNK = 256;
+
+    /// Runs task(chunk) for every chunk in [0, count) and returns once all of them are done, chunks may run in parallel
+    using ChunkDispatcher = std::function<void(size_t count, const std::function<void(size_t chunk)>& task)>;
+    /// Records the items [begin, end) of a pass into chunk
+    using ChunkRecorder = std::function<void(RenderPassChunk& chunk, size_t begin, size_t end)>;
+
+    /// Chunks count items are split into, every chunk gets at least minItemsPerChunk items and there are never more than maxChunks
+    size_t PassChunkCount(size_t count, size_t minItemsPerChunk, size_t maxChunks);
+
+    /// Splits count items of the render pass open on context into chunkCount contiguous ranges and records them through dispatch.
+    /// Chunk i covers [count * i / chunkCount, count * (i + 1) / chunkCount) and the chunks are submitted in that order,
+    /// so the pass draws exactly what recording the items one after another would have.
+    void RecordPassChunks(GraphicsContext& context, size_t count, size_t chunkCount, const ChunkDispatcher& dispatch, const ChunkRecorder& record);
+}
@@ -3,6 +3,7 @@
 #include <math/Vector3.hxx>
 
 namespace playground::rendering {
+    /// Layout matches the PointLight struct of the shaders, 32 bytes per light
     struct PointLight {
         math::Vector3 position;
         math::Vector3 colour;
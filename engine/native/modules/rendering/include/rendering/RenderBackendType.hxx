@@ -3,6 +3,8 @@
 namespace playground::rendering {
 	enum class RenderBackendType {
 		Vulkan,
-		D3D12
+		D3D12,
+		/// Runs on the CPU only, for headless benchmarks and tests
+		Null
 	};
 }
\ No newline at end of file
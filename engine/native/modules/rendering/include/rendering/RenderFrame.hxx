@@ -7,7 +7,14 @@
 #include "rendering/Constants.hxx"
 #include "rendering/Camera.hxx"
 #include "rendering/DirectionalLight.hxx"
+#include "rendering/InstanceBuffer.hxx"
+#include "rendering/LightClusters.hxx"
+#include "rendering/MaterialConstants.hxx"
+#include "rendering/PointLight.hxx"
+#include "rendering/ShadowCascades.hxx"
+#include "rendering/SpotLight.hxx"
 #include <array>
+#include <memory>
 #include <vector>
 #include <EASTL/array.h>
 #include <EASTL/vector.h>
@@ -15,10 +22,40 @@
 
 
 namespace playground::rendering {
+    /// Instances of the static buffer a packet changes, see RenderFrame::staticPatches
+    struct StaticInstancePatch {
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /// Frame packet handed from the producer to the render thread by pointer, see AcquireFrame
     struct RenderFrame {
         bool isDirty;
         eastl::vector<DrawCall> drawCalls;
+        /// Casters of every shadow cascade, batched by geometry only. Their instances follow the ones of drawCalls.
+        std::array<eastl::vector<DrawCall>, MAX_SHADOW_CASCADES> shadowDrawCalls;
+        /// Instances of all draw calls, written by the producer through InstanceBuffer::Data. See AcquireInstanceBuffer.
+        std::shared_ptr<InstanceBuffer> instanceBuffer;
+        uint32_t instanceCount = 0;
+        /// Cached static batches. Their instances live in a buffer kept across frames, it is only replaced once it has to grow.
+        eastl::vector<DrawCall> staticDrawCalls;
+        std::array<eastl::vector<DrawCall>, MAX_SHADOW_CASCADES> staticShadowDrawCalls;
+        std::shared_ptr<InstanceBuffer> staticInstanceBuffer;
+        uint32_t staticInstanceCount = 0;
+        /// Ranges of staticInstanceBuffer changed since the packet before, their instances follow each other in staticPatchData.
+        /// The render thread stages and uploads only these, a replaced buffer arrives as one patch covering every instance.
+        eastl::vector<StaticInstancePatch> staticPatches;
+        eastl::vector<DrawCall::InstanceData> staticPatchData;
         eastl::vector<Camera> cameras;
         DirectionalLight sun;
+        /// Cascades of the sun fitted to the main camera, none without a sun
+        std::array<ShadowCascade, MAX_SHADOW_CASCADES> cascades;
+        uint8_t cascadeCount = 0;
+        eastl::vector<PointLight> pointLights;
+        eastl::vector<SpotLight> spotLights;
+        /// Light clusters of every camera in the order of cameras. Grids keep their memory between uses of the packet.
+        std::vector<LightClusterGrid> lightClusters;
+        /// Material constants changed since the previous packet, filled by SubmitFrame
+        eastl::vector<MaterialEntry> materials;
     };
 }
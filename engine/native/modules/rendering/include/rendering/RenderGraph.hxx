@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace playground::rendering {
+    typedef uint32_t RenderGraphResource;
+    typedef uint32_t RenderGraphPass;
+
+    /// How a pass uses a resource, barriers move resources between these
+    enum class ResourceState : uint8_t {
+        /// Content is undefined, transient resources start out like this
+        Undefined,
+        RenderTarget,
+        DepthWrite,
+        ShaderResource,
+    };
+
+    /// Memory a transient resource takes in the heap transients alias in
+    struct TransientResourceDesc {
+        uint64_t size = 0;
+        uint64_t alignment = 1;
+    };
+
+    struct RenderGraphBarrier {
+        RenderGraphResource resource;
+        ResourceState before;
+        ResourceState after;
+    };
+
+    struct CompiledRenderPass {
+        RenderGraphPass pass;
+        /// Barriers to record before the pass runs. A transient's first one starts at Undefined, its memory may still hold another transient.
+        std::vector<RenderGraphBarrier> barriers;
+    };
+
+    /// Where a transient lives in the heap and which compiled passes use it
+    struct TransientPlacement {
+        RenderGraphResource resource;
+        uint64_t offset;
+        uint64_t size;
+        /// Indices into CompiledRenderGraph::passes
+        uint32_t firstPass;
+        uint32_t lastPass;
+    };
+
+    struct CompiledRenderGraph {
+        /// Passes something depends on, in the order they were added
+        std::vector<CompiledRenderPass> passes;
+        /// Barriers returning imported resources to their final state after the last pass
+        std::vector<RenderGraphBarrier> finalBarriers;
+        /// Transients the passes use, ordered by resource
+        std::vector<TransientPlacement> transients;
+        /// Memory all transients alias in, smaller than the sum of their sizes whenever lifetimes don't overlap
+        uint64_t transientHeapSize = 0;
+    };
+
+    /// Passes declare the resources they read and write. Compile culls the passes no output depends on, derives the barriers
+    /// between the remaining ones and packs transients whose lifetimes don't overlap into the same memory.
+    /// The graph only works on declarations, recording the passes and barriers is up to the caller.
+    class RenderGraph {
+    public:
+        /// Resource that outlives the frame, it enters the graph in initialState and is returned to finalState
+        auto Import(std::string name, ResourceState initialState, ResourceState finalState) -> RenderGraphResource;
+        /// Resource that only lives from its first to its last use, it has to be written before it is read
+        auto CreateTransient(std::string name, TransientResourceDesc desc) -> RenderGraphResource;
+        /// Keeps the passes writing the resource, and everything they read, alive
+        auto MarkOutput(RenderGraphResource resource) -> void;
+
+        /// Passes run in the order they are added
+        auto AddPass(std::string name) -> RenderGraphPass;
+        /// Keeps the pass alive even if nothing reads what it writes
+        auto SetSideEffects(RenderGraphPass pass) -> void;
+        /// Throws if the pass already uses the resource in another state
+        auto Read(RenderGraphPass pass, RenderGraphResource resource, ResourceState state) -> void;
+        /// Throws if the pass already uses the resource in another state
+        auto Write(RenderGraphPass pass, RenderGraphResource resource, ResourceState state) -> void;
+
+        /// Throws if a transient is read before any pass wrote it
+        auto Compile(CompiledRenderGraph& compiled) const -> void;
+        /// Forgets all resources and passes
+        auto Reset() -> void;
+
+        auto ResourceName(RenderGraphResource resource) const -> const std::string&;
+        auto PassName(RenderGraphPass pass) const -> const std::string&;
+
+    private:
+        struct Resource {
+            std::string name;
+            bool isTransient;
+            bool isOutput;
+            ResourceState initialState;
+            ResourceState finalState;
+            TransientResourceDesc desc;
+        };
+
+        struct Access {
+            RenderGraphResource resource;
+            ResourceState state;
+            bool isWrite;
+        };
+
+        struct Pass {
+            std::string name;
+            bool hasSideEffects;
+            std::vector<Access> accesses;
+        };
+
+        std::vector<Resource> _resources;
+        std::vector<Pass> _passes;
+
+        auto AddAccess(RenderGraphPass pass, RenderGraphResource resource, ResourceState state, bool isWrite) -> void;
+        // Assigns offsets to the placements, returns the heap size they need
+        auto PlaceTransients(std::vector<TransientPlacement>& transients) const -> uint64_t;
+    };
+}
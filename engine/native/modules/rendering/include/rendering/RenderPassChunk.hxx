@@ -0,0 +1,27 @@
+#pragma once
+
+#include "rendering/IndexBuffer.hxx"
+#include "rendering/InstanceBuffer.hxx"
+#include "rendering/Material.hxx"
+#include "rendering/VertexBuffer.hxx"
+#include <cstdint>
+#include <memory>
+
+namespace playground::rendering {
+    /// Part of the render pass that is open on a GraphicsContext, recorded on a worker and executed where the context submits it.
+    /// A chunk sees the heaps, camera or cascade, viewport and scissor the pass bound, buffers and the pipeline have to be bound again.
+    /// Each chunk may only be recorded by one thread at a time.
+    class RenderPassChunk {
+    public:
+        virtual ~RenderPassChunk() = default;
+
+        virtual auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void = 0;
+        virtual auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void = 0;
+        virtual auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void = 0;
+        virtual auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void = 0;
+        virtual auto BindMaterial(std::shared_ptr<Material> material) -> void = 0;
+        virtual auto BindShadowMaterial(std::shared_ptr<Material> material) -> void = 0;
+        /// Ends recording, only finished chunks can be submitted
+        virtual auto Finish() -> void = 0;
+    };
+}
@@ -22,7 +22,10 @@
 #include "rendering/MaterialUploadJob.hxx"
 #include "rendering/TextureUploadJob.hxx"
 #include "rendering/CubemapUploadJob.hxx"
+#include "rendering/UploadPriority.hxx"
+#include "rendering/RenderBackendType.hxx"
 #include "rendering/RenderFrame.hxx"
+#include "rendering/ShadowCascades.hxx"
 #include <assetloader/RawMeshData.hxx>
 #include <assetloader/RawTextureData.hxx>
 #include <assetloader/RawMaterialData.hxx>
@@ -37,6 +40,7 @@ namespace playground::rendering {
         uint32_t width,
         uint32_t height,
         bool offscreen,
+        RenderBackendType backend,
         std::promise<void>& rendererReadyPromise
     ) -> void;
 	auto Shutdown() -> void;
@@ -54,7 +58,8 @@ namespace playground::rendering {
 	auto UpdateVertexBuffer(VertexBufferHandle buffer, const void* data, size_t size) -> void;
 	auto UpdateIndexBuffer(IndexBufferHandle buffer, const void* data, size_t size) -> void;
 
-    auto QueueUploadModel(std::vector<assetloader::RawMeshData>& meshes, uint32_t, std::function<void(uint32_t, std::vector<Mesh>)>) -> void;
+    /// Uploads are spread over frames by priority, callbacks run once the GPU has the data
+    auto QueueUploadModel(std::vector<assetloader::RawMeshData>& meshes, uint32_t, std::function<void(uint32_t, std::vector<Mesh>)>, UploadPriority priority = UploadPriority::Visible) -> void;
     auto QueueUploadMaterial(
         std::string vertexShaderCode,
         std::string pixelShaderCode,
@@ -63,11 +68,14 @@ namespace playground::rendering {
         std::function<void(uint32_t, uint32_t)>,
         void (*onCompletion)(uint32_t) = nullptr
     ) -> void;
-    auto QueueUploadTexture(assetloader::RawTextureData* texture, uint32_t handle, void (*callback)(uint32_t, uint32_t)) -> void;
-    auto QueueUploadCubemap(std::shared_ptr<assetloader::RawCubemapData> cubemap, uint32_t handle, std::function<void(uint32_t, uint32_t)> callback) -> void;
-    auto UploadModel(ModelUploadJob& job) -> void;
-    auto UploadTexture(TextureUploadJob* job) -> void;
-    auto UploadCubemap(CubemapUploadJob& job) -> void;
+    auto QueueUploadTexture(assetloader::RawTextureData* texture, uint32_t handle, void (*callback)(uint32_t, uint32_t), UploadPriority priority = UploadPriority::Visible) -> void;
+    auto QueueUploadCubemap(std::shared_ptr<assetloader::RawCubemapData> cubemap, uint32_t handle, std::function<void(uint32_t, uint32_t)> callback, UploadPriority priority = UploadPriority::Visible) -> void;
+    /// Creates and uploads the buffers of a mesh and its LODs
+    auto UploadMesh(const assetloader::RawMeshData& data) -> Mesh;
+    /// Creates an empty texture for the job's regions to be uploaded into, returns its id
+    auto CreateTexture(TextureUploadJob* job) -> uint32_t;
+    /// Creates an empty cubemap for the job's regions to be uploaded into, returns its id
+    auto CreateCubemap(CubemapUploadJob& job) -> uint32_t;
     auto CreateMaterial(MaterialUploadJob job) -> void;
     auto RegisterShadowShader(
         std::string& vertexShaderCode
@@ -83,7 +91,17 @@ namespace playground::rendering {
     void SetMaterialCubemap(uint32_t materialId, uint8_t slot, uint32_t cubemapId);
     void SetMaterialFloat(uint32_t materialId, uint8_t slot, float value);
 
-    auto SubmitFrame(RenderFrame frame) -> void;
+    /// Cascade count and resolution only take effect when set before the renderer starts, the split settings apply from the next frame on
+    auto SetShadowSettings(const ShadowSettings& settings) -> void;
+    auto GetShadowSettings() -> ShadowSettings;
+
+    /// Hands out an empty frame packet to fill and pass to SubmitFrame. Packets keep their capacity between uses,
+    /// so steady state frames allocate nothing. Returns nullptr when the renderer isn't running or every packet is in flight.
+    auto AcquireFrame() -> RenderFrame*;
+    auto SubmitFrame(RenderFrame* frame) -> void;
+    /// Hands out a CPU visible instance buffer holding at least count instances. Draw call producers write straight into its Data().
+    /// The buffer returns to the pool once the last frame drawing with it finished on the GPU. Thread safe.
+    auto AcquireInstanceBuffer(uint32_t count) -> std::shared_ptr<InstanceBuffer>;
 
     double GetGPUFrameTime();
 }
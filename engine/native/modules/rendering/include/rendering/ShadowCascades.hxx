@@ -0,0 +1,35 @@
+#pragma once
+
+#include "rendering/Camera.hxx"
+#include "rendering/Constants.hxx"
+#include <math/Matrix4x4.hxx>
+#include <math/Vector3.hxx>
+#include <cstdint>
+
+namespace playground::rendering {
+    /// Quality of the sun's cascaded shadow maps. Cascade count and resolution are picked up when the renderer starts.
+    struct ShadowSettings {
+        uint8_t cascadeCount = 4;
+        uint16_t resolution = 2048;
+        /// Blend between uniform (0) and logarithmic (1) splits
+        float splitLambda = 0.75f;
+        /// View distance the cascades cover, capped by the camera's far plane
+        float distance = 150.0f;
+        /// How far toward the light casters in front of a cascade still get captured
+        float casterDistance = 100.0f;
+    };
+
+    struct ShadowCascade {
+        math::Matrix4x4 viewMatrix;
+        math::Matrix4x4 projectionMatrix;
+        /// View depth the cascade covers up to, cascades are ordered near to far
+        float splitDistance = 0.0f;
+    };
+
+    /// Practical split scheme, splits[i] receives the far distance of cascade i
+    void ComputeCascadeSplits(float nearPlane, float farPlane, uint8_t count, float lambda, float* splits);
+
+    /// Fits an orthographic cascade around the bounding sphere of the camera frustum slice [splitNear, splitFar].
+    /// The sphere only depends on the slice's size and its center is snapped to whole texels, so the map doesn't shimmer when the camera moves or turns.
+    ShadowCascade FitCascade(const Camera& camera, float splitNear, float splitFar, const math::Vector3& lightDirection, uint32_t resolution, float casterDistance);
+}
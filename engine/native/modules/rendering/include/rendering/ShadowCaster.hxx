@@ -1,5 +1,6 @@
 #pragma once
 
+#include "rendering/Constants.hxx"
 #include "rendering/ShadowMap.hxx"
 #include <math/Matrix4x4.hxx>
 #include <memory>
@@ -9,5 +10,9 @@ namespace playground::rendering {
         math::Matrix4x4 ViewMatrix;
         math::Matrix4x4 ProjectionMatrix;
         uint32_t ShadowMapID;
+        // Sun cascades only, the view depth the cascade covers up to. Casters with 0 apply everywhere.
+        float SplitDistance = 0.0f;
+        // Size of one texel of the map in UV space
+        float TexelSize = 1.0f / MAX_SHADOW_RES_POINT_AND_SPOT_LIGHT;
     };
 }
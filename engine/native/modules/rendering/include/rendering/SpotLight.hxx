@@ -0,0 +1,19 @@
+#pragma once
+
+#include <math/Vector3.hxx>
+
+namespace playground::rendering {
+    /// Layout matches the SpotLight struct of the shaders, 64 bytes per light
+    struct SpotLight {
+        math::Vector3 position;
+        float range;
+        math::Vector3 direction;
+        // Cosine of the half angle where the light fades out completely
+        float cosOuter;
+        math::Vector3 colour;
+        float intensity;
+        // Cosine of the half angle up to which the light is at full strength
+        float cosInner;
+        float padding[3] = {};
+    };
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstdint>
+
+namespace playground::rendering {
+    /// CPU visible memory uploads copy from, mapped for its whole lifetime
+    class StagingBuffer {
+    public:
+        virtual ~StagingBuffer() = default;
+
+        virtual auto Data() -> uint8_t* = 0;
+        virtual auto Size() const -> uint64_t = 0;
+    };
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "rendering/GraphicsContext.hxx"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace playground::rendering {
+    /// Binds and material uploads a StateTrackingGraphicsContext forwarded or dropped since its last Begin
+    struct StateTrackingStats {
+        uint64_t issuedBinds = 0;
+        uint64_t skippedBinds = 0;
+        uint64_t issuedMaterialUploads = 0;
+        uint64_t skippedMaterialUploads = 0;
+    };
+
+    class StateTrackingRenderPassChunk;
+
+    /// Sits in front of a backend context and drops binds of what is already bound.
+    /// Every pass records into its own command list, so bound state is forgotten when a pass begins.
+    /// Material constants are written at most once per material between Begin and Finish.
+    /// Chunks track their own bindings, their counters are added when they are submitted.
+    class StateTrackingGraphicsContext : public GraphicsContext {
+    public:
+        explicit StateTrackingGraphicsContext(std::shared_ptr<GraphicsContext> context);
+
+        auto Begin() -> void override;
+        auto BeginRenderPass(RenderPass pass, std::shared_ptr<RenderTarget> colour, std::shared_ptr<DepthBuffer> depth) -> void override;
+        auto EndRenderPass() -> void override;
+        auto Finish() -> void override;
+        auto WaitFor(const Context& other) -> void override;
+        auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override;
+        auto Draw(uint32_t numVertices) -> void override;
+        auto AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void override;
+        auto SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void override;
+        auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void override;
+        auto BindCamera(uint8_t index) -> void override;
+        auto BindShadowCascade(uint8_t index) -> void override;
+        auto SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void override;
+        auto SetShadowCastersData(std::vector<ShadowCaster>& shadowCasters) -> void override;
+        auto SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void override;
+        auto BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void override;
+        auto BindMaterial(std::shared_ptr<Material> material) -> void override;
+        auto BindShadowMaterial(std::shared_ptr<Material> material) -> void override;
+        auto BindSRVHeapToSlot(std::shared_ptr<Heap> heap, uint8_t slot) -> void override;
+        auto BindSampler(std::shared_ptr<Sampler> sampler, uint8_t slot) -> void override;
+        auto TransitionIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto TransitionVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto TransitionTexture(std::shared_ptr<Texture> texture) -> void override;
+        auto TransitionCubemap(std::shared_ptr<Cubemap> cubemap) -> void override;
+        auto TransitionShadowMapToDepthWrite(std::shared_ptr<ShadowMap> map) -> void override;
+        auto TransitionShadowMapToPixelShader(std::shared_ptr<ShadowMap> map) -> void override;
+        auto TransitionDepthBufferToDepthWrite(std::shared_ptr<DepthBuffer> depth) -> void override;
+        auto TransitionDepthBufferToPixelShader(std::shared_ptr<DepthBuffer> depth) -> void override;
+        auto CopyToSwapchainBackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<Swapchain> swapchain) -> void override;
+        auto CopyToReadbackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<ReadbackBuffer> target) -> void override;
+        auto SetMaterialData(std::shared_ptr<Material> material) -> void override;
+        auto SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void override;
+        auto SetDirectionalLight(DirectionalLight& light) -> void override;
+        auto SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void override;
+        auto SetViewport(
+            uint32_t startX,
+            uint32_t startY,
+            uint32_t width,
+            uint32_t height,
+            uint32_t depthStart,
+            uint32_t depthEnd
+        ) -> void override;
+        auto SetScissor(
+            uint32_t left,
+            uint32_t top,
+            uint32_t right,
+            uint32_t bottom
+        ) -> void override;
+        auto SetResolution(uint32_t width, uint32_t height) -> void override;
+
+        auto MouseOverID() -> uint64_t override;
+
+        /// Counters of the current or, after Finish, the last recording
+        auto Stats() const -> const StateTrackingStats& {
+            return _stats;
+        }
+
+        auto Inner() const -> const std::shared_ptr<GraphicsContext>& {
+            return _context;
+        }
+
+    private:
+        // Nothing bound uses index 0xFF
+        static constexpr uint8_t UNBOUND = 0xFF;
+
+        std::shared_ptr<GraphicsContext> _context;
+        StateTrackingStats _stats = {};
+
+        const VertexBuffer* _vertexBuffer = nullptr;
+        const IndexBuffer* _indexBuffer = nullptr;
+        const InstanceBuffer* _instanceBuffer = nullptr;
+        // Materials and shadow materials both set the pipeline, only the last one counts
+        const Material* _pipelineMaterial = nullptr;
+        bool _isShadowPipeline = false;
+        uint8_t _camera = UNBOUND;
+        uint8_t _shadowCascade = UNBOUND;
+
+        // Recording a material's constants were last written in, indexed by material id
+        std::vector<uint64_t> _materialRecordings;
+        uint64_t _recording = 0;
+
+        // Wrappers are reused after the next Begin, like the backend's chunks
+        std::vector<std::shared_ptr<StateTrackingRenderPassChunk>> _chunks;
+        size_t _usedChunks = 0;
+        std::vector<std::shared_ptr<RenderPassChunk>> _innerChunks;
+
+        auto ResetBindings() -> void;
+
+        // Counts the bind and returns whether it changes anything
+        template<typename T>
+        auto Track(T& bound, T value) -> bool {
+            if (bound == value) {
+                _stats.skippedBinds++;
+                return false;
+            }
+
+            bound = value;
+            _stats.issuedBinds++;
+            return true;
+        }
+    };
+}
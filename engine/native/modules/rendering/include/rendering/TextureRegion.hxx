@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace playground::rendering {
+    /// Textures are BC3, every 4x4 texel block takes 16 bytes
+    constexpr uint32_t TEXTURE_BLOCK_SIZE = 4;
+    constexpr uint32_t TEXTURE_BLOCK_BYTES = 16;
+    /// Staged rows and regions are aligned the way D3D12 copies texture data
+    constexpr uint32_t TEXTURE_ROW_PITCH_ALIGNMENT = 256;
+    constexpr uint64_t TEXTURE_PLACEMENT_ALIGNMENT = 512;
+
+    /// Block rows [firstRow, firstRow + rowCount) of one subresource. Subresources count mips first, then faces.
+    struct TextureRegion {
+        uint32_t subresource;
+        uint32_t firstRow;
+        uint32_t rowCount;
+        /// Bytes of one row in the packed source data
+        uint32_t rowBytes;
+        /// Bytes between two rows in staging memory
+        uint32_t rowPitch;
+
+        auto StagingBytes() const -> uint64_t {
+            return static_cast<uint64_t>(rowPitch) * rowCount;
+        }
+    };
+
+    inline auto TextureRowBytes(uint32_t width) -> uint32_t {
+        return ((width + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE) * TEXTURE_BLOCK_BYTES;
+    }
+
+    inline auto TextureRowCount(uint32_t height) -> uint32_t {
+        return (height + TEXTURE_BLOCK_SIZE - 1) / TEXTURE_BLOCK_SIZE;
+    }
+
+    /// Splits every subresource into regions of at most maxBytes staging bytes, rows are never split so a region holds at least one
+    auto SplitTexture(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t faceCount, uint64_t maxBytes) -> std::vector<TextureRegion>;
+    /// Copies the region's rows out of a packed subresource into staging memory laid out with the region's row pitch
+    auto StageTextureRegion(const uint8_t* source, size_t sourceSize, const TextureRegion& region, uint8_t* staging) -> void;
+}
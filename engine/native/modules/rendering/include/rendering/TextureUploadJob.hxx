@@ -1,6 +1,7 @@
 #pragma once
 
 #include "rendering/Texture.hxx"
+#include "rendering/UploadPriority.hxx"
 #include <assetloader/RawTextureData.hxx>
 #include <cstdint>
 #include <string>
@@ -13,9 +14,10 @@ namespace playground::rendering {
         uint32_t handle;
         assetloader::RawTextureData* rawData;
         void (*callback)(uint32_t, uint32_t);
+        UploadPriority priority;
 
-        TextureUploadJob(uint32_t handle, assetloader::RawTextureData* rawData, void (*callback)(uint32_t, uint32_t))
-            : handle(handle), rawData(rawData), callback(callback) {
+        TextureUploadJob(uint32_t handle, assetloader::RawTextureData* rawData, void (*callback)(uint32_t, uint32_t), UploadPriority priority = UploadPriority::Visible)
+            : handle(handle), rawData(rawData), callback(callback), priority(priority) {
         }
     };
 }
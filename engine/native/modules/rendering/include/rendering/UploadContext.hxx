@@ -5,7 +5,9 @@
 #include "rendering/IndexBuffer.hxx"
 #include "rendering/VertexBuffer.hxx"
 #include "rendering/InstanceBuffer.hxx"
+#include "rendering/StagingBuffer.hxx"
 #include "rendering/Texture.hxx"
+#include "rendering/TextureRegion.hxx"
 #include "rendering/Cubemap.hxx"
 
 namespace playground::rendering {
@@ -13,10 +15,14 @@ namespace playground::rendering {
     public:
         virtual ~UploadContext() = default;
 
-        virtual auto Upload(std::shared_ptr<Texture> texture) -> void = 0;
-        virtual auto Upload(std::shared_ptr<Cubemap> cubemap) -> void = 0;
+        /// Copies the region's rows, staged at offset of staging, into the texture
+        virtual auto Upload(std::shared_ptr<Texture> texture, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void = 0;
+        virtual auto Upload(std::shared_ptr<Cubemap> cubemap, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void = 0;
         virtual auto Upload(std::shared_ptr<IndexBuffer> buffer) -> void = 0;
         virtual auto Upload(std::shared_ptr<VertexBuffer> buffer) -> void = 0;
-        virtual auto Upload(std::shared_ptr<InstanceBuffer> buffer) -> void = 0;
+        /// Copies the first count instances to the GPU
+        virtual auto Upload(std::shared_ptr<InstanceBuffer> buffer, size_t count) -> void = 0;
+        /// Copies count instances starting at first, the rest of the GPU copy is left as it was
+        virtual auto Upload(std::shared_ptr<InstanceBuffer> buffer, size_t first, size_t count) -> void = 0;
     };
 }
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace playground::rendering {
+    /// Order queued uploads go out in, all visible uploads go before any nearby one
+    enum class UploadPriority : uint8_t {
+        /// Needed by what is on screen
+        Visible,
+        /// Likely on screen soon
+        Nearby,
+        /// Whenever there is budget left
+        Prefetch,
+    };
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "rendering/UploadPriority.hxx"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace playground::rendering {
+    /// Slice of a frame the uploads may take
+    struct UploadBudget {
+        uint64_t bytes;
+        std::chrono::microseconds time;
+    };
+
+    /// Staging memory reused in a ring. Space is reserved with the fence of the frame uploading from it
+    /// and reclaimed in the order it was reserved once that fence completed.
+    class StagingRing {
+    public:
+        static constexpr uint64_t INVALID_OFFSET = UINT64_MAX;
+
+        /// Reservations start at multiples of alignment
+        StagingRing(uint64_t capacity, uint64_t alignment) : _capacity(capacity), _alignment(alignment) {}
+
+        /// Offset of size contiguous bytes, INVALID_OFFSET while the ring has no room for them
+        auto Allocate(uint64_t size, uint64_t fence) -> uint64_t;
+        /// Frees every reservation made with a fence up to completedFence
+        auto Reclaim(uint64_t completedFence) -> void;
+
+        auto Capacity() const -> uint64_t {
+            return _capacity;
+        }
+
+        /// Reserved bytes, including the end of the ring skipped when a reservation didn't fit there
+        auto Used() const -> uint64_t {
+            return _used;
+        }
+
+    private:
+        struct Block {
+            uint64_t offset;
+            uint64_t size;
+            uint64_t fence;
+        };
+
+        uint64_t _capacity;
+        uint64_t _alignment;
+        uint64_t _head = 0;
+        uint64_t _used = 0;
+        // Oldest first, fences never decrease
+        std::deque<Block> _blocks;
+    };
+
+    struct UploadJob {
+        UploadPriority priority = UploadPriority::Visible;
+        /// Staging bytes of each part. Parts go out in order, a job may take several frames.
+        std::vector<uint64_t> parts;
+        /// Parts copy through the staging ring, each one must fit into it. Other jobs stage through memory of their own.
+        bool staged = false;
+        /// Records the part into the upload context of the frame. offset is the part's space in the staging ring,
+        /// StagingRing::INVALID_OFFSET for jobs that aren't staged.
+        std::function<void(size_t part, uint64_t offset)> upload;
+        /// Called once the frame the last part went out in completed on the GPU
+        std::function<void()> onComplete;
+    };
+
+    /// What one Run uploaded
+    struct UploadFrameStats {
+        uint64_t bytes = 0;
+        uint32_t parts = 0;
+    };
+
+    /// Spreads queued uploads over frames. Every frame uploads parts in priority order until its byte or time budget
+    /// is spent or the staging ring is full, so streaming only ever takes a fixed slice of the frame.
+    class UploadScheduler {
+    public:
+        /// Sized to the budget of every frame in flight, the ring only fills up when the GPU falls behind
+        UploadScheduler(uint64_t stagingSize, uint64_t stagingAlignment) : _ring(stagingSize, stagingAlignment) {}
+
+        /// Throws std::invalid_argument for staged parts larger than the staging ring
+        auto Enqueue(UploadJob job) -> void;
+        /// Uploads from here on go out with fence. Reclaims staging space and completes the jobs of frames up to completedFence.
+        auto BeginFrame(uint64_t fence, uint64_t completedFence) -> void;
+        /// The first part always goes out, so parts larger than the budget still make progress.
+        /// A staged part waits for a later frame while the ring has no room for it.
+        auto Run(const UploadBudget& budget) -> UploadFrameStats;
+
+        /// Jobs with parts left to upload
+        auto Queued() const -> size_t;
+        /// Jobs fully uploaded whose frame hasn't completed yet
+        auto InFlight() const -> size_t {
+            return _completing.size();
+        }
+
+        auto Staging() const -> const StagingRing& {
+            return _ring;
+        }
+
+    private:
+        struct QueuedJob {
+            UploadJob job;
+            size_t nextPart;
+        };
+
+        struct CompletingJob {
+            std::function<void()> onComplete;
+            uint64_t fence;
+        };
+
+        std::array<std::deque<QueuedJob>, 3> _queues;
+        std::deque<CompletingJob> _completing;
+        StagingRing _ring;
+        uint64_t _fence = 0;
+    };
+}
@@ -4,6 +4,13 @@
 #include "rendering/CPUResourceHandle.hxx"
 
 namespace playground::rendering::d3d12 {
+    /// Descriptor slot handed out by a D3D12HeapManager. Plain data, the owner hands it back with FreeHandle.
+    struct D3D12DescriptorSlot {
+        uint32_t index; // Within the range of the resource class, what shaders index with
+        CD3DX12_CPU_DESCRIPTOR_HANDLE cpu;
+        CD3DX12_GPU_DESCRIPTOR_HANDLE gpu;
+    };
+
     class D3D12ResourceHandle : public CPUResourceHandle
     {
     public:
@@ -15,7 +15,7 @@ namespace playground::rendering::d3d12
         (Microsoft::WRL::ComPtr<ID3D12Resource> resource,
             D3D12_CPU_DESCRIPTOR_HANDLE handle,
             D3D12_CPU_DESCRIPTOR_HANDLE readOnlyHandle,
-            std::shared_ptr<D3D12ResourceHandle> srvHandle
+            D3D12DescriptorSlot srvHandle
         )
         {
             _resource = resource;
@@ -27,7 +27,7 @@ namespace playground::rendering::d3d12
         D3D12DepthBuffer
         (Microsoft::WRL::ComPtr<ID3D12Resource> resource,
             D3D12_CPU_DESCRIPTOR_HANDLE handle,
-            std::shared_ptr<D3D12ResourceHandle> srvHandle
+            D3D12DescriptorSlot srvHandle
         )
         {
             _resource = resource;
@@ -54,7 +54,7 @@ namespace playground::rendering::d3d12
             return _readOnlyHandle;
         }
 
-        std::shared_ptr<D3D12ResourceHandle> SRVHandle() const
+        D3D12DescriptorSlot SRVHandle() const
         {
             return _srvHandle;
         }
@@ -73,7 +73,7 @@ namespace playground::rendering::d3d12
         Microsoft::WRL::ComPtr<ID3D12Resource> _resource;
         D3D12_CPU_DESCRIPTOR_HANDLE _handle;
         D3D12_CPU_DESCRIPTOR_HANDLE _readOnlyHandle;
-        std::shared_ptr<D3D12ResourceHandle> _srvHandle;
+        D3D12DescriptorSlot _srvHandle;
         D3D12_RESOURCE_STATES _state = D3D12_RESOURCE_STATE_DEPTH_WRITE;
     };
 }
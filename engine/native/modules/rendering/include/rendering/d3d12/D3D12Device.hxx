@@ -51,8 +51,9 @@ namespace playground::rendering::d3d12 {
         auto UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size) -> void override;
         auto CreateIndexBuffer(const uint32_t* indices, size_t size) -> std::shared_ptr<IndexBuffer> override;
         auto UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void override;
-        auto CreateTexture(uint32_t width, uint32_t height, std::vector<std::vector<uint8_t>> mips, Allocator& allocator) -> std::shared_ptr<Texture> override;
-        auto CreateCubemap(uint32_t width, uint32_t height, std::vector<std::vector<std::vector<uint8_t>>> faces, Allocator& allocator) -> std::shared_ptr<Cubemap> override;
+        auto CreateStagingBuffer(uint64_t size) -> std::shared_ptr<StagingBuffer> override;
+        auto CreateTexture(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Texture> override;
+        auto CreateCubemap(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Cubemap> override;
         auto CreateSampler(TextureFiltering filtering, TextureWrapping wrapping) -> std::shared_ptr<Sampler> override;
         auto CreateShadowMap(uint32_t width, uint32_t height, std::string name) -> std::shared_ptr<ShadowMap> override;
 
@@ -67,6 +68,7 @@ namespace playground::rendering::d3d12 {
         auto CreatePostprocessSignature() -> Microsoft::WRL::ComPtr<ID3D12RootSignature>;
         auto DestroyShader(uint64_t shaderHandle) -> void override;
         auto WaitForIdleGPU() -> void override;
+        auto BeginFrame(uint64_t frame) -> void override;
 
         auto GetSrvHeap()->std::shared_ptr<Heap> override;
         auto GetSamplerHeap()->std::shared_ptr<Heap> override;
@@ -86,10 +88,11 @@ namespace playground::rendering::d3d12 {
         Microsoft::WRL::ComPtr<IDXGIAdapter1> _adapter;
         Microsoft::WRL::ComPtr<ID3D12Device9> _device;
         // ---- Resources ----
-        std::unique_ptr<D3D12HeapManager> _rtvHeaps;
-        std::unique_ptr<D3D12HeapManager> _srvHeaps;
-        std::unique_ptr<D3D12HeapManager> _samplerHeaps;
-        std::unique_ptr<D3D12HeapManager> _dsvHeaps;
+        // Shared with the resources holding a slot, they free it when destroyed
+        std::shared_ptr<D3D12HeapManager> _rtvHeaps;
+        std::shared_ptr<D3D12HeapManager> _srvHeaps;
+        std::shared_ptr<D3D12HeapManager> _samplerHeaps;
+        std::shared_ptr<D3D12HeapManager> _dsvHeaps;
         Microsoft::WRL::ComPtr<ID3D12RootSignature> _rootSignature;
         Microsoft::WRL::ComPtr<ID3D12RootSignature> _shadowRootSignature;
         Microsoft::WRL::ComPtr<ID3D12RootSignature> _skyboxRootSignature;
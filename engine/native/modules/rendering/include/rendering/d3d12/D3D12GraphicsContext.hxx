@@ -8,6 +8,7 @@
 #include "rendering/d3d12/D3D12CommandAllocator.hxx"
 #include "rendering/d3d12/D3D12CommandList.hxx"
 #include "rendering/d3d12/D3D12Device.hxx"
+#include "rendering/d3d12/D3D12RenderPassChunk.hxx"
 #include "rendering/d3d12/D3D12CommandQueue.hxx"
 #include "rendering/d3d12/D3D12Swapchain.hxx"
 #include "rendering/GraphicsContext.hxx"
@@ -55,12 +56,16 @@ namespace playground::rendering::d3d12 {
         auto WaitFor(const Context& other) -> void override;
         auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override;
         auto Draw(uint32_t numVertices) -> void override;
+        auto AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void override;
+        auto SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void override;
         auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
         auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
         auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void override;
         auto BindCamera(uint8_t index) -> void override;
+        auto BindShadowCascade(uint8_t index) -> void override;
         auto SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void override;
         auto SetShadowCastersData(std::vector<ShadowCaster>& shadowCasters) -> void override;
+        auto SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void override;
         auto BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void override;
         auto BindMaterial(std::shared_ptr<Material>) -> void override;
         auto BindShadowMaterial(std::shared_ptr<Material> material) -> void override;
@@ -77,9 +82,11 @@ namespace playground::rendering::d3d12 {
         auto CopyToSwapchainBackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<Swapchain> swapchain) -> void override;
         auto CopyToReadbackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<ReadbackBuffer> target) -> void override;
         auto SetMaterialData(std::shared_ptr<Material> material) -> void override;
+        auto SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void override;
         auto SetDirectionalLight(
             DirectionalLight& light
         ) -> void override;
+        auto SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void override;
         auto SetViewport(
             uint32_t startX,
             uint32_t startY,
@@ -99,6 +106,8 @@ namespace playground::rendering::d3d12 {
         auto MouseOverID() -> uint64_t override;
 
     private:
+        friend class D3D12RenderPassChunk;
+
         using StackArenaType = memory::StackArena<4096>;
         using StackAllocator = memory::ArenaAllocator<StackArenaType>;
         using HeapArenaType = memory::VirtualArena;
@@ -127,10 +136,21 @@ namespace playground::rendering::d3d12 {
         std::shared_ptr<D3D12CommandList> _preperationCommandList;
         std::shared_ptr<D3D12CommandList> _transferCommandList;
         std::shared_ptr<D3D12CommandList> _currentPassList;
+        // Root signature of the open pass, chunks set it to inherit the pass's root arguments
+        ID3D12RootSignature* _currentRootSignature = nullptr;
+        // Bundles are reset once Begin waited for the GPU, so they are handed out again every frame
+        std::vector<std::shared_ptr<D3D12RenderPassChunk>> _chunks;
+        size_t _usedChunks = 0;
         std::shared_ptr<D3D12ConstantBuffer> _cameraBuffer;
         std::shared_ptr<D3D12StructuredBuffer> _pointLightsBuffer;
+        std::shared_ptr<D3D12StructuredBuffer> _spotLightsBuffer;
+        std::shared_ptr<D3D12StructuredBuffer> _lightClustersBuffer;
+        std::shared_ptr<D3D12StructuredBuffer> _lightIndicesBuffer;
+        ClusterParameters _clusterParameters = {};
         std::shared_ptr<D3D12ConstantBuffer> _directionalLightBuffer;
+        std::shared_ptr<D3D12ConstantBuffer> _shadowCascadeBuffer;
         std::shared_ptr<D3D12StructuredBuffer> _shadowCastersBuffer;
+        std::shared_ptr<D3D12StructuredBuffer> _materialsBuffer;
         uint8_t _shadowCastersCount;
         MaterialBufferMap _materialBuffers;
 
@@ -145,6 +165,9 @@ namespace playground::rendering::d3d12 {
         tracy::D3D12QueueCtx* _tracyCtx;
 #endif
 
+        // Constants of a material bound by CBV. Doesn't insert, so chunks may call it while the pass records.
+        auto MaterialBufferAddress(uint32_t id) const -> D3D12_GPU_VIRTUAL_ADDRESS;
+
         void StartPreperationRenderPass();
 
         void StartSkyboxRenderPass(
@@ -5,7 +5,8 @@
 #include "rendering/d3d12/D3D12CPUResourceHandle.hxx"
 #include "rendering/d3d12/D3D12GPUResourceHandle.hxx"
 #include "rendering/d3d12/D3D12Heap.hxx"
-#include <map>
+#include "rendering/DescriptorAllocator.hxx"
+#include <memory>
 
 namespace playground::rendering::d3d12
 {
@@ -59,12 +60,20 @@ namespace playground::rendering::d3d12
         D3D12HeapManager(Microsoft::WRL::ComPtr<ID3D12Device> device, D3D12_DESCRIPTOR_HEAP_TYPE type, uint16_t chunkSize);
 
         auto HandleAt(uint32_t index) -> std::shared_ptr<D3D12ResourceHandle>;
-        auto NextHandle(SRVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle>;
-        auto NextHandle(UAVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle>;
-        auto NextHandle(RTVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle>;
-        auto NextHandle(DSVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle>;
-        auto NextHandle(SamplerHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle>;
+        auto NextHandle(SRVHeapResource resourceType) -> D3D12DescriptorSlot;
+        auto NextHandle(UAVHeapResource resourceType) -> D3D12DescriptorSlot;
+        auto NextHandle(RTVHeapResource resourceType) -> D3D12DescriptorSlot;
+        auto NextHandle(DSVHeapResource resourceType) -> D3D12DescriptorSlot;
+        auto NextHandle(SamplerHeapResource resourceType) -> D3D12DescriptorSlot;
+        /// Hands back the slot at index within the resource class, called by the owner once it drops the descriptor
+        auto FreeHandle(SRVHeapResource resourceType, uint32_t index) -> void;
+        auto FreeHandle(UAVHeapResource resourceType, uint32_t index) -> void;
+        auto FreeHandle(RTVHeapResource resourceType, uint32_t index) -> void;
+        auto FreeHandle(DSVHeapResource resourceType, uint32_t index) -> void;
+        auto FreeHandle(SamplerHeapResource resourceType, uint32_t index) -> void;
         auto Heap() -> std::shared_ptr<D3D12Heap> { return _heap; }
+        /// Freed slots are reused once the frame freeing them completed
+        auto BeginFrame(uint64_t fence, uint64_t completedFence) -> void;
 
     private:
         Microsoft::WRL::ComPtr<ID3D12Device> _device;
@@ -72,12 +81,12 @@ namespace playground::rendering::d3d12
         std::shared_ptr<D3D12Heap> _heap;
         uint16_t _chunkSize;
         uint8_t _currentChunk = 0;
-        std::map<SRVHeapResource, uint32_t> _srvResourceIndices;
-        std::map<UAVHeapResource, uint32_t> _uavResourceIndices;
-        std::map<RTVHeapResource, uint32_t> _rtvResourceIndices;
-        std::map<DSVHeapResource, uint32_t> _dsvResourceIndices;
-        std::map<SamplerHeapResource, uint32_t> _samplerResourceIndices;
+        bool _shaderVisible;
+        std::unique_ptr<DescriptorAllocator> _allocator;
 
         auto CreateHeap() -> std::shared_ptr<D3D12Heap>;
+        // Slot in the range starting at rangeStart, its index is the one within the range
+        auto AllocateHandle(uint32_t rangeStart) -> D3D12DescriptorSlot;
+        auto ReleaseHandle(uint32_t rangeStart, uint32_t index) -> void;
     };
 }
@@ -112,6 +112,10 @@ namespace playground::rendering::d3d12 {
             std::memcpy(static_cast<uint8_t*>(_mappedData) + offset * _alignedStride, data, count * _alignedStride);
         }
 
+        auto Data() -> void* override {
+            return _mappedData;
+        }
+
         void Bind() const override {
         }
 
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "rendering/RenderPassChunk.hxx"
+#include "rendering/d3d12/D3D12CommandList.hxx"
+#include <directx/d3dx12.h>
+#include <wrl.h>
+#include <memory>
+
+namespace playground::rendering::d3d12 {
+    class D3D12GraphicsContext;
+
+    /// Bundle with its own allocator, so every chunk of a pass can be recorded on a different thread.
+    /// It sets the root signature of the pass, which makes it inherit the root arguments the pass bound.
+    class D3D12RenderPassChunk : public rendering::RenderPassChunk {
+    public:
+        D3D12RenderPassChunk(const D3D12GraphicsContext& context, std::shared_ptr<D3D12CommandList> bundle);
+
+        auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override;
+        auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void override;
+        auto BindMaterial(std::shared_ptr<Material> material) -> void override;
+        auto BindShadowMaterial(std::shared_ptr<Material> material) -> void override;
+        auto Finish() -> void override;
+
+        /// Resets the bundle for the pass using rootSignature. Only valid once the GPU is done with the last recording.
+        auto Begin(ID3D12RootSignature* rootSignature) -> void;
+
+        auto Native() -> ID3D12GraphicsCommandList7* {
+            return _bundle->Native().Get();
+        }
+
+    private:
+        const D3D12GraphicsContext& _context;
+        std::shared_ptr<D3D12CommandList> _bundle;
+    };
+}
@@ -14,7 +14,7 @@ namespace playground::rendering::d3d12
         D3D12RenderTarget(
             Microsoft::WRL::ComPtr<ID3D12Resource> resource,
             D3D12_CPU_DESCRIPTOR_HANDLE handle,
-            std::shared_ptr<D3D12ResourceHandle> srvHandle
+            D3D12DescriptorSlot srvHandle
         )
         {
             _resource = resource;
@@ -35,7 +35,7 @@ namespace playground::rendering::d3d12
             return _handle;
         }
 
-        std::shared_ptr<D3D12ResourceHandle> SRVHandle() const
+        D3D12DescriptorSlot SRVHandle() const
         {
             return _srvHandle;
         }
@@ -43,6 +43,6 @@ namespace playground::rendering::d3d12
     private:
         Microsoft::WRL::ComPtr<ID3D12Resource> _resource;
         D3D12_CPU_DESCRIPTOR_HANDLE _handle;
-        std::shared_ptr<D3D12ResourceHandle> _srvHandle;
+        D3D12DescriptorSlot _srvHandle;
     };
 }
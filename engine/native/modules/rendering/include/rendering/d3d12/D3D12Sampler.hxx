@@ -3,6 +3,7 @@
 #include <wrl.h>
 #include <directx/d3dx12.h>
 #include "rendering/Sampler.hxx"
+#include "rendering/d3d12/D3D12HeapManager.hxx"
 
 namespace playground::rendering::d3d12 {
     inline auto TranslateTextureFiltering(TextureFiltering filtering) -> D3D12_FILTER {
@@ -37,11 +38,11 @@ namespace playground::rendering::d3d12 {
     public:
         D3D12TextureSampler(
             Microsoft::WRL::ComPtr<ID3D12Device9> device,
-            std::shared_ptr<D3D12ResourceHandle> handle,
+            D3D12DescriptorSlot handle,
+            std::shared_ptr<D3D12HeapManager> heaps,
             TextureFiltering filtering,
             TextureWrapping wrapping
-        ) {
-            _handle = handle;
+        ) : _handle(handle), _heaps(std::move(heaps)) {
             D3D12_SAMPLER_DESC samplerDesc = {};
             samplerDesc.Filter = TranslateTextureFiltering(filtering);
             samplerDesc.AddressU = TranslateTextureWrapping(wrapping);
@@ -54,18 +55,23 @@ namespace playground::rendering::d3d12 {
             samplerDesc.MinLOD = 0;
             samplerDesc.MaxLOD = D3D12_FLOAT32_MAX;
 
-            device->CreateSampler(&samplerDesc, _handle->GetCPUHandle());
+            device->CreateSampler(&samplerDesc, _handle.cpu);
+        }
+
+        ~D3D12TextureSampler() override {
+            _heaps->FreeHandle(SamplerHeapResource::Sampler, _handle.index);
         }
 
         auto CPUHandle() -> CD3DX12_CPU_DESCRIPTOR_HANDLE {
-            return _handle->GetCPUHandle();
+            return _handle.cpu;
         }
 
         auto GPUHandle() -> CD3DX12_GPU_DESCRIPTOR_HANDLE {
-            return _handle->GetGPUHandle();
+            return _handle.gpu;
         }
 
     private:
-        std::shared_ptr<D3D12ResourceHandle> _handle;
+        D3D12DescriptorSlot _handle;
+        std::shared_ptr<D3D12HeapManager> _heaps;
     };
 }
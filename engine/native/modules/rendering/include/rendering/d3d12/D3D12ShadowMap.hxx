@@ -14,12 +14,14 @@ namespace playground::rendering::d3d12 {
     public:
         D3D12ShadowMap(
             Microsoft::WRL::ComPtr<ID3D12Device9> device,
-            std::shared_ptr<D3D12ResourceHandle>& depthHandle,
-            std::shared_ptr<D3D12ResourceHandle>& srvHandle,
+            D3D12DescriptorSlot depthHandle,
+            D3D12DescriptorSlot srvHandle,
+            std::shared_ptr<D3D12HeapManager> dsvHeaps,
+            std::shared_ptr<D3D12HeapManager> srvHeaps,
             uint16_t width,
             uint16_t height,
             std::string name
-        ) : _dsvHandle(depthHandle), _srvHandle(srvHandle), ShadowMap(width, height) {
+        ) : ShadowMap(width, height), _dsvHandle(depthHandle), _srvHandle(srvHandle), _dsvHeaps(std::move(dsvHeaps)), _srvHeaps(std::move(srvHeaps)) {
             D3D12_RESOURCE_DESC desc = {};
             desc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
             desc.Alignment = 0;
@@ -54,7 +56,7 @@ namespace playground::rendering::d3d12 {
             dsvDesc.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
             dsvDesc.Flags = D3D12_DSV_FLAG_NONE;
 
-            device->CreateDepthStencilView(_shadowMap.Get(), &dsvDesc, _dsvHandle->GetCPUHandle());
+            device->CreateDepthStencilView(_shadowMap.Get(), &dsvDesc, _dsvHandle.cpu);
 
             D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
             srvDesc.Format = DXGI_FORMAT_R32_FLOAT; // Shader-readable view of depth
@@ -65,15 +67,20 @@ namespace playground::rendering::d3d12 {
 
             _shadowMap->SetName(std::wstring(name.begin(), name.end()).c_str());
 
-            device->CreateShaderResourceView(_shadowMap.Get(), &srvDesc, _srvHandle->GetCPUHandle());
+            device->CreateShaderResourceView(_shadowMap.Get(), &srvDesc, _srvHandle.cpu);
+        }
+
+        ~D3D12ShadowMap() {
+            _dsvHeaps->FreeHandle(DSVHeapResource::ShadowMapDSV, _dsvHandle.index);
+            _srvHeaps->FreeHandle(SRVHeapResource::ShadowMap, _srvHandle.index);
         }
 
         std::shared_ptr<DepthBuffer> GetDepthBuffer() override {
-            return std::make_shared<D3D12DepthBuffer>(_shadowMap, _dsvHandle->GetCPUHandle(), _srvHandle);
+            return std::make_shared<D3D12DepthBuffer>(_shadowMap, _dsvHandle.cpu, _srvHandle);
         }
 
         uint32_t ID() const override {
-            return _srvHandle->ID();
+            return _srvHandle.index;
         }
 
         Microsoft::WRL::ComPtr<ID3D12Resource> Resource() const {
@@ -82,7 +89,9 @@ namespace playground::rendering::d3d12 {
 
     private:
         Microsoft::WRL::ComPtr<ID3D12Resource> _shadowMap;
-        std::shared_ptr<D3D12ResourceHandle> _dsvHandle;
-        std::shared_ptr<D3D12ResourceHandle> _srvHandle;
+        D3D12DescriptorSlot _dsvHandle;
+        D3D12DescriptorSlot _srvHandle;
+        std::shared_ptr<D3D12HeapManager> _dsvHeaps;
+        std::shared_ptr<D3D12HeapManager> _srvHeaps;
     };
 }
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <wrl.h>
+#include <directx/d3dx12.h>
+#include "rendering/StagingBuffer.hxx"
+
+namespace playground::rendering::d3d12 {
+    /// Upload heap buffer that stays mapped, copies on the upload queue read from it
+    class D3D12StagingBuffer : public rendering::StagingBuffer {
+    public:
+        D3D12StagingBuffer(Microsoft::WRL::ComPtr<ID3D12Device9> device, uint64_t size) : _size(size) {
+            D3D12_HEAP_PROPERTIES heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+            D3D12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+
+            HRESULT hr = device->CreateCommittedResource(
+                &heapProps,
+                D3D12_HEAP_FLAG_NONE,
+                &bufferDesc,
+                D3D12_RESOURCE_STATE_GENERIC_READ,
+                nullptr,
+                IID_PPV_ARGS(&_buffer)
+            );
+            if (FAILED(hr)) {
+                throw std::runtime_error("Failed to create staging buffer resource.");
+            }
+
+            // Never read back by the CPU
+            D3D12_RANGE readRange = {};
+            _buffer->Map(0, &readRange, reinterpret_cast<void**>(&_mappedData));
+        }
+
+        ~D3D12StagingBuffer() override {
+            _buffer->Unmap(0, nullptr);
+            _mappedData = nullptr;
+        }
+
+        auto Data() -> uint8_t* override {
+            return _mappedData;
+        }
+
+        auto Size() const -> uint64_t override {
+            return _size;
+        }
+
+        auto Buffer() const -> Microsoft::WRL::ComPtr<ID3D12Resource> {
+            return _buffer;
+        }
+
+    private:
+        Microsoft::WRL::ComPtr<ID3D12Resource> _buffer;
+        uint8_t* _mappedData = nullptr;
+        uint64_t _size;
+    };
+}
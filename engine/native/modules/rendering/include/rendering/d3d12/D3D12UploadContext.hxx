@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <tuple>
 #include <wrl.h>
 #include <directx/d3dx12.h>
 #include "rendering/UploadContext.hxx"
@@ -13,6 +14,7 @@
 #include "rendering/InstanceBuffer.hxx"
 #include "rendering/d3d12/D3D12Texture.hxx"
 #include "rendering/d3d12/D3D12Cubemap.hxx"
+#include "rendering/d3d12/D3D12StagingBuffer.hxx"
 
 namespace playground::rendering::d3d12 {
     class D3D12UploadContext : public UploadContext {
@@ -27,11 +29,12 @@ namespace playground::rendering::d3d12 {
         auto Begin() -> void override;
         auto Finish() -> void override;
         auto WaitFor(const Context& other) -> void override;
-        auto Upload(std::shared_ptr<Texture> texture) -> void override;
-        auto Upload(std::shared_ptr<Cubemap> cubemap) -> void override;
+        auto Upload(std::shared_ptr<Texture> texture, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void override;
+        auto Upload(std::shared_ptr<Cubemap> cubemap, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void override;
         auto Upload(std::shared_ptr<IndexBuffer> buffer) -> void override;
         auto Upload(std::shared_ptr<VertexBuffer> buffer) -> void override;
-        auto Upload(std::shared_ptr<InstanceBuffer> buffer) -> void override;
+        auto Upload(std::shared_ptr<InstanceBuffer> buffer, size_t count) -> void override;
+        auto Upload(std::shared_ptr<InstanceBuffer> buffer, size_t first, size_t count) -> void override;
 
         auto Fence() const -> Microsoft::WRL::ComPtr<ID3D12Fence> {
             return _fence;
@@ -42,13 +45,20 @@ namespace playground::rendering::d3d12 {
         }
 
     private:
+        /// One region staged in the shared staging buffer, the buffer outlives the copy until its fence completes
+        struct TextureCopy {
+            Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+            TextureRegion region;
+            std::shared_ptr<StagingBuffer> staging;
+            uint64_t offset;
+        };
+
         Microsoft::WRL::ComPtr<ID3D12CommandQueue> _queue;
         std::shared_ptr<D3D12CommandList> _list;
-        std::vector<std::shared_ptr<Texture>> _textures;
-        std::vector<std::shared_ptr<Cubemap>> _cubemaps;
+        std::vector<TextureCopy> _textureCopies;
         std::vector<std::shared_ptr<IndexBuffer>> _indexBuffers;
         std::vector<std::shared_ptr<VertexBuffer>> _vertexBuffers;
-        std::vector<std::shared_ptr<InstanceBuffer>> _instanceBuffers;
+        std::vector<std::tuple<std::shared_ptr<InstanceBuffer>, size_t, size_t>> _instanceBuffers;
         Microsoft::WRL::ComPtr<ID3D12Fence> _fence;
         Microsoft::WRL::ComPtr<ID3D12CommandAllocator> _commandAllocator;
         UINT64 _fenceValue = 0;
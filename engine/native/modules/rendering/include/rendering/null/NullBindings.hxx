@@ -0,0 +1,41 @@
+#pragma once
+
+#include "rendering/null/NullIndexBuffer.hxx"
+#include "rendering/null/NullInstanceBuffer.hxx"
+#include "rendering/null/NullVertexBuffer.hxx"
+#include <cstdint>
+#include <memory>
+
+namespace playground::rendering::null {
+    /// What an indexed draw reads, tracked by contexts and chunks alike
+    struct NullBindings {
+        std::shared_ptr<NullVertexBuffer> vertexBuffer;
+        std::shared_ptr<NullIndexBuffer> indexBuffer;
+        std::shared_ptr<NullInstanceBuffer> instanceBuffer;
+        bool hasPipeline = false;
+
+        auto Reset() -> void {
+            vertexBuffer = nullptr;
+            indexBuffer = nullptr;
+            instanceBuffer = nullptr;
+            hasPipeline = false;
+        }
+
+        /// Whether the draw only reads resident buffers and uploaded instances
+        auto CanDraw(uint32_t numIndices, uint32_t startIndex, uint32_t numInstances, uint32_t startInstance) const -> bool {
+            bool valid = hasPipeline && vertexBuffer != nullptr && indexBuffer != nullptr && instanceBuffer != nullptr;
+            valid = valid && vertexBuffer->IsResident() && indexBuffer->IsResident();
+            // Reading past the indices or the uploaded instances is undefined on the GPU
+            valid = valid && static_cast<uint64_t>(startIndex) + numIndices <= indexBuffer->Size();
+            valid = valid && static_cast<uint64_t>(startInstance) + numInstances <= instanceBuffer->UploadedCount();
+
+            return valid;
+        }
+    };
+
+    /// Instance range of a draw that passed validation
+    struct NullDraw {
+        uint32_t startInstance;
+        uint32_t numInstances;
+    };
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "rendering/CommandList.hxx"
+#include "rendering/null/NullStats.hxx"
+#include <cstdint>
+#include <memory>
+
+namespace playground::rendering::null {
+    /// Counts what it records, the graphics context is where the null backend does its bookkeeping
+    class NullCommandList : public CommandList {
+    public:
+        NullCommandList(CommandListType type, std::shared_ptr<NullStats> stats) : CommandList(type), _stats(std::move(stats)) {}
+
+        auto Begin() -> void override {
+            _isRecording = true;
+        }
+
+        auto Close() -> void override {
+            _isRecording = false;
+        }
+
+        auto Reset() -> void override {
+            _commandCount = 0;
+            _isRecording = true;
+        }
+
+        auto SetRenderTarget(std::shared_ptr<RenderTarget> colour, std::shared_ptr<DepthBuffer> depth) -> void override { Record(); }
+        auto ClearDepthTarget(std::shared_ptr<DepthBuffer> target, float depth) -> void override { Record(); }
+        auto ClearRenderTarget(std::shared_ptr<RenderTarget> handle, math::Vector4 color) -> void override { Record(); }
+        auto SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t minDepth, uint32_t maxDepth) -> void override { Record(); }
+        auto SetScissorRect(uint32_t left, uint32_t top, uint32_t right, uint32_t bottom) -> void override { Record(); }
+        auto SetPrimitiveTopology(PrimitiveTopology topology) -> void override { Record(); }
+        auto SetMaterial(std::shared_ptr<Material>& material) -> void override { Bind(); }
+        auto BindVertexBuffer(std::shared_ptr<VertexBuffer>& vertexBuffer, uint8_t slot) -> void override { Bind(); }
+        auto BindIndexBuffer(std::shared_ptr<IndexBuffer>& indexBuffer) -> void override { Bind(); }
+        auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer>& instanceBuffer) -> void override { Bind(); }
+        auto BindDescriptorTable(std::shared_ptr<ConstantBuffer> buffer, uint8_t slot, uint32_t index) -> void override { Bind(); }
+        auto BindConstantBuffer(std::shared_ptr<ConstantBuffer> buffer, uint8_t slot, uint32_t index) -> void override { Bind(); }
+        auto BindTexture(std::shared_ptr<Texture> texture, uint8_t slot) -> void override { Bind(); }
+        auto BindSampler(std::shared_ptr<Sampler> sampler, uint8_t slot) -> void override { Bind(); }
+
+        auto DrawIndexed(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override {
+            Record();
+            _stats->drawCalls++;
+            _stats->indicesDrawn += static_cast<uint64_t>(numIndices) * numInstances;
+            _stats->instancesDrawn += numInstances;
+        }
+
+        /// Commands recorded since the last reset
+        auto CommandCount() const -> uint64_t {
+            return _commandCount;
+        }
+
+    private:
+        std::shared_ptr<NullStats> _stats;
+        uint64_t _commandCount = 0;
+        bool _isRecording = false;
+
+        auto Record() -> void {
+            if (!_isRecording) {
+                _stats->invalidCalls++;
+            }
+
+            _commandCount++;
+        }
+
+        auto Bind() -> void {
+            Record();
+            _stats->bindings++;
+        }
+    };
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "rendering/ConstantBuffer.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace playground::rendering::null {
+    /// Entries are 256 byte aligned and written like the D3D12 buffer, actualSize bytes starting at entry offset
+    class NullConstantBuffer : public rendering::ConstantBuffer {
+    public:
+        NullConstantBuffer(const void* data, size_t count, size_t itemSize, BindingMode mode, std::shared_ptr<NullHeap> heap)
+            : _alignedStride((itemSize + 255) & ~size_t(255)), _mode(mode), _memory(count * _alignedStride), _descriptor(std::move(heap)) {
+            if (data != nullptr) {
+                for (size_t x = 0; x < count; x++) {
+                    std::memcpy(_memory.data() + x * _alignedStride, static_cast<const uint8_t*>(data) + x * itemSize, itemSize);
+                }
+            }
+        }
+
+        auto SetData(const void* data, size_t count, size_t offset, size_t actualSize) -> void override {
+            std::memcpy(_memory.data() + offset * _alignedStride, data, actualSize);
+        }
+
+        auto Mode() const -> BindingMode {
+            return _mode;
+        }
+
+        auto Count() const -> size_t {
+            return _alignedStride == 0 ? 0 : _memory.size() / _alignedStride;
+        }
+
+        auto Entry(size_t index) const -> const uint8_t* {
+            return _memory.data() + index * _alignedStride;
+        }
+
+        auto ID() const -> uint32_t {
+            return _descriptor.Index();
+        }
+
+    private:
+        size_t _alignedStride;
+        BindingMode _mode;
+        std::vector<uint8_t> _memory;
+        NullDescriptor _descriptor;
+    };
+}
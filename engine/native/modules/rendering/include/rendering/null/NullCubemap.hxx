@@ -0,0 +1,35 @@
+#pragma once
+
+#include "rendering/Cubemap.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include "rendering/null/NullTexture.hxx"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace playground::rendering::null {
+    /// Six faces of mips, uploaded region by region like NullTexture
+    class NullCubemap : public Cubemap {
+    public:
+        NullCubemap(uint32_t width, uint32_t height, uint32_t mipCount, std::shared_ptr<NullHeap> heap)
+            : _width(width), _height(height), _faces(width, height, mipCount, 6), _descriptor(std::move(heap)) {}
+
+        uint32_t ID() const override {
+            return _descriptor.Index();
+        }
+
+        auto Faces() -> NullSubresources& {
+            return _faces;
+        }
+
+        auto IsResident() const -> bool {
+            return _faces.IsResident();
+        }
+
+    private:
+        uint32_t _width;
+        uint32_t _height;
+        NullSubresources _faces;
+        NullDescriptor _descriptor;
+    };
+}
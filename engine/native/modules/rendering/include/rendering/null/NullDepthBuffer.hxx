@@ -0,0 +1,28 @@
+#pragma once
+
+#include "rendering/DepthBuffer.hxx"
+#include <cstdint>
+#include <string>
+
+namespace playground::rendering::null {
+    class NullDepthBuffer : public DepthBuffer {
+    public:
+        NullDepthBuffer(uint32_t width, uint32_t height, std::string name) : _width(width), _height(height), _name(std::move(name)) {}
+
+        auto Width() const -> uint32_t {
+            return _width;
+        }
+
+        auto Height() const -> uint32_t {
+            return _height;
+        }
+
+        /// Tracks the state the D3D12 resource would be in, transitions into the current state are invalid
+        bool isWritable = true;
+
+    private:
+        uint32_t _width;
+        uint32_t _height;
+        std::string _name;
+    };
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "rendering/Device.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include "rendering/null/NullStats.hxx"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace playground::rendering::null {
+    /// Device without a GPU. Resources live in CPU memory and descriptors, uploads and instance writes are tracked
+    /// like on D3D12, so the render thread, upload queues and draw call batching can run and be measured headless.
+    class NullDevice : public rendering::Device, public std::enable_shared_from_this<NullDevice> {
+    public:
+        explicit NullDevice(uint8_t frameCount);
+        ~NullDevice() override = default;
+
+        auto Flush() -> void override;
+        auto CreateGraphicsContext(std::string name, void* window, uint32_t width, uint32_t height, bool offscreen) -> std::shared_ptr<GraphicsContext> override;
+        auto CreateUploadContext(std::string name) -> std::shared_ptr<UploadContext> override;
+        auto CreateCommandList(
+            CommandListType type,
+            std::string name
+        ) -> std::shared_ptr<CommandList> override;
+        auto CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> override;
+        auto CreateRenderTarget(
+            uint32_t width,
+            uint32_t height,
+            TextureFormat format,
+            std::string name,
+            bool isCPUReadable
+        ) -> std::shared_ptr<RenderTarget> override;
+        auto CreateDepthBuffer(
+            uint32_t width,
+            uint32_t height,
+            std::string name
+        ) -> std::shared_ptr<DepthBuffer> override;
+        auto CreateMaterial(std::string vertexShader, std::string pixelShader, MaterialType type) -> std::shared_ptr<Material> override;
+        auto CreateVertexBuffer(const void* data, uint64_t size, uint64_t stride, bool isStatic) -> std::shared_ptr<VertexBuffer> override;
+        auto UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size) -> void override;
+        auto CreateIndexBuffer(const uint32_t* indices, size_t size) -> std::shared_ptr<IndexBuffer> override;
+        auto UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void override;
+        auto CreateConstantBuffer(const void* data, size_t size, size_t itemSize, ConstantBuffer::BindingMode mode, std::string name) -> std::shared_ptr<ConstantBuffer> override;
+        auto CreateStructuredBuffer(void* data, size_t size, size_t itemSize, std::string name) -> std::shared_ptr<StructuredBuffer> override;
+        auto CreateInstanceBuffer(uint64_t count, uint64_t stride) -> std::shared_ptr<InstanceBuffer> override;
+        auto CreateStagingBuffer(uint64_t size) -> std::shared_ptr<StagingBuffer> override;
+        auto CreateTexture(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Texture> override;
+        auto CreateCubemap(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Cubemap> override;
+        auto CreateSampler(TextureFiltering filtering, TextureWrapping wrapping) -> std::shared_ptr<Sampler> override;
+        auto CreateShadowMap(uint32_t width, uint32_t height, std::string name) -> std::shared_ptr<ShadowMap> override;
+        auto CreateSwapchain(uint8_t bufferCount, uint16_t width, uint16_t height, void* window) -> std::shared_ptr<Swapchain> override;
+
+        auto GetSrvHeap() -> std::shared_ptr<Heap> override;
+        auto GetSamplerHeap() -> std::shared_ptr<Heap> override;
+
+        auto DestroyShader(uint64_t shaderHandle) -> void override;
+        auto WaitForIdleGPU() -> void override;
+        auto BeginFrame(uint64_t frame) -> void override;
+
+        /// Counters of everything created and submitted through this device
+        auto Stats() const -> const NullStats& {
+            return *_stats;
+        }
+
+    private:
+        std::shared_ptr<NullStats> _stats;
+        std::shared_ptr<NullHeap> _srvHeap;
+        std::shared_ptr<NullHeap> _samplerHeap;
+    };
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "rendering/GraphicsContext.hxx"
+#include "rendering/null/NullBindings.hxx"
+#include "rendering/null/NullConstantBuffer.hxx"
+#include "rendering/null/NullRenderPassChunk.hxx"
+#include "rendering/null/NullStats.hxx"
+#include "rendering/null/NullStructuredBuffer.hxx"
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace playground::rendering::null {
+    class NullDevice;
+
+    /// Writes frame data into CPU memory and validates draws against what was bound and uploaded instead of rasterizing.
+    /// Anything the D3D12 backend would fail or draw garbage with is counted in NullStats::invalidCalls.
+    class NullGraphicsContext : public rendering::GraphicsContext {
+    public:
+        NullGraphicsContext(std::string name, std::shared_ptr<NullDevice> device, std::shared_ptr<NullStats> stats, uint32_t width, uint32_t height);
+
+        auto Begin() -> void override;
+        auto BeginRenderPass(RenderPass pass, std::shared_ptr<RenderTarget> colour, std::shared_ptr<DepthBuffer> depth) -> void override;
+        auto EndRenderPass() -> void override;
+        auto Finish() -> void override;
+        auto WaitFor(const Context& other) -> void override;
+        auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override;
+        auto Draw(uint32_t numVertices) -> void override;
+        auto AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void override;
+        auto SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void override;
+        auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void override;
+        auto BindCamera(uint8_t index) -> void override;
+        auto BindShadowCascade(uint8_t index) -> void override;
+        auto SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void override;
+        auto SetShadowCastersData(std::vector<ShadowCaster>& shadowCasters) -> void override;
+        auto SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void override;
+        auto BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void override;
+        auto BindMaterial(std::shared_ptr<Material> material) -> void override;
+        auto BindShadowMaterial(std::shared_ptr<Material> material) -> void override;
+        auto BindSRVHeapToSlot(std::shared_ptr<Heap> heap, uint8_t slot) -> void override;
+        auto BindSampler(std::shared_ptr<Sampler> sampler, uint8_t slot) -> void override;
+        auto TransitionIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto TransitionVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto TransitionTexture(std::shared_ptr<Texture> texture) -> void override;
+        auto TransitionCubemap(std::shared_ptr<Cubemap> cubemap) -> void override;
+        auto TransitionShadowMapToDepthWrite(std::shared_ptr<ShadowMap> map) -> void override;
+        auto TransitionShadowMapToPixelShader(std::shared_ptr<ShadowMap> map) -> void override;
+        auto TransitionDepthBufferToDepthWrite(std::shared_ptr<DepthBuffer> depth) -> void override;
+        auto TransitionDepthBufferToPixelShader(std::shared_ptr<DepthBuffer> depth) -> void override;
+        auto CopyToSwapchainBackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<Swapchain> swapchain) -> void override;
+        auto CopyToReadbackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<ReadbackBuffer> target) -> void override;
+        auto SetMaterialData(std::shared_ptr<Material> material) -> void override;
+        auto SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void override;
+        auto SetDirectionalLight(DirectionalLight& light) -> void override;
+        auto SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void override;
+        auto SetViewport(
+            uint32_t startX,
+            uint32_t startY,
+            uint32_t width,
+            uint32_t height,
+            uint32_t depthStart,
+            uint32_t depthEnd
+        ) -> void override;
+        auto SetScissor(
+            uint32_t left,
+            uint32_t top,
+            uint32_t right,
+            uint32_t bottom
+        ) -> void override;
+        auto SetResolution(uint32_t width, uint32_t height) -> void override;
+
+        auto MouseOverID() -> uint64_t override;
+
+        /// Whether BindMaterial would find constants for the material. Safe to call from chunks while the pass records.
+        auto HasMaterialConstants(const Material& material) const -> bool;
+
+        /// Indexed draws that passed validation since Begin, in the order the GPU would execute them
+        auto Draws() const -> const std::vector<NullDraw>& {
+            return _draws;
+        }
+
+    private:
+        std::string _name;
+        std::shared_ptr<NullDevice> _device;
+        std::shared_ptr<NullStats> _stats;
+        std::shared_ptr<NullConstantBuffer> _cameraBuffer;
+        std::shared_ptr<NullStructuredBuffer> _pointLightsBuffer;
+        std::shared_ptr<NullStructuredBuffer> _spotLightsBuffer;
+        std::shared_ptr<NullStructuredBuffer> _lightClustersBuffer;
+        std::shared_ptr<NullStructuredBuffer> _lightIndicesBuffer;
+        ClusterParameters _clusterParameters = {};
+        std::shared_ptr<NullConstantBuffer> _directionalLightBuffer;
+        std::shared_ptr<NullConstantBuffer> _shadowCascadeBuffer;
+        std::shared_ptr<NullStructuredBuffer> _shadowCastersBuffer;
+        uint8_t _shadowCastersCount = 0;
+        std::unordered_map<uint32_t, std::shared_ptr<NullConstantBuffer>> _materialBuffers;
+        std::shared_ptr<NullStructuredBuffer> _materialsBuffer;
+        // Entries of the materials buffer that were ever written
+        std::vector<bool> _writtenMaterials;
+
+        bool _isRecording = false;
+        std::optional<RenderPass> _currentPass;
+        // Increases with every pass so chunks can't be submitted to a later one
+        uint64_t _passIndex = 0;
+        NullBindings _bindings;
+        std::vector<NullDraw> _draws;
+        // Chunks are handed out again after the next Begin
+        std::vector<std::shared_ptr<NullRenderPassChunk>> _chunks;
+        size_t _usedChunks = 0;
+        // First chunk acquired in the open pass
+        size_t _passChunks = 0;
+
+        uint32_t _width;
+        uint32_t _height;
+
+        // Counts a call that needs an open render pass, returns false if there is none
+        auto RequirePass() -> bool;
+        auto Transition(bool valid) -> void;
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "rendering/DescriptorAllocator.hxx"
+#include "rendering/Heap.hxx"
+#include "rendering/null/NullStats.hxx"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace playground::rendering::null {
+    /// Descriptor heap without descriptors, hands out slot indices the same way the D3D12 heaps do
+    class NullHeap : public Heap {
+    public:
+        NullHeap(std::string name, uint32_t capacity, std::shared_ptr<NullStats> stats)
+            : _name(std::move(name)), _allocator({ DescriptorRange{ 0, capacity } }), _stats(std::move(stats)) {}
+
+        auto Allocate() -> uint32_t {
+            auto index = _allocator.Allocate(0);
+            _stats->descriptorsAllocated++;
+
+            return index;
+        }
+
+        /// The slot is reused once the frame freeing it completed, see DescriptorAllocator
+        auto Free(uint32_t index) -> void {
+            _allocator.Free(index);
+            _stats->descriptorsFreed++;
+        }
+
+        auto BeginFrame(uint64_t fence, uint64_t completedFence) -> void {
+            _allocator.BeginFrame(fence, completedFence);
+        }
+
+        auto Capacity() const -> uint32_t {
+            return _allocator.Capacity(0);
+        }
+
+        /// Slots currently handed out or waiting for their frame to complete
+        auto Used() -> uint32_t {
+            return _allocator.Used(0);
+        }
+
+    private:
+        std::string _name;
+        DescriptorAllocator _allocator;
+        std::shared_ptr<NullStats> _stats;
+    };
+
+    /// Slot of a resource in a heap, handed back when the resource is destroyed
+    class NullDescriptor {
+    public:
+        explicit NullDescriptor(std::shared_ptr<NullHeap> heap) : _heap(std::move(heap)), _index(_heap->Allocate()) {}
+
+        ~NullDescriptor() {
+            _heap->Free(_index);
+        }
+
+        NullDescriptor(const NullDescriptor&) = delete;
+        NullDescriptor& operator=(const NullDescriptor&) = delete;
+
+        auto Index() const -> uint32_t {
+            return _index;
+        }
+
+    private:
+        std::shared_ptr<NullHeap> _heap;
+        uint32_t _index;
+    };
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "rendering/IndexBuffer.hxx"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace playground::rendering::null {
+    /// Size() is the index count like on D3D12
+    class NullIndexBuffer : public rendering::IndexBuffer {
+    public:
+        NullIndexBuffer(const uint32_t* indices, size_t count) : rendering::IndexBuffer(count), _staging(count) {
+            if (indices != nullptr) {
+                std::memcpy(_staging.data(), indices, count * sizeof(uint32_t));
+            }
+        }
+
+        auto Id() const -> uint64_t override {
+            return 0;
+        }
+
+        void SetData(const void* data, size_t size) override {
+            _staging.resize(size / sizeof(uint32_t));
+            std::memcpy(_staging.data(), data, _staging.size() * sizeof(uint32_t));
+        }
+
+        void Bind() const override {
+        }
+
+        /// Moves the staged indices into the resident copy, returns the bytes copied
+        auto MakeResident() -> size_t {
+            if (_staging.empty()) {
+                return 0;
+            }
+
+            _memory = std::move(_staging);
+            _staging = {};
+
+            return _memory.size() * sizeof(uint32_t);
+        }
+
+        auto IsResident() const -> bool {
+            return !_memory.empty();
+        }
+
+        auto Memory() const -> const std::vector<uint32_t>& {
+            return _memory;
+        }
+
+    private:
+        std::vector<uint32_t> _staging;
+        std::vector<uint32_t> _memory;
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "rendering/InstanceBuffer.hxx"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace playground::rendering::null {
+    /// Data() is the staging memory the batcher writes to, uploads copy it into the memory draws read from
+    class NullInstanceBuffer : public rendering::InstanceBuffer {
+    public:
+        NullInstanceBuffer(size_t count, size_t stride) : rendering::InstanceBuffer(count), _stride(stride), _staging(count * stride), _memory(count * stride) {}
+
+        auto Id() const -> uint64_t override {
+            return 0;
+        }
+
+        void SetData(const void* data, size_t count, size_t offset) override {
+            std::memcpy(_staging.data() + offset * _stride, data, count * _stride);
+        }
+
+        auto Data() -> void* override {
+            return _staging.data();
+        }
+
+        void Bind() const override {
+        }
+
+        /// Copies the first count instances, returns the bytes copied
+        auto Upload(size_t count) -> size_t {
+            auto bytes = std::min(count, _size) * _stride;
+            std::memcpy(_memory.data(), _staging.data(), bytes);
+            _uploadedCount = std::min(count, _size);
+
+            return bytes;
+        }
+
+        /// Copies count instances starting at first and leaves the others resident as they were, returns the bytes copied
+        auto Upload(size_t first, size_t count) -> size_t {
+            first = std::min(first, _size);
+            count = std::min(count, _size - first);
+            std::memcpy(_memory.data() + first * _stride, _staging.data() + first * _stride, count * _stride);
+            _uploadedCount = std::max(_uploadedCount, first + count);
+
+            return count * _stride;
+        }
+
+        /// Instances a draw may read, everything past it was never uploaded
+        auto UploadedCount() const -> size_t {
+            return _uploadedCount;
+        }
+
+        auto Stride() const -> size_t {
+            return _stride;
+        }
+
+        auto Memory() const -> const std::vector<uint8_t>& {
+            return _memory;
+        }
+
+    private:
+        size_t _stride;
+        size_t _uploadedCount = 0;
+        std::vector<uint8_t> _staging;
+        std::vector<uint8_t> _memory;
+    };
+}
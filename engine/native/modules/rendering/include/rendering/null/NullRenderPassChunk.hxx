@@ -0,0 +1,71 @@
+#pragma once
+
+#include "rendering/RenderPassChunk.hxx"
+#include "rendering/null/NullBindings.hxx"
+#include "rendering/null/NullStats.hxx"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace playground::rendering::null {
+    class NullGraphicsContext;
+
+    /// Validates its calls against its own bindings. Invalid calls are counted right away, the work it recorded reaches NullStats when the context submits it.
+    class NullRenderPassChunk : public rendering::RenderPassChunk {
+    public:
+        enum class State {
+            Recording,
+            Finished,
+            Submitted
+        };
+
+        struct Counters {
+            uint64_t drawCalls = 0;
+            uint64_t instancesDrawn = 0;
+            uint64_t indicesDrawn = 0;
+            uint64_t bindings = 0;
+        };
+
+        NullRenderPassChunk(const NullGraphicsContext& context, std::shared_ptr<NullStats> stats);
+
+        auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override;
+        auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void override;
+        auto BindMaterial(std::shared_ptr<Material> material) -> void override;
+        auto BindShadowMaterial(std::shared_ptr<Material> material) -> void override;
+        auto Finish() -> void override;
+
+        /// Starts an empty recording for the given pass of the context
+        auto Reset(uint64_t pass) -> void;
+        auto MarkSubmitted() -> void;
+
+        auto CurrentState() const -> State {
+            return _state;
+        }
+
+        auto Pass() const -> uint64_t {
+            return _pass;
+        }
+
+        auto Counts() const -> const Counters& {
+            return _counters;
+        }
+
+        auto Draws() const -> const std::vector<NullDraw>& {
+            return _draws;
+        }
+
+    private:
+        const NullGraphicsContext& _context;
+        std::shared_ptr<NullStats> _stats;
+        State _state = State::Submitted;
+        uint64_t _pass = 0;
+        NullBindings _bindings;
+        Counters _counters;
+        std::vector<NullDraw> _draws;
+
+        // Counts a call made after Finish, returns false if there was one
+        auto RequireRecording() -> bool;
+    };
+}
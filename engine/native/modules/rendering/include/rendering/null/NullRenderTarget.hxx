@@ -0,0 +1,38 @@
+#pragma once
+
+#include "rendering/RenderTarget.hxx"
+#include "rendering/TextureFormat.hxx"
+#include <cstdint>
+#include <string>
+
+namespace playground::rendering::null {
+    /// Nothing is rasterized, the target only keeps its description
+    class NullRenderTarget : public RenderTarget {
+    public:
+        NullRenderTarget(uint32_t width, uint32_t height, TextureFormat format, std::string name, bool isCPUReadable)
+            : _width(width), _height(height), _format(format), _name(std::move(name)), _isCPUReadable(isCPUReadable) {}
+
+        auto Width() const -> uint32_t {
+            return _width;
+        }
+
+        auto Height() const -> uint32_t {
+            return _height;
+        }
+
+        auto Format() const -> TextureFormat {
+            return _format;
+        }
+
+        auto IsCPUReadable() const -> bool {
+            return _isCPUReadable;
+        }
+
+    private:
+        uint32_t _width;
+        uint32_t _height;
+        TextureFormat _format;
+        std::string _name;
+        bool _isCPUReadable;
+    };
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "rendering/Sampler.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include <memory>
+
+namespace playground::rendering::null {
+    class NullSampler : public Sampler {
+    public:
+        NullSampler(TextureFiltering filtering, TextureWrapping wrapping, std::shared_ptr<NullHeap> heap)
+            : _filtering(filtering), _wrapping(wrapping), _descriptor(std::move(heap)) {}
+
+        auto Filtering() const -> TextureFiltering {
+            return _filtering;
+        }
+
+        auto Wrapping() const -> TextureWrapping {
+            return _wrapping;
+        }
+
+    private:
+        TextureFiltering _filtering;
+        TextureWrapping _wrapping;
+        NullDescriptor _descriptor;
+    };
+}
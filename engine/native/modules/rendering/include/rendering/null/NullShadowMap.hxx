@@ -0,0 +1,28 @@
+#pragma once
+
+#include "rendering/ShadowMap.hxx"
+#include "rendering/null/NullDepthBuffer.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace playground::rendering::null {
+    class NullShadowMap : public ShadowMap {
+    public:
+        NullShadowMap(uint32_t width, uint32_t height, std::string name, std::shared_ptr<NullHeap> heap)
+            : ShadowMap(width, height), _depthBuffer(std::make_shared<NullDepthBuffer>(width, height, name)), _descriptor(std::move(heap)) {}
+
+        std::shared_ptr<DepthBuffer> GetDepthBuffer() override {
+            return _depthBuffer;
+        }
+
+        uint32_t ID() const override {
+            return _descriptor.Index();
+        }
+
+    private:
+        std::shared_ptr<NullDepthBuffer> _depthBuffer;
+        NullDescriptor _descriptor;
+    };
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "rendering/StagingBuffer.hxx"
+#include <cstdint>
+#include <vector>
+
+namespace playground::rendering::null {
+    class NullStagingBuffer : public rendering::StagingBuffer {
+    public:
+        explicit NullStagingBuffer(uint64_t size) : _memory(size) {}
+
+        auto Data() -> uint8_t* override {
+            return _memory.data();
+        }
+
+        auto Size() const -> uint64_t override {
+            return _memory.size();
+        }
+
+    private:
+        std::vector<uint8_t> _memory;
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace playground::rendering::null {
+    /// Call counters of a null device, shared by all of its contexts and resources
+    struct NullStats {
+        // Resources
+        std::atomic<uint64_t> buffersCreated = 0;
+        std::atomic<uint64_t> texturesCreated = 0;
+        std::atomic<uint64_t> materialsCreated = 0;
+        std::atomic<uint64_t> descriptorsAllocated = 0;
+        std::atomic<uint64_t> descriptorsFreed = 0;
+
+        // Upload context
+        std::atomic<uint64_t> uploads = 0;
+        std::atomic<uint64_t> uploadedBytes = 0;
+        std::atomic<uint64_t> instancesUploaded = 0;
+
+        // Graphics context
+        std::atomic<uint64_t> contextSubmissions = 0;
+        std::atomic<uint64_t> renderPasses = 0;
+        std::atomic<uint64_t> drawCalls = 0;
+        // Chunks of a pass recorded on other threads, see GraphicsContext::AcquireChunks
+        std::atomic<uint64_t> chunksSubmitted = 0;
+        std::atomic<uint64_t> instancesDrawn = 0;
+        std::atomic<uint64_t> indicesDrawn = 0;
+        std::atomic<uint64_t> bindings = 0;
+        std::atomic<uint64_t> transitions = 0;
+        std::atomic<uint64_t> constantBytes = 0;
+        // Calls the D3D12 backend would have failed or drawn garbage with, e.g. drawing outside a render pass
+        std::atomic<uint64_t> invalidCalls = 0;
+
+        // Swapchain
+        std::atomic<uint64_t> presents = 0;
+    };
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "rendering/StructuredBuffer.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace playground::rendering::null {
+    class NullStructuredBuffer : public rendering::StructuredBuffer {
+    public:
+        NullStructuredBuffer(const void* data, size_t count, size_t stride, std::shared_ptr<NullHeap> heap)
+            : _stride(stride), _memory(count * stride), _descriptor(std::move(heap)) {
+            if (data != nullptr) {
+                std::memcpy(_memory.data(), data, _memory.size());
+            }
+        }
+
+        auto SetData(const void* data, size_t count, size_t offset, size_t actualSize) -> void override {
+            std::memcpy(_memory.data() + offset * _stride, data, actualSize);
+        }
+
+        auto Entry(size_t index) const -> const uint8_t* {
+            return _memory.data() + index * _stride;
+        }
+
+        auto ID() const -> uint32_t {
+            return _descriptor.Index();
+        }
+
+    private:
+        size_t _stride;
+        std::vector<uint8_t> _memory;
+        NullDescriptor _descriptor;
+    };
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "rendering/Swapchain.hxx"
+#include "rendering/null/NullStats.hxx"
+#include <cstdint>
+#include <memory>
+
+namespace playground::rendering::null {
+    /// Cycles through the back buffers like a flip model swapchain, presenting never blocks
+    class NullSwapChain : public Swapchain {
+    public:
+        NullSwapChain(uint8_t frameCount, std::shared_ptr<NullStats> stats) : _frameCount(frameCount), _stats(std::move(stats)) {}
+
+        auto Swap() -> void override {
+            _backBufferIndex = (_backBufferIndex + 1) % _frameCount;
+            _stats->presents++;
+        }
+
+        auto BackBufferIndex() -> uint8_t override {
+            return _backBufferIndex;
+        }
+
+    private:
+        uint8_t _frameCount;
+        uint8_t _backBufferIndex = 0;
+        std::shared_ptr<NullStats> _stats;
+    };
+}
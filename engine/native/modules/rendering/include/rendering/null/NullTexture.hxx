@@ -0,0 +1,83 @@
+#pragma once
+
+#include "rendering/Texture.hxx"
+#include "rendering/TextureRegion.hxx"
+#include "rendering/null/NullHeap.hxx"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace playground::rendering::null {
+    /// Packed subresources of a texture, filled region by region from staging memory
+    class NullSubresources {
+    public:
+        NullSubresources(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t faceCount) {
+            for (uint32_t face = 0; face < faceCount; face++) {
+                for (uint32_t mip = 0; mip < mipCount; mip++) {
+                    auto rows = TextureRowCount(std::max(height >> mip, 1u));
+                    _subresources.emplace_back(static_cast<size_t>(rows) * TextureRowBytes(std::max(width >> mip, 1u)));
+                    _pendingRows += rows;
+                }
+            }
+        }
+
+        /// Copies the region's rows out of staging, returns the bytes copied
+        auto Write(const TextureRegion& region, const uint8_t* staging) -> size_t {
+            auto& subresource = _subresources[region.subresource];
+            for (uint32_t row = 0; row < region.rowCount; row++) {
+                std::memcpy(subresource.data() + static_cast<size_t>(region.firstRow + row) * region.rowBytes, staging + static_cast<size_t>(row) * region.rowPitch, region.rowBytes);
+            }
+            _pendingRows -= std::min(_pendingRows, static_cast<uint64_t>(region.rowCount));
+
+            return static_cast<size_t>(region.rowCount) * region.rowBytes;
+        }
+
+        /// Every row of every subresource was uploaded
+        auto IsResident() const -> bool {
+            return _pendingRows == 0;
+        }
+
+        auto Subresource(uint32_t index) const -> const std::vector<uint8_t>& {
+            return _subresources[index];
+        }
+
+    private:
+        std::vector<std::vector<uint8_t>> _subresources;
+        uint64_t _pendingRows = 0;
+    };
+
+    /// The mips are uploaded region by region, ID() is the texture's slot in the SRV heap
+    class NullTexture : public Texture {
+    public:
+        NullTexture(uint32_t width, uint32_t height, uint32_t mipCount, std::shared_ptr<NullHeap> heap)
+            : _width(width), _height(height), _mips(width, height, mipCount, 1), _descriptor(std::move(heap)) {}
+
+        uint32_t ID() const override {
+            return _descriptor.Index();
+        }
+
+        auto Mips() -> NullSubresources& {
+            return _mips;
+        }
+
+        auto IsResident() const -> bool {
+            return _mips.IsResident();
+        }
+
+        auto Width() const -> uint32_t {
+            return _width;
+        }
+
+        auto Height() const -> uint32_t {
+            return _height;
+        }
+
+    private:
+        uint32_t _width;
+        uint32_t _height;
+        NullSubresources _mips;
+        NullDescriptor _descriptor;
+    };
+}
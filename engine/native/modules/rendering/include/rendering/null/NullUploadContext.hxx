@@ -0,0 +1,35 @@
+#pragma once
+
+#include "rendering/UploadContext.hxx"
+#include "rendering/null/NullStats.hxx"
+#include <memory>
+#include <string>
+
+namespace playground::rendering::null {
+    class NullDevice;
+
+    /// Copies staged resource data into their resident memory, uploads outside Begin/Finish count as invalid calls
+    class NullUploadContext : public UploadContext {
+    public:
+        NullUploadContext(std::string name, std::shared_ptr<NullDevice> device, std::shared_ptr<NullStats> stats);
+
+        auto Begin() -> void override;
+        auto Finish() -> void override;
+        auto WaitFor(const Context& other) -> void override;
+
+        auto Upload(std::shared_ptr<Texture> texture, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void override;
+        auto Upload(std::shared_ptr<Cubemap> cubemap, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void override;
+        auto Upload(std::shared_ptr<IndexBuffer> buffer) -> void override;
+        auto Upload(std::shared_ptr<VertexBuffer> buffer) -> void override;
+        auto Upload(std::shared_ptr<InstanceBuffer> buffer, size_t count) -> void override;
+        auto Upload(std::shared_ptr<InstanceBuffer> buffer, size_t first, size_t count) -> void override;
+
+    private:
+        std::string _name;
+        std::shared_ptr<NullDevice> _device;
+        std::shared_ptr<NullStats> _stats;
+        bool _isRecording = false;
+
+        auto Count(size_t bytes) -> void;
+    };
+}
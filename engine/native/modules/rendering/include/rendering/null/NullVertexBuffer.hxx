@@ -0,0 +1,58 @@
+#pragma once
+
+#include "rendering/VertexBuffer.hxx"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace playground::rendering::null {
+    /// Data is staged on creation and only becomes resident once an upload context uploaded it
+    class NullVertexBuffer : public rendering::VertexBuffer {
+    public:
+        NullVertexBuffer(const void* data, size_t size, size_t stride) : rendering::VertexBuffer(size), _stride(stride), _staging(size) {
+            if (data != nullptr) {
+                std::memcpy(_staging.data(), data, size);
+            }
+        }
+
+        auto Id() const -> uint64_t override {
+            return 0;
+        }
+
+        void SetData(const void* data, size_t size) override {
+            _staging.assign(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        }
+
+        void Bind() const override {
+        }
+
+        /// Moves the staged data into the resident copy, returns the bytes copied
+        auto MakeResident() -> size_t {
+            if (_staging.empty()) {
+                return 0;
+            }
+
+            _memory = std::move(_staging);
+            _staging = {};
+
+            return _memory.size();
+        }
+
+        auto IsResident() const -> bool {
+            return !_memory.empty();
+        }
+
+        auto Stride() const -> size_t {
+            return _stride;
+        }
+
+        auto Memory() const -> const std::vector<uint8_t>& {
+            return _memory;
+        }
+
+    private:
+        size_t _stride;
+        std::vector<uint8_t> _staging;
+        std::vector<uint8_t> _memory;
+    };
+}
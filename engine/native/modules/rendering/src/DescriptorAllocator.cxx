@@ -0,0 +1,106 @@
+#include "rendering/DescriptorAllocator.hxx"
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <string>
+
+namespace playground::rendering {
+    DescriptorAllocator::DescriptorAllocator(std::vector<DescriptorRange> ranges) {
+        uint32_t end = 0;
+        for (const auto& range : ranges) {
+            end = std::max(end, range.first + range.count);
+        }
+
+        _slotRanges.resize(end, INVALID_SLOT);
+        _nextFree.resize(end, INVALID_SLOT);
+        _states.resize(end, SlotState::Free);
+        _ranges.reserve(ranges.size());
+
+        for (const auto& range : ranges) {
+            for (uint32_t slot = range.first; slot < range.first + range.count; slot++) {
+                if (_slotRanges[slot] != INVALID_SLOT) {
+                    throw std::runtime_error("Descriptor ranges overlap at slot " + std::to_string(slot));
+                }
+
+                _slotRanges[slot] = static_cast<uint32_t>(_ranges.size());
+            }
+
+            _ranges.push_back(Range{ .slots = range, .untouched = range.first, .freeHead = INVALID_SLOT, .used = 0 });
+        }
+    }
+
+    auto DescriptorAllocator::Allocate(uint32_t range) -> uint32_t {
+        std::scoped_lock lock(_mutex);
+
+        auto& state = _ranges[range];
+        uint32_t slot;
+        if (state.freeHead != INVALID_SLOT) {
+            slot = state.freeHead;
+            state.freeHead = _nextFree[slot];
+        }
+        else if (state.untouched < state.slots.first + state.slots.count) {
+            slot = state.untouched++;
+        }
+        else {
+            throw std::runtime_error("Descriptor range " + std::to_string(range) + " is full");
+        }
+
+        _states[slot] = SlotState::Allocated;
+        state.used++;
+
+        return slot;
+    }
+
+    auto DescriptorAllocator::Free(uint32_t slot) -> void {
+        std::scoped_lock lock(_mutex);
+
+        if (slot >= _states.size() || _states[slot] != SlotState::Allocated) {
+            throw std::runtime_error("Descriptor slot " + std::to_string(slot) + " is not allocated");
+        }
+
+        _states[slot] = SlotState::Retired;
+        _retired.push_back(RetiredSlot{ slot, _fence });
+    }
+
+    auto DescriptorAllocator::BeginFrame(uint64_t fence, uint64_t completedFence) -> void {
+        std::scoped_lock lock(_mutex);
+
+        assert(fence >= _fence && "Fences must not decrease");
+        _fence = fence;
+
+        while (!_retired.empty() && _retired.front().fence <= completedFence) {
+            auto slot = _retired.front().slot;
+            _retired.pop_front();
+
+            auto& range = _ranges[_slotRanges[slot]];
+            _states[slot] = SlotState::Free;
+            _nextFree[slot] = range.freeHead;
+            range.freeHead = slot;
+            range.used--;
+        }
+    }
+
+    auto DescriptorAllocator::RangeOf(uint32_t slot) const -> uint32_t {
+        return slot < _slotRanges.size() ? _slotRanges[slot] : INVALID_SLOT;
+    }
+
+    auto DescriptorAllocator::First(uint32_t range) const -> uint32_t {
+        return _ranges[range].slots.first;
+    }
+
+    auto DescriptorAllocator::Capacity(uint32_t range) const -> uint32_t {
+        return _ranges[range].slots.count;
+    }
+
+    auto DescriptorAllocator::Used(uint32_t range) -> uint32_t {
+        std::scoped_lock lock(_mutex);
+
+        return _ranges[range].used;
+    }
+
+    auto DescriptorAllocator::Retired() -> size_t {
+        std::scoped_lock lock(_mutex);
+
+        return _retired.size();
+    }
+}
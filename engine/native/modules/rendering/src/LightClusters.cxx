@@ -0,0 +1,239 @@
+#include "rendering/LightClusters.hxx"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <shared/JobSystem.hxx>
+#include <simde/x86/avx.h>
+#include <tracy/Tracy.hpp>
+
+namespace playground::rendering {
+    void LightClusterBuilder::LightStreams::Resize(size_t count) {
+        x.resize(count);
+        y.resize(count);
+        z.resize(count);
+        radius.resize(count);
+        directionX.resize(count);
+        directionY.resize(count);
+        directionZ.resize(count);
+        cosOuter.resize(count);
+        sinOuter.resize(count);
+    }
+
+    void LightClusterBuilder::Build(
+        const Camera& camera,
+        uint32_t width,
+        uint32_t height,
+        const PointLight* pointLights,
+        size_t pointCount,
+        const SpotLight* spotLights,
+        size_t spotCount,
+        LightClusterGrid& grid
+    ) {
+        float nearPlane = std::max(camera.Near, 0.001f);
+        float farPlane = std::max(camera.Far, nearPlane * 1.001f);
+        float depthRatio = std::log(farPlane / nearPlane);
+
+        grid.parameters = ClusterParameters{
+            .tilesX = CLUSTER_TILES_X,
+            .tilesY = CLUSTER_TILES_Y,
+            .slices = CLUSTER_SLICES,
+            .sliceScale = CLUSTER_SLICES / depthRatio,
+            .sliceBias = -(CLUSTER_SLICES * std::log(nearPlane)) / depthRatio,
+            .tileScaleX = static_cast<float>(CLUSTER_TILES_X) / std::max(width, 1u),
+            .tileScaleY = static_cast<float>(CLUSTER_TILES_Y) / std::max(height, 1u),
+            .padding = 0,
+        };
+
+        auto view = camera.GetViewMatrix();
+        auto projection = camera.GetProjectionMatrix();
+        float xScale = projection.elements[0][0];
+        float yScale = projection.elements[1][1];
+
+        bounds.resize(CLUSTER_SLICES);
+        lights.resize(CLUSTER_SLICES);
+        points.Resize(pointCount);
+        spots.Resize(spotCount);
+
+        // Lights move into view space once, the clusters never leave it
+        auto toView = [&view](const math::Vector3& p, float w, float& x, float& y, float& z) {
+            const auto& e = view.elements;
+            x = p.X * e[0][0] + p.Y * e[1][0] + p.Z * e[2][0] + w * e[3][0];
+            y = p.X * e[0][1] + p.Y * e[1][1] + p.Z * e[2][1] + w * e[3][1];
+            z = p.X * e[0][2] + p.Y * e[1][2] + p.Z * e[2][2] + w * e[3][2];
+        };
+
+        for (size_t x = 0; x < pointCount; x++) {
+            toView(pointLights[x].position, 1.0f, points.x[x], points.y[x], points.z[x]);
+            points.radius[x] = pointLights[x].radius;
+        }
+
+        for (size_t x = 0; x < spotCount; x++) {
+            const auto& light = spotLights[x];
+            toView(light.position, 1.0f, spots.x[x], spots.y[x], spots.z[x]);
+            toView(light.direction.Normalise(), 0.0f, spots.directionX[x], spots.directionY[x], spots.directionZ[x]);
+            spots.radius[x] = light.range;
+            spots.cosOuter[x] = std::clamp(light.cosOuter, -1.0f, 1.0f);
+            spots.sinOuter[x] = std::sqrt(1.0f - spots.cosOuter[x] * spots.cosOuter[x]);
+        }
+
+        jobsystem::ParallelFor("Rendering: Assign Lights", CLUSTER_SLICES, 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t slice = begin; slice < end; slice++) {
+                auto& sliceBounds = bounds[slice];
+                auto& sliceLights = lights[slice];
+
+                float zNear = nearPlane * std::exp(depthRatio * slice / CLUSTER_SLICES);
+                float zFar = nearPlane * std::exp(depthRatio * (slice + 1) / CLUSTER_SLICES);
+                sliceBounds.minZ = zNear;
+                sliceBounds.maxZ = zFar;
+
+                // The tile's side planes pass through the eye, so its extremes lie on the near or far face of the slice
+                for (uint32_t tile = 0; tile < sliceBounds.minX.size(); tile++) {
+                    if (tile >= TILES_PER_SLICE) {
+                        sliceBounds.minX[tile] = std::numeric_limits<float>::max();
+                        sliceBounds.maxX[tile] = -std::numeric_limits<float>::max();
+                        sliceBounds.minY[tile] = std::numeric_limits<float>::max();
+                        sliceBounds.maxY[tile] = -std::numeric_limits<float>::max();
+                        continue;
+                    }
+
+                    float tx = static_cast<float>(tile % CLUSTER_TILES_X);
+                    float ty = static_cast<float>(tile / CLUSTER_TILES_X);
+                    float left = -1.0f + 2.0f * tx / CLUSTER_TILES_X;
+                    float right = -1.0f + 2.0f * (tx + 1) / CLUSTER_TILES_X;
+                    float top = 1.0f - 2.0f * ty / CLUSTER_TILES_Y;
+                    float bottom = 1.0f - 2.0f * (ty + 1) / CLUSTER_TILES_Y;
+
+                    sliceBounds.minX[tile] = std::min(left * zNear, left * zFar) / xScale;
+                    sliceBounds.maxX[tile] = std::max(right * zNear, right * zFar) / xScale;
+                    sliceBounds.minY[tile] = std::min(bottom * zNear, bottom * zFar) / yScale;
+                    sliceBounds.maxY[tile] = std::max(top * zNear, top * zFar) / yScale;
+                }
+
+                sliceLights.pointCounts.fill(0);
+                sliceLights.spotCounts.fill(0);
+
+                const simde__m128 zero = simde_mm_setzero_ps();
+                const simde__m128 centerZ = simde_mm_set1_ps((zNear + zFar) * 0.5f);
+                const simde__m128 halfDepth = simde_mm_set1_ps((zFar - zNear) * 0.5f);
+
+                // Squared distance from the sphere center to four cluster boxes, the depth part is the same for the whole slice
+                auto sphereDistance = [&](uint32_t tile, float x, float y, float dz) {
+                    simde__m128 lx = simde_mm_set1_ps(x);
+                    simde__m128 ly = simde_mm_set1_ps(y);
+                    simde__m128 dx = simde_mm_max_ps(simde_mm_max_ps(simde_mm_sub_ps(simde_mm_load_ps(&sliceBounds.minX[tile]), lx), zero), simde_mm_sub_ps(lx, simde_mm_load_ps(&sliceBounds.maxX[tile])));
+                    simde__m128 dy = simde_mm_max_ps(simde_mm_max_ps(simde_mm_sub_ps(simde_mm_load_ps(&sliceBounds.minY[tile]), ly), zero), simde_mm_sub_ps(ly, simde_mm_load_ps(&sliceBounds.maxY[tile])));
+                    return simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(dx, dx), simde_mm_mul_ps(dy, dy)), simde_mm_set1_ps(dz * dz));
+                };
+
+                for (uint32_t light = 0; light < pointCount; light++) {
+                    float z = points.z[light];
+                    float r = points.radius[light];
+                    if (z + r < zNear || z - r > zFar) {
+                        continue;
+                    }
+
+                    float dz = std::max(std::max(zNear - z, 0.0f), z - zFar);
+                    simde__m128 radiusSq = simde_mm_set1_ps(r * r);
+
+                    for (uint32_t tile = 0; tile < TILES_PER_SLICE; tile += 4) {
+                        int hits = simde_mm_movemask_ps(simde_mm_cmple_ps(sphereDistance(tile, points.x[light], points.y[light], dz), radiusSq));
+                        while (hits != 0) {
+                            auto cluster = tile + std::countr_zero(static_cast<uint32_t>(hits));
+                            hits &= hits - 1;
+
+                            auto& count = sliceLights.pointCounts[cluster];
+                            if (count < MAX_LIGHTS_PER_CLUSTER) {
+                                sliceLights.points[cluster][count++] = light;
+                            }
+                        }
+                    }
+                }
+
+                for (uint32_t light = 0; light < spotCount; light++) {
+                    float z = spots.z[light];
+                    float r = spots.radius[light];
+                    if (z + r < zNear || z - r > zFar) {
+                        continue;
+                    }
+
+                    float dz = std::max(std::max(zNear - z, 0.0f), z - zFar);
+                    simde__m128 radiusSq = simde_mm_set1_ps(r * r);
+                    simde__m128 lx = simde_mm_set1_ps(spots.x[light]);
+                    simde__m128 ly = simde_mm_set1_ps(spots.y[light]);
+                    simde__m128 lz = simde_mm_set1_ps(z);
+                    simde__m128 dirX = simde_mm_set1_ps(spots.directionX[light]);
+                    simde__m128 dirY = simde_mm_set1_ps(spots.directionY[light]);
+                    simde__m128 dirZ = simde_mm_set1_ps(spots.directionZ[light]);
+                    simde__m128 cosOuter = simde_mm_set1_ps(spots.cosOuter[light]);
+                    simde__m128 sinOuter = simde_mm_set1_ps(spots.sinOuter[light]);
+                    simde__m128 range = simde_mm_set1_ps(r);
+
+                    for (uint32_t tile = 0; tile < TILES_PER_SLICE; tile += 4) {
+                        simde__m128 inRange = simde_mm_cmple_ps(sphereDistance(tile, spots.x[light], spots.y[light], dz), radiusSq);
+
+                        // Cone against the cluster's bounding sphere: reject when the sphere lies entirely outside the cone's angle, in front of its range or behind its apex
+                        simde__m128 minX = simde_mm_load_ps(&sliceBounds.minX[tile]);
+                        simde__m128 maxX = simde_mm_load_ps(&sliceBounds.maxX[tile]);
+                        simde__m128 minY = simde_mm_load_ps(&sliceBounds.minY[tile]);
+                        simde__m128 maxY = simde_mm_load_ps(&sliceBounds.maxY[tile]);
+                        simde__m128 half = simde_mm_set1_ps(0.5f);
+                        simde__m128 extentX = simde_mm_mul_ps(simde_mm_sub_ps(maxX, minX), half);
+                        simde__m128 extentY = simde_mm_mul_ps(simde_mm_sub_ps(maxY, minY), half);
+                        simde__m128 sphereRadius = simde_mm_sqrt_ps(simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(extentX, extentX), simde_mm_mul_ps(extentY, extentY)), simde_mm_mul_ps(halfDepth, halfDepth)));
+
+                        simde__m128 vx = simde_mm_sub_ps(simde_mm_mul_ps(simde_mm_add_ps(minX, maxX), half), lx);
+                        simde__m128 vy = simde_mm_sub_ps(simde_mm_mul_ps(simde_mm_add_ps(minY, maxY), half), ly);
+                        simde__m128 vz = simde_mm_sub_ps(centerZ, lz);
+                        simde__m128 lengthSq = simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(vx, vx), simde_mm_mul_ps(vy, vy)), simde_mm_mul_ps(vz, vz));
+                        simde__m128 along = simde_mm_add_ps(simde_mm_add_ps(simde_mm_mul_ps(vx, dirX), simde_mm_mul_ps(vy, dirY)), simde_mm_mul_ps(vz, dirZ));
+                        simde__m128 across = simde_mm_sqrt_ps(simde_mm_max_ps(simde_mm_sub_ps(lengthSq, simde_mm_mul_ps(along, along)), zero));
+                        simde__m128 closest = simde_mm_sub_ps(simde_mm_mul_ps(cosOuter, across), simde_mm_mul_ps(along, sinOuter));
+
+                        simde__m128 outside = simde_mm_or_ps(
+                            simde_mm_cmpgt_ps(closest, sphereRadius),
+                            simde_mm_or_ps(
+                                simde_mm_cmpgt_ps(along, simde_mm_add_ps(sphereRadius, range)),
+                                simde_mm_cmplt_ps(along, simde_mm_sub_ps(zero, sphereRadius))
+                            )
+                        );
+
+                        int hits = simde_mm_movemask_ps(simde_mm_andnot_ps(outside, inRange));
+                        while (hits != 0) {
+                            auto cluster = tile + std::countr_zero(static_cast<uint32_t>(hits));
+                            hits &= hits - 1;
+
+                            auto& count = sliceLights.spotCounts[cluster];
+                            if (count < MAX_LIGHTS_PER_CLUSTER) {
+                                sliceLights.spots[cluster][count++] = light;
+                            }
+                        }
+                    }
+                }
+            }
+        });
+
+        // Clusters are laid out slice by slice, row by row, matching the lookup in the shaders
+        ZoneScopedN("Rendering: Compact Light Clusters");
+        grid.clusters.resize(CLUSTER_COUNT);
+        grid.indices.clear();
+
+        for (uint32_t slice = 0; slice < CLUSTER_SLICES; slice++) {
+            const auto& sliceLights = lights[slice];
+
+            for (uint32_t tile = 0; tile < TILES_PER_SLICE; tile++) {
+                auto& cluster = grid.clusters[slice * TILES_PER_SLICE + tile];
+                auto available = MAX_LIGHT_INDICES - static_cast<uint32_t>(grid.indices.size());
+                auto pointCount = std::min<uint32_t>(sliceLights.pointCounts[tile], available);
+                auto spotCount = std::min<uint32_t>(sliceLights.spotCounts[tile], available - pointCount);
+
+                cluster.offset = static_cast<uint32_t>(grid.indices.size());
+                cluster.pointCount = static_cast<uint16_t>(pointCount);
+                cluster.spotCount = static_cast<uint16_t>(spotCount);
+
+                grid.indices.insert(grid.indices.end(), sliceLights.points[tile].begin(), sliceLights.points[tile].begin() + pointCount);
+                grid.indices.insert(grid.indices.end(), sliceLights.spots[tile].begin(), sliceLights.spots[tile].begin() + spotCount);
+            }
+        }
+    }
+}
@@ -0,0 +1,77 @@
+#include "rendering/MaterialConstants.hxx"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+namespace playground::rendering {
+    MaterialConstants::MaterialConstants(uint8_t frameCount)
+        : _data(static_cast<size_t>(MAX_MATERIALS) * MAX_MATERIAL_SIZE_BYTES, 0), _dirty(frameCount), _stagedIndex(MAX_MATERIALS, NOT_STAGED) {
+        // The fallback entry is never updated, it only has to reach every frame's buffer once
+        for (auto& dirty : _dirty) {
+            dirty.fill(0);
+            dirty[FALLBACK_MATERIAL_SLOT / 64] |= uint64_t(1) << (FALLBACK_MATERIAL_SLOT % 64);
+        }
+    }
+
+    void MaterialConstants::Update(const Material& material) {
+        if (material.id >= FALLBACK_MATERIAL_SLOT) {
+            if (!_reportedOverflow.exchange(true, std::memory_order_relaxed)) {
+                std::cerr << "Material " << material.id << " exceeds the " << FALLBACK_MATERIAL_SLOT << " material entries, it and every later material draw with the fallback entry." << std::endl;
+            }
+            return;
+        }
+
+        std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES> entry;
+        Pack(material, entry);
+
+        std::scoped_lock lock(_stagingMutex);
+        auto& index = _stagedIndex[material.id];
+        if (index == NOT_STAGED) {
+            index = static_cast<uint32_t>(_staged.size());
+            _staged.push_back(MaterialEntry{ .id = material.id, .data = entry });
+        }
+        else {
+            _staged[index].data = entry;
+        }
+    }
+
+    void MaterialConstants::TakeStaged(eastl::vector<MaterialEntry>& changes) {
+        assert(changes.empty() && "Changes must be empty");
+
+        std::scoped_lock lock(_stagingMutex);
+        // Swapping hands the packet's memory back for the next updates
+        changes.swap(_staged);
+        for (const auto& change : changes) {
+            _stagedIndex[change.id] = NOT_STAGED;
+        }
+    }
+
+    void MaterialConstants::Apply(const eastl::vector<MaterialEntry>& changes) {
+        for (const auto& change : changes) {
+            std::memcpy(_data.data() + static_cast<size_t>(change.id) * MAX_MATERIAL_SIZE_BYTES, change.data.data(), change.data.size());
+
+            for (auto& dirty : _dirty) {
+                dirty[change.id / 64] |= uint64_t(1) << (change.id % 64);
+            }
+        }
+    }
+
+    auto MaterialConstants::Pack(const Material& material, std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES>& entry) -> size_t {
+        entry.fill(0);
+
+        size_t offset = 0;
+        auto push = [&](const void* data, size_t size) {
+            if (size > 0 && offset < entry.size()) {
+                std::memcpy(entry.data() + offset, data, std::min(size, entry.size() - offset));
+            }
+            offset += size;
+        };
+
+        push(material.textures.data(), material.textures.size() * sizeof(uint32_t));
+        push(material.cubemaps.data(), material.cubemaps.size() * sizeof(uint32_t));
+        push(material.floats.data(), material.floats.size() * sizeof(float));
+
+        return offset;
+    }
+}
@@ -0,0 +1,36 @@
+#include "rendering/ParallelPassRecording.hxx"
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <tracy/Tracy.hpp>
+
+namespace playground::rendering {
+    size_t PassChunkCount(size_t count, size_t minItemsPerChunk, size_t maxChunks) {
+        if (count == 0) {
+            return 0;
+        }
+
+        minItemsPerChunk = std::max<size_t>(minItemsPerChunk, 1);
+
+        return std::clamp<size_t>((count + minItemsPerChunk - 1) / minItemsPerChunk, 1, std::max<size_t>(maxChunks, 1));
+    }
+
+    void RecordPassChunks(GraphicsContext& context, size_t count, size_t chunkCount, const ChunkDispatcher& dispatch, const ChunkRecorder& record) {
+        ZoneScopedN("RenderThread: Record Pass Chunks");
+        chunkCount = std::min(chunkCount, count);
+        if (chunkCount == 0) {
+            return;
+        }
+
+        std::vector<std::shared_ptr<RenderPassChunk>> chunks;
+        context.AcquireChunks(static_cast<uint32_t>(chunkCount), chunks);
+
+        dispatch(chunkCount, [&](size_t chunk) {
+            ZoneScopedN("Rendering: Record Chunk");
+            record(*chunks[chunk], count * chunk / chunkCount, count * (chunk + 1) / chunkCount);
+            chunks[chunk]->Finish();
+        });
+
+        context.SubmitChunks(chunks);
+    }
+}
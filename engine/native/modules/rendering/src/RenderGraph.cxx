@@ -0,0 +1,233 @@
+#include "rendering/RenderGraph.hxx"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace playground::rendering {
+    auto RenderGraph::Import(std::string name, ResourceState initialState, ResourceState finalState) -> RenderGraphResource {
+        _resources.push_back(Resource{
+            .name = std::move(name),
+            .isTransient = false,
+            .isOutput = false,
+            .initialState = initialState,
+            .finalState = finalState,
+            .desc = TransientResourceDesc{},
+        });
+
+        return static_cast<RenderGraphResource>(_resources.size() - 1);
+    }
+
+    auto RenderGraph::CreateTransient(std::string name, TransientResourceDesc desc) -> RenderGraphResource {
+        _resources.push_back(Resource{
+            .name = std::move(name),
+            .isTransient = true,
+            .isOutput = false,
+            .initialState = ResourceState::Undefined,
+            .finalState = ResourceState::Undefined,
+            .desc = desc,
+        });
+
+        return static_cast<RenderGraphResource>(_resources.size() - 1);
+    }
+
+    auto RenderGraph::MarkOutput(RenderGraphResource resource) -> void {
+        _resources[resource].isOutput = true;
+    }
+
+    auto RenderGraph::AddPass(std::string name) -> RenderGraphPass {
+        _passes.push_back(Pass{ .name = std::move(name), .hasSideEffects = false, .accesses = {} });
+
+        return static_cast<RenderGraphPass>(_passes.size() - 1);
+    }
+
+    auto RenderGraph::SetSideEffects(RenderGraphPass pass) -> void {
+        _passes[pass].hasSideEffects = true;
+    }
+
+    auto RenderGraph::Read(RenderGraphPass pass, RenderGraphResource resource, ResourceState state) -> void {
+        AddAccess(pass, resource, state, false);
+    }
+
+    auto RenderGraph::Write(RenderGraphPass pass, RenderGraphResource resource, ResourceState state) -> void {
+        AddAccess(pass, resource, state, true);
+    }
+
+    auto RenderGraph::Compile(CompiledRenderGraph& compiled) const -> void {
+        compiled.passes.clear();
+        compiled.finalBarriers.clear();
+        compiled.transients.clear();
+        compiled.transientHeapSize = 0;
+
+        // Walk back from the outputs, a pass is needed if it writes something a later needed pass reads
+        std::vector<bool> isNeeded(_resources.size(), false);
+        std::vector<bool> isAlive(_passes.size(), false);
+        for (size_t x = 0; x < _resources.size(); x++) {
+            isNeeded[x] = _resources[x].isOutput;
+        }
+
+        for (size_t x = _passes.size(); x > 0; x--) {
+            const auto& pass = _passes[x - 1];
+            isAlive[x - 1] = pass.hasSideEffects || std::any_of(pass.accesses.begin(), pass.accesses.end(), [&](const Access& access) {
+                return access.isWrite && isNeeded[access.resource];
+            });
+
+            if (!isAlive[x - 1]) {
+                continue;
+            }
+
+            for (const auto& access : pass.accesses) {
+                if (!access.isWrite) {
+                    isNeeded[access.resource] = true;
+                }
+            }
+        }
+
+        std::vector<ResourceState> states(_resources.size());
+        std::vector<bool> isWritten(_resources.size(), false);
+        // Index of the transient's placement, or -1 while no pass used it
+        std::vector<int32_t> placements(_resources.size(), -1);
+        for (size_t x = 0; x < _resources.size(); x++) {
+            states[x] = _resources[x].initialState;
+        }
+
+        for (size_t x = 0; x < _passes.size(); x++) {
+            if (!isAlive[x]) {
+                continue;
+            }
+
+            auto passIndex = static_cast<uint32_t>(compiled.passes.size());
+            auto& compiledPass = compiled.passes.emplace_back(CompiledRenderPass{ .pass = static_cast<RenderGraphPass>(x), .barriers = {} });
+
+            for (const auto& access : _passes[x].accesses) {
+                const auto& resource = _resources[access.resource];
+                if (resource.isTransient) {
+                    if (!access.isWrite && !isWritten[access.resource]) {
+                        throw std::runtime_error("Render graph pass " + _passes[x].name + " reads transient " + resource.name + " before it was written");
+                    }
+
+                    if (placements[access.resource] < 0) {
+                        placements[access.resource] = static_cast<int32_t>(compiled.transients.size());
+                        compiled.transients.push_back(TransientPlacement{
+                            .resource = access.resource,
+                            .offset = 0,
+                            .size = resource.desc.size,
+                            .firstPass = passIndex,
+                            .lastPass = passIndex,
+                        });
+                    }
+
+                    compiled.transients[placements[access.resource]].lastPass = passIndex;
+                }
+
+                // Passes using a resource in the state the last one left it in need no barrier
+                if (states[access.resource] != access.state) {
+                    compiledPass.barriers.push_back(RenderGraphBarrier{ access.resource, states[access.resource], access.state });
+                    states[access.resource] = access.state;
+                }
+
+                isWritten[access.resource] = isWritten[access.resource] || access.isWrite;
+            }
+        }
+
+        for (size_t x = 0; x < _resources.size(); x++) {
+            const auto& resource = _resources[x];
+            if (!resource.isTransient && states[x] != resource.finalState) {
+                compiled.finalBarriers.push_back(RenderGraphBarrier{ static_cast<RenderGraphResource>(x), states[x], resource.finalState });
+            }
+        }
+
+        compiled.transientHeapSize = PlaceTransients(compiled.transients);
+        std::sort(compiled.transients.begin(), compiled.transients.end(), [](const TransientPlacement& lhs, const TransientPlacement& rhs) {
+            return lhs.resource < rhs.resource;
+        });
+    }
+
+    auto RenderGraph::Reset() -> void {
+        _resources.clear();
+        _passes.clear();
+    }
+
+    auto RenderGraph::ResourceName(RenderGraphResource resource) const -> const std::string& {
+        return _resources[resource].name;
+    }
+
+    auto RenderGraph::PassName(RenderGraphPass pass) const -> const std::string& {
+        return _passes[pass].name;
+    }
+
+    auto RenderGraph::AddAccess(RenderGraphPass pass, RenderGraphResource resource, ResourceState state, bool isWrite) -> void {
+        auto& accesses = _passes[pass].accesses;
+        auto existing = std::find_if(accesses.begin(), accesses.end(), [resource](const Access& access) {
+            return access.resource == resource;
+        });
+
+        if (existing == accesses.end()) {
+            accesses.push_back(Access{ resource, state, isWrite });
+            return;
+        }
+
+        // A resource is in exactly one state while a pass runs
+        if (existing->state != state) {
+            throw std::runtime_error("Render graph pass " + _passes[pass].name + " uses " + _resources[resource].name + " in two states");
+        }
+
+        existing->isWrite = existing->isWrite || isWrite;
+    }
+
+    auto RenderGraph::PlaceTransients(std::vector<TransientPlacement>& transients) const -> uint64_t {
+        // Largest first, the small ones then fill the gaps the large ones leave
+        std::vector<size_t> order(transients.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+            if (transients[lhs].size != transients[rhs].size) {
+                return transients[lhs].size > transients[rhs].size;
+            }
+
+            return transients[lhs].firstPass < transients[rhs].firstPass;
+        });
+
+        uint64_t heapSize = 0;
+        std::vector<size_t> placed;
+        placed.reserve(transients.size());
+
+        for (auto index : order) {
+            auto& transient = transients[index];
+            auto alignment = std::max<uint64_t>(_resources[transient.resource].desc.alignment, 1);
+
+            auto overlaps = [&](const TransientPlacement& other) {
+                return other.firstPass <= transient.lastPass && transient.firstPass <= other.lastPass;
+            };
+
+            // The lowest fitting offset is either the start of the heap or right behind a transient living at the same time
+            std::vector<uint64_t> candidates = { 0 };
+            for (auto other : placed) {
+                if (overlaps(transients[other])) {
+                    candidates.push_back(transients[other].offset + transients[other].size);
+                }
+            }
+
+            uint64_t offset = UINT64_MAX;
+            for (auto candidate : candidates) {
+                candidate = (candidate + alignment - 1) / alignment * alignment;
+                if (candidate >= offset) {
+                    continue;
+                }
+
+                bool fits = std::none_of(placed.begin(), placed.end(), [&](size_t other) {
+                    const auto& placement = transients[other];
+                    return overlaps(placement) && candidate < placement.offset + placement.size && placement.offset < candidate + transient.size;
+                });
+
+                if (fits) {
+                    offset = candidate;
+                }
+            }
+
+            transient.offset = offset;
+            heapSize = std::max(heapSize, offset + transient.size);
+            placed.push_back(index);
+        }
+
+        return heapSize;
+    }
+}
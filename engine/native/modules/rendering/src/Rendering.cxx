@@ -9,17 +9,26 @@
 #include "rendering/Camera.hxx"
 #include "rendering/Sampler.hxx"
 #include "rendering/DirectionalLight.hxx"
+#include "rendering/MaterialConstants.hxx"
+#include "rendering/ParallelPassRecording.hxx"
+#include "rendering/RenderGraph.hxx"
 #include "rendering/ShadowCaster.hxx"
+#include "rendering/StateTrackingGraphicsContext.hxx"
+#include "rendering/UploadScheduler.hxx"
 #include <math/Quaternion.hxx>
 #include <math/Vector3.hxx>
 #include <math/Matrix4x4.hxx>
 #include <assetloader/AssetLoader.hxx>
+#include <shared/JobSystem.hxx>
 #include <shared/RingBuffer.hxx>
 #include <shared/Logger.hxx>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <functional>
 #include <semaphore>
 #include <queue>
 #include <profiler/Profiler.hxx>
@@ -40,9 +49,9 @@ namespace playground::rendering {
     };
 
     struct ObjectBuffer {
-        math::Matrix4x4 ModelMatrix;
-        math::Matrix4x4 NormalMatrix;
+        math::Vector4 ModelColumns[3];
     };
+    static_assert(sizeof(ObjectBuffer) == sizeof(DrawCall::InstanceData), "Instance buffer stride must match the batcher's instance data");
 
     struct LightBuffer {
         math::Matrix4x4 ViewProjection;
@@ -57,16 +66,41 @@ namespace playground::rendering {
         int frameIndex;
     };
 
+    struct GraphPass {
+        /// Pass the barriers in front of this one are recorded in, it has to record into the same command list
+        RenderPass barrierPass;
+        std::function<void()> record;
+    };
+
+    /// What a render graph resource transitions, resources without one keep their state all frame
+    struct GraphTarget {
+        std::shared_ptr<DepthBuffer> depth = nullptr;
+        std::shared_ptr<ShadowMap> shadowMap = nullptr;
+    };
+
     Config config;
+    ShadowSettings shadowSettings;
 
     // Use triple buffering for rendering (N = Render Thread, N + 1 = Idle, N + 2 = Main Thread)
     constexpr uint8_t FRAME_COUNT = 3;
     // The maximum number of frames to render ahead
     constexpr uint8_t MAX_AHEAD_FRAMES = 8;
-    // Start the instace buffer at this size
+    // Queued frames, the one being drawn, the ones the GPU still works on and the one being filled
+    constexpr uint8_t FRAME_PACKET_COUNT = MAX_AHEAD_FRAMES + FRAME_COUNT + 1;
+    // Rings carrying packets are large enough to hold all of them, so passing one on never fails
+    constexpr size_t FRAME_PACKET_RING_SIZE = 16;
+    static_assert(FRAME_PACKET_COUNT < FRAME_PACKET_RING_SIZE, "Frame packet rings must be able to hold every packet");
+    // Start instance buffers at this size
     constexpr uint32_t MAX_OBJECTS_PER_FRAME = 8192;
-
-    uint8_t instanceBufferGrowth = 1;
+    // Instance buffers that are too small get replaced by one this many times larger
+    constexpr uint8_t INSTANCE_BUFFER_GROWTH = 2;
+    // Slice of every frame streaming may take
+    constexpr UploadBudget UPLOAD_BUDGET = { .bytes = 16 * 1024 * 1024, .time = std::chrono::milliseconds(2) };
+    // Every frame in flight may stage its whole budget, space comes back once the frame's fence completed
+    constexpr uint64_t STAGING_RING_SIZE = UPLOAD_BUDGET.bytes * FRAME_COUNT;
+    // Textures are split into regions of at most this many staged bytes, so a large one is spread over several frames
+    constexpr uint64_t TEXTURE_PART_SIZE = 4 * 1024 * 1024;
+    static_assert(TEXTURE_PART_SIZE <= UPLOAD_BUDGET.bytes, "A texture part must fit the upload budget of one frame");
 
 	std::shared_ptr<Device> device = nullptr;
 	void* window = nullptr;
@@ -80,10 +114,20 @@ namespace playground::rendering {
 	std::vector<std::shared_ptr<Frame>> frames = {};
 
     // Frames that are due to be rendered, ring buffer
-    RingBuffer<RenderFrame, MAX_AHEAD_FRAMES> renderFrames = {};
-    RenderFrame currentFrame = {};
+    RingBuffer<RenderFrame*, FRAME_PACKET_RING_SIZE> renderFrames = {};
+    // Frame packets only ever move by pointer. Users are the current frame and every GPU frame recorded from it, touched by the render thread only.
+    std::array<RenderFrame, FRAME_PACKET_COUNT> framePackets = {};
+    std::array<uint8_t, FRAME_PACKET_COUNT> framePacketUsers = {};
+    RingBuffer<RenderFrame*, FRAME_PACKET_RING_SIZE> freeFramePackets = {};
+    RenderFrame* currentFrame = nullptr;
+    RenderFrame emptyFrame = {};
     std::atomic<uint32_t> frameInUseByGPU = 0;
     std::atomic<uint32_t> nextFrameIndex = 0;
+    // Frames the render thread started recording, freed descriptors and completed uploads are tracked by it
+    uint64_t recordedFrames = 0;
+    UploadScheduler uploadScheduler(STAGING_RING_SIZE, TEXTURE_PLACEMENT_ALIGNMENT);
+    // Persistently mapped memory behind the scheduler's staging ring
+    std::shared_ptr<StagingBuffer> stagingBuffer = nullptr;
 
 	// Resource management
     std::mutex uploadMutex;
@@ -100,6 +144,8 @@ namespace playground::rendering {
     std::vector<uint32_t> freeShaderIds = {};
 	std::vector<std::shared_ptr<Material>> materials = {};
     std::vector<uint32_t> freeMaterialIds = {};
+    // Packed constants of all materials. Changes travel with the frame packets, each frame's context receives the entries that changed since it last drew
+    MaterialConstants materialConstants(FRAME_COUNT);
 	std::vector<Mesh> meshes = {};
     std::vector<uint32_t> freeMeshIds = {};
 
@@ -113,6 +159,16 @@ namespace playground::rendering {
 
     std::vector<std::shared_ptr<Material>> postprocessMaterials = {};
 
+    // Instance buffers no frame refers to anymore, reused by AcquireInstanceBuffer
+    moodycamel::ConcurrentQueue<std::shared_ptr<InstanceBuffer>> freeInstanceBuffers;
+    std::atomic<uint32_t> instanceBufferCapacity = MAX_OBJECTS_PER_FRAME;
+
+    // Rebuilt every frame, so passes the frame doesn't need are culled and their barriers skipped
+    RenderGraph renderGraph;
+    CompiledRenderGraph compiledGraph;
+    std::vector<GraphPass> graphPasses = {};
+    std::vector<GraphTarget> graphTargets = {};
+
     bool didUpload = false;
 
     bool isRunning = false;
@@ -123,16 +179,35 @@ namespace playground::rendering {
 
     void SetupBuiltinAssets();
 
+    void RetainFramePacket(RenderFrame* frame) {
+        if (frame != nullptr) {
+            framePacketUsers[frame - framePackets.data()]++;
+        }
+    }
+
+    void ReleaseFramePacket(RenderFrame* frame) {
+        if (frame == nullptr || --framePacketUsers[frame - framePackets.data()] > 0) {
+            return;
+        }
+
+        // Hand the instances back right away, the packet itself is cleared by the next AcquireFrame
+        frame->instanceBuffer = nullptr;
+        frame->staticInstanceBuffer = nullptr;
+        freeFramePackets.enqueue(frame);
+    }
+
 	auto Init(
         void* window,
         uint32_t width,
         uint32_t height,
         bool offscreen,
+        RenderBackendType backend,
         std::promise<void>& rendererReadyPromise
     ) -> void {
         logging::logger::SetupSubsystem("rendering");
         // Create a device
-        device = DeviceFactory::CreateDevice(RenderBackendType::D3D12, FRAME_COUNT);
+        device = DeviceFactory::CreateDevice(backend, FRAME_COUNT);
+        stagingBuffer = device->CreateStagingBuffer(STAGING_RING_SIZE);
 
 #if _WIN32
         SetThreadDescription(GetCurrentThread(), L"Render Thread");
@@ -159,16 +234,18 @@ namespace playground::rendering {
             auto ulName = "UploadContext_" + std::to_string(x);
             auto shadowMapsBufferName = "ShadowMapsBuffer" + std::to_string(x);
 
-            auto graphicsContext = device->CreateGraphicsContext(gfxName, window, width, height, offscreen);
+            auto graphicsContext = std::make_shared<StateTrackingGraphicsContext>(device->CreateGraphicsContext(gfxName, window, width, height, offscreen));
             auto uploadContext = device->CreateUploadContext(ulName);
 
-            auto instanceBuffer = device->CreateInstanceBuffer(131072, sizeof(ObjectBuffer));
-
-            frames.emplace_back(std::make_shared<Frame>(x, device, rendertarget, depthBuffer, graphicsContext, uploadContext, instanceBuffer));
+            frames.emplace_back(std::make_shared<Frame>(x, device, rendertarget, depthBuffer, graphicsContext, uploadContext, shadowSettings.cascadeCount, shadowSettings.resolution));
         }
 
         swapchain = device->CreateSwapchain(FRAME_COUNT, width, height, window);
 
+        for (auto& packet : framePackets) {
+            freeFramePackets.enqueue(&packet);
+        }
+
         tracy::SetThreadName("Render Thread");
 
         isRunning = true;
@@ -194,10 +271,22 @@ namespace playground::rendering {
             frame = nullptr;
         }
 
+        // Packets still hold instance buffers, they go back to the pool which is drained last
+        currentFrame = nullptr;
+        for (auto& packet : framePackets) {
+            packet.instanceBuffer = nullptr;
+            packet.staticInstanceBuffer = nullptr;
+        }
+
+        std::shared_ptr<InstanceBuffer> freeBuffer;
+        while (freeInstanceBuffers.try_dequeue(freeBuffer)) {}
+        freeBuffer = nullptr;
+
         vertexBuffers = {};
         indexBuffers = {};
 
         swapchain = nullptr;
+        stagingBuffer = nullptr;
         // Cleanup
         device = nullptr;
 	}
@@ -206,6 +295,106 @@ namespace playground::rendering {
         isRunning = false;
 	}
 
+    auto MeshBytes(const std::vector<assetloader::RawVertex>& vertices, const std::vector<uint32_t>& indices) -> uint64_t {
+        return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t);
+    }
+
+    auto ScheduleModelUpload(ModelUploadJob job) -> void {
+        auto model = std::make_shared<ModelUploadJob>(std::move(job));
+        auto meshes = std::make_shared<std::vector<Mesh>>();
+        meshes->reserve(model->meshes.size());
+
+        // One part per mesh, so a large model is spread over several frames
+        std::vector<uint64_t> parts;
+        parts.reserve(model->meshes.size());
+        for (const auto& mesh : model->meshes) {
+            auto bytes = MeshBytes(mesh.vertices, mesh.indices);
+            for (const auto& lod : mesh.lods) {
+                bytes += MeshBytes(lod.vertices, lod.indices);
+            }
+            parts.push_back(bytes);
+        }
+
+        uploadScheduler.Enqueue(UploadJob{
+            .priority = model->priority,
+            .parts = std::move(parts),
+            // Mesh ids are positions in the model, parts go out in order
+            .upload = [model, meshes](size_t part, uint64_t) { meshes->push_back(UploadMesh(model->meshes[part])); },
+            .onComplete = [model, meshes] { model->callback(model->handle, std::move(*meshes)); },
+        });
+    }
+
+    auto ScheduleTextureUpload(TextureUploadJob* job) -> void {
+        auto mipCount = static_cast<uint32_t>(job->rawData->MipMaps.size());
+        auto regions = std::make_shared<std::vector<TextureRegion>>(SplitTexture(job->rawData->Width, job->rawData->Height, mipCount, 1, TEXTURE_PART_SIZE));
+
+        std::vector<uint64_t> parts;
+        parts.reserve(regions->size());
+        for (const auto& region : *regions) {
+            parts.push_back(region.StagingBytes());
+        }
+
+        auto textureId = std::make_shared<uint32_t>(0);
+        uploadScheduler.Enqueue(UploadJob{
+            .priority = job->priority,
+            .parts = std::move(parts),
+            .staged = true,
+            // Regions go out in order, the first one creates the texture and the last one makes it readable
+            .upload = [job, regions, textureId](size_t part, uint64_t offset) {
+                if (part == 0) {
+                    *textureId = CreateTexture(job);
+                }
+
+                const auto& region = (*regions)[part];
+                const auto& mip = job->rawData->MipMaps[region.subresource];
+                StageTextureRegion(mip.data(), mip.size(), region, stagingBuffer->Data() + offset);
+                frames[swapchain->BackBufferIndex()]->UploadContext()->Upload(textures[*textureId], region, stagingBuffer, offset);
+
+                if (part == regions->size() - 1) {
+                    frames[swapchain->BackBufferIndex()]->TexturesToTransition().push_back(job->handle);
+                }
+            },
+            .onComplete = [job, textureId] {
+                job->callback(job->handle, *textureId);
+                delete job;
+            },
+        });
+    }
+
+    auto ScheduleCubemapUpload(CubemapUploadJob job) -> void {
+        auto cubemap = std::make_shared<CubemapUploadJob>(std::move(job));
+        auto mipCount = static_cast<uint32_t>(cubemap->cubemapData->facesRawData.front().size());
+        auto regions = std::make_shared<std::vector<TextureRegion>>(SplitTexture(cubemap->cubemapData->Width, cubemap->cubemapData->Height, mipCount, 6, TEXTURE_PART_SIZE));
+
+        std::vector<uint64_t> parts;
+        parts.reserve(regions->size());
+        for (const auto& region : *regions) {
+            parts.push_back(region.StagingBytes());
+        }
+
+        auto cubemapId = std::make_shared<uint32_t>(0);
+        uploadScheduler.Enqueue(UploadJob{
+            .priority = cubemap->priority,
+            .parts = std::move(parts),
+            .staged = true,
+            .upload = [cubemap, regions, cubemapId, mipCount](size_t part, uint64_t offset) {
+                if (part == 0) {
+                    *cubemapId = CreateCubemap(*cubemap);
+                }
+
+                const auto& region = (*regions)[part];
+                const auto& mip = cubemap->cubemapData->facesRawData[region.subresource / mipCount][region.subresource % mipCount];
+                StageTextureRegion(mip.data(), mip.size(), region, stagingBuffer->Data() + offset);
+                frames[swapchain->BackBufferIndex()]->UploadContext()->Upload(cubemaps[*cubemapId], region, stagingBuffer, offset);
+
+                if (part == regions->size() - 1) {
+                    frames[swapchain->BackBufferIndex()]->CubemapsToTransition().push_back(cubemap->handle);
+                }
+            },
+            .onComplete = [cubemap, cubemapId] { cubemap->callback(cubemap->handle, *cubemapId); },
+        });
+    }
+
 	auto PreFrame() -> void {
         ZoneScopedN("RenderThread: Pre Frame");
         lastFrameTime = std::chrono::high_resolution_clock::now();
@@ -218,29 +407,33 @@ namespace playground::rendering {
 
         uploadContext->Begin();
 
+        // Begin waited for this frame's previous uploads, so everything uploaded FRAME_COUNT frames ago is on the GPU
+        recordedFrames++;
+        uploadScheduler.BeginFrame(recordedFrames, recordedFrames > FRAME_COUNT ? recordedFrames - FRAME_COUNT : 0);
+
         auto& modelUploadQueue = frames[backBufferIndex]->ModelUploadQueue();
         while (modelUploadQueue.size() > 0) {
             auto modelUploadJob = std::move(modelUploadQueue.back());
             modelUploadQueue.pop_back();
 
-            UploadModel(modelUploadJob);
+            ScheduleModelUpload(std::move(modelUploadJob));
         }
 
+        // Materials upload nothing, compiling them still counts against the frame's time budget
         auto& materialUploadQueue = frames[backBufferIndex]->MaterialUploadQueue();
         while (materialUploadQueue.size() > 0) {
-            auto materialUploadJob = std::move(materialUploadQueue.back());
+            auto materialUploadJob = std::make_shared<MaterialUploadJob>(std::move(materialUploadQueue.back()));
             materialUploadQueue.pop_back();
 
-            CreateMaterial(materialUploadJob);
+            uploadScheduler.Enqueue(UploadJob{
+                .parts = { 0 },
+                .upload = [materialUploadJob](size_t part, uint64_t) { CreateMaterial(std::move(*materialUploadJob)); },
+            });
         }
 
         TextureUploadJob* textureUploadJob = frames[backBufferIndex]->PopTextureUploadJob();
         while (textureUploadJob != nullptr) {
-            UploadTexture(textureUploadJob);
-
-            frames[backBufferIndex]->TexturesToTransition().push_back(textureUploadJob->handle);
-
-            delete textureUploadJob;
+            ScheduleTextureUpload(textureUploadJob);
 
             textureUploadJob = frames[backBufferIndex]->PopTextureUploadJob();
         }
@@ -250,12 +443,38 @@ namespace playground::rendering {
             auto job = cubemapQueue.back();
             cubemapQueue.pop_back();
 
-            UploadCubemap(job);
+            ScheduleCubemapUpload(std::move(job));
+        }
 
-            frames[backBufferIndex]->CubemapsToTransition().push_back(job.handle);
+        {
+            ZoneScopedN("RenderThread: Scheduled Uploads");
+            auto uploadStats = uploadScheduler.Run(UPLOAD_BUDGET);
+            TracyPlot("Uploaded Bytes", static_cast<int64_t>(uploadStats.bytes));
+            TracyPlot("Queued Uploads", static_cast<int64_t>(uploadScheduler.Queued()));
         }
 
-        uploadContext->Upload(frames[backBufferIndex]->InstanceBuffer());
+        // Without a new frame the last one is drawn again, its instances are already on the GPU
+        RenderFrame* next = nullptr;
+        if (renderFrames.dequeue(next)) {
+            ReleaseFramePacket(currentFrame);
+            RetainFramePacket(next);
+            currentFrame = next;
+            materialConstants.Apply(currentFrame->materials);
+
+            if (currentFrame->instanceCount > 0) {
+                uploadContext->Upload(currentFrame->instanceBuffer, currentFrame->instanceCount);
+            }
+
+            // The static buffer stays resident across frames, only the ranges the packet changed are staged and copied
+            if (currentFrame->staticInstanceBuffer != nullptr) {
+                const auto* patchData = currentFrame->staticPatchData.data();
+                for (const auto& patch : currentFrame->staticPatches) {
+                    currentFrame->staticInstanceBuffer->SetData(patchData, patch.count, patch.first);
+                    uploadContext->Upload(currentFrame->staticInstanceBuffer, patch.first, patch.count);
+                    patchData += patch.count;
+                }
+            }
+        }
 
         uploadContext->Finish();
 
@@ -264,16 +483,50 @@ namespace playground::rendering {
         cubemapQueue = {};
 	}
 
+    auto ImportGraphTarget(std::string name, ResourceState state, GraphTarget target) -> RenderGraphResource {
+        graphTargets.push_back(std::move(target));
+
+        return renderGraph.Import(std::move(name), state, state);
+    }
+
+    auto AddGraphPass(std::string name, RenderPass barrierPass, std::function<void()> record) -> RenderGraphPass {
+        graphPasses.push_back(GraphPass{ barrierPass, std::move(record) });
+
+        return renderGraph.AddPass(std::move(name));
+    }
+
+    auto RecordGraphBarriers(GraphicsContext& context, const std::vector<RenderGraphBarrier>& barriers) -> void {
+        for (const auto& barrier : barriers) {
+            const auto& target = graphTargets[barrier.resource];
+            bool toShaderResource = barrier.after == ResourceState::ShaderResource;
+
+            if (target.shadowMap != nullptr) {
+                if (toShaderResource) {
+                    context.TransitionShadowMapToPixelShader(target.shadowMap);
+                } else {
+                    context.TransitionShadowMapToDepthWrite(target.shadowMap);
+                }
+            } else if (target.depth != nullptr) {
+                if (toShaderResource) {
+                    context.TransitionDepthBufferToPixelShader(target.depth);
+                } else {
+                    context.TransitionDepthBufferToDepthWrite(target.depth);
+                }
+            }
+        }
+    }
+
     auto Update() -> void {
         ZoneScopedN("RenderThread: Update");
         ZoneColor(tracy::Color::Orange1);
         auto backBufferIndex = swapchain->BackBufferIndex();
         auto graphicsContext = frames[backBufferIndex]->GraphicsContext();
         graphicsContext->Begin();
+        device->BeginFrame(recordedFrames);
 
         auto renderTarget = frames[backBufferIndex]->RenderTarget();
         auto depthBuffer = frames[backBufferIndex]->DepthBuffer();
-        auto shadowMap = frames[backBufferIndex]->DirectionalLightShadowMap();
+        const auto& cascadeMaps = frames[backBufferIndex]->CascadeShadowMaps();
 
         {
             graphicsContext->BeginRenderPass(RenderPass::Preparation, nullptr, nullptr);
@@ -295,26 +548,14 @@ namespace playground::rendering {
             graphicsContext->EndRenderPass();
         }
 
-        RenderFrame nextFrame;
-        if (renderFrames.dequeue(nextFrame)) {
-            currentFrame = nextFrame;
-        }
-        else {
-            nextFrame = currentFrame;
-        }
+        // Begin waited for the GPU to finish this frame's previous work, so the packet it was recorded from can be released
+        ReleaseFramePacket(frames[backBufferIndex]->RenderFrame());
+        RetainFramePacket(currentFrame);
+        frames[backBufferIndex]->SetRenderFrame(currentFrame);
 
-        auto instanceBuffer = frames[logicFrameIndex]->InstanceBuffer();
-        {
-            ZoneScopedN("RenderThread: Update Instance Buffer");
-            uint16_t instanceOffset = 0;
-            for (const auto& drawCall : nextFrame.drawCalls) {
-                for (int x = 0; x < drawCall.instanceData.size(); x++) {
-                    const auto& instanceData = drawCall.instanceData[x];
-                    instanceBuffer->SetData(&instanceData, 1, instanceOffset);
-                    instanceOffset++;
-                }
-            }
-        }
+        auto& nextFrame = currentFrame != nullptr ? *currentFrame : emptyFrame;
+        auto instanceBuffer = nextFrame.instanceBuffer;
+        auto staticInstanceBuffer = nextFrame.staticInstanceBuffer;
 
         for (int x = 0; x < nextFrame.cameras.size(); x++) {
             assert(x < MAX_CAMERA_COUNT && "Max cameras exceeded");
@@ -340,96 +581,199 @@ namespace playground::rendering {
             cameras[x] = buff;
         }
 
+        materialConstants.UploadDirty(backBufferIndex, [&](uint32_t first, uint32_t count, const uint8_t* data) {
+            graphicsContext->SetMaterialsData(data, first, count);
+        });
+
         // Write camera data to context
         graphicsContext->SetCameraData(cameras);
         graphicsContext->SetDirectionalLight(nextFrame.sun);
 
-        graphicsContext->BeginRenderPass(RenderPass::Skybox, frames[backBufferIndex]->RenderTarget(), nullptr);
-        graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
-        graphicsContext->SetViewport(0, 0, config.Width, config.Height, 0, 1);
-        graphicsContext->SetScissor(0, 0, config.Width, config.Height);
-        graphicsContext->BindCamera(0);
-
-        if (skyboxMaterial != nullptr) {
-            graphicsContext->SetMaterialData(skyboxMaterial);
-            graphicsContext->BindMaterial(skyboxMaterial);
-            graphicsContext->Draw(36);
+        auto cascadeCount = std::min<size_t>(nextFrame.cascadeCount, cascadeMaps.size());
+        std::array<DirectionalLight, MAX_SHADOW_CASCADES> cascadeLights;
+        for (size_t x = 0; x < cascadeCount; x++) {
+            cascadeLights[x] = nextFrame.sun;
+            cascadeLights[x].viewMatrix = nextFrame.cascades[x].viewMatrix;
+            cascadeLights[x].projectionMatrix = nextFrame.cascades[x].projectionMatrix;
         }
+        graphicsContext->SetShadowCascades(cascadeLights.data(), cascadeCount);
 
-        graphicsContext->EndRenderPass();
+        // Only the main camera is drawn, its grid assigns the local lights. The opaque pass binds the data when it starts.
+        static const LightClusterGrid noClusters = {};
+        const auto& clusters = nextFrame.lightClusters.empty() ? noClusters : nextFrame.lightClusters.front();
+        graphicsContext->SetLightData(clusters, nextFrame.pointLights.data(), nextFrame.pointLights.size(), nextFrame.spotLights.data(), nextFrame.spotLights.size());
 
-        uint32_t instanceOffet = 0;
+        std::vector<ShadowCaster> shadowcasters = {};
+        shadowcasters.reserve(MAX_SHADOW_MAPS_PER_FRAME + 1);
 
-        graphicsContext->BeginRenderPass(RenderPass::Shadow, nullptr, shadowMap->GetDepthBuffer());
+        // Cascades go first, near to far, the shader samples the first one covering a pixel
+        for (size_t x = 0; x < cascadeCount; x++) {
+            const auto& cascade = nextFrame.cascades[x];
+            shadowcasters.emplace_back(cascade.viewMatrix, cascade.projectionMatrix, cascadeMaps[x]->ID(), cascade.splitDistance, 1.0f / cascadeMaps[x]->Width());
+        }
 
-        graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
-        graphicsContext->SetViewport(0, 0, shadowMap->Width(), shadowMap->Height(), 0, 1);
-        graphicsContext->SetScissor(0, 0, shadowMap->Width(), shadowMap->Height());
-        graphicsContext->BindInstanceBuffer(frames[backBufferIndex]->InstanceBuffer());
+        // TODO: Add other lights to the buffer
+        graphicsContext->SetShadowCastersData(shadowcasters);
 
-        if (shadowMaterial != nullptr) {
-            graphicsContext->BindShadowMaterial(shadowMaterial);
-            for (auto& drawcall : nextFrame.drawCalls) {
-                graphicsContext->BindVertexBuffer(vertexBuffers[drawcall.vertexBuffer]);
-                graphicsContext->BindIndexBuffer(indexBuffers[drawcall.indexBuffer]);
+        // The render thread records the first chunk itself, the others go to the high performance workers
+        auto dispatchChunks = [](size_t count, const std::function<void(size_t chunk)>& task) {
+            jobsystem::ParallelFor("Rendering: Record Chunks", count, 1, [&](size_t range, size_t begin, size_t end) {
+                for (size_t chunk = begin; chunk < end; chunk++) {
+                    task(chunk);
+                }
+            });
+        };
 
-                graphicsContext->Draw(indexBuffers[drawcall.indexBuffer]->Size(), 0, 0, drawcall.instanceData.size(), instanceOffet);
+        // Records the dynamic draws followed by the static ones into chunks of the open pass.
+        // Chunks start with nothing bound, beginChunk sets up what all of their draws share.
+        auto recordDraws = [&](const eastl::vector<DrawCall>& dynamicCalls, const eastl::vector<DrawCall>& staticCalls, const auto& beginChunk, const auto& draw) {
+            size_t dynamicCount = instanceBuffer != nullptr ? dynamicCalls.size() : 0;
+            size_t staticCount = staticInstanceBuffer != nullptr ? staticCalls.size() : 0;
+            size_t count = dynamicCount + staticCount;
+            auto chunkCount = PassChunkCount(count, MIN_DRAWS_PER_CHUNK, static_cast<size_t>(jobsystem::HighPerfWorkers()) + 1);
+
+            RecordPassChunks(*graphicsContext, count, chunkCount, dispatchChunks, [&](RenderPassChunk& chunk, size_t begin, size_t end) {
+                beginChunk(chunk);
+                for (size_t x = begin; x < end; x++) {
+                    bool isStatic = x >= dynamicCount;
+                    if (x == begin || x == dynamicCount) {
+                        chunk.BindInstanceBuffer(isStatic ? staticInstanceBuffer : instanceBuffer);
+                    }
+
+                    draw(chunk, isStatic ? staticCalls[x - dynamicCount] : dynamicCalls[x]);
+                }
+            });
+        };
 
-                instanceOffet = instanceOffet + drawcall.instanceData.size();
-            }
-        }
-        graphicsContext->EndRenderPass();
+        auto drawShadow = [&](RenderPassChunk& chunk, const DrawCall& drawcall) {
+            chunk.BindVertexBuffer(vertexBuffers[drawcall.vertexBuffer]);
+            chunk.BindIndexBuffer(indexBuffers[drawcall.indexBuffer]);
 
-        instanceOffet = 0;
+            chunk.Draw(indexBuffers[drawcall.indexBuffer]->Size(), 0, 0, drawcall.instanceCount, drawcall.firstInstance);
+        };
 
-        graphicsContext->BeginRenderPass(RenderPass::PostShadow, nullptr, nullptr);
-        graphicsContext->TransitionShadowMapToPixelShader(shadowMap);
-        graphicsContext->EndRenderPass();
+        auto drawOpaque = [&](RenderPassChunk& chunk, const DrawCall& drawcall) {
+            if (!(drawcall.visibility & CameraVisibilityMask(0))) {
+                return;
+            }
 
-        graphicsContext->BeginRenderPass(RenderPass::Opaque, renderTarget, depthBuffer);
-        graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
-        graphicsContext->BindCamera(0);
-        graphicsContext->SetViewport(0, 0, config.Width, config.Height, 0, 1);
-        graphicsContext->SetScissor(0, 0, config.Width, config.Height);
-        graphicsContext->BindInstanceBuffer(frames[backBufferIndex]->InstanceBuffer());
+            chunk.BindVertexBuffer(vertexBuffers[drawcall.vertexBuffer]);
+            chunk.BindIndexBuffer(indexBuffers[drawcall.indexBuffer]);
+            chunk.BindMaterial(materials[drawcall.material]);
 
-        std::vector<ShadowCaster> shadowcasters = {};
-        shadowcasters.reserve(MAX_SHADOW_MAPS_PER_FRAME + 1);
+            chunk.Draw(indexBuffers[drawcall.indexBuffer]->Size(), 0, 0, drawcall.instanceCount, drawcall.firstInstance);
+        };
 
-        shadowcasters.emplace_back(nextFrame.sun.viewMatrix, nextFrame.sun.projectionMatrix, frames[backBufferIndex]->DirectionalLightShadowMap()->ID());
+        renderGraph.Reset();
+        graphTargets.clear();
 
-        // TODO: Add other lights to the buffer
-        graphicsContext->SetShadowCastersData(shadowcasters);
+        auto colour = ImportGraphTarget("Colour", ResourceState::RenderTarget, {});
+        auto depth = ImportGraphTarget("Depth", ResourceState::DepthWrite, { .depth = depthBuffer });
+        renderGraph.MarkOutput(colour);
 
-        for (auto& drawcall : nextFrame.drawCalls) {
-            // TODO: Mark materials dirty and bulk update all dirty ones
-            graphicsContext->SetMaterialData(materials[drawcall.material]);
+        std::array<RenderGraphResource, MAX_SHADOW_CASCADES> cascadeResources = {};
+        for (size_t x = 0; x < cascadeMaps.size(); x++) {
+            cascadeResources[x] = ImportGraphTarget("Shadow Cascade " + std::to_string(x), ResourceState::DepthWrite, { .shadowMap = cascadeMaps[x] });
+        }
 
-            graphicsContext->BindVertexBuffer(vertexBuffers[drawcall.vertexBuffer]);
-            graphicsContext->BindIndexBuffer(indexBuffers[drawcall.indexBuffer]);
-            graphicsContext->BindMaterial(materials[drawcall.material]);
+        auto skyboxPass = AddGraphPass("Skybox", RenderPass::PostOpaque, [&] {
+            graphicsContext->BeginRenderPass(RenderPass::Skybox, renderTarget, nullptr);
+            graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
+            graphicsContext->SetViewport(0, 0, config.Width, config.Height, 0, 1);
+            graphicsContext->SetScissor(0, 0, config.Width, config.Height);
+            graphicsContext->BindCamera(0);
 
-            graphicsContext->Draw(indexBuffers[drawcall.indexBuffer]->Size(), 0, 0, drawcall.instanceData.size(), instanceOffet);
+            if (skyboxMaterial != nullptr) {
+                graphicsContext->SetMaterialData(skyboxMaterial);
+                graphicsContext->BindMaterial(skyboxMaterial);
+                graphicsContext->Draw(36);
+            }
 
-            instanceOffet = instanceOffet + drawcall.instanceData.size();
+            graphicsContext->EndRenderPass();
+        });
+        renderGraph.Write(skyboxPass, colour, ResourceState::RenderTarget);
+
+        // Cascades the frame doesn't use are never read, so the graph culls their passes
+        for (size_t x = 0; x < cascadeMaps.size(); x++) {
+            auto shadowPass = AddGraphPass("Shadow Cascade " + std::to_string(x), RenderPass::PostShadow, [&, x] {
+                const auto& shadowMap = cascadeMaps[x];
+
+                graphicsContext->BeginRenderPass(RenderPass::Shadow, nullptr, shadowMap->GetDepthBuffer());
+
+                graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
+                graphicsContext->SetViewport(0, 0, shadowMap->Width(), shadowMap->Height(), 0, 1);
+                graphicsContext->SetScissor(0, 0, shadowMap->Width(), shadowMap->Height());
+                if (shadowMaterial != nullptr) {
+                    graphicsContext->BindShadowCascade(static_cast<uint8_t>(x));
+
+                    recordDraws(
+                        nextFrame.shadowDrawCalls[x],
+                        nextFrame.staticShadowDrawCalls[x],
+                        [&](RenderPassChunk& chunk) { chunk.BindShadowMaterial(shadowMaterial); },
+                        drawShadow
+                    );
+                }
+                graphicsContext->EndRenderPass();
+            });
+            renderGraph.Write(shadowPass, cascadeResources[x], ResourceState::DepthWrite);
         }
-        graphicsContext->EndRenderPass();
 
-        graphicsContext->BeginRenderPass(RenderPass::PostOpaque, nullptr, nullptr);
-        graphicsContext->TransitionDepthBufferToPixelShader(depthBuffer);
-        graphicsContext->EndRenderPass();
-
-        for (auto& postProcessingEffect : postprocessMaterials) {
-            graphicsContext->BeginRenderPass(RenderPass::PostProcessing, renderTarget, depthBuffer);
+        // Its barriers go to the end of the shadow list, like the shadow maps were transitioned before
+        auto opaquePass = AddGraphPass("Opaque", RenderPass::PostShadow, [&] {
+            graphicsContext->BeginRenderPass(RenderPass::Opaque, renderTarget, depthBuffer);
             graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
+            graphicsContext->BindCamera(0);
             graphicsContext->SetViewport(0, 0, config.Width, config.Height, 0, 1);
             graphicsContext->SetScissor(0, 0, config.Width, config.Height);
-            graphicsContext->SetMaterialData(postProcessingEffect);
-            graphicsContext->BindMaterial(postProcessingEffect);
-            graphicsContext->BindCamera(0);
-            graphicsContext->Draw(3);
+
+            recordDraws(nextFrame.drawCalls, nextFrame.staticDrawCalls, [](RenderPassChunk& chunk) {}, drawOpaque);
             graphicsContext->EndRenderPass();
+        });
+        for (size_t x = 0; x < cascadeCount; x++) {
+            renderGraph.Read(opaquePass, cascadeResources[x], ResourceState::ShaderResource);
+        }
+        renderGraph.Write(opaquePass, colour, ResourceState::RenderTarget);
+        renderGraph.Write(opaquePass, depth, ResourceState::DepthWrite);
+
+        for (const auto& postProcessingEffect : postprocessMaterials) {
+            auto effectPass = AddGraphPass("Post Processing", RenderPass::PostOpaque, [&, postProcessingEffect] {
+                graphicsContext->BeginRenderPass(RenderPass::PostProcessing, renderTarget, depthBuffer);
+                graphicsContext->BindHeaps({ device->GetSrvHeap(), device->GetSamplerHeap() });
+                graphicsContext->SetViewport(0, 0, config.Width, config.Height, 0, 1);
+                graphicsContext->SetScissor(0, 0, config.Width, config.Height);
+                graphicsContext->SetMaterialData(postProcessingEffect);
+                graphicsContext->BindMaterial(postProcessingEffect);
+                graphicsContext->BindCamera(0);
+                graphicsContext->Draw(3);
+                graphicsContext->EndRenderPass();
+            });
+            renderGraph.Read(effectPass, depth, ResourceState::ShaderResource);
+            renderGraph.Write(effectPass, colour, ResourceState::RenderTarget);
+        }
+
+        {
+            ZoneScopedN("RenderThread: Compile Render Graph");
+            renderGraph.Compile(compiledGraph);
+        }
+
+        for (const auto& pass : compiledGraph.passes) {
+            const auto& graphPass = graphPasses[pass.pass];
+            if (!pass.barriers.empty()) {
+                graphicsContext->BeginRenderPass(graphPass.barrierPass, nullptr, nullptr);
+                RecordGraphBarriers(*graphicsContext, pass.barriers);
+                graphicsContext->EndRenderPass();
+            }
+
+            graphPass.record();
         }
+
+        // The passes captured this frame's locals
+        graphPasses.clear();
+
+        const auto& stateStats = std::static_pointer_cast<StateTrackingGraphicsContext>(graphicsContext)->Stats();
+        TracyPlot("Issued Binds", static_cast<int64_t>(stateStats.issuedBinds));
+        TracyPlot("Skipped Binds", static_cast<int64_t>(stateStats.skippedBinds));
+        TracyPlot("Skipped Material Uploads", static_cast<int64_t>(stateStats.skippedMaterialUploads));
 	}
 
 	auto PostFrame() -> void {
@@ -440,13 +784,12 @@ namespace playground::rendering {
 
         auto renderTarget = frames[backBufferIndex]->RenderTarget();
         auto depthBuffer = frames[backBufferIndex]->DepthBuffer();
-        auto shadowMap = frames[backBufferIndex]->DirectionalLightShadowMap();
 
         graphicsContext->CopyToSwapchainBackBuffer(frames[backBufferIndex]->RenderTarget(), swapchain);
 
+        // Returns the resources the graph transitioned to the state the next frame's graph expects
         graphicsContext->BeginRenderPass(RenderPass::Completion, nullptr, nullptr);
-        graphicsContext->TransitionDepthBufferToDepthWrite(depthBuffer);
-        graphicsContext->TransitionShadowMapToDepthWrite(shadowMap);
+        RecordGraphBarriers(*graphicsContext, compiledGraph.finalBarriers);
         graphicsContext->EndRenderPass();
 
         graphicsContext->WaitFor(*frames[backBufferIndex]->UploadContext().get());
@@ -495,12 +838,13 @@ namespace playground::rendering {
 
 	}
 
-    auto QueueUploadModel(std::vector<assetloader::RawMeshData>& meshes, uint32_t handle, std::function<void(uint32_t, std::vector<Mesh>)> callback) -> void {
+    auto QueueUploadModel(std::vector<assetloader::RawMeshData>& meshes, uint32_t handle, std::function<void(uint32_t, std::vector<Mesh>)> callback, UploadPriority priority) -> void {
         std::scoped_lock lock(uploadMutex);
         auto job = ModelUploadJob {
             .handle = handle,
             .meshes = meshes,
-            .callback = callback
+            .callback = callback,
+            .priority = priority
         };
 
         frames[logicFrameIndex]->ModelUploadQueue().push_back(job);
@@ -528,16 +872,17 @@ namespace playground::rendering {
         frames[logicFrameIndex]->MaterialUploadQueue().push_back(job);
     }
 
-    auto QueueUploadTexture(assetloader::RawTextureData* texture, uint32_t handle, void (*callback)(uint32_t, uint32_t)) -> void {
+    auto QueueUploadTexture(assetloader::RawTextureData* texture, uint32_t handle, void (*callback)(uint32_t, uint32_t), UploadPriority priority) -> void {
         auto job = new TextureUploadJob(
             handle,
             texture,
-            callback
+            callback,
+            priority
         );
         frames[logicFrameIndex]->PushTextureUploadJob(job);
     }
 
-    auto QueueUploadCubemap(std::shared_ptr<assetloader::RawCubemapData> cubemap, uint32_t handle, std::function<void(uint32_t, uint32_t)> callback) -> void {
+    auto QueueUploadCubemap(std::shared_ptr<assetloader::RawCubemapData> cubemap, uint32_t handle, std::function<void(uint32_t, uint32_t)> callback, UploadPriority priority) -> void {
         std::scoped_lock lock(uploadMutex);
 
         ZoneScopedN("RenderThread: Queue Upload Cubemap");
@@ -557,74 +902,71 @@ namespace playground::rendering {
         auto job = CubemapUploadJob{
             .handle = handle,
             .cubemapData = std::move(cubemap),
-            .callback = callback
+            .callback = callback,
+            .priority = priority
         };
 
         frames[logicFrameIndex]->CubemapUploadQueue().push_back(job);
     }
 
-    auto UploadModel(ModelUploadJob& job) -> void {
-        ZoneScopedN("RenderThread: Upload Model");
-        ZoneColor(tracy::Color::Violet);
-        auto meshes = std::vector<Mesh>();
-        for (auto& mesh : job.meshes) {
-            const UINT vertexBufferSize = mesh.vertices.size();
-            const UINT indexBufferSize = mesh.indices.size();
-
-            auto vertexBuffer = device->CreateVertexBuffer(mesh.vertices.data(), sizeof(Vertex) * vertexBufferSize, sizeof(Vertex), true);
-            auto indexBuffer = device->CreateIndexBuffer(mesh.indices.data(), indexBufferSize);
-
-            uint32_t vertexBufferId = 0;
-            if (freeVertexBufferIds.size() > 0) {
-                vertexBufferId = freeVertexBufferIds.back();
-                vertexBuffers[vertexBufferId] = vertexBuffer;
-                freeVertexBufferIds.pop_back();
-            }
-            else {
-                vertexBuffers.push_back(vertexBuffer);
-                vertexBufferId = vertexBuffers.size() - 1;
-            }
+    // Creates and uploads the buffers of one mesh or LOD, returns the vertex and index buffer ids
+    auto UploadMeshBuffers(const std::vector<assetloader::RawVertex>& vertices, const std::vector<uint32_t>& indices) -> std::pair<uint32_t, uint32_t> {
+        const UINT vertexBufferSize = vertices.size();
+        const UINT indexBufferSize = indices.size();
 
-            uint32_t indexBufferId = 0;
-            if (freeIndexBufferIds.size() > 0) {
-                indexBufferId = freeIndexBufferIds.back();
-                indexBuffers[indexBufferId] = indexBuffer;
-                freeIndexBufferIds.pop_back();
-            }
-            else {
-                indexBuffers.push_back(indexBuffer);
-                indexBufferId = indexBuffers.size() - 1;
-            }
+        auto vertexBuffer = device->CreateVertexBuffer(vertices.data(), sizeof(Vertex) * vertexBufferSize, sizeof(Vertex), true);
+        auto indexBuffer = device->CreateIndexBuffer(indices.data(), indexBufferSize);
 
-            uint32_t meshId = 0;
-            if (freeMeshIds.size() > 0) {
-                meshId = freeMeshIds.back();
-                meshes[meshId] = Mesh{ vertexBufferId, indexBufferId };
-                freeMeshIds.pop_back();
-            }
-            else {
-                meshes.push_back(Mesh{ vertexBufferId, indexBufferId });
-                meshId = meshes.size() - 1;
-            }
+        uint32_t vertexBufferId = 0;
+        if (freeVertexBufferIds.size() > 0) {
+            vertexBufferId = freeVertexBufferIds.back();
+            vertexBuffers[vertexBufferId] = vertexBuffer;
+            freeVertexBufferIds.pop_back();
+        }
+        else {
+            vertexBuffers.push_back(vertexBuffer);
+            vertexBufferId = vertexBuffers.size() - 1;
+        }
+
+        uint32_t indexBufferId = 0;
+        if (freeIndexBufferIds.size() > 0) {
+            indexBufferId = freeIndexBufferIds.back();
+            indexBuffers[indexBufferId] = indexBuffer;
+            freeIndexBufferIds.pop_back();
+        }
+        else {
+            indexBuffers.push_back(indexBuffer);
+            indexBufferId = indexBuffers.size() - 1;
+        }
+
+        auto backBufferIndex = swapchain->BackBufferIndex();
+        auto uploadContext = frames[backBufferIndex]->UploadContext();
 
-            auto backBufferIndex = swapchain->BackBufferIndex();
-            auto uploadContext = frames[backBufferIndex]->UploadContext();
+        uploadContext->Upload(vertexBuffer);
+        uploadContext->Upload(indexBuffer);
 
-            uploadContext->Upload(vertexBuffer);
-            uploadContext->Upload(indexBuffer);
+        return { vertexBufferId, indexBufferId };
+    }
+
+    auto UploadMesh(const assetloader::RawMeshData& data) -> Mesh {
+        ZoneScopedN("RenderThread: Upload Mesh");
+        ZoneColor(tracy::Color::Violet);
+        auto [vertexBufferId, indexBufferId] = UploadMeshBuffers(data.vertices, data.indices);
+        auto mesh = Mesh{ vertexBufferId, indexBufferId };
 
-            meshes.push_back(Mesh{ vertexBufferId, indexBufferId });
+        for (const auto& lod : data.lods) {
+            auto [lodVertexBufferId, lodIndexBufferId] = UploadMeshBuffers(lod.vertices, lod.indices);
+            mesh.lods.push_back(MeshLod{ lodVertexBufferId, lodIndexBufferId, lod.screenSize });
         }
 
-        job.callback(job.handle, meshes);
+        return mesh;
     }
 
-    auto UploadTexture(TextureUploadJob* job) -> void {
-        ZoneScopedN("RenderThread: Upload Texture");
+    auto CreateTexture(TextureUploadJob* job) -> uint32_t {
+        ZoneScopedN("RenderThread: Create Texture");
         ZoneColor(tracy::Color::Violet);
-        auto backBufferIndex = swapchain->BackBufferIndex();
 
-        auto texture = device->CreateTexture(job->rawData->Width, job->rawData->Height, job->rawData->MipMaps, frames[backBufferIndex]->Alloc());
+        auto texture = device->CreateTexture(job->rawData->Width, job->rawData->Height, static_cast<uint32_t>(job->rawData->MipMaps.size()));
 
         uint32_t textureId = 0;
         if (freeTextureIds.size() > 0) {
@@ -637,18 +979,14 @@ namespace playground::rendering {
             textureId = textures.size() - 1;
         }
 
-        auto uploadContext = frames[backBufferIndex]->UploadContext();
-        uploadContext->Upload(texture);
-
-        job->callback(job->handle, textureId);
+        return textureId;
     }
 
-    auto UploadCubemap(CubemapUploadJob& job) -> void {
-        ZoneScopedN("RenderThread: Upload Cubemap");
+    auto CreateCubemap(CubemapUploadJob& job) -> uint32_t {
+        ZoneScopedN("RenderThread: Create Cubemap");
         ZoneColor(tracy::Color::Violet);
-        auto backBufferIndex = swapchain->BackBufferIndex();
 
-        auto cubemap = device->CreateCubemap(job.cubemapData->Width, job.cubemapData->Height, job.cubemapData->facesRawData, frames[backBufferIndex]->Alloc());
+        auto cubemap = device->CreateCubemap(job.cubemapData->Width, job.cubemapData->Height, static_cast<uint32_t>(job.cubemapData->facesRawData.front().size()));
 
         uint32_t cubemapId = 0;
         if (freeCubemapIds.size() > 0) {
@@ -661,20 +999,99 @@ namespace playground::rendering {
             cubemapId = cubemaps.size() - 1;
         }
 
-        auto uploadContext = frames[backBufferIndex]->UploadContext();
-        uploadContext->Upload(cubemap);
+        return cubemapId;
+    }
+
+    auto SetShadowSettings(const ShadowSettings& settings) -> void {
+        auto cascadeCount = shadowSettings.cascadeCount;
+        auto resolution = shadowSettings.resolution;
+
+        shadowSettings = settings;
+        // The maps are created when the renderer starts, a running one keeps their count and size
+        if (isRunning) {
+            shadowSettings.cascadeCount = cascadeCount;
+            shadowSettings.resolution = resolution;
+        }
+        else {
+            shadowSettings.cascadeCount = std::clamp<uint8_t>(settings.cascadeCount, 1, MAX_SHADOW_CASCADES);
+            shadowSettings.resolution = std::clamp<uint16_t>(settings.resolution, MIN_SHADOW_RES_DIRECTIONAL_LIGHT, MAX_SHADOW_RES_DIRECTIONAL_LIGHT);
+        }
+        shadowSettings.splitLambda = std::clamp(settings.splitLambda, 0.0f, 1.0f);
+    }
 
-        job.callback(job.handle, cubemapId);
+    auto GetShadowSettings() -> ShadowSettings {
+        return shadowSettings;
     }
 
-    auto SubmitFrame(RenderFrame frame) -> void {
-        if (!isRunning) {
-            return;
+    auto AcquireFrame() -> RenderFrame* {
+        RenderFrame* frame = nullptr;
+        if (!isRunning || !freeFramePackets.dequeue(frame)) {
+            return nullptr;
         }
 
+        frame->isDirty = false;
+        frame->drawCalls.clear();
+        for (auto& drawCalls : frame->shadowDrawCalls) {
+            drawCalls.clear();
+        }
+        frame->cameras.clear();
+        frame->cascadeCount = 0;
+        frame->pointLights.clear();
+        frame->spotLights.clear();
+        frame->instanceBuffer = nullptr;
+        frame->instanceCount = 0;
+        frame->staticDrawCalls.clear();
+        for (auto& drawCalls : frame->staticShadowDrawCalls) {
+            drawCalls.clear();
+        }
+        frame->staticInstanceBuffer = nullptr;
+        frame->staticInstanceCount = 0;
+        frame->staticPatches.clear();
+        frame->staticPatchData.clear();
+        frame->materials.clear();
+
+        return frame;
+    }
+
+    auto SubmitFrame(RenderFrame* frame) -> void {
+        // Material changes made up to now are drawn with this packet
+        materialConstants.TakeStaged(frame->materials);
+        // Running ahead is bounded by the packet count, AcquireFrame fails before this ring could fill up
         renderFrames.enqueue(frame);
     }
 
+    auto AcquireInstanceBuffer(uint32_t count) -> std::shared_ptr<InstanceBuffer> {
+        if (!isRunning || device == nullptr) {
+            return nullptr;
+        }
+
+        // Grow the size of new buffers until the request fits, pooled ones that are too small get dropped below
+        auto capacity = instanceBufferCapacity.load();
+        while (capacity < count) {
+            capacity *= INSTANCE_BUFFER_GROWTH;
+        }
+        instanceBufferCapacity.store(std::max(capacity, instanceBufferCapacity.load()));
+
+        std::shared_ptr<InstanceBuffer> buffer;
+        while (freeInstanceBuffers.try_dequeue(buffer)) {
+            if (buffer->Size() >= count) {
+                break;
+            }
+
+            buffer = nullptr;
+        }
+
+        if (buffer == nullptr) {
+            ZoneScopedN("Rendering: Create Instance Buffer");
+            buffer = device->CreateInstanceBuffer(capacity, sizeof(ObjectBuffer));
+        }
+
+        // The handed out pointer shares nothing with the pooled one, dropping its last copy returns the buffer to the pool
+        return std::shared_ptr<InstanceBuffer>(buffer.get(), [pooled = std::move(buffer)](InstanceBuffer*) mutable {
+            freeInstanceBuffers.enqueue(std::move(pooled));
+        });
+    }
+
     double GetGPUFrameTime() {
         return deltaTime;
     }
@@ -694,6 +1111,8 @@ namespace playground::rendering {
         }
 
         material->id = materialId;
+        // A reused id must not keep the constants of the material that had it before
+        materialConstants.Update(*material);
         job.callback(job.handle, materialId);
     }
 
@@ -743,6 +1162,7 @@ namespace playground::rendering {
         }
 
         material->textures[slot] = textures[textureId]->ID();
+        materialConstants.Update(*material);
     }
 
     void SetMaterialCubemap(uint32_t materialId, uint8_t slot, uint32_t cubemapId) {
@@ -755,6 +1175,7 @@ namespace playground::rendering {
             material->cubemaps.resize(material->cubemaps.size() + 1);
         }
         material->cubemaps[slot] = cubemaps[cubemapId]->ID();
+        materialConstants.Update(*material);
     }
 
     void SetMaterialFloat(uint32_t materialId, uint8_t slot, float value) {
@@ -763,6 +1184,7 @@ namespace playground::rendering {
             material->floats.resize(material->floats.size() + 1);
         }
         material->floats[slot] = value;
+        materialConstants.Update(*material);
     }
 
     void SetupBuiltinAssets() {
@@ -0,0 +1,54 @@
+#include "rendering/ShadowCascades.hxx"
+#include <math/Math.hxx>
+#include <algorithm>
+#include <cmath>
+
+namespace playground::rendering {
+    void ComputeCascadeSplits(float nearPlane, float farPlane, uint8_t count, float lambda, float* splits) {
+        nearPlane = std::max(nearPlane, 0.001f);
+        farPlane = std::max(farPlane, nearPlane);
+
+        for (uint8_t x = 0; x < count; x++) {
+            float t = static_cast<float>(x + 1) / count;
+            float logarithmic = nearPlane * std::pow(farPlane / nearPlane, t);
+            float uniform = nearPlane + (farPlane - nearPlane) * t;
+
+            splits[x] = lambda * logarithmic + (1.0f - lambda) * uniform;
+        }
+    }
+
+    ShadowCascade FitCascade(const Camera& camera, float splitNear, float splitFar, const math::Vector3& lightDirection, uint32_t resolution, float casterDistance) {
+        float tanY = std::tan(math::DegreesToRadians(camera.FOV) * 0.5f);
+        float tanX = tanY * camera.AspectRatio;
+        float slope = tanX * tanX + tanY * tanY;
+
+        // The slice is symmetric around the view axis, the smallest sphere holding both corner rings is centered on it
+        float centerDepth = std::min((splitNear + splitFar) * 0.5f * (1.0f + slope), splitFar);
+        float radius = std::sqrt((splitFar - centerDepth) * (splitFar - centerDepth) + splitFar * splitFar * slope);
+        // Rounding keeps float noise from changing the texel size frame to frame
+        radius = std::ceil(radius * 16.0f) / 16.0f;
+
+        auto center = camera.Position + (camera.Rotation * math::Vector3(0, 0, 1)) * centerDepth;
+
+        math::Vector3 lightDir = lightDirection.Normalise();
+        math::Vector3 up = std::fabs(lightDir.Y) > 0.99f ? math::Vector3(0, 0, 1) : math::Vector3(0, 1, 0);
+        math::Vector3 right = up.Cross(lightDir).Normalise();
+        math::Vector3 lightUp = lightDir.Cross(right);
+
+        // Moving the center in whole texels across the light's plane moves the rasterized casters by whole texels too
+        float texelSize = radius * 2.0f / static_cast<float>(std::max(resolution, 1u));
+        float x = std::floor(right.Dot(center) / texelSize) * texelSize;
+        float y = std::floor(lightUp.Dot(center) / texelSize) * texelSize;
+        center = right * x + lightUp * y + lightDir * lightDir.Dot(center);
+
+        auto eye = center - lightDir * (radius + casterDistance);
+
+        ShadowCascade cascade;
+        math::LookAtLH(eye, center, up, &cascade.viewMatrix);
+        // A zero near plane keeps the matrix free of a translation term, the eye is pulled back instead
+        cascade.projectionMatrix = math::Matrix4x4::OrthographicOffCenter(-radius, radius, -radius, radius, 0.0f, radius * 2.0f + casterDistance);
+        cascade.splitDistance = splitFar;
+
+        return cascade;
+    }
+}
@@ -0,0 +1,350 @@
+#include "rendering/StateTrackingGraphicsContext.hxx"
+
+namespace playground::rendering {
+    /// Drops redundant binds within one chunk, a chunk starts with nothing bound
+    class StateTrackingRenderPassChunk : public RenderPassChunk {
+    public:
+        auto Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void override {
+            _chunk->Draw(numIndices, startIndex, startVertex, numInstances, startInstance);
+        }
+
+        auto BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void override {
+            if (Track<const VertexBuffer*>(_vertexBuffer, buffer.get())) {
+                _chunk->BindVertexBuffer(buffer);
+            }
+        }
+
+        auto BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void override {
+            if (Track<const IndexBuffer*>(_indexBuffer, buffer.get())) {
+                _chunk->BindIndexBuffer(buffer);
+            }
+        }
+
+        auto BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void override {
+            if (Track<const InstanceBuffer*>(_instanceBuffer, buffer.get())) {
+                _chunk->BindInstanceBuffer(buffer);
+            }
+        }
+
+        auto BindMaterial(std::shared_ptr<Material> material) -> void override {
+            if (_isShadowPipeline) {
+                _pipelineMaterial = nullptr;
+                _isShadowPipeline = false;
+            }
+
+            if (Track<const Material*>(_pipelineMaterial, material.get())) {
+                _chunk->BindMaterial(material);
+            }
+        }
+
+        auto BindShadowMaterial(std::shared_ptr<Material> material) -> void override {
+            if (!_isShadowPipeline) {
+                _pipelineMaterial = nullptr;
+                _isShadowPipeline = true;
+            }
+
+            if (Track<const Material*>(_pipelineMaterial, material.get())) {
+                _chunk->BindShadowMaterial(material);
+            }
+        }
+
+        auto Finish() -> void override {
+            _chunk->Finish();
+        }
+
+        auto Reset(std::shared_ptr<RenderPassChunk> chunk) -> void {
+            _chunk = std::move(chunk);
+            _stats = {};
+            _vertexBuffer = nullptr;
+            _indexBuffer = nullptr;
+            _instanceBuffer = nullptr;
+            _pipelineMaterial = nullptr;
+            _isShadowPipeline = false;
+        }
+
+        auto Inner() const -> const std::shared_ptr<RenderPassChunk>& {
+            return _chunk;
+        }
+
+        auto Stats() const -> const StateTrackingStats& {
+            return _stats;
+        }
+
+    private:
+        std::shared_ptr<RenderPassChunk> _chunk;
+        StateTrackingStats _stats = {};
+        const VertexBuffer* _vertexBuffer = nullptr;
+        const IndexBuffer* _indexBuffer = nullptr;
+        const InstanceBuffer* _instanceBuffer = nullptr;
+        const Material* _pipelineMaterial = nullptr;
+        bool _isShadowPipeline = false;
+
+        template<typename T>
+        auto Track(T& bound, T value) -> bool {
+            if (bound == value) {
+                _stats.skippedBinds++;
+                return false;
+            }
+
+            bound = value;
+            _stats.issuedBinds++;
+            return true;
+        }
+    };
+
+    StateTrackingGraphicsContext::StateTrackingGraphicsContext(std::shared_ptr<GraphicsContext> context) : _context(std::move(context)) {
+    }
+
+    auto StateTrackingGraphicsContext::Begin() -> void {
+        _context->Begin();
+        _stats = {};
+        _recording++;
+        _usedChunks = 0;
+        ResetBindings();
+    }
+
+    auto StateTrackingGraphicsContext::BeginRenderPass(RenderPass pass, std::shared_ptr<RenderTarget> colour, std::shared_ptr<DepthBuffer> depth) -> void {
+        _context->BeginRenderPass(pass, colour, depth);
+        ResetBindings();
+    }
+
+    auto StateTrackingGraphicsContext::EndRenderPass() -> void {
+        _context->EndRenderPass();
+        ResetBindings();
+    }
+
+    auto StateTrackingGraphicsContext::Finish() -> void {
+        _context->Finish();
+    }
+
+    auto StateTrackingGraphicsContext::WaitFor(const Context& other) -> void {
+        _context->WaitFor(other);
+    }
+
+    auto StateTrackingGraphicsContext::Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void {
+        _context->Draw(numIndices, startIndex, startVertex, numInstances, startInstance);
+    }
+
+    auto StateTrackingGraphicsContext::Draw(uint32_t numVertices) -> void {
+        _context->Draw(numVertices);
+    }
+
+    auto StateTrackingGraphicsContext::AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void {
+        _context->AcquireChunks(count, _innerChunks);
+
+        chunks.clear();
+        for (auto& inner : _innerChunks) {
+            if (_usedChunks == _chunks.size()) {
+                _chunks.push_back(std::make_shared<StateTrackingRenderPassChunk>());
+            }
+
+            auto& chunk = _chunks[_usedChunks++];
+            chunk->Reset(inner);
+            chunks.push_back(chunk);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void {
+        _innerChunks.clear();
+        for (const auto& chunk : chunks) {
+            auto tracked = std::static_pointer_cast<StateTrackingRenderPassChunk>(chunk);
+            _innerChunks.push_back(tracked->Inner());
+            _stats.issuedBinds += tracked->Stats().issuedBinds;
+            _stats.skippedBinds += tracked->Stats().skippedBinds;
+        }
+
+        _context->SubmitChunks(_innerChunks);
+        _innerChunks.clear();
+
+        // Whatever the chunks bound last is bound now, which is unknown here
+        _vertexBuffer = nullptr;
+        _indexBuffer = nullptr;
+        _instanceBuffer = nullptr;
+        _pipelineMaterial = nullptr;
+        _isShadowPipeline = false;
+    }
+
+    auto StateTrackingGraphicsContext::BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
+        if (Track<const VertexBuffer*>(_vertexBuffer, buffer.get())) {
+            _context->BindVertexBuffer(buffer);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void {
+        if (Track<const IndexBuffer*>(_indexBuffer, buffer.get())) {
+            _context->BindIndexBuffer(buffer);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void {
+        if (Track<const InstanceBuffer*>(_instanceBuffer, buffer.get())) {
+            _context->BindInstanceBuffer(buffer);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::BindCamera(uint8_t index) -> void {
+        if (Track(_camera, index)) {
+            // Cascades and cameras both provide the view, binding one invalidates the other
+            _shadowCascade = UNBOUND;
+            _context->BindCamera(index);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::BindShadowCascade(uint8_t index) -> void {
+        if (Track(_shadowCascade, index)) {
+            _camera = UNBOUND;
+            _context->BindShadowCascade(index);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void {
+        _context->SetCameraData(cameras);
+    }
+
+    auto StateTrackingGraphicsContext::SetShadowCastersData(std::vector<ShadowCaster>& shadowCasters) -> void {
+        _context->SetShadowCastersData(shadowCasters);
+    }
+
+    auto StateTrackingGraphicsContext::SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void {
+        _context->SetLightData(clusters, pointLights, pointCount, spotLights, spotCount);
+    }
+
+    auto StateTrackingGraphicsContext::BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void {
+        _context->BindHeaps(std::move(heaps));
+    }
+
+    auto StateTrackingGraphicsContext::BindMaterial(std::shared_ptr<Material> material) -> void {
+        if (_isShadowPipeline) {
+            _pipelineMaterial = nullptr;
+            _isShadowPipeline = false;
+        }
+
+        if (Track<const Material*>(_pipelineMaterial, material.get())) {
+            _context->BindMaterial(material);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::BindShadowMaterial(std::shared_ptr<Material> material) -> void {
+        if (!_isShadowPipeline) {
+            _pipelineMaterial = nullptr;
+            _isShadowPipeline = true;
+        }
+
+        if (Track<const Material*>(_pipelineMaterial, material.get())) {
+            _context->BindShadowMaterial(material);
+        }
+    }
+
+    auto StateTrackingGraphicsContext::BindSRVHeapToSlot(std::shared_ptr<Heap> heap, uint8_t slot) -> void {
+        _context->BindSRVHeapToSlot(heap, slot);
+    }
+
+    auto StateTrackingGraphicsContext::BindSampler(std::shared_ptr<Sampler> sampler, uint8_t slot) -> void {
+        _context->BindSampler(sampler, slot);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void {
+        _context->TransitionIndexBuffer(buffer);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
+        _context->TransitionVertexBuffer(buffer);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionTexture(std::shared_ptr<Texture> texture) -> void {
+        _context->TransitionTexture(texture);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionCubemap(std::shared_ptr<Cubemap> cubemap) -> void {
+        _context->TransitionCubemap(cubemap);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionShadowMapToDepthWrite(std::shared_ptr<ShadowMap> map) -> void {
+        _context->TransitionShadowMapToDepthWrite(map);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionShadowMapToPixelShader(std::shared_ptr<ShadowMap> map) -> void {
+        _context->TransitionShadowMapToPixelShader(map);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionDepthBufferToDepthWrite(std::shared_ptr<DepthBuffer> depth) -> void {
+        _context->TransitionDepthBufferToDepthWrite(depth);
+    }
+
+    auto StateTrackingGraphicsContext::TransitionDepthBufferToPixelShader(std::shared_ptr<DepthBuffer> depth) -> void {
+        _context->TransitionDepthBufferToPixelShader(depth);
+    }
+
+    auto StateTrackingGraphicsContext::CopyToSwapchainBackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<Swapchain> swapchain) -> void {
+        _context->CopyToSwapchainBackBuffer(source, swapchain);
+    }
+
+    auto StateTrackingGraphicsContext::CopyToReadbackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<ReadbackBuffer> target) -> void {
+        _context->CopyToReadbackBuffer(source, target);
+    }
+
+    auto StateTrackingGraphicsContext::SetMaterialData(std::shared_ptr<Material> material) -> void {
+        // Materials only change between frames, the constants written earlier in this recording are still current
+        if (material->id >= _materialRecordings.size()) {
+            _materialRecordings.resize(material->id + 1, 0);
+        }
+        else if (_materialRecordings[material->id] == _recording) {
+            _stats.skippedMaterialUploads++;
+            return;
+        }
+
+        _materialRecordings[material->id] = _recording;
+        _stats.issuedMaterialUploads++;
+        _context->SetMaterialData(material);
+    }
+
+    auto StateTrackingGraphicsContext::SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void {
+        _context->SetMaterialsData(data, first, count);
+    }
+
+    auto StateTrackingGraphicsContext::SetDirectionalLight(DirectionalLight& light) -> void {
+        _context->SetDirectionalLight(light);
+    }
+
+    auto StateTrackingGraphicsContext::SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void {
+        _context->SetShadowCascades(cascades, count);
+    }
+
+    auto StateTrackingGraphicsContext::SetViewport(
+        uint32_t startX,
+        uint32_t startY,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depthStart,
+        uint32_t depthEnd
+    ) -> void {
+        _context->SetViewport(startX, startY, width, height, depthStart, depthEnd);
+    }
+
+    auto StateTrackingGraphicsContext::SetScissor(
+        uint32_t left,
+        uint32_t top,
+        uint32_t right,
+        uint32_t bottom
+    ) -> void {
+        _context->SetScissor(left, top, right, bottom);
+    }
+
+    auto StateTrackingGraphicsContext::SetResolution(uint32_t width, uint32_t height) -> void {
+        _context->SetResolution(width, height);
+    }
+
+    auto StateTrackingGraphicsContext::MouseOverID() -> uint64_t {
+        return _context->MouseOverID();
+    }
+
+    auto StateTrackingGraphicsContext::ResetBindings() -> void {
+        _vertexBuffer = nullptr;
+        _indexBuffer = nullptr;
+        _instanceBuffer = nullptr;
+        _pipelineMaterial = nullptr;
+        _isShadowPipeline = false;
+        _camera = UNBOUND;
+        _shadowCascade = UNBOUND;
+    }
+}
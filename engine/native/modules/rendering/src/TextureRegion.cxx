@@ -0,0 +1,40 @@
+#include "rendering/TextureRegion.hxx"
+#include <algorithm>
+#include <cstring>
+
+namespace playground::rendering {
+    auto SplitTexture(uint32_t width, uint32_t height, uint32_t mipCount, uint32_t faceCount, uint64_t maxBytes) -> std::vector<TextureRegion> {
+        std::vector<TextureRegion> regions;
+
+        for (uint32_t face = 0; face < faceCount; face++) {
+            for (uint32_t mip = 0; mip < mipCount; mip++) {
+                auto rowBytes = TextureRowBytes(std::max(width >> mip, 1u));
+                auto rowCount = TextureRowCount(std::max(height >> mip, 1u));
+                auto rowPitch = (rowBytes + TEXTURE_ROW_PITCH_ALIGNMENT - 1) & ~(TEXTURE_ROW_PITCH_ALIGNMENT - 1);
+                auto rowsPerRegion = static_cast<uint32_t>(std::max<uint64_t>(maxBytes / rowPitch, 1));
+
+                for (uint32_t first = 0; first < rowCount; first += rowsPerRegion) {
+                    regions.push_back(TextureRegion{
+                        .subresource = face * mipCount + mip,
+                        .firstRow = first,
+                        .rowCount = std::min(rowsPerRegion, rowCount - first),
+                        .rowBytes = rowBytes,
+                        .rowPitch = rowPitch,
+                    });
+                }
+            }
+        }
+
+        return regions;
+    }
+
+    auto StageTextureRegion(const uint8_t* source, size_t sourceSize, const TextureRegion& region, uint8_t* staging) -> void {
+        for (uint32_t row = 0; row < region.rowCount; row++) {
+            auto offset = static_cast<size_t>(region.firstRow + row) * region.rowBytes;
+            // Rows missing from a short source stay as they were, the copy never reads past it
+            if (offset < sourceSize) {
+                std::memcpy(staging + static_cast<size_t>(row) * region.rowPitch, source + offset, std::min<size_t>(region.rowBytes, sourceSize - offset));
+            }
+        }
+    }
+}
@@ -0,0 +1,130 @@
+#include "rendering/UploadScheduler.hxx"
+#include <stdexcept>
+
+namespace playground::rendering {
+    auto StagingRing::Allocate(uint64_t size, uint64_t fence) -> uint64_t {
+        size = (size + _alignment - 1) / _alignment * _alignment;
+        if (size > _capacity - _used) {
+            return INVALID_OFFSET;
+        }
+
+        if (_blocks.empty()) {
+            _head = 0;
+        }
+
+        uint64_t offset = _head;
+        if (!_blocks.empty()) {
+            auto tail = _blocks.front().offset;
+            // Head before tail, the free space is the gap between them
+            if (_head < tail) {
+                if (tail - _head < size) {
+                    return INVALID_OFFSET;
+                }
+            }
+            else if (_capacity - _head < size) {
+                // Doesn't fit at the end, the rest of the ring is skipped and the reservation starts over at the beginning
+                if (tail < size) {
+                    return INVALID_OFFSET;
+                }
+
+                if (_head < _capacity) {
+                    _blocks.push_back(Block{ _head, _capacity - _head, fence });
+                    _used += _capacity - _head;
+                }
+                offset = 0;
+            }
+        }
+
+        if (size > 0) {
+            _blocks.push_back(Block{ offset, size, fence });
+            _used += size;
+        }
+        _head = offset + size;
+
+        return offset;
+    }
+
+    auto StagingRing::Reclaim(uint64_t completedFence) -> void {
+        while (!_blocks.empty() && _blocks.front().fence <= completedFence) {
+            _used -= _blocks.front().size;
+            _blocks.pop_front();
+        }
+    }
+
+    auto UploadScheduler::Enqueue(UploadJob job) -> void {
+        if (job.staged) {
+            for (auto size : job.parts) {
+                if (size > _ring.Capacity()) {
+                    throw std::invalid_argument("Staged upload part is larger than the staging ring");
+                }
+            }
+        }
+
+        auto priority = static_cast<size_t>(job.priority);
+        _queues[priority].push_back(QueuedJob{ std::move(job), 0 });
+    }
+
+    auto UploadScheduler::BeginFrame(uint64_t fence, uint64_t completedFence) -> void {
+        _fence = fence;
+        _ring.Reclaim(completedFence);
+
+        while (!_completing.empty() && _completing.front().fence <= completedFence) {
+            auto onComplete = std::move(_completing.front().onComplete);
+            _completing.pop_front();
+
+            if (onComplete) {
+                onComplete();
+            }
+        }
+    }
+
+    auto UploadScheduler::Run(const UploadBudget& budget) -> UploadFrameStats {
+        auto start = std::chrono::steady_clock::now();
+        UploadFrameStats stats;
+
+        for (auto& queue : _queues) {
+            while (!queue.empty()) {
+                auto& queued = queue.front();
+                auto& parts = queued.job.parts;
+
+                while (queued.nextPart < parts.size()) {
+                    auto size = parts[queued.nextPart];
+                    if (stats.parts > 0) {
+                        bool overBytes = stats.bytes + size > budget.bytes;
+                        bool overTime = std::chrono::steady_clock::now() - start >= budget.time;
+                        if (overBytes || overTime) {
+                            return stats;
+                        }
+                    }
+
+                    auto offset = StagingRing::INVALID_OFFSET;
+                    if (queued.job.staged) {
+                        offset = _ring.Allocate(size, _fence);
+                        if (offset == StagingRing::INVALID_OFFSET) {
+                            return stats;
+                        }
+                    }
+
+                    queued.job.upload(queued.nextPart, offset);
+                    queued.nextPart++;
+                    stats.bytes += size;
+                    stats.parts++;
+                }
+
+                _completing.push_back(CompletingJob{ std::move(queued.job.onComplete), _fence });
+                queue.pop_front();
+            }
+        }
+
+        return stats;
+    }
+
+    auto UploadScheduler::Queued() const -> size_t {
+        size_t count = 0;
+        for (const auto& queue : _queues) {
+            count += queue.size();
+        }
+
+        return count;
+    }
+}
@@ -29,6 +29,9 @@ namespace playground::rendering::d3d12
         case CommandListType::Transfer:
             listType = D3D12_COMMAND_LIST_TYPE_COPY;
             break;
+        case CommandListType::Bundle:
+            listType = D3D12_COMMAND_LIST_TYPE_BUNDLE;
+            break;
         }
 
         if (FAILED(device->CreateCommandAllocator(listType, IID_PPV_ARGS(&_commandAllocator))))
@@ -37,6 +37,9 @@ namespace playground::rendering::d3d12 {
 			case CommandListType::Transfer:
 				listType = D3D12_COMMAND_LIST_TYPE_COPY;
 				break;
+			case CommandListType::Bundle:
+				listType = D3D12_COMMAND_LIST_TYPE_BUNDLE;
+				break;
 		}
 
         ComPtr<ID3D12CommandAllocator> commandAllocator;
@@ -76,7 +79,8 @@ namespace playground::rendering::d3d12 {
 
 	auto D3D12CommandList::Begin() -> void
 	{
-        if (_type == CommandListType::Graphics) {
+        // Bundles have to set the same heaps as the list executing them
+        if (_type == CommandListType::Graphics || _type == CommandListType::Bundle) {
             // Automatically bind the descriptor heaps
             auto heaps = _device->GetDescriptorHeaps();
             _list->SetDescriptorHeaps(heaps.size(), heaps.data());
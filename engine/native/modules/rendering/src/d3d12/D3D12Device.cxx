@@ -14,6 +14,7 @@
 #include <map>
 #include <iostream>
 #include "rendering/Constants.hxx"
+#include "rendering/LightClusters.hxx"
 #include "rendering/d3d12/D3D12Material.hxx"
 #include "rendering/d3d12/D3D12Device.hxx"
 #include "rendering/d3d12/D3D12GraphicsContext.hxx"
@@ -34,6 +35,7 @@
 #include "rendering/d3d12/D3D12Texture.hxx"
 #include "rendering/d3d12/D3D12Sampler.hxx"
 #include "rendering/d3d12/D3D12Cubemap.hxx"
+#include "rendering/d3d12/D3D12StagingBuffer.hxx"
 #include <shared/Logger.hxx>
 
 using namespace Microsoft::WRL;
@@ -102,11 +104,11 @@ namespace playground::rendering::d3d12 {
         // Create heaps
         // Start with one heap per type
         // 32 RTVS (2-3 for the back buffers and 30~ for render textures)
-        _rtvHeaps = std::make_unique<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, (uint16_t)RTVHeapResource::End);
+        _rtvHeaps = std::make_shared<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_RTV, (uint16_t)RTVHeapResource::End);
         // Use chunks of 512 entries per shader heap
-        _srvHeaps = std::make_unique<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, (uint16_t)SRVHeapResource::End);
+        _srvHeaps = std::make_shared<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, (uint16_t)SRVHeapResource::End);
         // 128 Depth stencils are enough for any type of render pipeline
-        _dsvHeaps = std::make_unique<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, (uint16_t)DSVHeapResource::End);
+        _dsvHeaps = std::make_shared<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_DSV, (uint16_t)DSVHeapResource::End);
 
         // Create sampler heap
         // 6 Samplers:
@@ -116,7 +118,7 @@ namespace playground::rendering::d3d12 {
         // - Linear Wrap
         // - Anisotropic Clamp
         // - Anisotropic Wrap
-        _samplerHeaps = std::make_unique<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, (uint16_t)SamplerHeapResource::End);
+        _samplerHeaps = std::make_shared<D3D12HeapManager>(_device, D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER, (uint16_t)SamplerHeapResource::End);
 
         _skyboxRootSignature = CreateSkyboxRootSignature();
         _rootSignature = CreateRootSignature();
@@ -289,7 +291,7 @@ namespace playground::rendering::d3d12 {
 
         auto nextHandle = _rtvHeaps->NextHandle(RTVHeapResource::RenderTargetView);
 
-        _device->CreateRenderTargetView(rtv.Get(), nullptr, nextHandle->GetCPUHandle());
+        _device->CreateRenderTargetView(rtv.Get(), nullptr, nextHandle.cpu);
 
         rtv->SetName(std::wstring(name.begin(), name.end()).c_str());
 
@@ -303,9 +305,9 @@ namespace playground::rendering::d3d12 {
         srvDesc.Texture2D.ResourceMinLODClamp = 0.0f;
 
         auto handleSrv = _srvHeaps->NextHandle(SRVHeapResource::FrameBuffer);
-        _device->CreateShaderResourceView(rtv.Get(), &srvDesc, handleSrv->GetCPUHandle());
+        _device->CreateShaderResourceView(rtv.Get(), &srvDesc, handleSrv.cpu);
 
-        return std::make_shared<D3D12RenderTarget>(rtv, nextHandle->GetCPUHandle(), handleSrv);
+        return std::make_shared<D3D12RenderTarget>(rtv, nextHandle.cpu, handleSrv);
     }
 
     auto D3D12Device::CreateDepthBuffer(
@@ -358,10 +360,10 @@ namespace playground::rendering::d3d12 {
         dsvDescReadonly.ViewDimension = D3D12_DSV_DIMENSION_TEXTURE2D;
         dsvDescReadonly.Flags = D3D12_DSV_FLAG_READ_ONLY_DEPTH;
 
-        _device->CreateDepthStencilView(depthBuffer.Get(), &dsvDesc, nextHandle->GetCPUHandle());
+        _device->CreateDepthStencilView(depthBuffer.Get(), &dsvDesc, nextHandle.cpu);
 
         auto readOnlyHandle = _dsvHeaps->NextHandle(DSVHeapResource::DepthStencilView);
-        _device->CreateDepthStencilView(depthBuffer.Get(), &dsvDescReadonly, readOnlyHandle->GetCPUHandle());
+        _device->CreateDepthStencilView(depthBuffer.Get(), &dsvDescReadonly, readOnlyHandle.cpu);
 
         D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
         srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
@@ -374,9 +376,9 @@ namespace playground::rendering::d3d12 {
 
         auto handleSrv = _srvHeaps->NextHandle(SRVHeapResource::DepthBuffer);
 
-        _device->CreateShaderResourceView(depthBuffer.Get(), &srvDesc, handleSrv->GetCPUHandle());
+        _device->CreateShaderResourceView(depthBuffer.Get(), &srvDesc, handleSrv.cpu);
 
-        return std::make_shared<D3D12DepthBuffer>(depthBuffer, nextHandle->GetCPUHandle(), readOnlyHandle->GetCPUHandle(), handleSrv);
+        return std::make_shared<D3D12DepthBuffer>(depthBuffer, nextHandle.cpu, readOnlyHandle.cpu, handleSrv);
     }
 
     auto D3D12Device::CreateMaterial(std::string vertexShader, std::string pixelShader, MaterialType type) -> std::shared_ptr<Material>
@@ -456,12 +458,7 @@ namespace playground::rendering::d3d12 {
             { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 40, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
             { "INSTANCE_TRANSFORM", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
             { "INSTANCE_TRANSFORM", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 64, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 80, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 96, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 112, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 }
+            { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 }
         };
 
         psoDesc.InputLayout = { inputLayout, _countof(inputLayout) };
@@ -525,12 +522,7 @@ namespace playground::rendering::d3d12 {
             { "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 40, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
             { "INSTANCE_TRANSFORM", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
             { "INSTANCE_TRANSFORM", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_TRANSFORM", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 64, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 80, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 96, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 },
-            { "INSTANCE_NORMALS", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 112, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 }
+            { "INSTANCE_TRANSFORM", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA, 1 }
         };
 
         psoDesc.InputLayout = { inputLayout, _countof(inputLayout) };
@@ -679,23 +671,27 @@ namespace playground::rendering::d3d12 {
 
     }
 
-    auto D3D12Device::CreateTexture(uint32_t width, uint32_t height, std::vector<std::vector<uint8_t>> mips, Allocator& allocator) -> std::shared_ptr<Texture> {
-        return std::make_shared<D3D12Texture>(_device, width, height, std::move(mips), _srvHeaps->NextHandle(SRVHeapResource::Texture2D), allocator);
+    auto D3D12Device::CreateStagingBuffer(uint64_t size) -> std::shared_ptr<StagingBuffer> {
+        return std::make_shared<D3D12StagingBuffer>(_device, size);
     }
 
-    auto D3D12Device::CreateCubemap(uint32_t width, uint32_t height, std::vector<std::vector<std::vector<uint8_t>>> faces, Allocator& allocator) -> std::shared_ptr<Cubemap> {
-        return std::make_shared<D3D12Cubemap>(_device, width, height, faces, _srvHeaps->NextHandle(SRVHeapResource::TextureCube), allocator);
+    auto D3D12Device::CreateTexture(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Texture> {
+        return std::make_shared<D3D12Texture>(_device, width, height, mipCount, _srvHeaps->NextHandle(SRVHeapResource::Texture2D), _srvHeaps);
+    }
+
+    auto D3D12Device::CreateCubemap(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Cubemap> {
+        return std::make_shared<D3D12Cubemap>(_device, width, height, mipCount, _srvHeaps->NextHandle(SRVHeapResource::TextureCube), _srvHeaps);
     }
 
     auto D3D12Device::CreateSampler(TextureFiltering filtering, TextureWrapping wrapping) -> std::shared_ptr<Sampler> {
-        return std::make_shared<D3D12TextureSampler>(_device, _samplerHeaps->NextHandle(SamplerHeapResource::Sampler), filtering, wrapping);
+        return std::make_shared<D3D12TextureSampler>(_device, _samplerHeaps->NextHandle(SamplerHeapResource::Sampler), _samplerHeaps, filtering, wrapping);
     }
 
     auto D3D12Device::CreateShadowMap(uint32_t width, uint32_t height, std::string name)->std::shared_ptr<ShadowMap> {
         auto dsvHandle = _dsvHeaps->NextHandle(DSVHeapResource::ShadowMapDSV);
         auto srvHandle = _srvHeaps->NextHandle(SRVHeapResource::ShadowMap);
 
-        return std::make_shared<D3D12ShadowMap>(GetDevice(), dsvHandle, srvHandle, width, height, name);
+        return std::make_shared<D3D12ShadowMap>(GetDevice(), dsvHandle, srvHandle, _dsvHeaps, _srvHeaps, width, height, name);
     }
 
     auto D3D12Device::CreateSwapchain(uint8_t bufferCount, uint16_t width, uint16_t height, void* window) -> std::shared_ptr<Swapchain> {
@@ -714,8 +710,8 @@ namespace playground::rendering::d3d12 {
         auto handle = _srvHeaps->NextHandle(SRVHeapResource::ConstantBuffer);
         return std::make_shared<D3D12ConstantBuffer>(
             _device,
-            handle->GetCPUHandle(),
-            handle->GetGPUHandle(),
+            handle.cpu,
+            handle.gpu,
             _srvHeaps->Heap()->Native(),
             data,
             size,
@@ -729,8 +725,8 @@ namespace playground::rendering::d3d12 {
         auto handle = _srvHeaps->NextHandle(SRVHeapResource::StructuredBuffer);
         return std::make_shared<D3D12StructuredBuffer>(
             _device,
-            handle->GetCPUHandle(),
-            handle->GetGPUHandle(),
+            handle.cpu,
+            handle.gpu,
             _srvHeaps->Heap()->Native(),
             data,
             size,
@@ -811,13 +807,13 @@ namespace playground::rendering::d3d12 {
     }
 
     auto D3D12Device::CreateRootSignature() -> Microsoft::WRL::ComPtr<ID3D12RootSignature> {
-        std::array<CD3DX12_ROOT_PARAMETER, 9> rootParameters = {};
+        std::array<CD3DX12_ROOT_PARAMETER, 15> rootParameters = {};
 
         // Per-frame CBV (Camera, Lighting, Material props, etc.)
         rootParameters[GLOBALS_BUFFER_BINDING].InitAsConstantBufferView(GLOBALS_BUFFER_BINDING); // b0
         rootParameters[DIRECTIONAL_LIGHT_BUFFER_BINDING].InitAsConstantBufferView(DIRECTIONAL_LIGHT_BUFFER_BINDING); // b1
         rootParameters[CAMERA_BUFFER_BINDING].InitAsConstantBufferView(CAMERA_BUFFER_BINDING); // b2
-        rootParameters[MATERIAL_BUFFER_BINDING].InitAsConstantBufferView(MATERIAL_BUFFER_BINDING); // b3
+        rootParameters[MATERIAL_INDEX_BINDING].InitAsConstants(1, MATERIAL_INDEX_BINDING, 0); // b3
         rootParameters[SHADOW_CASTERS_COUNT_BINDING].InitAsConstants(1, SHADOW_CASTERS_COUNT_BINDING, 0); // b4
 
         uint16_t texturesCount = (uint16_t)SRVHeapResource::TextureCube;
@@ -838,6 +834,20 @@ namespace playground::rendering::d3d12 {
         CD3DX12_DESCRIPTOR_RANGE shadowMapsBuffer(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 3, 0);
         rootParameters[SHADOW_CASTERS_BUFFER_BINDING].InitAsDescriptorTable(1, &shadowMapsBuffer, D3D12_SHADER_VISIBILITY_PIXEL);
 
+        // Clustered local lights, spaces 4 to 7
+        rootParameters[CLUSTER_PARAMETERS_BINDING].InitAsConstants(sizeof(ClusterParameters) / sizeof(uint32_t), 5, 0, D3D12_SHADER_VISIBILITY_PIXEL); // b5
+        CD3DX12_DESCRIPTOR_RANGE lightClustersRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 4, 0);
+        rootParameters[LIGHT_CLUSTERS_BUFFER_BINDING].InitAsDescriptorTable(1, &lightClustersRange, D3D12_SHADER_VISIBILITY_PIXEL);
+        CD3DX12_DESCRIPTOR_RANGE lightIndicesRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 5, 0);
+        rootParameters[LIGHT_INDICES_BUFFER_BINDING].InitAsDescriptorTable(1, &lightIndicesRange, D3D12_SHADER_VISIBILITY_PIXEL);
+        CD3DX12_DESCRIPTOR_RANGE pointLightsRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 6, 0);
+        rootParameters[POINT_LIGHTS_BUFFER_BINDING].InitAsDescriptorTable(1, &pointLightsRange, D3D12_SHADER_VISIBILITY_PIXEL);
+        CD3DX12_DESCRIPTOR_RANGE spotLightsRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 7, 0);
+        rootParameters[SPOT_LIGHTS_BUFFER_BINDING].InitAsDescriptorTable(1, &spotLightsRange, D3D12_SHADER_VISIBILITY_PIXEL);
+        // Materials indexed by the id in b3, space 8
+        CD3DX12_DESCRIPTOR_RANGE materialsRange(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 8, 0);
+        rootParameters[MATERIALS_BUFFER_BINDING].InitAsDescriptorTable(1, &materialsRange, D3D12_SHADER_VISIBILITY_ALL);
+
         const CD3DX12_STATIC_SAMPLER_DESC pointClamp(
             0,
             D3D12_FILTER_COMPARISON_MIN_MAG_LINEAR_MIP_POINT,
@@ -1012,4 +1022,12 @@ namespace playground::rendering::d3d12 {
 
         CloseHandle(fenceEvent);
     }
+
+    auto D3D12Device::BeginFrame(uint64_t frame) -> void {
+        auto completedFrame = CompletedFrame(frame);
+        _rtvHeaps->BeginFrame(frame, completedFrame);
+        _srvHeaps->BeginFrame(frame, completedFrame);
+        _dsvHeaps->BeginFrame(frame, completedFrame);
+        _samplerHeaps->BeginFrame(frame, completedFrame);
+    }
 }
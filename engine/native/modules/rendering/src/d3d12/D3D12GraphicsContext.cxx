@@ -6,6 +6,7 @@
 #include <iostream>
 #include <sstream>
 #include "rendering/Context.hxx"
+#include "rendering/MaterialConstants.hxx"
 #include "rendering/ShadowCaster.hxx"
 #include "rendering/d3d12/D3D12GraphicsContext.hxx"
 #include "rendering/d3d12/D3D12GraphicsContext.hxx"
@@ -21,6 +22,7 @@
 #include "rendering/d3d12/D3D12Texture.hxx"
 #include "rendering/d3d12/D3D12UploadContext.hxx"
 #include "rendering/PointLight.hxx"
+#include "rendering/SpotLight.hxx"
 #include "rendering/DirectionalLight.hxx"
 #include <profiler/Profiler.hxx>
 #include <tracy/Tracy.hpp>
@@ -80,10 +82,15 @@ namespace playground::rendering::d3d12
         _cameraBuffer = std::static_pointer_cast<D3D12ConstantBuffer>(device->CreateConstantBuffer(nullptr, MAX_CAMERA_COUNT, sizeof(CameraBuffer), ConstantBuffer::BindingMode::RootCBV, name + "_CAMERA_BUFFER"));
 
         _pointLightsBuffer = std::static_pointer_cast<D3D12StructuredBuffer>(device->CreateStructuredBuffer(nullptr, MAX_POINT_LIGHTS, sizeof(PointLight), name + "_POINT_LIGHT_BUFFER"));
+        _spotLightsBuffer = std::static_pointer_cast<D3D12StructuredBuffer>(device->CreateStructuredBuffer(nullptr, MAX_SPOT_LIGHTS, sizeof(SpotLight), name + "_SPOT_LIGHT_BUFFER"));
+        _lightClustersBuffer = std::static_pointer_cast<D3D12StructuredBuffer>(device->CreateStructuredBuffer(nullptr, CLUSTER_COUNT, sizeof(LightCluster), name + "_LIGHT_CLUSTERS_BUFFER"));
+        _lightIndicesBuffer = std::static_pointer_cast<D3D12StructuredBuffer>(device->CreateStructuredBuffer(nullptr, MAX_LIGHT_INDICES, sizeof(uint32_t), name + "_LIGHT_INDICES_BUFFER"));
 
         _directionalLightBuffer = std::static_pointer_cast<D3D12ConstantBuffer>(device->CreateConstantBuffer(nullptr, 1, sizeof(DirectionalLight), ConstantBuffer::BindingMode::RootCBV, name + "_DIRECTIONAL_LIGHT_BUFFER"));
+        _shadowCascadeBuffer = std::static_pointer_cast<D3D12ConstantBuffer>(device->CreateConstantBuffer(nullptr, MAX_SHADOW_CASCADES, sizeof(DirectionalLight), ConstantBuffer::BindingMode::RootCBV, name + "_SHADOW_CASCADE_BUFFER"));
 
         _shadowCastersBuffer = std::static_pointer_cast<D3D12StructuredBuffer>(device->CreateStructuredBuffer(nullptr, MAX_SHADOW_MAPS_PER_FRAME, sizeof(ShadowCaster), name + "_SHADOW_CASTERS_BUFFER"));
+        _materialsBuffer = std::static_pointer_cast<D3D12StructuredBuffer>(device->CreateStructuredBuffer(nullptr, MAX_MATERIALS, MAX_MATERIAL_SIZE_BYTES, name + "_MATERIALS_BUFFER"));
 
 #if ENABLE_PROFILER
         _tracyCtx = ctx;
@@ -124,6 +131,7 @@ namespace playground::rendering::d3d12
         _transferCommandList->Begin();
         _postProcessingCommandList->Begin();
         _preperationCommandList->Begin();
+        _usedChunks = 0;
 
         _stackAllocator.arena->Reset();
     }
@@ -171,6 +179,7 @@ namespace playground::rendering::d3d12
         ZoneColor(tracy::Color::Orange2);
         _currentPassList->Native()->EndRenderPass();
         _currentPassList = nullptr;
+        _currentRootSignature = nullptr;
         PIXEndEvent();
     }
 
@@ -182,6 +191,34 @@ namespace playground::rendering::d3d12
         _currentPassList->Native()->DrawInstanced(numVertices, 1, 0, 0);
     }
 
+    auto D3D12GraphicsContext::AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void {
+        ZoneScopedN("RenderThread: Acquire Chunks");
+        ZoneColor(tracy::Color::Orange3);
+        assert(_currentRootSignature != nullptr && "Chunks need a pass that set a root signature");
+
+        while (_chunks.size() < _usedChunks + count) {
+            auto bundle = std::static_pointer_cast<D3D12CommandList>(
+                _device->CreateCommandList(CommandListType::Bundle, _name + "_CHUNK_" + std::to_string(_chunks.size()))
+            );
+            _chunks.push_back(std::make_shared<D3D12RenderPassChunk>(*this, bundle));
+        }
+
+        chunks.clear();
+        for (uint32_t x = 0; x < count; x++) {
+            auto& chunk = _chunks[_usedChunks++];
+            chunk->Begin(_currentRootSignature);
+            chunks.push_back(chunk);
+        }
+    }
+
+    auto D3D12GraphicsContext::SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void {
+        ZoneScopedN("RenderThread: Submit Chunks");
+        ZoneColor(tracy::Color::Orange3);
+        for (const auto& chunk : chunks) {
+            _currentPassList->Native()->ExecuteBundle(std::static_pointer_cast<D3D12RenderPassChunk>(chunk)->Native());
+        }
+    }
+
     auto D3D12GraphicsContext::BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
         _currentPassList->BindVertexBuffer(buffer, 0);
     }
@@ -201,6 +238,12 @@ namespace playground::rendering::d3d12
         _currentPassList->BindConstantBuffer(_cameraBuffer, CAMERA_BUFFER_BINDING, index);
     }
 
+    auto D3D12GraphicsContext::BindShadowCascade(uint8_t index) -> void {
+        ZoneScopedN("RenderThread: Bind Shadow Cascade");
+        ZoneColor(tracy::Color::Orange3);
+        _currentPassList->BindConstantBuffer(_shadowCascadeBuffer, 0, index);
+    }
+
     auto D3D12GraphicsContext::SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void {
         ZoneScopedN("RenderThread: Set Camera Data");
         ZoneColor(tracy::Color::Orange3);
@@ -214,6 +257,26 @@ namespace playground::rendering::d3d12
         _shadowCastersCount = shadowCasters.size();
     }
 
+    auto D3D12GraphicsContext::SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void {
+        ZoneScopedN("RenderThread: Set Light Data");
+        ZoneColor(tracy::Color::Orange3);
+
+        pointCount = std::min<size_t>(pointCount, MAX_POINT_LIGHTS);
+        spotCount = std::min<size_t>(spotCount, MAX_SPOT_LIGHTS);
+        _pointLightsBuffer->SetData(pointLights, pointCount, 0, sizeof(PointLight) * pointCount);
+        _spotLightsBuffer->SetData(spotLights, spotCount, 0, sizeof(SpotLight) * spotCount);
+
+        // Without a full grid the shaders skip local lights altogether
+        if (clusters.clusters.size() != CLUSTER_COUNT) {
+            _clusterParameters = {};
+            return;
+        }
+
+        _lightClustersBuffer->SetData(clusters.clusters.data(), CLUSTER_COUNT, 0, sizeof(LightCluster) * CLUSTER_COUNT);
+        _lightIndicesBuffer->SetData(clusters.indices.data(), clusters.indices.size(), 0, sizeof(uint32_t) * clusters.indices.size());
+        _clusterParameters = clusters.parameters;
+    }
+
     auto D3D12GraphicsContext::BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void {
         eastl::vector<ID3D12DescriptorHeap*, StackAllocator> lists(_stackAllocator);
 
@@ -228,9 +291,23 @@ namespace playground::rendering::d3d12
         auto list = _currentPassList->Native();
         auto dxMat = std::static_pointer_cast<D3D12Material>(material);
         list->SetPipelineState(dxMat->pso.Get());
+
+        // Opaque materials live in the materials buffer, the shaders only need the id
+        if (material->type == MaterialType::Standard) {
+            list->SetGraphicsRoot32BitConstant(MATERIAL_INDEX_BINDING, MaterialConstants::Slot(material->id), 0);
+            return;
+        }
+
         list->SetGraphicsRootConstantBufferView(MATERIAL_BUFFER_BINDING, _materialBuffers[material->id]->GPUAdress(0));
     }
 
+    auto D3D12GraphicsContext::MaterialBufferAddress(uint32_t id) const -> D3D12_GPU_VIRTUAL_ADDRESS {
+        auto buffer = _materialBuffers.find(id);
+        assert(buffer != _materialBuffers.end() && "Material has no constants. Did you forget to call SetMaterialData?");
+
+        return buffer->second->GPUAdress(0);
+    }
+
     auto D3D12GraphicsContext::BindShadowMaterial(std::shared_ptr<Material> material) -> void {
         auto list = _currentPassList->Native();
         auto dxMat = std::static_pointer_cast<D3D12Material>(material);
@@ -458,31 +535,12 @@ namespace playground::rendering::d3d12
         _transferCommandList->Native()->ResourceBarrier(1, &renderTargetBarrier);
     }
 
-    template< typename T>
-    void Push(std::vector<uint8_t>& dst, T& value) {
-        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(&value);
-        dst.insert(dst.end(), ptr, ptr + sizeof(T));
-    }
-
     auto D3D12GraphicsContext::SetMaterialData(std::shared_ptr<Material> material) -> void {
         ZoneScopedN("RenderThread: Set Material Data");
         ZoneColor(tracy::Color::Orange3);
 
-        std::vector<uint8_t> data;
-
-        // Push the textures
-        for (const auto texture : material->textures) {
-            Push(data, texture);
-        }
-
-        // Push the cubemaps
-        for (const auto cubemap : material->cubemaps) {
-            Push(data, cubemap);
-        }
-
-        for(const auto floatProp: material->floats) {
-            Push(data, floatProp);
-        }
+        std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES> data;
+        MaterialConstants::Pack(*material, data);
 
         // We need to create the material first
         if (_materialBuffers.find(material->id) == _materialBuffers.end()) {
@@ -501,6 +559,13 @@ namespace playground::rendering::d3d12
         _materialBuffers[material->id]->SetData(data.data(), 1, 0, data.size());
     }
 
+    auto D3D12GraphicsContext::SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void {
+        ZoneScopedN("RenderThread: Set Materials Data");
+        ZoneColor(tracy::Color::Orange3);
+        count = std::min(count, MAX_MATERIALS - std::min(first, MAX_MATERIALS));
+        _materialsBuffer->SetData(data, count, first, static_cast<size_t>(count) * MAX_MATERIAL_SIZE_BYTES);
+    }
+
     auto D3D12GraphicsContext::SetDirectionalLight(
         DirectionalLight& light
     ) -> void {
@@ -510,6 +575,15 @@ namespace playground::rendering::d3d12
         _directionalLightBuffer->SetData(reinterpret_cast<void*>(&light), 1, 0, sizeof(DirectionalLight));
     }
 
+    auto D3D12GraphicsContext::SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void {
+        ZoneScopedN("RenderThread: Set Shadow Cascades");
+        ZoneColor(tracy::Color::Orange3);
+        // Entries sit at the buffer's aligned stride, each one is written on its own
+        for (size_t x = 0; x < std::min<size_t>(count, MAX_SHADOW_CASCADES); x++) {
+            _shadowCascadeBuffer->SetData(&cascades[x], 1, x, sizeof(DirectionalLight));
+        }
+    }
+
     auto D3D12GraphicsContext::SetViewport(
         uint32_t startX,
         uint32_t startY,
@@ -587,7 +661,8 @@ namespace playground::rendering::d3d12
         _currentPassList = _opaqueCommandList;
 
         _currentPassList->Native()->BeginRenderPass(1, &rtDesc, nullptr, D3D12_RENDER_PASS_FLAG_NONE);
-        _currentPassList->Native()->SetGraphicsRootSignature(_skyboxRootSignature.Get());
+        _currentRootSignature = _skyboxRootSignature.Get();
+        _currentPassList->Native()->SetGraphicsRootSignature(_currentRootSignature);
 
         std::array<float, 2> inverseRes = { 1.0f / _width, 1.0f / _height };
         _currentPassList->Native()->SetGraphicsRoot32BitConstants(1, 2, &inverseRes, 0);
@@ -622,9 +697,10 @@ namespace playground::rendering::d3d12
         dsDesc.StencilEndingAccess.Type = D3D12_RENDER_PASS_ENDING_ACCESS_TYPE_NO_ACCESS;
         _currentPassList = _shadowCommandList;
         _currentPassList->Native()->BeginRenderPass(0, nullptr, &dsDesc, D3D12_RENDER_PASS_FLAG_NONE);
-        _currentPassList->Native()->SetGraphicsRootSignature(_shadowsRootSignature.Get());
+        _currentRootSignature = _shadowsRootSignature.Get();
+        _currentPassList->Native()->SetGraphicsRootSignature(_currentRootSignature);
         _currentPassList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_LIST);
-        _currentPassList->BindConstantBuffer(_directionalLightBuffer, 0, 0);
+        _currentPassList->BindConstantBuffer(_shadowCascadeBuffer, 0, 0);
 
         PIXEndEvent();
     }
@@ -675,7 +751,8 @@ namespace playground::rendering::d3d12
         _currentPassList = _opaqueCommandList;
 
         _currentPassList->Native()->BeginRenderPass(1, &rtDesc, &dsDesc, D3D12_RENDER_PASS_FLAG_NONE);
-        _currentPassList->Native()->SetGraphicsRootSignature(_opaqueRootSignature.Get());
+        _currentRootSignature = _opaqueRootSignature.Get();
+        _currentPassList->Native()->SetGraphicsRootSignature(_currentRootSignature);
         _currentPassList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_LIST);
         _currentPassList->BindConstantBuffer(_directionalLightBuffer, 1, 0);
         // TODO: Add offsets to the descriptor tables
@@ -700,6 +777,17 @@ namespace playground::rendering::d3d12
             _shadowCastersCount,
             0
         );
+        _currentPassList->Native()->SetGraphicsRoot32BitConstants(
+            CLUSTER_PARAMETERS_BINDING,
+            sizeof(ClusterParameters) / sizeof(uint32_t),
+            &_clusterParameters,
+            0
+        );
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(LIGHT_CLUSTERS_BUFFER_BINDING, _lightClustersBuffer->GPUHandle());
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(LIGHT_INDICES_BUFFER_BINDING, _lightIndicesBuffer->GPUHandle());
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(POINT_LIGHTS_BUFFER_BINDING, _pointLightsBuffer->GPUHandle());
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(SPOT_LIGHTS_BUFFER_BINDING, _spotLightsBuffer->GPUHandle());
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(MATERIALS_BUFFER_BINDING, _materialsBuffer->GPUHandle());
 
         PIXEndEvent();
     }
@@ -736,7 +824,8 @@ namespace playground::rendering::d3d12
         _currentPassList = _opaqueCommandList;
 
         _currentPassList->Native()->BeginRenderPass(1, &rtDesc, nullptr, D3D12_RENDER_PASS_FLAG_NONE);
-        _currentPassList->Native()->SetGraphicsRootSignature(_postProcessingRootSignature.Get());
+        _currentRootSignature = _postProcessingRootSignature.Get();
+        _currentPassList->Native()->SetGraphicsRootSignature(_currentRootSignature);
         _currentPassList->SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_STRIP);
         _currentPassList->Native()->SetGraphicsRoot32BitConstants(
             PP_INVERSE_SCREEN_RES_CONSTANTS_BINDING,
@@ -745,8 +834,8 @@ namespace playground::rendering::d3d12
             0
         );
 
-        _currentPassList->Native()->SetGraphicsRootDescriptorTable(PP_FRAME_COLOUR_BUFFER_BINDING, std::static_pointer_cast<D3D12RenderTarget>(colour)->SRVHandle()->GetGPUHandle());
-        _currentPassList->Native()->SetGraphicsRootDescriptorTable(PP_FRAME_DEPTH_BUFFER_BINDING, std::static_pointer_cast<D3D12DepthBuffer>(depth)->SRVHandle()->GetGPUHandle());
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(PP_FRAME_COLOUR_BUFFER_BINDING, std::static_pointer_cast<D3D12RenderTarget>(colour)->SRVHandle().gpu);
+        _currentPassList->Native()->SetGraphicsRootDescriptorTable(PP_FRAME_DEPTH_BUFFER_BINDING, std::static_pointer_cast<D3D12DepthBuffer>(depth)->SRVHandle().gpu);
 
         // TODO: Add offsets to the descriptor tables
         _currentPassList->Native()->SetGraphicsRootDescriptorTable(
@@ -1,43 +1,60 @@
 #include "rendering/d3d12/D3D12HeapManager.hxx"
 #include "rendering/d3d12/D3D12CPUResourceHandle.hxx"
 #include "rendering/d3d12/D3D12GPUResourceHandle.hxx"
+#include <stdexcept>
+#include <string>
 
 namespace playground::rendering::d3d12
 {
+    namespace {
+        // Each resource class owns the slots up to the start of the next one
+        template<typename T>
+        auto RangesBetween(std::initializer_list<T> starts) -> std::vector<DescriptorRange> {
+            std::vector<DescriptorRange> ranges;
+            for (auto it = starts.begin(); it + 1 != starts.end(); it++) {
+                ranges.push_back(DescriptorRange{ (uint32_t)*it, (uint32_t)*(it + 1) - (uint32_t)*it });
+            }
+
+            return ranges;
+        }
+    }
+
     D3D12HeapManager::D3D12HeapManager(
         Microsoft::WRL::ComPtr<ID3D12Device> device,
         D3D12_DESCRIPTOR_HEAP_TYPE type,
         uint16_t chunkSize
-    ) : _device(device), _type(type), _chunkSize(chunkSize)
+    ) : _device(device), _type(type), _chunkSize(chunkSize),
+        _shaderVisible(type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER)
     {
         _heap = CreateHeap();
 
+        std::vector<DescriptorRange> ranges;
         switch (type)
         {
         case D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV:
             _heap->Native()->SetName(L"CBV_SRV_UAV Heap");
-            _srvResourceIndices[SRVHeapResource::FrameBuffer] = 0;
-            _srvResourceIndices[SRVHeapResource::DepthBuffer] = 0;
-            _srvResourceIndices[SRVHeapResource::Texture2D] = 0;
-            _srvResourceIndices[SRVHeapResource::TextureCube] = 0;
-            _srvResourceIndices[SRVHeapResource::ShadowMap] = 0;
-            _srvResourceIndices[SRVHeapResource::StructuredBuffer] = 0;
+            ranges = RangesBetween({
+                SRVHeapResource::FrameBuffer,
+                SRVHeapResource::DepthBuffer,
+                SRVHeapResource::Texture2D,
+                SRVHeapResource::TextureCube,
+                SRVHeapResource::ShadowMap,
+                SRVHeapResource::StructuredBuffer,
+                SRVHeapResource::ConstantBuffer,
+                SRVHeapResource::End
+            });
             break;
         case D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER:
             _heap->Native()->SetName(L"SAMPLER Heap");
-            _samplerResourceIndices[SamplerHeapResource::Sampler] = 0;
-            _samplerResourceIndices[SamplerHeapResource::ComparisonSampler] = 0;
+            ranges = RangesBetween({ SamplerHeapResource::Sampler, SamplerHeapResource::ComparisonSampler, SamplerHeapResource::End });
             break;
         case D3D12_DESCRIPTOR_HEAP_TYPE_RTV:
             _heap->Native()->SetName(L"RTV Heap");
-            _rtvResourceIndices[RTVHeapResource::RenderTargetView] = 0;
-            _rtvResourceIndices[RTVHeapResource::SwapChainBuffer] = 0;
-            _rtvResourceIndices[RTVHeapResource::ShadowMapRTV] = 0;
+            ranges = RangesBetween({ RTVHeapResource::RenderTargetView, RTVHeapResource::SwapChainBuffer, RTVHeapResource::ShadowMapRTV, RTVHeapResource::End });
             break;
         case D3D12_DESCRIPTOR_HEAP_TYPE_DSV:
             _heap->Native()->SetName(L"DSV Heap");
-            _dsvResourceIndices[DSVHeapResource::DepthStencilView] = 0;
-            _dsvResourceIndices[DSVHeapResource::ShadowMapDSV] = 0;
+            ranges = RangesBetween({ DSVHeapResource::DepthStencilView, DSVHeapResource::ShadowMapDSV, DSVHeapResource::End });
             break;
         case D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES:
             _heap->Native()->SetName(L"NUM_TYPES Heap");
@@ -46,55 +63,79 @@ namespace playground::rendering::d3d12
         default:
             break;
         }
+
+        _allocator = std::make_unique<DescriptorAllocator>(std::move(ranges));
     }
 
     auto D3D12HeapManager::HandleAt(uint32_t index) -> std::shared_ptr<D3D12ResourceHandle> {
         return _heap->HandleFor(index, index);
     }
 
-    auto D3D12HeapManager::NextHandle(SRVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle> {
-        auto index = _srvResourceIndices[resourceType];
-        auto handle = _heap->HandleFor((uint32_t)resourceType + index, index);
-
-        _srvResourceIndices[resourceType]++;
+    auto D3D12HeapManager::NextHandle(SRVHeapResource resourceType) -> D3D12DescriptorSlot {
+        return AllocateHandle((uint32_t)resourceType);
+    }
 
-        return handle;
+    auto D3D12HeapManager::NextHandle(UAVHeapResource resourceType) -> D3D12DescriptorSlot {
+        return AllocateHandle((uint32_t)resourceType);
     }
 
-    auto D3D12HeapManager::NextHandle(UAVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle> {
-        auto index = _uavResourceIndices[resourceType];
-        auto handle = _heap->HandleFor((uint32_t)resourceType + index, index);
+    auto D3D12HeapManager::NextHandle(RTVHeapResource resourceType) -> D3D12DescriptorSlot {
+        return AllocateHandle((uint32_t)resourceType);
+    }
 
-        _uavResourceIndices[resourceType]++;
+    auto D3D12HeapManager::NextHandle(DSVHeapResource resourceType) -> D3D12DescriptorSlot {
+        return AllocateHandle((uint32_t)resourceType);
+    }
 
-        return handle;
+    auto D3D12HeapManager::NextHandle(SamplerHeapResource resourceType) -> D3D12DescriptorSlot {
+        return AllocateHandle((uint32_t)resourceType);
     }
 
-    auto D3D12HeapManager::NextHandle(RTVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle> {
-        auto index = _rtvResourceIndices[resourceType];
-        auto handle = _heap->HandleFor((uint32_t)resourceType + index, index);
+    auto D3D12HeapManager::FreeHandle(SRVHeapResource resourceType, uint32_t index) -> void {
+        ReleaseHandle((uint32_t)resourceType, index);
+    }
 
-        _rtvResourceIndices[resourceType]++;
+    auto D3D12HeapManager::FreeHandle(UAVHeapResource resourceType, uint32_t index) -> void {
+        ReleaseHandle((uint32_t)resourceType, index);
+    }
 
-        return handle;;
+    auto D3D12HeapManager::FreeHandle(RTVHeapResource resourceType, uint32_t index) -> void {
+        ReleaseHandle((uint32_t)resourceType, index);
     }
 
-    auto D3D12HeapManager::NextHandle(DSVHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle> {
-        auto index = _dsvResourceIndices[resourceType];
-        auto handle = _heap->HandleFor((uint32_t)resourceType + index, index);
+    auto D3D12HeapManager::FreeHandle(DSVHeapResource resourceType, uint32_t index) -> void {
+        ReleaseHandle((uint32_t)resourceType, index);
+    }
 
-        _dsvResourceIndices[resourceType]++;
+    auto D3D12HeapManager::FreeHandle(SamplerHeapResource resourceType, uint32_t index) -> void {
+        ReleaseHandle((uint32_t)resourceType, index);
+    }
 
-        return handle;
+    auto D3D12HeapManager::BeginFrame(uint64_t fence, uint64_t completedFence) -> void {
+        _allocator->BeginFrame(fence, completedFence);
     }
 
-    auto D3D12HeapManager::NextHandle(SamplerHeapResource resourceType) -> std::shared_ptr<D3D12ResourceHandle> {
-        auto index = _samplerResourceIndices[resourceType];
-        auto handle = _heap->HandleFor((uint32_t)resourceType + index, index);
+    auto D3D12HeapManager::AllocateHandle(uint32_t rangeStart) -> D3D12DescriptorSlot {
+        auto range = _allocator->RangeOf(rangeStart);
+        if (range == DescriptorAllocator::INVALID_SLOT) {
+            throw std::runtime_error("Descriptor heap has no range at slot " + std::to_string(rangeStart));
+        }
+
+        auto slot = _allocator->Allocate(range);
+        auto native = _heap->Native();
 
-        _samplerResourceIndices[resourceType]++;
+        return D3D12DescriptorSlot{
+            .index = slot - rangeStart,
+            .cpu = CD3DX12_CPU_DESCRIPTOR_HANDLE(native->GetCPUDescriptorHandleForHeapStart(), slot, _heap->Increment()),
+            .gpu = _shaderVisible
+                ? CD3DX12_GPU_DESCRIPTOR_HANDLE(native->GetGPUDescriptorHandleForHeapStart(), slot, _heap->Increment())
+                : CD3DX12_GPU_DESCRIPTOR_HANDLE(),
+        };
+    }
 
-        return handle;
+    auto D3D12HeapManager::ReleaseHandle(uint32_t rangeStart, uint32_t index) -> void {
+        // Retired with the frame being recorded, the slot is handed out again once that frame completed
+        _allocator->Free(rangeStart + index);
     }
 
     auto D3D12HeapManager::CreateHeap() -> std::shared_ptr<D3D12Heap>
@@ -104,7 +145,7 @@ namespace playground::rendering::d3d12
             _device,
             _type,
             _chunkSize * _currentChunk,
-            _type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV || _type == D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER
+            _shaderVisible
         );
     }
 }
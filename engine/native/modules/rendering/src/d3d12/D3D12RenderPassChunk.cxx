@@ -0,0 +1,59 @@
+#include "rendering/d3d12/D3D12RenderPassChunk.hxx"
+#include "rendering/d3d12/D3D12GraphicsContext.hxx"
+#include "rendering/d3d12/D3D12Material.hxx"
+#include "rendering/MaterialConstants.hxx"
+#include "rendering/PrimitiveTopology.hxx"
+
+namespace playground::rendering::d3d12 {
+    D3D12RenderPassChunk::D3D12RenderPassChunk(const D3D12GraphicsContext& context, std::shared_ptr<D3D12CommandList> bundle)
+        : _context(context), _bundle(std::move(bundle)) {
+        // Bundles are created open, the pool expects closed ones
+        _bundle->Close();
+    }
+
+    auto D3D12RenderPassChunk::Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void {
+        _bundle->DrawIndexed(numIndices, startIndex, startVertex, numInstances, startInstance);
+    }
+
+    auto D3D12RenderPassChunk::BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
+        _bundle->BindVertexBuffer(buffer, 0);
+    }
+
+    auto D3D12RenderPassChunk::BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void {
+        _bundle->BindIndexBuffer(buffer);
+    }
+
+    auto D3D12RenderPassChunk::BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void {
+        _bundle->BindInstanceBuffer(buffer);
+    }
+
+    auto D3D12RenderPassChunk::BindMaterial(std::shared_ptr<Material> material) -> void {
+        auto list = _bundle->Native();
+        auto dxMat = std::static_pointer_cast<D3D12Material>(material);
+        list->SetPipelineState(dxMat->pso.Get());
+
+        if (material->type == MaterialType::Standard) {
+            list->SetGraphicsRoot32BitConstant(MATERIAL_INDEX_BINDING, MaterialConstants::Slot(material->id), 0);
+            return;
+        }
+
+        list->SetGraphicsRootConstantBufferView(MATERIAL_BUFFER_BINDING, _context.MaterialBufferAddress(material->id));
+    }
+
+    auto D3D12RenderPassChunk::BindShadowMaterial(std::shared_ptr<Material> material) -> void {
+        auto dxMat = std::static_pointer_cast<D3D12Material>(material);
+        _bundle->Native()->SetPipelineState(dxMat->pso.Get());
+    }
+
+    auto D3D12RenderPassChunk::Finish() -> void {
+        _bundle->Close();
+    }
+
+    auto D3D12RenderPassChunk::Begin(ID3D12RootSignature* rootSignature) -> void {
+        _bundle->Reset();
+        _bundle->Begin();
+        _bundle->Native()->SetGraphicsRootSignature(rootSignature);
+        // Topology isn't inherited from the executing list
+        _bundle->SetPrimitiveTopology(PrimitiveTopology::TRIANGLE_LIST);
+    }
+}
@@ -11,7 +11,7 @@ namespace playground::rendering::d3d12 {
         Microsoft::WRL::ComPtr<ID3D12CommandQueue> queue
     ) : _queue(queue)
     {
-        _textures = {};
+        _textureCopies = {};
         _indexBuffers = {};
         _vertexBuffers = {};
 
@@ -45,16 +45,7 @@ namespace playground::rendering::d3d12 {
             std::static_pointer_cast<D3D12VertexBuffer>(buffer)->Free();
         }
 
-        for (auto& texture : _textures) {
-            std::static_pointer_cast<D3D12Texture>(texture)->Free();
-        }
-
-        for (auto& cubemap : _cubemaps) {
-            std::static_pointer_cast<D3D12Cubemap>(cubemap)->Free();
-        }
-
-        _textures.clear();
-        _cubemaps.clear();
+        _textureCopies.clear();
         _indexBuffers.clear();
         _vertexBuffers.clear();
         _instanceBuffers.clear();
@@ -85,48 +76,33 @@ namespace playground::rendering::d3d12 {
             list->CopyBufferRegion(d3d12Buffer.Get(), 0, uploadBuffer.Get(), 0, size);
         }
 
-        for (auto& buffer : _instanceBuffers) {
+        for (auto& [buffer, first, count] : _instanceBuffers) {
             ZoneScopedN("RenderThread: Copy Instance Buffer");
             ZoneColor(tracy::Color::RebeccaPurple);
             auto d3d12Buffer = std::static_pointer_cast<D3D12InstanceBuffer>(buffer)->Buffer();
             auto uploadBuffer = std::static_pointer_cast<D3D12InstanceBuffer>(buffer)->StagingBuffer();
-            auto size = std::static_pointer_cast<D3D12InstanceBuffer>(buffer)->View().SizeInBytes;
-            // Copy upload buffer to GPU memory
-            list->CopyBufferRegion(d3d12Buffer.Get(), 0, uploadBuffer.Get(), 0, size);
+            auto stride = std::static_pointer_cast<D3D12InstanceBuffer>(buffer)->View().StrideInBytes;
+            // Only the instances written this frame are copied to GPU memory
+            list->CopyBufferRegion(d3d12Buffer.Get(), first * stride, uploadBuffer.Get(), first * stride, count * stride);
         }
 
-        for (auto& texture : _textures) {
-            ZoneScopedN("RenderThread: Copy Texture");
+        for (auto& copy : _textureCopies) {
+            ZoneScopedN("RenderThread: Copy Texture Region");
             ZoneColor(tracy::Color::RebeccaPurple);
-            auto d3d12Texture = std::static_pointer_cast<D3D12Texture>(texture)->Texture();
-            auto textureUploadBuffer = std::static_pointer_cast<D3D12Texture>(texture)->StagingBuffer();
-            auto textureData = std::static_pointer_cast<D3D12Texture>(texture)->TextureData();
-            auto result = UpdateSubresources(
-                list.Get(),
-                d3d12Texture.Get(),
-                textureUploadBuffer.Get(),
-                0,
-                0,
-                static_cast<UINT>(textureData.size()),
-                textureData.data()
-            );
-        }
-
-        for (auto& cubemap : _cubemaps) {
-            ZoneScopedN("RenderThread: Copy Cubemaps");
-            ZoneColor(tracy::Color::RebeccaPurple);
-            auto d3d12Cubemap = std::static_pointer_cast<D3D12Cubemap>(cubemap)->Cubemap();
-            auto cubemapUploadBuffer = std::static_pointer_cast<D3D12Cubemap>(cubemap)->StagingBuffer();
-            auto cubemapData = std::static_pointer_cast<D3D12Cubemap>(cubemap)->CubemapData();
-            auto result = UpdateSubresources(
-                list.Get(),
-                d3d12Cubemap.Get(),
-                cubemapUploadBuffer.Get(),
-                0,
-                0,
-                static_cast<UINT>(cubemapData.size()),
-                cubemapData.data()
-            );
+            auto stagingBuffer = std::static_pointer_cast<D3D12StagingBuffer>(copy.staging)->Buffer();
+
+            // The staged rows are a footprint of their own, placed at the region's offset in the staging buffer
+            D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+            footprint.Offset = copy.offset;
+            footprint.Footprint.Format = DXGI_FORMAT_BC3_UNORM;
+            footprint.Footprint.Width = (copy.region.rowBytes / TEXTURE_BLOCK_BYTES) * TEXTURE_BLOCK_SIZE;
+            footprint.Footprint.Height = copy.region.rowCount * TEXTURE_BLOCK_SIZE;
+            footprint.Footprint.Depth = 1;
+            footprint.Footprint.RowPitch = copy.region.rowPitch;
+
+            CD3DX12_TEXTURE_COPY_LOCATION dst(copy.resource.Get(), copy.region.subresource);
+            CD3DX12_TEXTURE_COPY_LOCATION src(stagingBuffer.Get(), footprint);
+            list->CopyTextureRegion(&dst, 0, copy.region.firstRow * TEXTURE_BLOCK_SIZE, 0, &src, nullptr);
         }
 
         {
@@ -151,12 +127,22 @@ namespace playground::rendering::d3d12 {
         // No-op for D3D12UploadContext, as it does not need to wait for other contexts.
     }
 
-    auto D3D12UploadContext::Upload(std::shared_ptr<Texture> texture) -> void {
-        _textures.push_back(texture);
+    auto D3D12UploadContext::Upload(std::shared_ptr<Texture> texture, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void {
+        _textureCopies.push_back(TextureCopy{
+            .resource = std::static_pointer_cast<D3D12Texture>(texture)->Texture(),
+            .region = region,
+            .staging = std::move(staging),
+            .offset = offset,
+        });
     }
 
-    auto D3D12UploadContext::Upload(std::shared_ptr<Cubemap> cubemap) -> void {
-        _cubemaps.push_back(cubemap);
+    auto D3D12UploadContext::Upload(std::shared_ptr<Cubemap> cubemap, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void {
+        _textureCopies.push_back(TextureCopy{
+            .resource = std::static_pointer_cast<D3D12Cubemap>(cubemap)->Cubemap(),
+            .region = region,
+            .staging = std::move(staging),
+            .offset = offset,
+        });
     }
 
     auto D3D12UploadContext::Upload(std::shared_ptr<IndexBuffer> buffer) -> void {
@@ -167,7 +153,11 @@ namespace playground::rendering::d3d12 {
         _vertexBuffers.push_back(buffer);
     }
 
-    auto D3D12UploadContext::Upload(std::shared_ptr<InstanceBuffer> buffer) -> void {
-        _instanceBuffers.push_back(buffer);
+    auto D3D12UploadContext::Upload(std::shared_ptr<InstanceBuffer> buffer, size_t count) -> void {
+        _instanceBuffers.emplace_back(buffer, 0, count);
+    }
+
+    auto D3D12UploadContext::Upload(std::shared_ptr<InstanceBuffer> buffer, size_t first, size_t count) -> void {
+        _instanceBuffers.emplace_back(buffer, first, count);
     }
 }
@@ -0,0 +1,171 @@
+#include "rendering/null/NullDevice.hxx"
+#include "rendering/null/NullCommandList.hxx"
+#include "rendering/null/NullConstantBuffer.hxx"
+#include "rendering/null/NullCubemap.hxx"
+#include "rendering/null/NullDepthBuffer.hxx"
+#include "rendering/null/NullGraphicsContext.hxx"
+#include "rendering/null/NullIndexBuffer.hxx"
+#include "rendering/null/NullInstanceBuffer.hxx"
+#include "rendering/null/NullRenderTarget.hxx"
+#include "rendering/null/NullSampler.hxx"
+#include "rendering/null/NullShadowMap.hxx"
+#include "rendering/null/NullStructuredBuffer.hxx"
+#include "rendering/null/NullStagingBuffer.hxx"
+#include "rendering/null/NullSwapChain.hxx"
+#include "rendering/null/NullTexture.hxx"
+#include "rendering/null/NullUploadContext.hxx"
+#include "rendering/null/NullVertexBuffer.hxx"
+
+namespace playground::rendering::null {
+    // Same slot count as the D3D12 sampler heap
+    constexpr uint32_t SAMPLER_HEAP_SIZE = 32;
+
+    NullDevice::NullDevice(uint8_t frameCount) : Device(frameCount) {
+        _stats = std::make_shared<NullStats>();
+        _srvHeap = std::make_shared<NullHeap>("SRV_HEAP", MAX_SRV_HEAP_SIZE, _stats);
+        _samplerHeap = std::make_shared<NullHeap>("SAMPLER_HEAP", SAMPLER_HEAP_SIZE, _stats);
+    }
+
+    auto NullDevice::Flush() -> void {
+    }
+
+    auto NullDevice::CreateGraphicsContext(std::string name, void* window, uint32_t width, uint32_t height, bool offscreen) -> std::shared_ptr<GraphicsContext> {
+        return std::make_shared<NullGraphicsContext>(name, shared_from_this(), _stats, width, height);
+    }
+
+    auto NullDevice::CreateUploadContext(std::string name) -> std::shared_ptr<UploadContext> {
+        return std::make_shared<NullUploadContext>(name, shared_from_this(), _stats);
+    }
+
+    auto NullDevice::CreateCommandList(
+        CommandListType type,
+        std::string name
+    ) -> std::shared_ptr<CommandList> {
+        return std::make_shared<NullCommandList>(type, _stats);
+    }
+
+    auto NullDevice::CreateBuffer(uint64_t size) -> std::shared_ptr<Buffer> {
+        return nullptr;
+    }
+
+    auto NullDevice::CreateRenderTarget(
+        uint32_t width,
+        uint32_t height,
+        TextureFormat format,
+        std::string name,
+        bool isCPUReadable
+    ) -> std::shared_ptr<RenderTarget> {
+        _stats->texturesCreated++;
+
+        return std::make_shared<NullRenderTarget>(width, height, format, name, isCPUReadable);
+    }
+
+    auto NullDevice::CreateDepthBuffer(
+        uint32_t width,
+        uint32_t height,
+        std::string name
+    ) -> std::shared_ptr<DepthBuffer> {
+        _stats->texturesCreated++;
+
+        return std::make_shared<NullDepthBuffer>(width, height, name);
+    }
+
+    auto NullDevice::CreateMaterial(std::string vertexShader, std::string pixelShader, MaterialType type) -> std::shared_ptr<Material> {
+        _stats->materialsCreated++;
+
+        auto material = std::make_shared<Material>();
+        material->type = type;
+
+        return material;
+    }
+
+    auto NullDevice::CreateVertexBuffer(const void* data, uint64_t size, uint64_t stride, bool isStatic) -> std::shared_ptr<VertexBuffer> {
+        _stats->buffersCreated++;
+
+        return std::make_shared<NullVertexBuffer>(data, size, stride);
+    }
+
+    auto NullDevice::UpdateVertexBuffer(std::shared_ptr<VertexBuffer> buffer, const void* data, uint64_t size) -> void {
+        buffer->SetData(data, size);
+    }
+
+    auto NullDevice::CreateIndexBuffer(const uint32_t* indices, size_t size) -> std::shared_ptr<IndexBuffer> {
+        _stats->buffersCreated++;
+
+        return std::make_shared<NullIndexBuffer>(indices, size);
+    }
+
+    auto NullDevice::UpdateIndexBuffer(std::shared_ptr<IndexBuffer> buffer, std::vector<uint32_t> indices) -> void {
+        buffer->SetData(indices.data(), indices.size() * sizeof(uint32_t));
+    }
+
+    auto NullDevice::CreateConstantBuffer(const void* data, size_t size, size_t itemSize, ConstantBuffer::BindingMode mode, std::string name) -> std::shared_ptr<ConstantBuffer> {
+        _stats->buffersCreated++;
+
+        return std::make_shared<NullConstantBuffer>(data, size, itemSize, mode, _srvHeap);
+    }
+
+    auto NullDevice::CreateStructuredBuffer(void* data, size_t size, size_t itemSize, std::string name) -> std::shared_ptr<StructuredBuffer> {
+        _stats->buffersCreated++;
+
+        return std::make_shared<NullStructuredBuffer>(data, size, itemSize, _srvHeap);
+    }
+
+    auto NullDevice::CreateInstanceBuffer(uint64_t count, uint64_t stride) -> std::shared_ptr<InstanceBuffer> {
+        _stats->buffersCreated++;
+
+        return std::make_shared<NullInstanceBuffer>(count, stride);
+    }
+
+    auto NullDevice::CreateStagingBuffer(uint64_t size) -> std::shared_ptr<StagingBuffer> {
+        _stats->buffersCreated++;
+
+        return std::make_shared<NullStagingBuffer>(size);
+    }
+
+    auto NullDevice::CreateTexture(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Texture> {
+        _stats->texturesCreated++;
+
+        return std::make_shared<NullTexture>(width, height, mipCount, _srvHeap);
+    }
+
+    auto NullDevice::CreateCubemap(uint32_t width, uint32_t height, uint32_t mipCount) -> std::shared_ptr<Cubemap> {
+        _stats->texturesCreated++;
+
+        return std::make_shared<NullCubemap>(width, height, mipCount, _srvHeap);
+    }
+
+    auto NullDevice::CreateSampler(TextureFiltering filtering, TextureWrapping wrapping) -> std::shared_ptr<Sampler> {
+        return std::make_shared<NullSampler>(filtering, wrapping, _samplerHeap);
+    }
+
+    auto NullDevice::CreateShadowMap(uint32_t width, uint32_t height, std::string name) -> std::shared_ptr<ShadowMap> {
+        _stats->texturesCreated++;
+
+        return std::make_shared<NullShadowMap>(width, height, name, _srvHeap);
+    }
+
+    auto NullDevice::CreateSwapchain(uint8_t bufferCount, uint16_t width, uint16_t height, void* window) -> std::shared_ptr<Swapchain> {
+        return std::make_shared<NullSwapChain>(bufferCount, _stats);
+    }
+
+    auto NullDevice::GetSrvHeap() -> std::shared_ptr<Heap> {
+        return _srvHeap;
+    }
+
+    auto NullDevice::GetSamplerHeap() -> std::shared_ptr<Heap> {
+        return _samplerHeap;
+    }
+
+    auto NullDevice::DestroyShader(uint64_t shaderHandle) -> void {
+    }
+
+    auto NullDevice::WaitForIdleGPU() -> void {
+    }
+
+    auto NullDevice::BeginFrame(uint64_t frame) -> void {
+        auto completedFrame = CompletedFrame(frame);
+        _srvHeap->BeginFrame(frame, completedFrame);
+        _samplerHeap->BeginFrame(frame, completedFrame);
+    }
+}
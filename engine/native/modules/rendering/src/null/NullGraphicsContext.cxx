@@ -0,0 +1,425 @@
+#include "rendering/null/NullGraphicsContext.hxx"
+#include "rendering/MaterialConstants.hxx"
+#include "rendering/null/NullDepthBuffer.hxx"
+#include "rendering/null/NullCubemap.hxx"
+#include "rendering/null/NullDevice.hxx"
+#include "rendering/null/NullTexture.hxx"
+#include <algorithm>
+#include <vector>
+
+namespace playground::rendering::null {
+    NullGraphicsContext::NullGraphicsContext(
+        std::string name,
+        std::shared_ptr<NullDevice> device,
+        std::shared_ptr<NullStats> stats,
+        uint32_t width,
+        uint32_t height
+    ) : _name(std::move(name)), _device(std::move(device)), _stats(std::move(stats)), _width(width), _height(height) {
+        // Same buffers the D3D12 context creates, so writes go through the same size and stride rules
+        _cameraBuffer = std::static_pointer_cast<NullConstantBuffer>(_device->CreateConstantBuffer(nullptr, MAX_CAMERA_COUNT, sizeof(CameraBuffer), ConstantBuffer::BindingMode::RootCBV, _name + "_CAMERA_BUFFER"));
+        _pointLightsBuffer = std::static_pointer_cast<NullStructuredBuffer>(_device->CreateStructuredBuffer(nullptr, MAX_POINT_LIGHTS, sizeof(PointLight), _name + "_POINT_LIGHT_BUFFER"));
+        _spotLightsBuffer = std::static_pointer_cast<NullStructuredBuffer>(_device->CreateStructuredBuffer(nullptr, MAX_SPOT_LIGHTS, sizeof(SpotLight), _name + "_SPOT_LIGHT_BUFFER"));
+        _lightClustersBuffer = std::static_pointer_cast<NullStructuredBuffer>(_device->CreateStructuredBuffer(nullptr, CLUSTER_COUNT, sizeof(LightCluster), _name + "_LIGHT_CLUSTERS_BUFFER"));
+        _lightIndicesBuffer = std::static_pointer_cast<NullStructuredBuffer>(_device->CreateStructuredBuffer(nullptr, MAX_LIGHT_INDICES, sizeof(uint32_t), _name + "_LIGHT_INDICES_BUFFER"));
+        _directionalLightBuffer = std::static_pointer_cast<NullConstantBuffer>(_device->CreateConstantBuffer(nullptr, 1, sizeof(DirectionalLight), ConstantBuffer::BindingMode::RootCBV, _name + "_DIRECTIONAL_LIGHT_BUFFER"));
+        _shadowCascadeBuffer = std::static_pointer_cast<NullConstantBuffer>(_device->CreateConstantBuffer(nullptr, MAX_SHADOW_CASCADES, sizeof(DirectionalLight), ConstantBuffer::BindingMode::RootCBV, _name + "_SHADOW_CASCADE_BUFFER"));
+        _shadowCastersBuffer = std::static_pointer_cast<NullStructuredBuffer>(_device->CreateStructuredBuffer(nullptr, MAX_SHADOW_MAPS_PER_FRAME, sizeof(ShadowCaster), _name + "_SHADOW_CASTERS_BUFFER"));
+        _materialsBuffer = std::static_pointer_cast<NullStructuredBuffer>(_device->CreateStructuredBuffer(nullptr, MAX_MATERIALS, MAX_MATERIAL_SIZE_BYTES, _name + "_MATERIALS_BUFFER"));
+        _writtenMaterials.resize(MAX_MATERIALS, false);
+    }
+
+    auto NullGraphicsContext::Begin() -> void {
+        if (_isRecording) {
+            _stats->invalidCalls++;
+        }
+
+        _isRecording = true;
+        _bindings.Reset();
+        _draws.clear();
+        // The previous recording finished on the GPU once Begin returns on D3D12, so its chunks can be reused
+        _usedChunks = 0;
+        _passChunks = 0;
+    }
+
+    auto NullGraphicsContext::BeginRenderPass(RenderPass pass, std::shared_ptr<RenderTarget> colour, std::shared_ptr<DepthBuffer> depth) -> void {
+        if (!_isRecording || _currentPass.has_value()) {
+            _stats->invalidCalls++;
+        }
+
+        _currentPass = pass;
+        _passIndex++;
+        _passChunks = _usedChunks;
+        // Every pass records into its own command list, nothing bound carries over
+        _bindings.Reset();
+        _stats->renderPasses++;
+    }
+
+    auto NullGraphicsContext::EndRenderPass() -> void {
+        if (!_currentPass.has_value()) {
+            _stats->invalidCalls++;
+        }
+
+        // Chunks acquired for the pass but never submitted would be lost
+        for (size_t x = _passChunks; x < _usedChunks; x++) {
+            if (_chunks[x]->CurrentState() != NullRenderPassChunk::State::Submitted) {
+                _stats->invalidCalls++;
+            }
+        }
+
+        _currentPass.reset();
+    }
+
+    auto NullGraphicsContext::Finish() -> void {
+        if (!_isRecording || _currentPass.has_value()) {
+            _stats->invalidCalls++;
+        }
+
+        _isRecording = false;
+        _currentPass.reset();
+        _stats->contextSubmissions++;
+    }
+
+    auto NullGraphicsContext::WaitFor(const Context& other) -> void {
+    }
+
+    auto NullGraphicsContext::Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void {
+        if (!RequirePass()) {
+            return;
+        }
+
+        if (!_bindings.CanDraw(numIndices, startIndex, numInstances, startInstance)) {
+            _stats->invalidCalls++;
+            return;
+        }
+
+        _stats->drawCalls++;
+        _stats->instancesDrawn += numInstances;
+        _stats->indicesDrawn += static_cast<uint64_t>(numIndices) * numInstances;
+        _draws.push_back(NullDraw{ startInstance, numInstances });
+    }
+
+    auto NullGraphicsContext::Draw(uint32_t numVertices) -> void {
+        if (!RequirePass()) {
+            return;
+        }
+
+        if (!_bindings.hasPipeline) {
+            _stats->invalidCalls++;
+            return;
+        }
+
+        _stats->drawCalls++;
+        _stats->instancesDrawn++;
+    }
+
+    auto NullGraphicsContext::AcquireChunks(uint32_t count, std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void {
+        chunks.clear();
+        if (!RequirePass()) {
+            return;
+        }
+
+        while (_chunks.size() < _usedChunks + count) {
+            _chunks.push_back(std::make_shared<NullRenderPassChunk>(*this, _stats));
+        }
+
+        for (uint32_t x = 0; x < count; x++) {
+            auto& chunk = _chunks[_usedChunks++];
+            chunk->Reset(_passIndex);
+            chunks.push_back(chunk);
+        }
+    }
+
+    auto NullGraphicsContext::SubmitChunks(const std::vector<std::shared_ptr<RenderPassChunk>>& chunks) -> void {
+        if (!RequirePass()) {
+            return;
+        }
+
+        for (const auto& chunk : chunks) {
+            auto nullChunk = std::static_pointer_cast<NullRenderPassChunk>(chunk);
+            // Bundles of another pass or ones still being recorded can't be executed
+            if (nullChunk->Pass() != _passIndex || nullChunk->CurrentState() != NullRenderPassChunk::State::Finished) {
+                _stats->invalidCalls++;
+                continue;
+            }
+
+            const auto& counts = nullChunk->Counts();
+            _stats->drawCalls += counts.drawCalls;
+            _stats->instancesDrawn += counts.instancesDrawn;
+            _stats->indicesDrawn += counts.indicesDrawn;
+            _stats->bindings += counts.bindings;
+            _stats->chunksSubmitted++;
+            _draws.insert(_draws.end(), nullChunk->Draws().begin(), nullChunk->Draws().end());
+            nullChunk->MarkSubmitted();
+        }
+
+        // What the chunks bound leaks into the pass, nothing the pass bound before is known to be bound anymore
+        _bindings.Reset();
+    }
+
+    auto NullGraphicsContext::BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
+        if (RequirePass()) {
+            _bindings.vertexBuffer = std::static_pointer_cast<NullVertexBuffer>(buffer);
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void {
+        if (RequirePass()) {
+            _bindings.indexBuffer = std::static_pointer_cast<NullIndexBuffer>(buffer);
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void {
+        if (RequirePass()) {
+            _bindings.instanceBuffer = std::static_pointer_cast<NullInstanceBuffer>(buffer);
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::BindCamera(uint8_t index) -> void {
+        if (RequirePass()) {
+            if (index >= MAX_CAMERA_COUNT) {
+                _stats->invalidCalls++;
+                return;
+            }
+
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::BindShadowCascade(uint8_t index) -> void {
+        if (RequirePass()) {
+            if (index >= MAX_SHADOW_CASCADES) {
+                _stats->invalidCalls++;
+                return;
+            }
+
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::SetCameraData(std::array<CameraBuffer, MAX_CAMERA_COUNT>& cameras) -> void {
+        for (size_t x = 0; x < cameras.size(); x++) {
+            _cameraBuffer->SetData(&cameras[x], 1, x, sizeof(CameraBuffer));
+        }
+
+        _stats->constantBytes += sizeof(CameraBuffer) * cameras.size();
+    }
+
+    auto NullGraphicsContext::SetShadowCastersData(std::vector<ShadowCaster>& shadowCasters) -> void {
+        auto count = std::min<size_t>(shadowCasters.size(), MAX_SHADOW_MAPS_PER_FRAME);
+        if (count < shadowCasters.size()) {
+            _stats->invalidCalls++;
+        }
+
+        _shadowCastersBuffer->SetData(shadowCasters.data(), count, 0, sizeof(ShadowCaster) * count);
+        _shadowCastersCount = static_cast<uint8_t>(count);
+        _stats->constantBytes += sizeof(ShadowCaster) * count;
+    }
+
+    auto NullGraphicsContext::SetLightData(const LightClusterGrid& clusters, const PointLight* pointLights, size_t pointCount, const SpotLight* spotLights, size_t spotCount) -> void {
+        pointCount = std::min<size_t>(pointCount, MAX_POINT_LIGHTS);
+        spotCount = std::min<size_t>(spotCount, MAX_SPOT_LIGHTS);
+        _pointLightsBuffer->SetData(pointLights, pointCount, 0, sizeof(PointLight) * pointCount);
+        _spotLightsBuffer->SetData(spotLights, spotCount, 0, sizeof(SpotLight) * spotCount);
+        _stats->constantBytes += sizeof(PointLight) * pointCount + sizeof(SpotLight) * spotCount;
+
+        if (clusters.clusters.size() != CLUSTER_COUNT) {
+            _clusterParameters = {};
+            return;
+        }
+
+        auto indexCount = std::min<size_t>(clusters.indices.size(), MAX_LIGHT_INDICES);
+        _lightClustersBuffer->SetData(clusters.clusters.data(), CLUSTER_COUNT, 0, sizeof(LightCluster) * CLUSTER_COUNT);
+        _lightIndicesBuffer->SetData(clusters.indices.data(), indexCount, 0, sizeof(uint32_t) * indexCount);
+        _clusterParameters = clusters.parameters;
+        _stats->constantBytes += sizeof(LightCluster) * CLUSTER_COUNT + sizeof(uint32_t) * indexCount;
+    }
+
+    auto NullGraphicsContext::BindHeaps(std::vector<std::shared_ptr<Heap>> heaps) -> void {
+        if (RequirePass()) {
+            _stats->bindings += heaps.size();
+        }
+    }
+
+    auto NullGraphicsContext::BindMaterial(std::shared_ptr<Material> material) -> void {
+        if (!RequirePass()) {
+            return;
+        }
+
+        if (!HasMaterialConstants(*material)) {
+            _stats->invalidCalls++;
+            return;
+        }
+
+        _bindings.hasPipeline = true;
+        _stats->bindings++;
+    }
+
+    auto NullGraphicsContext::BindShadowMaterial(std::shared_ptr<Material> material) -> void {
+        if (RequirePass()) {
+            _bindings.hasPipeline = true;
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::BindSRVHeapToSlot(std::shared_ptr<Heap> heap, uint8_t slot) -> void {
+        if (RequirePass()) {
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::BindSampler(std::shared_ptr<Sampler> sampler, uint8_t slot) -> void {
+        if (RequirePass()) {
+            _stats->bindings++;
+        }
+    }
+
+    auto NullGraphicsContext::TransitionIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void {
+        Transition(std::static_pointer_cast<NullIndexBuffer>(buffer)->IsResident());
+    }
+
+    auto NullGraphicsContext::TransitionVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
+        Transition(std::static_pointer_cast<NullVertexBuffer>(buffer)->IsResident());
+    }
+
+    auto NullGraphicsContext::TransitionTexture(std::shared_ptr<Texture> texture) -> void {
+        Transition(std::static_pointer_cast<NullTexture>(texture)->IsResident());
+    }
+
+    auto NullGraphicsContext::TransitionCubemap(std::shared_ptr<Cubemap> cubemap) -> void {
+        Transition(std::static_pointer_cast<NullCubemap>(cubemap)->IsResident());
+    }
+
+    auto NullGraphicsContext::TransitionShadowMapToDepthWrite(std::shared_ptr<ShadowMap> map) -> void {
+        TransitionDepthBufferToDepthWrite(map->GetDepthBuffer());
+    }
+
+    auto NullGraphicsContext::TransitionShadowMapToPixelShader(std::shared_ptr<ShadowMap> map) -> void {
+        TransitionDepthBufferToPixelShader(map->GetDepthBuffer());
+    }
+
+    auto NullGraphicsContext::TransitionDepthBufferToDepthWrite(std::shared_ptr<DepthBuffer> depth) -> void {
+        auto buffer = std::static_pointer_cast<NullDepthBuffer>(depth);
+        Transition(!buffer->isWritable);
+        buffer->isWritable = true;
+    }
+
+    auto NullGraphicsContext::TransitionDepthBufferToPixelShader(std::shared_ptr<DepthBuffer> depth) -> void {
+        auto buffer = std::static_pointer_cast<NullDepthBuffer>(depth);
+        Transition(buffer->isWritable);
+        buffer->isWritable = false;
+    }
+
+    auto NullGraphicsContext::CopyToSwapchainBackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<Swapchain> swapchain) -> void {
+        Transition(true);
+    }
+
+    auto NullGraphicsContext::CopyToReadbackBuffer(std::shared_ptr<RenderTarget> source, std::shared_ptr<ReadbackBuffer> target) -> void {
+        Transition(true);
+    }
+
+    auto NullGraphicsContext::SetMaterialData(std::shared_ptr<Material> material) -> void {
+        std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES> data;
+        // Properties past the entry are dropped
+        if (MaterialConstants::Pack(*material, data) > data.size()) {
+            _stats->invalidCalls++;
+        }
+
+        auto it = _materialBuffers.find(material->id);
+        if (it == _materialBuffers.end()) {
+            auto buffer = _device->CreateConstantBuffer(nullptr, 1, MAX_MATERIAL_SIZE_BYTES, ConstantBuffer::BindingMode::RootCBV, _name + "_MATERIAL_" + std::to_string(material->id));
+            it = _materialBuffers.emplace(material->id, std::static_pointer_cast<NullConstantBuffer>(buffer)).first;
+        }
+
+        it->second->SetData(data.data(), 1, 0, data.size());
+        _stats->constantBytes += data.size();
+    }
+
+    auto NullGraphicsContext::SetMaterialsData(const uint8_t* data, uint32_t first, uint32_t count) -> void {
+        if (static_cast<uint64_t>(first) + count > MAX_MATERIALS) {
+            _stats->invalidCalls++;
+            count = first < MAX_MATERIALS ? MAX_MATERIALS - first : 0;
+        }
+
+        if (count == 0) {
+            return;
+        }
+
+        _materialsBuffer->SetData(data, count, first, static_cast<size_t>(count) * MAX_MATERIAL_SIZE_BYTES);
+        std::fill_n(_writtenMaterials.begin() + first, count, true);
+        _stats->constantBytes += static_cast<uint64_t>(count) * MAX_MATERIAL_SIZE_BYTES;
+    }
+
+    auto NullGraphicsContext::SetDirectionalLight(DirectionalLight& light) -> void {
+        _directionalLightBuffer->SetData(&light, 1, 0, sizeof(DirectionalLight));
+        _stats->constantBytes += sizeof(DirectionalLight);
+    }
+
+    auto NullGraphicsContext::SetShadowCascades(const DirectionalLight* cascades, size_t count) -> void {
+        for (size_t x = 0; x < std::min<size_t>(count, MAX_SHADOW_CASCADES); x++) {
+            _shadowCascadeBuffer->SetData(&cascades[x], 1, x, sizeof(DirectionalLight));
+            _stats->constantBytes += sizeof(DirectionalLight);
+        }
+    }
+
+    auto NullGraphicsContext::SetViewport(
+        uint32_t startX,
+        uint32_t startY,
+        uint32_t width,
+        uint32_t height,
+        uint32_t depthStart,
+        uint32_t depthEnd
+    ) -> void {
+        RequirePass();
+    }
+
+    auto NullGraphicsContext::SetScissor(
+        uint32_t left,
+        uint32_t top,
+        uint32_t right,
+        uint32_t bottom
+    ) -> void {
+        RequirePass();
+    }
+
+    auto NullGraphicsContext::SetResolution(uint32_t width, uint32_t height) -> void {
+        _width = width;
+        _height = height;
+    }
+
+    auto NullGraphicsContext::MouseOverID() -> uint64_t {
+        // Nothing is rendered, so there is never an entity under the cursor
+        return 0;
+    }
+
+    auto NullGraphicsContext::HasMaterialConstants(const Material& material) const -> bool {
+        // Opaque materials are read from the materials buffer, the others bind the constants SetMaterialData created
+        return material.type == MaterialType::Standard
+            ? _writtenMaterials[MaterialConstants::Slot(material.id)]
+            : _materialBuffers.contains(material.id);
+    }
+
+    auto NullGraphicsContext::RequirePass() -> bool {
+        if (!_currentPass.has_value()) {
+            _stats->invalidCalls++;
+
+            return false;
+        }
+
+        return true;
+    }
+
+    auto NullGraphicsContext::Transition(bool valid) -> void {
+        if (!RequirePass()) {
+            return;
+        }
+
+        if (!valid) {
+            _stats->invalidCalls++;
+        }
+
+        _stats->transitions++;
+    }
+}
@@ -0,0 +1,93 @@
+#include "rendering/null/NullRenderPassChunk.hxx"
+#include "rendering/null/NullGraphicsContext.hxx"
+
+namespace playground::rendering::null {
+    NullRenderPassChunk::NullRenderPassChunk(const NullGraphicsContext& context, std::shared_ptr<NullStats> stats) : _context(context), _stats(std::move(stats)) {
+    }
+
+    auto NullRenderPassChunk::Draw(uint32_t numIndices, uint32_t startIndex, uint32_t startVertex, uint32_t numInstances, uint32_t startInstance) -> void {
+        if (!RequireRecording()) {
+            return;
+        }
+
+        if (!_bindings.CanDraw(numIndices, startIndex, numInstances, startInstance)) {
+            _stats->invalidCalls++;
+            return;
+        }
+
+        _counters.drawCalls++;
+        _counters.instancesDrawn += numInstances;
+        _counters.indicesDrawn += static_cast<uint64_t>(numIndices) * numInstances;
+        _draws.push_back(NullDraw{ startInstance, numInstances });
+    }
+
+    auto NullRenderPassChunk::BindVertexBuffer(std::shared_ptr<VertexBuffer> buffer) -> void {
+        if (RequireRecording()) {
+            _bindings.vertexBuffer = std::static_pointer_cast<NullVertexBuffer>(buffer);
+            _counters.bindings++;
+        }
+    }
+
+    auto NullRenderPassChunk::BindIndexBuffer(std::shared_ptr<IndexBuffer> buffer) -> void {
+        if (RequireRecording()) {
+            _bindings.indexBuffer = std::static_pointer_cast<NullIndexBuffer>(buffer);
+            _counters.bindings++;
+        }
+    }
+
+    auto NullRenderPassChunk::BindInstanceBuffer(std::shared_ptr<InstanceBuffer> buffer) -> void {
+        if (RequireRecording()) {
+            _bindings.instanceBuffer = std::static_pointer_cast<NullInstanceBuffer>(buffer);
+            _counters.bindings++;
+        }
+    }
+
+    auto NullRenderPassChunk::BindMaterial(std::shared_ptr<Material> material) -> void {
+        if (!RequireRecording()) {
+            return;
+        }
+
+        if (!_context.HasMaterialConstants(*material)) {
+            _stats->invalidCalls++;
+            return;
+        }
+
+        _bindings.hasPipeline = true;
+        _counters.bindings++;
+    }
+
+    auto NullRenderPassChunk::BindShadowMaterial(std::shared_ptr<Material> material) -> void {
+        if (RequireRecording()) {
+            _bindings.hasPipeline = true;
+            _counters.bindings++;
+        }
+    }
+
+    auto NullRenderPassChunk::Finish() -> void {
+        if (RequireRecording()) {
+            _state = State::Finished;
+        }
+    }
+
+    auto NullRenderPassChunk::Reset(uint64_t pass) -> void {
+        _state = State::Recording;
+        _pass = pass;
+        _bindings.Reset();
+        _counters = {};
+        _draws.clear();
+    }
+
+    auto NullRenderPassChunk::MarkSubmitted() -> void {
+        _state = State::Submitted;
+    }
+
+    auto NullRenderPassChunk::RequireRecording() -> bool {
+        if (_state != State::Recording) {
+            _stats->invalidCalls++;
+
+            return false;
+        }
+
+        return true;
+    }
+}
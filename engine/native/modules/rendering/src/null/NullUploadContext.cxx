@@ -0,0 +1,65 @@
+#include "rendering/null/NullUploadContext.hxx"
+#include "rendering/null/NullCubemap.hxx"
+#include "rendering/null/NullDevice.hxx"
+#include "rendering/null/NullIndexBuffer.hxx"
+#include "rendering/null/NullInstanceBuffer.hxx"
+#include "rendering/null/NullTexture.hxx"
+#include "rendering/null/NullVertexBuffer.hxx"
+
+namespace playground::rendering::null {
+    NullUploadContext::NullUploadContext(
+        std::string name,
+        std::shared_ptr<NullDevice> device,
+        std::shared_ptr<NullStats> stats
+    ) : _name(std::move(name)), _device(std::move(device)), _stats(std::move(stats)) {
+    }
+
+    auto NullUploadContext::Begin() -> void {
+        _isRecording = true;
+    }
+
+    auto NullUploadContext::Finish() -> void {
+        _isRecording = false;
+    }
+
+    auto NullUploadContext::WaitFor(const Context& other) -> void {
+    }
+
+    auto NullUploadContext::Upload(std::shared_ptr<Texture> texture, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void {
+        Count(std::static_pointer_cast<NullTexture>(texture)->Mips().Write(region, staging->Data() + offset));
+    }
+
+    auto NullUploadContext::Upload(std::shared_ptr<Cubemap> cubemap, const TextureRegion& region, std::shared_ptr<StagingBuffer> staging, uint64_t offset) -> void {
+        Count(std::static_pointer_cast<NullCubemap>(cubemap)->Faces().Write(region, staging->Data() + offset));
+    }
+
+    auto NullUploadContext::Upload(std::shared_ptr<IndexBuffer> buffer) -> void {
+        Count(std::static_pointer_cast<NullIndexBuffer>(buffer)->MakeResident());
+    }
+
+    auto NullUploadContext::Upload(std::shared_ptr<VertexBuffer> buffer) -> void {
+        Count(std::static_pointer_cast<NullVertexBuffer>(buffer)->MakeResident());
+    }
+
+    auto NullUploadContext::Upload(std::shared_ptr<InstanceBuffer> buffer, size_t count) -> void {
+        auto instanceBuffer = std::static_pointer_cast<NullInstanceBuffer>(buffer);
+        Count(instanceBuffer->Upload(count));
+        _stats->instancesUploaded += instanceBuffer->UploadedCount();
+    }
+
+    auto NullUploadContext::Upload(std::shared_ptr<InstanceBuffer> buffer, size_t first, size_t count) -> void {
+        auto instanceBuffer = std::static_pointer_cast<NullInstanceBuffer>(buffer);
+        auto bytes = instanceBuffer->Upload(first, count);
+        Count(bytes);
+        _stats->instancesUploaded += bytes / instanceBuffer->Stride();
+    }
+
+    auto NullUploadContext::Count(size_t bytes) -> void {
+        if (!_isRecording) {
+            _stats->invalidCalls++;
+        }
+
+        _stats->uploads++;
+        _stats->uploadedBytes += bytes;
+    }
+}
@@ -0,0 +1,53 @@
+#include <GTest/GTest.h>
+
+#include <rendering/DescriptorAllocator.hxx>
+#include <stdexcept>
+
+using namespace playground::rendering;
+
+TEST(DescriptorAllocator, RangesAreIndependent) {
+    DescriptorAllocator allocator({ { 0, 2 }, { 2, 3 } });
+
+    EXPECT_EQ(allocator.Allocate(0), 0u);
+    EXPECT_EQ(allocator.Allocate(0), 1u);
+    EXPECT_THROW(allocator.Allocate(0), std::runtime_error);
+    EXPECT_EQ(allocator.Allocate(1), 2u);
+
+    EXPECT_EQ(allocator.RangeOf(4), 1u);
+    EXPECT_EQ(allocator.RangeOf(5), DescriptorAllocator::INVALID_SLOT);
+    EXPECT_EQ(allocator.Used(0), 2u);
+    EXPECT_EQ(allocator.Used(1), 1u);
+}
+
+TEST(DescriptorAllocator, FreedSlotsWaitForTheirFence) {
+    DescriptorAllocator allocator({ { 64, 4 } });
+
+    allocator.BeginFrame(1, 0);
+    auto first = allocator.Allocate(0);
+    auto second = allocator.Allocate(0);
+    allocator.Free(first);
+    allocator.Free(second);
+
+    allocator.BeginFrame(2, 0);
+    EXPECT_EQ(allocator.Allocate(0), 66u);
+    EXPECT_EQ(allocator.Retired(), 2u);
+
+    // The latest free is handed out first
+    allocator.BeginFrame(3, 1);
+    EXPECT_EQ(allocator.Retired(), 0u);
+    EXPECT_EQ(allocator.Allocate(0), second);
+    EXPECT_EQ(allocator.Allocate(0), first);
+    EXPECT_EQ(allocator.Allocate(0), 67u);
+    EXPECT_EQ(allocator.Used(0), 4u);
+}
+
+TEST(DescriptorAllocator, RejectsInvalidFrees) {
+    DescriptorAllocator allocator({ { 0, 4 } });
+    auto slot = allocator.Allocate(0);
+
+    allocator.Free(slot);
+    EXPECT_THROW(allocator.Free(slot), std::runtime_error);
+    EXPECT_THROW(allocator.Free(3), std::runtime_error);
+    EXPECT_THROW(allocator.Free(100), std::runtime_error);
+    EXPECT_THROW(DescriptorAllocator({ { 0, 4 }, { 3, 4 } }), std::runtime_error);
+}
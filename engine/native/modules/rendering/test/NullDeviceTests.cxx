@@ -0,0 +1,210 @@
+#include <GTest/GTest.h>
+
+#include "NullScene.hxx"
+
+#include <rendering/MaterialConstants.hxx>
+#include <rendering/null/NullDevice.hxx>
+#include <rendering/null/NullInstanceBuffer.hxx>
+#include <rendering/null/NullTexture.hxx>
+#include <rendering/TextureRegion.hxx>
+#include <array>
+#include <cstring>
+
+using namespace playground::rendering;
+
+using namespace playground::rendering::testing;
+
+TEST(NullDevice, FreedDescriptorsAreReusedOnceTheirFrameCompleted) {
+    auto device = std::make_shared<null::NullDevice>(3);
+    device->BeginFrame(1);
+    auto first = device->CreateShadowMap(64, 64, "First");
+    auto firstId = first->ID();
+    first = nullptr;
+
+    // Frame 1 may still be in flight until frame 4 begins
+    device->BeginFrame(2);
+    device->BeginFrame(3);
+    auto second = device->CreateShadowMap(64, 64, "Second");
+    device->BeginFrame(4);
+    auto third = device->CreateShadowMap(64, 64, "Third");
+
+    EXPECT_NE(second->ID(), firstId);
+    EXPECT_EQ(third->ID(), firstId);
+    EXPECT_EQ(device->Stats().descriptorsAllocated, 3u);
+    EXPECT_EQ(device->Stats().descriptorsFreed, 1u);
+}
+
+TEST(NullDevice, UploadsCopyStagedInstances) {
+    NullScene scene;
+
+    std::memset(scene.instances->Data(), 0xAB, 64 * 4);
+    scene.Upload(4);
+
+    auto buffer = std::static_pointer_cast<null::NullInstanceBuffer>(scene.instances);
+    EXPECT_EQ(buffer->UploadedCount(), 4u);
+    EXPECT_EQ(buffer->Memory()[64 * 4 - 1], 0xAB);
+    EXPECT_EQ(buffer->Memory()[64 * 4], 0);
+    EXPECT_EQ(scene.device->Stats().uploads, 3u);
+    EXPECT_EQ(scene.device->Stats().uploadedBytes, 36u + 12u + 64u * 4u);
+    EXPECT_EQ(scene.device->Stats().instancesUploaded, 4u);
+    EXPECT_EQ(scene.device->Stats().invalidCalls, 0u);
+}
+
+TEST(NullDevice, RangedUploadsOnlyReplaceTheirInstances) {
+    NullScene scene;
+    std::memset(scene.instances->Data(), 0xAB, 64 * 8);
+    scene.Upload(8);
+
+    // A patch of instances 2 and 3, the resident copy of every other instance stays as it was
+    std::memset(scene.instances->Data(), 0xCD, 64 * 8);
+    auto upload = scene.device->CreateUploadContext("Patch");
+    upload->Begin();
+    upload->Upload(scene.instances, 2, 2);
+    upload->Finish();
+
+    auto buffer = std::static_pointer_cast<null::NullInstanceBuffer>(scene.instances);
+    EXPECT_EQ(buffer->UploadedCount(), 8u);
+    EXPECT_EQ(buffer->Memory()[64 * 2 - 1], 0xAB);
+    EXPECT_EQ(buffer->Memory()[64 * 2], 0xCD);
+    EXPECT_EQ(buffer->Memory()[64 * 4 - 1], 0xCD);
+    EXPECT_EQ(buffer->Memory()[64 * 4], 0xAB);
+    EXPECT_EQ(scene.device->Stats().instancesUploaded, 10u);
+}
+
+TEST(NullDevice, TexturesAreResidentOnceEveryRegionWasUploaded) {
+    NullScene scene;
+    auto texture = scene.device->CreateTexture(64, 64, 2);
+    auto staging = scene.device->CreateStagingBuffer(64 * 1024);
+    // 16 block rows of 256 bytes in mip 0, 8 in mip 1, at most 4 rows per region
+    auto regions = SplitTexture(64, 64, 2, 1, 1024);
+    ASSERT_EQ(regions.size(), 6u);
+
+    std::vector<uint8_t> mip0(16 * 256);
+    for (size_t i = 0; i < mip0.size(); i++) {
+        mip0[i] = static_cast<uint8_t>(i / 256);
+    }
+
+    auto upload = scene.device->CreateUploadContext("Texture");
+    uint64_t offset = 0;
+    for (size_t i = 0; i < regions.size(); i++) {
+        upload->Begin();
+        if (regions[i].subresource == 0) {
+            StageTextureRegion(mip0.data(), mip0.size(), regions[i], staging->Data() + offset);
+        }
+        upload->Upload(texture, regions[i], staging, offset);
+        upload->Finish();
+        offset += TEXTURE_PLACEMENT_ALIGNMENT * 2;
+
+        auto null = std::static_pointer_cast<null::NullTexture>(texture);
+        EXPECT_EQ(null->IsResident(), i == regions.size() - 1);
+    }
+
+    auto null = std::static_pointer_cast<null::NullTexture>(texture);
+    EXPECT_EQ(null->Mips().Subresource(0), mip0);
+    EXPECT_EQ(scene.device->Stats().invalidCalls, 0u);
+}
+
+TEST(NullDevice, DrawsAreValidatedAgainstUploadedInstances) {
+    NullScene scene;
+    auto& graphics = scene.graphics;
+    auto material = scene.device->CreateMaterial("", "", MaterialType::Standard);
+    scene.Upload(4);
+
+    graphics->Begin();
+    graphics->BeginRenderPass(RenderPass::Opaque, nullptr, nullptr);
+    std::array<uint8_t, MAX_MATERIAL_SIZE_BYTES> constants = {};
+    graphics->SetMaterialsData(constants.data(), material->id, 1);
+    graphics->BindMaterial(material);
+    graphics->BindVertexBuffer(scene.vertices);
+    graphics->BindIndexBuffer(scene.indices);
+    graphics->BindInstanceBuffer(scene.instances);
+    graphics->Draw(3, 0, 0, 4, 0);
+    // Reads instances that were never uploaded
+    graphics->Draw(3, 0, 0, 4, 2);
+    graphics->EndRenderPass();
+    graphics->Finish();
+
+    EXPECT_EQ(scene.device->Stats().drawCalls, 1u);
+    EXPECT_EQ(scene.device->Stats().instancesDrawn, 4u);
+    EXPECT_EQ(scene.device->Stats().indicesDrawn, 12u);
+    EXPECT_EQ(scene.device->Stats().invalidCalls, 1u);
+    EXPECT_EQ(scene.device->Stats().contextSubmissions, 1u);
+}
+
+TEST(NullDevice, DrawingOutsideARenderPassIsInvalid) {
+    NullScene scene;
+
+    scene.graphics->Begin();
+    scene.graphics->Draw(3);
+    scene.graphics->Finish();
+
+    EXPECT_EQ(scene.device->Stats().drawCalls, 0u);
+    EXPECT_EQ(scene.device->Stats().invalidCalls, 1u);
+}
+
+TEST(NullDevice, MaterialsPastTheBufferDrawWithTheFallbackEntry) {
+    NullScene scene;
+    auto& graphics = scene.graphics;
+    auto material = scene.device->CreateMaterial("", "", MaterialType::Standard);
+    MaterialConstants constants(1);
+    material->id = MAX_MATERIALS + 5;
+    constants.Update(*material);
+
+    eastl::vector<MaterialEntry> changes;
+    constants.TakeStaged(changes);
+    EXPECT_TRUE(changes.empty());
+    constants.Apply(changes);
+
+    graphics->Begin();
+    constants.UploadDirty(0, [&](uint32_t first, uint32_t count, const uint8_t* data) {
+        // Only the fallback entry was ever marked, the material didn't write past the buffer
+        EXPECT_EQ(first, FALLBACK_MATERIAL_SLOT);
+        EXPECT_EQ(count, 1u);
+        graphics->SetMaterialsData(data, first, count);
+    });
+    graphics->BeginRenderPass(RenderPass::Opaque, nullptr, nullptr);
+    graphics->BindMaterial(material);
+    graphics->EndRenderPass();
+    graphics->Finish();
+
+    EXPECT_EQ(MaterialConstants::Slot(material->id), FALLBACK_MATERIAL_SLOT);
+    EXPECT_EQ(scene.device->Stats().invalidCalls, 0u);
+}
+
+TEST(NullDevice, MaterialChangesReachTheEntriesWithTheNextPacket) {
+    NullScene scene;
+    auto material = scene.device->CreateMaterial("", "", MaterialType::Standard);
+    MaterialConstants constants(2);
+    material->id = 3;
+    material->floats = { 1.0f };
+    constants.Update(*material);
+
+    eastl::vector<MaterialEntry> packet;
+    constants.TakeStaged(packet);
+    ASSERT_EQ(packet.size(), 1u);
+
+    // Staged after the packet was taken, the render thread must not see it before the next one
+    material->floats = { 2.0f };
+    constants.Update(*material);
+    material->floats = { 3.0f };
+    constants.Update(*material);
+
+    constants.Apply(packet);
+    float value = 0.0f;
+    std::memcpy(&value, constants.Entry(3), sizeof(float));
+    EXPECT_EQ(value, 1.0f);
+
+    // Every frame slot uploads the entry once, next to the fallback entry
+    for (uint8_t frame = 0; frame < 2; frame++) {
+        uint32_t uploaded = 0;
+        constants.UploadDirty(frame, [&](uint32_t first, uint32_t count, const uint8_t*) { uploaded += count; });
+        EXPECT_EQ(uploaded, 2u);
+    }
+
+    eastl::vector<MaterialEntry> next;
+    constants.TakeStaged(next);
+    ASSERT_EQ(next.size(), 1u);
+    constants.Apply(next);
+    std::memcpy(&value, constants.Entry(3), sizeof(float));
+    EXPECT_EQ(value, 3.0f);
+}
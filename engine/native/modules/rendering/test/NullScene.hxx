@@ -0,0 +1,42 @@
+#pragma once
+
+#include <rendering/null/NullDevice.hxx>
+#include <rendering/null/NullGraphicsContext.hxx>
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace playground::rendering::testing {
+    /// Null device with a graphics context, one triangle and an instance buffer, the geometry every rendering test draws
+    struct NullScene {
+        std::shared_ptr<null::NullDevice> device = std::make_shared<null::NullDevice>(3);
+        std::shared_ptr<GraphicsContext> graphics;
+        std::shared_ptr<VertexBuffer> vertices;
+        std::shared_ptr<IndexBuffer> indices;
+        std::shared_ptr<InstanceBuffer> instances;
+
+        explicit NullScene(uint32_t instanceCount = 16) {
+            graphics = device->CreateGraphicsContext("Graphics", nullptr, 800, 600, true);
+
+            std::array<float, 9> positions = {};
+            std::array<uint32_t, 3> triangle = { 0, 1, 2 };
+            vertices = device->CreateVertexBuffer(positions.data(), sizeof(positions), sizeof(float) * 3, true);
+            indices = device->CreateIndexBuffer(triangle.data(), triangle.size());
+            instances = device->CreateInstanceBuffer(instanceCount, 64);
+        }
+
+        /// Uploads the triangle and the first instanceCount instances, draws past them are invalid
+        auto Upload(uint32_t instanceCount) -> void {
+            auto upload = device->CreateUploadContext("Upload");
+            upload->Begin();
+            upload->Upload(vertices);
+            upload->Upload(indices);
+            upload->Upload(instances, instanceCount);
+            upload->Finish();
+        }
+
+        auto Null() -> null::NullGraphicsContext& {
+            return static_cast<null::NullGraphicsContext&>(*graphics);
+        }
+    };
+}
@@ -0,0 +1,145 @@
+#include <GTest/GTest.h>
+
+#include "NullScene.hxx"
+
+#include <rendering/ParallelPassRecording.hxx>
+#include <rendering/StateTrackingGraphicsContext.hxx>
+#include <thread>
+#include <vector>
+
+using namespace playground::rendering;
+using namespace playground::rendering::testing;
+
+namespace {
+    constexpr uint32_t INSTANCES = 1024;
+
+    // Every item draws the shadow pipeline, so chunks need no material constants
+    struct Pass : NullScene {
+        std::shared_ptr<Material> material;
+
+        Pass() : NullScene(INSTANCES) {
+            material = device->CreateMaterial("", "", MaterialType::Shadow);
+            Upload(INSTANCES);
+        }
+
+        // Draws instance x for every item x
+        auto Recorder() -> ChunkRecorder {
+            return [this](RenderPassChunk& chunk, size_t begin, size_t end) {
+                chunk.BindShadowMaterial(material);
+                chunk.BindInstanceBuffer(instances);
+                for (size_t x = begin; x < end; x++) {
+                    chunk.BindVertexBuffer(vertices);
+                    chunk.BindIndexBuffer(indices);
+                    chunk.Draw(3, 0, 0, 1, static_cast<uint32_t>(x));
+                }
+            };
+        }
+    };
+
+    // Runs the chunks on their own threads, started last to first so they finish out of order
+    void DispatchReversed(size_t count, const std::function<void(size_t chunk)>& task) {
+        std::vector<std::thread> threads;
+        for (size_t chunk = count; chunk > 0; chunk--) {
+            threads.emplace_back([&task, chunk] { task(chunk - 1); });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+}
+
+TEST(ParallelPassRecording, ChunkCountRespectsMinimumAndMaximum) {
+    EXPECT_EQ(PassChunkCount(0, 256, 8), 0u);
+    EXPECT_EQ(PassChunkCount(100, 256, 8), 1u);
+    EXPECT_EQ(PassChunkCount(1000, 256, 8), 4u);
+    EXPECT_EQ(PassChunkCount(100000, 256, 8), 8u);
+    EXPECT_EQ(PassChunkCount(10, 0, 4), 4u);
+}
+
+TEST(ParallelPassRecording, SubmitsChunksInItemOrder) {
+    Pass pass;
+
+    pass.graphics->Begin();
+    pass.graphics->BeginRenderPass(RenderPass::Shadow, nullptr, nullptr);
+    RecordPassChunks(*pass.graphics, INSTANCES, 7, DispatchReversed, pass.Recorder());
+    pass.graphics->EndRenderPass();
+    pass.graphics->Finish();
+
+    const auto& draws = pass.Null().Draws();
+    ASSERT_EQ(draws.size(), INSTANCES);
+    for (uint32_t x = 0; x < INSTANCES; x++) {
+        EXPECT_EQ(draws[x].startInstance, x);
+    }
+
+    EXPECT_EQ(pass.device->Stats().chunksSubmitted, 7u);
+    EXPECT_EQ(pass.device->Stats().drawCalls, INSTANCES);
+    EXPECT_EQ(pass.device->Stats().invalidCalls, 0u);
+}
+
+TEST(ParallelPassRecording, ChunksAreReusedAfterBegin) {
+    Pass pass;
+    std::vector<std::shared_ptr<RenderPassChunk>> first;
+    std::vector<std::shared_ptr<RenderPassChunk>> second;
+
+    pass.graphics->Begin();
+    pass.graphics->BeginRenderPass(RenderPass::Shadow, nullptr, nullptr);
+    pass.graphics->AcquireChunks(2, first);
+    for (auto& chunk : first) {
+        chunk->Finish();
+    }
+    pass.graphics->SubmitChunks(first);
+    pass.graphics->EndRenderPass();
+    pass.graphics->Finish();
+
+    pass.graphics->Begin();
+    pass.graphics->BeginRenderPass(RenderPass::Shadow, nullptr, nullptr);
+    pass.graphics->AcquireChunks(2, second);
+    for (auto& chunk : second) {
+        chunk->Finish();
+    }
+    pass.graphics->SubmitChunks(second);
+    pass.graphics->EndRenderPass();
+    pass.graphics->Finish();
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(pass.device->Stats().invalidCalls, 0u);
+}
+
+TEST(ParallelPassRecording, RejectsChunksOutsideTheirPass) {
+    Pass pass;
+    std::vector<std::shared_ptr<RenderPassChunk>> chunks;
+
+    pass.graphics->Begin();
+    pass.graphics->BeginRenderPass(RenderPass::Shadow, nullptr, nullptr);
+    pass.graphics->AcquireChunks(1, chunks);
+    // Unfinished chunks can't be executed and the pass ends with one that never was
+    pass.graphics->SubmitChunks(chunks);
+    pass.graphics->EndRenderPass();
+
+    chunks.front()->Finish();
+    pass.graphics->BeginRenderPass(RenderPass::Opaque, nullptr, nullptr);
+    pass.graphics->SubmitChunks(chunks);
+    pass.graphics->EndRenderPass();
+    pass.graphics->Finish();
+
+    EXPECT_EQ(pass.device->Stats().invalidCalls, 3u);
+    EXPECT_EQ(pass.device->Stats().chunksSubmitted, 0u);
+}
+
+TEST(ParallelPassRecording, StateTrackingSkipsRedundantBindsPerChunk) {
+    Pass pass;
+    auto context = std::make_shared<StateTrackingGraphicsContext>(pass.graphics);
+
+    context->Begin();
+    context->BeginRenderPass(RenderPass::Shadow, nullptr, nullptr);
+    RecordPassChunks(*context, 8, 2, DispatchReversed, pass.Recorder());
+    context->EndRenderPass();
+    context->Finish();
+
+    // Each chunk binds the pipeline, the instances, vertices and indices once
+    EXPECT_EQ(context->Stats().issuedBinds, 8u);
+    EXPECT_EQ(context->Stats().skippedBinds, 12u);
+    EXPECT_EQ(pass.Null().Draws().size(), 8u);
+    EXPECT_EQ(pass.device->Stats().invalidCalls, 0u);
+}
@@ -0,0 +1,123 @@
+#include <GTest/GTest.h>
+
+#include <rendering/RenderGraph.hxx>
+#include <stdexcept>
+
+using namespace playground::rendering;
+
+TEST(RenderGraph, CullsPassesNoOutputDependsOn) {
+    RenderGraph graph;
+    auto colour = graph.Import("Colour", ResourceState::RenderTarget, ResourceState::RenderTarget);
+    auto nearCascade = graph.Import("Near Cascade", ResourceState::DepthWrite, ResourceState::DepthWrite);
+    auto farCascade = graph.Import("Far Cascade", ResourceState::DepthWrite, ResourceState::DepthWrite);
+    graph.MarkOutput(colour);
+
+    auto nearShadows = graph.AddPass("Near Shadows");
+    graph.Write(nearShadows, nearCascade, ResourceState::DepthWrite);
+    auto farShadows = graph.AddPass("Far Shadows");
+    graph.Write(farShadows, farCascade, ResourceState::DepthWrite);
+    auto opaque = graph.AddPass("Opaque");
+    graph.Read(opaque, nearCascade, ResourceState::ShaderResource);
+    graph.Write(opaque, colour, ResourceState::RenderTarget);
+    auto readback = graph.AddPass("Readback");
+    graph.SetSideEffects(readback);
+
+    CompiledRenderGraph compiled;
+    graph.Compile(compiled);
+
+    ASSERT_EQ(compiled.passes.size(), 3u);
+    EXPECT_EQ(compiled.passes[0].pass, nearShadows);
+    EXPECT_EQ(compiled.passes[1].pass, opaque);
+    EXPECT_EQ(compiled.passes[2].pass, readback);
+}
+
+TEST(RenderGraph, OnlyTransitionsOnStateChanges) {
+    RenderGraph graph;
+    auto colour = graph.Import("Colour", ResourceState::RenderTarget, ResourceState::RenderTarget);
+    auto depth = graph.Import("Depth", ResourceState::DepthWrite, ResourceState::DepthWrite);
+    graph.MarkOutput(colour);
+
+    auto opaque = graph.AddPass("Opaque");
+    graph.Write(opaque, colour, ResourceState::RenderTarget);
+    graph.Write(opaque, depth, ResourceState::DepthWrite);
+    for (auto name : { "Fog", "Outline" }) {
+        auto effect = graph.AddPass(name);
+        graph.Read(effect, depth, ResourceState::ShaderResource);
+        graph.Write(effect, colour, ResourceState::RenderTarget);
+    }
+
+    CompiledRenderGraph compiled;
+    graph.Compile(compiled);
+
+    ASSERT_EQ(compiled.passes.size(), 3u);
+    EXPECT_TRUE(compiled.passes[0].barriers.empty());
+    ASSERT_EQ(compiled.passes[1].barriers.size(), 1u);
+    EXPECT_EQ(compiled.passes[1].barriers[0].resource, depth);
+    EXPECT_EQ(compiled.passes[1].barriers[0].before, ResourceState::DepthWrite);
+    EXPECT_EQ(compiled.passes[1].barriers[0].after, ResourceState::ShaderResource);
+    EXPECT_TRUE(compiled.passes[2].barriers.empty());
+
+    ASSERT_EQ(compiled.finalBarriers.size(), 1u);
+    EXPECT_EQ(compiled.finalBarriers[0].resource, depth);
+    EXPECT_EQ(compiled.finalBarriers[0].after, ResourceState::DepthWrite);
+}
+
+TEST(RenderGraph, AliasesTransientsThatDontLiveAtTheSameTime) {
+    RenderGraph graph;
+    auto colour = graph.Import("Colour", ResourceState::RenderTarget, ResourceState::RenderTarget);
+    graph.MarkOutput(colour);
+    auto spotShadows = graph.CreateTransient("Spot Shadows", { .size = 4096, .alignment = 1024 });
+    auto pointShadows = graph.CreateTransient("Point Shadows", { .size = 4096, .alignment = 1024 });
+    auto bloom = graph.CreateTransient("Bloom", { .size = 1000, .alignment = 1024 });
+
+    auto spot = graph.AddPass("Spot Shadows");
+    graph.Write(spot, spotShadows, ResourceState::DepthWrite);
+    auto spotLighting = graph.AddPass("Spot Lighting");
+    graph.Read(spotLighting, spotShadows, ResourceState::ShaderResource);
+    graph.Write(spotLighting, colour, ResourceState::RenderTarget);
+    auto point = graph.AddPass("Point Shadows");
+    graph.Write(point, pointShadows, ResourceState::DepthWrite);
+    auto bloomPass = graph.AddPass("Bloom");
+    graph.Write(bloomPass, bloom, ResourceState::RenderTarget);
+    auto pointLighting = graph.AddPass("Point Lighting");
+    graph.Read(pointLighting, pointShadows, ResourceState::ShaderResource);
+    graph.Read(pointLighting, bloom, ResourceState::ShaderResource);
+    graph.Write(pointLighting, colour, ResourceState::RenderTarget);
+
+    CompiledRenderGraph compiled;
+    graph.Compile(compiled);
+
+    ASSERT_EQ(compiled.transients.size(), 3u);
+    const auto& spotPlacement = compiled.transients[0];
+    const auto& pointPlacement = compiled.transients[1];
+    const auto& bloomPlacement = compiled.transients[2];
+    EXPECT_EQ(spotPlacement.firstPass, 0u);
+    EXPECT_EQ(spotPlacement.lastPass, 1u);
+    EXPECT_EQ(pointPlacement.firstPass, 2u);
+    EXPECT_EQ(pointPlacement.lastPass, 4u);
+
+    // The shadow maps share memory, bloom lives next to the point shadows and is aligned behind them
+    EXPECT_EQ(spotPlacement.offset, pointPlacement.offset);
+    EXPECT_EQ(bloomPlacement.offset, 4096u);
+    EXPECT_EQ(compiled.transientHeapSize, 4096u + 1000u);
+
+    // Aliased memory holds garbage when a transient is first used
+    ASSERT_EQ(compiled.passes[2].barriers.size(), 1u);
+    EXPECT_EQ(compiled.passes[2].barriers[0].before, ResourceState::Undefined);
+    EXPECT_EQ(compiled.passes[2].barriers[0].after, ResourceState::DepthWrite);
+}
+
+TEST(RenderGraph, RejectsInvalidAccesses) {
+    RenderGraph graph;
+    auto colour = graph.Import("Colour", ResourceState::RenderTarget, ResourceState::RenderTarget);
+    auto depth = graph.CreateTransient("Depth", { .size = 64, .alignment = 64 });
+    graph.MarkOutput(colour);
+
+    auto pass = graph.AddPass("Opaque");
+    graph.Write(pass, colour, ResourceState::RenderTarget);
+    EXPECT_THROW(graph.Read(pass, colour, ResourceState::ShaderResource), std::runtime_error);
+
+    graph.Read(pass, depth, ResourceState::ShaderResource);
+    CompiledRenderGraph compiled;
+    EXPECT_THROW(graph.Compile(compiled), std::runtime_error);
+}
@@ -0,0 +1,91 @@
+#include <GTest/GTest.h>
+
+#include "NullScene.hxx"
+
+#include <rendering/StateTrackingGraphicsContext.hxx>
+
+using namespace playground::rendering;
+using namespace playground::rendering::testing;
+
+namespace {
+    struct Recording : NullScene {
+        std::shared_ptr<StateTrackingGraphicsContext> context;
+
+        Recording() {
+            context = std::make_shared<StateTrackingGraphicsContext>(graphics);
+            Upload(16);
+        }
+
+        auto Material(uint32_t id) -> std::shared_ptr<playground::rendering::Material> {
+            // Post processing materials bind their own constants, so SetMaterialData reaches the backend
+            auto material = device->CreateMaterial("", "", MaterialType::PostProcessing);
+            material->id = id;
+            return material;
+        }
+
+        auto DrawWith(std::shared_ptr<playground::rendering::Material> material, uint32_t instance) -> void {
+            context->SetMaterialData(material);
+            context->BindVertexBuffer(vertices);
+            context->BindIndexBuffer(indices);
+            context->BindMaterial(material);
+            context->Draw(3, 0, 0, 1, instance);
+        }
+    };
+}
+
+TEST(StateTrackingGraphicsContext, SkipsRebindingSharedState) {
+    Recording recording;
+    auto first = recording.Material(0);
+    auto second = recording.Material(1);
+
+    recording.context->Begin();
+    recording.context->BeginRenderPass(RenderPass::Opaque, nullptr, nullptr);
+    recording.context->BindInstanceBuffer(recording.instances);
+    recording.DrawWith(first, 0);
+    recording.DrawWith(first, 1);
+    recording.DrawWith(second, 2);
+    recording.DrawWith(first, 3);
+    recording.context->EndRenderPass();
+    recording.context->Finish();
+
+    const auto& stats = recording.context->Stats();
+    // Instance buffer, vertex buffer, index buffer and three material switches
+    EXPECT_EQ(stats.issuedBinds, 6u);
+    EXPECT_EQ(stats.skippedBinds, 7u);
+    EXPECT_EQ(stats.issuedMaterialUploads, 2u);
+    EXPECT_EQ(stats.skippedMaterialUploads, 2u);
+    EXPECT_EQ(recording.device->Stats().drawCalls, 4u);
+    EXPECT_EQ(recording.device->Stats().invalidCalls, 0u);
+}
+
+TEST(StateTrackingGraphicsContext, RebindsInEveryPass) {
+    Recording recording;
+    auto material = recording.Material(0);
+
+    recording.context->Begin();
+    for (int x = 0; x < 2; x++) {
+        recording.context->BeginRenderPass(RenderPass::Opaque, nullptr, nullptr);
+        recording.context->BindInstanceBuffer(recording.instances);
+        recording.DrawWith(material, 0);
+        recording.context->EndRenderPass();
+    }
+    recording.context->Finish();
+
+    EXPECT_EQ(recording.context->Stats().skippedBinds, 0u);
+    EXPECT_EQ(recording.context->Stats().skippedMaterialUploads, 1u);
+    EXPECT_EQ(recording.device->Stats().drawCalls, 2u);
+    EXPECT_EQ(recording.device->Stats().invalidCalls, 0u);
+}
+
+TEST(StateTrackingGraphicsContext, UploadsMaterialsAgainInTheNextFrame) {
+    Recording recording;
+    auto material = recording.Material(0);
+
+    for (int x = 0; x < 2; x++) {
+        recording.context->Begin();
+        recording.context->SetMaterialData(material);
+        recording.context->Finish();
+
+        EXPECT_EQ(recording.context->Stats().issuedMaterialUploads, 1u);
+    }
+}
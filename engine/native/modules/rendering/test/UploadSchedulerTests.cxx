@@ -0,0 +1,231 @@
+#include <GTest/GTest.h>
+
+#include <rendering/TextureRegion.hxx>
+#include <rendering/UploadScheduler.hxx>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace playground::rendering;
+using namespace std::chrono_literals;
+
+namespace {
+    constexpr UploadBudget UNLIMITED = { .bytes = UINT64_MAX, .time = 1h };
+
+    // Logs "name:part" for every uploaded part
+    auto LoggedJob(std::vector<std::string>& log, std::string name, UploadPriority priority, std::vector<uint64_t> parts) -> UploadJob {
+        return UploadJob{
+            .priority = priority,
+            .parts = std::move(parts),
+            .upload = [&log, name](size_t part, uint64_t) { log.push_back(name + ":" + std::to_string(part)); },
+        };
+    }
+}
+
+TEST(StagingRing, WrapsAndReclaimsInFenceOrder) {
+    StagingRing ring(100, 1);
+
+    EXPECT_EQ(ring.Allocate(40, 1), 0u);
+    EXPECT_EQ(ring.Allocate(40, 1), 40u);
+    EXPECT_EQ(ring.Allocate(40, 2), StagingRing::INVALID_OFFSET);
+
+    ring.Reclaim(1);
+    EXPECT_EQ(ring.Used(), 0u);
+    EXPECT_EQ(ring.Allocate(40, 2), 0u);
+    EXPECT_EQ(ring.Allocate(50, 3), 40u);
+    EXPECT_EQ(ring.Allocate(30, 4), StagingRing::INVALID_OFFSET);
+
+    // The last 10 bytes are skipped, the reservation starts over at the beginning
+    ring.Reclaim(2);
+    EXPECT_EQ(ring.Allocate(30, 4), 0u);
+    EXPECT_EQ(ring.Used(), 90u);
+    EXPECT_EQ(ring.Allocate(15, 4), StagingRing::INVALID_OFFSET);
+    EXPECT_EQ(ring.Allocate(10, 4), 30u);
+    EXPECT_EQ(ring.Used(), 100u);
+
+    ring.Reclaim(3);
+    EXPECT_EQ(ring.Used(), 50u);
+    EXPECT_EQ(ring.Allocate(200, 5), StagingRing::INVALID_OFFSET);
+}
+
+TEST(StagingRing, ReservationsStartAligned) {
+    StagingRing ring(1024, 256);
+
+    EXPECT_EQ(ring.Allocate(10, 1), 0u);
+    EXPECT_EQ(ring.Allocate(300, 1), 256u);
+    EXPECT_EQ(ring.Used(), 768u);
+}
+
+TEST(UploadScheduler, UploadsByPriorityWithinTheByteBudget) {
+    std::vector<std::string> log;
+    UploadScheduler scheduler(1024, 1);
+    scheduler.Enqueue(LoggedJob(log, "prefetch", UploadPriority::Prefetch, { 10 }));
+    scheduler.Enqueue(LoggedJob(log, "visible", UploadPriority::Visible, { 10, 10, 10 }));
+    scheduler.Enqueue(LoggedJob(log, "nearby", UploadPriority::Nearby, { 10 }));
+
+    scheduler.BeginFrame(1, 0);
+    auto first = scheduler.Run({ .bytes = 25, .time = 1h });
+    EXPECT_EQ(first.bytes, 20u);
+    EXPECT_EQ(log, (std::vector<std::string>{ "visible:0", "visible:1" }));
+
+    scheduler.BeginFrame(2, 0);
+    scheduler.Run({ .bytes = 25, .time = 1h });
+    EXPECT_EQ(log, (std::vector<std::string>{ "visible:0", "visible:1", "visible:2", "nearby:0" }));
+    EXPECT_EQ(scheduler.Queued(), 1u);
+    EXPECT_EQ(scheduler.InFlight(), 2u);
+}
+
+TEST(UploadScheduler, LargePartsStillMakeProgress) {
+    std::vector<std::string> log;
+    UploadScheduler scheduler(1024, 1);
+    scheduler.Enqueue(LoggedJob(log, "texture", UploadPriority::Visible, { 50, 1 }));
+
+    scheduler.BeginFrame(1, 0);
+    auto stats = scheduler.Run({ .bytes = 5, .time = 1h });
+
+    // Larger than the budget, it goes out alone
+    EXPECT_EQ(stats.parts, 1u);
+    EXPECT_EQ(stats.bytes, 50u);
+
+    scheduler.BeginFrame(2, 0);
+    scheduler.Run({ .bytes = 5, .time = 1h });
+    EXPECT_EQ(log, (std::vector<std::string>{ "texture:0", "texture:1" }));
+}
+
+TEST(UploadScheduler, CompletesJobsOnceTheirFenceCompleted) {
+    std::vector<std::string> log;
+    bool completed = false;
+    UploadScheduler scheduler(1024, 1);
+    auto job = LoggedJob(log, "mesh", UploadPriority::Visible, { 100, 100 });
+    job.onComplete = [&completed] { completed = true; };
+    scheduler.Enqueue(std::move(job));
+
+    scheduler.BeginFrame(1, 0);
+    scheduler.Run({ .bytes = 100, .time = 1h });
+    scheduler.BeginFrame(2, 0);
+    scheduler.Run({ .bytes = 100, .time = 1h });
+    EXPECT_EQ(scheduler.InFlight(), 1u);
+
+    scheduler.BeginFrame(3, 1);
+    EXPECT_FALSE(completed);
+    scheduler.BeginFrame(4, 2);
+    EXPECT_TRUE(completed);
+    EXPECT_EQ(scheduler.InFlight(), 0u);
+}
+
+TEST(UploadScheduler, StopsWhenTheTimeBudgetIsSpent) {
+    size_t uploaded = 0;
+    UploadScheduler scheduler(1024, 1);
+    scheduler.Enqueue(UploadJob{
+        .parts = { 1, 1, 1 },
+        .upload = [&uploaded](size_t part, uint64_t) {
+            std::this_thread::sleep_for(2ms);
+            uploaded++;
+        },
+    });
+
+    scheduler.BeginFrame(1, 0);
+    scheduler.Run({ .bytes = UINT64_MAX, .time = 1ms });
+    EXPECT_EQ(uploaded, 1u);
+}
+
+TEST(UploadScheduler, StagedPartsWaitForRoomInTheRing) {
+    std::vector<std::string> log;
+    UploadScheduler scheduler(100, 1);
+    auto job = LoggedJob(log, "texture", UploadPriority::Visible, { 60, 60 });
+    job.staged = true;
+    scheduler.Enqueue(std::move(job));
+
+    scheduler.BeginFrame(1, 0);
+    scheduler.Run(UNLIMITED);
+    EXPECT_EQ(log.size(), 1u);
+    EXPECT_EQ(scheduler.Staging().Used(), 60u);
+
+    // Frame 1 is still in flight, its part keeps the space
+    scheduler.BeginFrame(2, 0);
+    scheduler.Run(UNLIMITED);
+    EXPECT_EQ(log.size(), 1u);
+
+    scheduler.BeginFrame(3, 1);
+    scheduler.Run(UNLIMITED);
+    EXPECT_EQ(log, (std::vector<std::string>{ "texture:0", "texture:1" }));
+}
+
+TEST(UploadScheduler, RejectsStagedPartsLargerThanTheRing) {
+    std::vector<std::string> log;
+    UploadScheduler scheduler(100, 1);
+    auto job = LoggedJob(log, "texture", UploadPriority::Visible, { 101 });
+    job.staged = true;
+
+    EXPECT_THROW(scheduler.Enqueue(std::move(job)), std::invalid_argument);
+}
+
+TEST(UploadScheduler, SpreadsAnOversizedTextureOverSeveralFrames) {
+    // 1024x1024 with a full mip chain is about 1.4 MB staged, four times the frame's budget
+    constexpr uint32_t SIZE = 1024;
+    constexpr uint32_t MIPS = 11;
+    constexpr uint64_t PART_SIZE = 64 * 1024;
+    constexpr UploadBudget BUDGET = { .bytes = 256 * 1024, .time = 1h };
+    constexpr uint64_t FRAMES_IN_FLIGHT = 3;
+
+    auto regions = SplitTexture(SIZE, SIZE, MIPS, 1, PART_SIZE);
+    std::vector<uint64_t> parts;
+    uint64_t total = 0;
+    for (const auto& region : regions) {
+        EXPECT_LE(region.StagingBytes(), PART_SIZE);
+        parts.push_back(region.StagingBytes());
+        total += region.StagingBytes();
+    }
+    ASSERT_GT(total, BUDGET.bytes * FRAMES_IN_FLIGHT);
+
+    // Every block row of every mip has to arrive exactly once
+    std::vector<std::vector<uint32_t>> rowUploads(MIPS);
+    for (uint32_t mip = 0; mip < MIPS; mip++) {
+        rowUploads[mip].resize(TextureRowCount(std::max(SIZE >> mip, 1u)));
+    }
+
+    UploadScheduler scheduler(BUDGET.bytes * FRAMES_IN_FLIGHT, TEXTURE_PLACEMENT_ALIGNMENT);
+    bool completed = false;
+    uint64_t frameBytes = 0;
+    scheduler.Enqueue(UploadJob{
+        .parts = parts,
+        .staged = true,
+        .upload = [&](size_t part, uint64_t offset) {
+            EXPECT_EQ(offset % TEXTURE_PLACEMENT_ALIGNMENT, 0u);
+            EXPECT_LE(offset + regions[part].StagingBytes(), BUDGET.bytes * FRAMES_IN_FLIGHT);
+            frameBytes += regions[part].StagingBytes();
+
+            const auto& region = regions[part];
+            for (uint32_t row = region.firstRow; row < region.firstRow + region.rowCount; row++) {
+                rowUploads[region.subresource][row]++;
+            }
+        },
+        .onComplete = [&completed] { completed = true; },
+    });
+
+    uint64_t frame = 0;
+    uint32_t framesUploading = 0;
+    while (!completed) {
+        frame++;
+        ASSERT_LT(frame, 100u);
+        scheduler.BeginFrame(frame, frame > FRAMES_IN_FLIGHT ? frame - FRAMES_IN_FLIGHT : 0);
+
+        frameBytes = 0;
+        scheduler.Run(BUDGET);
+        EXPECT_LE(frameBytes, BUDGET.bytes);
+        EXPECT_LE(scheduler.Staging().Used(), scheduler.Staging().Capacity());
+        if (frameBytes > 0) {
+            framesUploading++;
+        }
+    }
+
+    EXPECT_GE(framesUploading, 5u);
+    for (const auto& mip : rowUploads) {
+        for (auto uploads : mip) {
+            EXPECT_EQ(uploads, 1u);
+        }
+    }
+    EXPECT_EQ(scheduler.Staging().Used(), 0u);
+}
@@ -16,4 +16,10 @@ namespace playground::jobsystem {
 
     uint8_t HighPerfWorkers();
     uint8_t LowPerfWorkers();
+
+    /// Number of ranges ParallelFor splits count items into, at most one per high performance worker plus the caller
+    size_t ParallelRanges(size_t count, size_t minRangeSize);
+    /// Splits [0, count) into ParallelRanges ranges and runs them on the high performance workers, the calling thread takes the first one.
+    /// Blocks until every range is done. The range index is stable for a given count and can be used to address per range scratch data.
+    void ParallelFor(const char* name, size_t count, size_t minRangeSize, const std::function<void(size_t range, size_t begin, size_t end)>& task);
 }
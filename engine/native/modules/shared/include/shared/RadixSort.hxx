@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace playground::shared {
+    struct SortItem {
+        uint64_t key;
+        uint32_t value;
+    };
+
+    /// Stable LSD radix sort by key, one byte per pass. Passes where every key shares the same byte are skipped,
+    /// so keys that only use a few bits sort in a few passes. Large inputs are histogrammed and scattered on the job system.
+    /// scratch is resized as needed and can be kept around between calls to avoid reallocating.
+    void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch);
+}
@@ -5,6 +5,7 @@
 #include "shared/Hardware.hxx"
 #include "shared/Logger.hxx"
 #include <concurrentqueue.h>
+#include <algorithm>
 #include <thread>
 #include <tracy/Tracy.hpp>
 #include "shared/Arena.hxx"
@@ -91,6 +92,44 @@ namespace playground::jobsystem {
         return lowPerfWorkers;
     }
 
+    size_t ParallelRanges(size_t count, size_t minRangeSize) {
+        if (count == 0) {
+            return 0;
+        }
+
+        size_t ranges = (count + std::max<size_t>(minRangeSize, 1) - 1) / std::max<size_t>(minRangeSize, 1);
+
+        return std::clamp<size_t>(ranges, 1, static_cast<size_t>(highPerfWorkers) + 1);
+    }
+
+    void ParallelFor(const char* name, size_t count, size_t minRangeSize, const std::function<void(size_t range, size_t begin, size_t end)>& task) {
+        ZoneScopedN("Job System: Parallel For");
+
+        auto ranges = ParallelRanges(count, minRangeSize);
+        if (ranges == 0) {
+            return;
+        }
+
+        std::vector<std::shared_ptr<JobHandle>> handles;
+        handles.reserve(ranges - 1);
+
+        for (size_t range = 1; range < ranges; range++) {
+            handles.push_back(Submit(Job{
+                .Name = name,
+                .Priority = JobPriority::High,
+                .Task = [&task, range, ranges, count](uint8_t workerId) {
+                    task(range, count * range / ranges, count * (range + 1) / ranges);
+                }
+            }));
+        }
+
+        task(0, 0, count / ranges);
+
+        for (auto& handle : handles) {
+            handle->Wait();
+        }
+    }
+
     // ---- Helpers ----
     void SetupWorkers() {
         auto maxWorkers = hardware::CPUCount();
@@ -0,0 +1,106 @@
+#include "shared/RadixSort.hxx"
+#include "shared/JobSystem.hxx"
+#include <tracy/Tracy.hpp>
+#include <array>
+#include <vector>
+
+namespace playground::shared {
+    constexpr size_t RADIX_BITS = 8;
+    constexpr size_t RADIX_BUCKETS = 1 << RADIX_BITS;
+    constexpr size_t RADIX_PASSES = sizeof(uint64_t) * 8 / RADIX_BITS;
+    // Below this many items per range the job overhead outweighs the work
+    constexpr size_t MIN_SORT_RANGE = 16384;
+
+    using Histogram = std::array<uint32_t, RADIX_BUCKETS>;
+
+    inline size_t Digit(uint64_t key, size_t pass) {
+        return (key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1);
+    }
+
+    void RadixSort(std::vector<SortItem>& items, std::vector<SortItem>& scratch) {
+        ZoneScopedN("Radix Sort");
+
+        auto count = items.size();
+        if (count < 2) {
+            return;
+        }
+
+        scratch.resize(count);
+
+        auto ranges = jobsystem::ParallelRanges(count, MIN_SORT_RANGE);
+
+        // One read over all keys tells which passes would move anything at all
+        std::vector<std::array<Histogram, RADIX_PASSES>> totals(ranges);
+        jobsystem::ParallelFor("Radix Sort: Histogram", count, MIN_SORT_RANGE, [&](size_t range, size_t begin, size_t end) {
+            auto& histograms = totals[range];
+            for (auto& histogram : histograms) {
+                histogram.fill(0);
+            }
+
+            for (size_t x = begin; x < end; x++) {
+                for (size_t pass = 0; pass < RADIX_PASSES; pass++) {
+                    histograms[pass][Digit(items[x].key, pass)]++;
+                }
+            }
+        });
+
+        std::vector<Histogram> offsets(ranges);
+        auto* source = &items;
+        auto* destination = &scratch;
+
+        for (size_t pass = 0; pass < RADIX_PASSES; pass++) {
+            bool sorted = false;
+            for (size_t bucket = 0; bucket < RADIX_BUCKETS && !sorted; bucket++) {
+                uint32_t total = 0;
+                for (auto& histograms : totals) {
+                    total += histograms[pass][bucket];
+                }
+
+                sorted = total == count;
+            }
+
+            if (sorted) {
+                continue;
+            }
+
+            // Ranges see different items after every scatter, so their share of each bucket has to be counted again
+            if (ranges > 1) {
+                jobsystem::ParallelFor("Radix Sort: Count", count, MIN_SORT_RANGE, [&](size_t range, size_t begin, size_t end) {
+                    auto& histogram = offsets[range];
+                    histogram.fill(0);
+                    for (size_t x = begin; x < end; x++) {
+                        histogram[Digit((*source)[x].key, pass)]++;
+                    }
+                });
+            }
+            else {
+                offsets[0] = totals[0][pass];
+            }
+
+            // Exclusive prefix sum, bucket major so equal digits keep the order of their ranges
+            uint32_t offset = 0;
+            for (size_t bucket = 0; bucket < RADIX_BUCKETS; bucket++) {
+                for (auto& histogram : offsets) {
+                    auto bucketCount = histogram[bucket];
+                    histogram[bucket] = offset;
+                    offset += bucketCount;
+                }
+            }
+
+            jobsystem::ParallelFor("Radix Sort: Scatter", count, MIN_SORT_RANGE, [&](size_t range, size_t begin, size_t end) {
+                auto& histogram = offsets[range];
+                auto& from = *source;
+                auto& to = *destination;
+                for (size_t x = begin; x < end; x++) {
+                    to[histogram[Digit(from[x].key, pass)]++] = from[x];
+                }
+            });
+
+            std::swap(source, destination);
+        }
+
+        if (source != &items) {
+            items.swap(scratch);
+        }
+    }
+}
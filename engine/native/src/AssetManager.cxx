@@ -2,7 +2,9 @@
 #include <assetloader/AssetLoader.hxx>
 #include <rendering/Mesh.hxx>
 #include <rendering/Rendering.hxx>
+#ifdef PLATFORM_MODULES
 #include <audio/Audio.hxx>
+#endif
 #include <physics/Physics.hxx>
 #include <shared/Hasher.hxx>
 #include <shared/Job.hxx>
@@ -23,6 +25,33 @@ namespace playground::assetmanager {
     std::vector<PhysicsMaterialHandle*> _physicsMaterialHandles = {};
     std::vector<CubemapHandle*> _cubemapHandles = {};
     std::vector<AudioHandle*> _audioHandles = {};
+    bool _headless = false;
+    bool _rendering = true;
+
+    // Banks need an audio device, headless runs and builds without the audio module only track the handle
+    void* LoadAudioBank(std::string_view archive, std::string_view name) {
+#ifdef PLATFORM_MODULES
+        return _headless ? nullptr : audio::LoadBank(archive, name);
+#else
+        return nullptr;
+#endif
+    }
+
+    std::vector<math::BoundingBox> ComputeMeshBounds(const std::vector<assetloader::RawMeshData>& meshes) {
+        std::vector<math::BoundingBox> bounds;
+        bounds.reserve(meshes.size());
+
+        for (const auto& mesh : meshes) {
+            auto box = math::BoundingBox::Empty();
+            for (const auto& vertex : mesh.vertices) {
+                box.Encapsulate(math::Vector3(vertex.x, vertex.y, vertex.z));
+            }
+
+            bounds.push_back(box.IsValid() ? box : math::BoundingBox());
+        }
+
+        return bounds;
+    }
 
     bool ParseU64(std::string_view s, uint64_t& out)
     {
@@ -38,6 +67,15 @@ namespace playground::assetmanager {
         }
     }
 
+    void UploadModel(std::vector<assetloader::RawMeshData>& meshes, uint32_t handleId, rendering::UploadPriority priority) {
+        if (!_rendering) {
+            MarkModelUploadFinished(handleId, {});
+            return;
+        }
+
+        playground::rendering::QueueUploadModel(meshes, handleId, MarkModelUploadFinished, priority);
+    }
+
     void MarkMaterialUploadFinished(uint32_t handleId, uint32_t materialId) {
         auto materialSetupJob = jobsystem::Job{
             .Name = std::string("MATERIAL_SETUP_JOB_") + std::to_string(handleId),
@@ -126,6 +164,12 @@ namespace playground::assetmanager {
         }
     }
 
+    void Init(bool headless, bool rendering)
+    {
+        _headless = headless;
+        _rendering = rendering;
+    }
+
     ModelHandle* GetModel(uint32_t handle)
     {
         if (handle >= _modelHandles.size())
@@ -189,7 +233,7 @@ namespace playground::assetmanager {
         return _physicsMaterialHandles[handle];
     }
 
-    uint32_t LoadModel(uint64_t hash) {
+    uint32_t LoadModel(uint64_t hash, rendering::UploadPriority priority) {
         ModelHandle* handle;
         for (uint32_t i = 0; i < _modelHandles.size(); ++i) {
             handle = _modelHandles[i];
@@ -202,9 +246,10 @@ namespace playground::assetmanager {
                 }
                 if (state == ResourceState::Unloaded) {
                     auto rawMeshData = playground::assetloader::LoadMeshes(hash);
+                    handle->bounds = ComputeMeshBounds(rawMeshData);
                     handle->externalRefs = 1;
                     handle->state.store(ResourceState::Created);
-                    playground::rendering::QueueUploadModel(rawMeshData, i, MarkModelUploadFinished);
+                    UploadModel(rawMeshData, i, priority);
 
                     return i;
                 }
@@ -219,18 +264,19 @@ namespace playground::assetmanager {
             .externalRefs = 1,
             .internalRefs = 1,
             .meshes = {},
+            .bounds = ComputeMeshBounds(rawMeshData),
         };
 
         uint32_t handleId;
         handleId = _modelHandles.size();
         _modelHandles.push_back(std::move(newHandle));
 
-        playground::rendering::QueueUploadModel(rawMeshData, handleId, MarkModelUploadFinished);
+        UploadModel(rawMeshData, handleId, priority);
 
         return handleId;
     }
 
-    uint32_t LoadMaterial(uint64_t hash, void (*onCompletion)(uint32_t)) {
+    uint32_t LoadMaterial(uint64_t hash, void (*onCompletion)(uint32_t), rendering::UploadPriority priority) {
         std::optional<uint32_t> handleId;
         MaterialHandle* handle;
         for (uint32_t i = 0; i < _materialHandles.size(); ++i) {
@@ -267,12 +313,19 @@ namespace playground::assetmanager {
             _materialHandles.push_back(handle);
         }
 
+        if (!_rendering) {
+            handle->state.store(ResourceState::Uploaded);
+            handle->internalRefs--;
+
+            return handleId.value();
+        }
+
         auto rawMaterialData = playground::assetloader::LoadMaterial(hash);
 
         for (auto& texture : rawMaterialData.textures) {
             uint64_t hash;
             ParseU64(texture.value, hash);
-            auto texHandle = LoadTexture(hash);
+            auto texHandle = LoadTexture(hash, priority);
             auto texHandlePtr = GetTexture(texHandle);
             handle->textures.insert({ texture.name, texHandlePtr });
         }
@@ -280,7 +333,7 @@ namespace playground::assetmanager {
         for (auto& cubemap : rawMaterialData.cubemaps) {
             uint64_t hash;
             ParseU64(cubemap.value, hash);
-            auto cubemapHandle = LoadCubemap(hash);
+            auto cubemapHandle = LoadCubemap(hash, priority);
             auto cubemapHandlePtr = GetCubemap(cubemapHandle);
             handle->cubemaps.insert({ cubemap.name, cubemapHandlePtr });
         }
@@ -376,7 +429,7 @@ namespace playground::assetmanager {
         return handleId;
     }
 
-    uint32_t LoadTexture(uint64_t hash) {
+    uint32_t LoadTexture(uint64_t hash, rendering::UploadPriority priority) {
         std::optional<uint32_t> handleId;
         TextureHandle* handle;
         for (uint32_t i = 0; i < _textureHandles.size(); ++i) {
@@ -412,12 +465,18 @@ namespace playground::assetmanager {
             _textureHandles.push_back(handle);
         }
 
+        if (!_rendering) {
+            handle->state.store(ResourceState::Uploaded);
+
+            return handleId.value();
+        }
+
         auto uploadJob = jobsystem::Job{
             .Name = "_TEXTURE_UPLOAD_JOB_" + std::to_string(hash),
             .Priority = jobsystem::JobPriority::Low,
             .Color = tracy::Color::Green,
             .Dependencies = {},
-            .Task = [handle, handleId, hash](uint8_t workerId) {
+            .Task = [handle, handleId, hash, priority](uint8_t workerId) {
                 auto rawTextureData = playground::assetloader::LoadTexture(hash);
                 auto data = new assetloader::RawTextureData();
                 data->MipMaps = rawTextureData.MipMaps;
@@ -425,7 +484,7 @@ namespace playground::assetmanager {
                 data->Height = rawTextureData.Height;
                 data->Channels = rawTextureData.Channels;
                 handle->data = data;
-                rendering::QueueUploadTexture(handle->data, handleId.value(), MarkTextureUploadFinished);
+                rendering::QueueUploadTexture(handle->data, handleId.value(), MarkTextureUploadFinished, priority);
             }
         };
 
@@ -473,7 +532,7 @@ namespace playground::assetmanager {
         return handleId;
     }
 
-    uint32_t LoadCubemap(uint64_t hash) {
+    uint32_t LoadCubemap(uint64_t hash, rendering::UploadPriority priority) {
         std::optional<uint32_t> handleId;
         CubemapHandle* handle;
         for (uint32_t i = 0; i < _cubemapHandles.size(); ++i) {
@@ -509,16 +568,22 @@ namespace playground::assetmanager {
             _cubemapHandles.push_back(handle);
         }
 
+        if (!_rendering) {
+            handle->state.store(ResourceState::Uploaded);
+
+            return handleId.value();
+        }
+
         auto uploadJob = jobsystem::Job{
             .Name = "_CUBEMAP_UPLOAD_JOB_" + std::to_string(hash),
             .Priority = jobsystem::JobPriority::Low,
             .Color = tracy::Color::Blue,
             .Dependencies = {},
-            .Task = [handle, handleId, hash](uint8_t workerId) {
+            .Task = [handle, handleId, hash, priority](uint8_t workerId) {
                 auto rawCubemapData = playground::assetloader::LoadCubemap(hash);
                 auto data = std::make_shared<assetloader::RawCubemapData>(rawCubemapData);
                 handle->data = data;
-                rendering::QueueUploadCubemap(handle->data, handleId.value(), MarkCubemapUploadFinished);
+                rendering::QueueUploadCubemap(handle->data, handleId.value(), MarkCubemapUploadFinished, priority);
             }
         };
 
@@ -541,7 +606,7 @@ namespace playground::assetmanager {
                     if (archive.size() == 0) {
                         throw std::runtime_error("Audio file not found: " + std::to_string(hash));
                     }
-                    handle->audioBank = audio::LoadBank(archive, name);
+                    handle->audioBank = LoadAudioBank(archive, name);
                     handle->externalRefs = 1;
                     handle->state = ResourceState::Uploaded;
 
@@ -559,7 +624,7 @@ namespace playground::assetmanager {
 
         auto archive = assetloader::TryFindFile(hash);
         if (archive.size() > 0) {
-            handle->audioBank = audio::LoadBank(archive, name);
+            handle->audioBank = LoadAudioBank(archive, name);
         }
         else {
             throw std::runtime_error("Audio file not found: " + std::to_string(hash));
@@ -642,6 +707,27 @@ namespace playground::assetmanager {
         LoadSceneData(hash, data, size);
     }
 
+    void RetainModel(uint32_t handle, uint32_t count)
+    {
+        if (handle < _modelHandles.size()) {
+            _modelHandles[handle]->externalRefs += count;
+        }
+    }
+
+    void RetainMaterial(uint32_t handle, uint32_t count)
+    {
+        if (handle < _materialHandles.size()) {
+            _materialHandles[handle]->externalRefs += count;
+        }
+    }
+
+    void RetainPhysicsMaterial(uint32_t handle, uint32_t count)
+    {
+        if (handle < _physicsMaterialHandles.size()) {
+            _physicsMaterialHandles[handle]->externalRefs += count;
+        }
+    }
+
     void ReleaseModel(uint32_t handle)
     {
         _modelHandles[handle]->externalRefs--;
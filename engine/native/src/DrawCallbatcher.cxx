@@ -6,17 +6,32 @@
 #include <rendering/Constants.hxx>
 #include <rendering/DirectionalLight.hxx>
 #include <rendering/Camera.hxx>
+#include <rendering/LightClusters.hxx>
+#include <rendering/ShadowCascades.hxx>
+#include <rendering/PointLight.hxx>
+#include <rendering/SpotLight.hxx>
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <bit>
+#include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <cmath>
+#include <cstring>
+#include <tuple>
 #include <unordered_map>
-#include <EASTL/hash_map.h>
+#include <vector>
 #include <EASTL/queue.h>
 #include <EASTL/vector.h>
-#include <EASTL/functional.h>
 #include <tracy/Tracy.hpp>
+#include <shared/JobSystem.hxx>
 #include <shared/Memory.hxx>
+#include <shared/RadixSort.hxx>
+#include <math/Bounds.hxx>
 #include <math/Math.hxx>
+#include <math/Occlusion.hxx>
 #include <shared/Arena.hxx>
 #include <shared/Logger.hxx>
 #include <concurrentqueue.h>
@@ -25,31 +40,6 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
-struct BatchKey {
-    playground::rendering::MaterialHandle material;
-    playground::rendering::VertexBufferHandle vertexBuffer;
-    playground::rendering::IndexBufferHandle indexBuffer;
-
-    bool operator==(const BatchKey& other) const {
-        return material == other.material &&
-            vertexBuffer == other.vertexBuffer &&
-            indexBuffer == other.indexBuffer;
-    }
-};
-
-// Hash function for BatchKey (specialize eastl::hash)
-namespace eastl {
-    template<>
-    struct hash<BatchKey> {
-        size_t operator()(const BatchKey& key) const {
-            size_t h1 = eastl::hash<uint32_t>{}(static_cast<uint32_t>(key.material));
-            size_t h2 = eastl::hash<uint32_t>{}(static_cast<uint32_t>(key.vertexBuffer));
-            size_t h3 = eastl::hash<uint32_t>{}(static_cast<uint32_t>(key.indexBuffer));
-            return h1 ^ (h2 << 1) ^ (h3 << 2);
-        }
-    };
-}
-
 namespace playground::drawcallbatcher {
     using ArenaType = memory::VirtualArena;
     using Allocator = memory::ArenaAllocator<ArenaType>;
@@ -64,9 +54,151 @@ namespace playground::drawcallbatcher {
         size_t count = 0;
     };
 
+    // Draw item resolved against the asset manager, indexed by its position across all ranges of the frame
+    struct ResolvedItem {
+        const DrawCall* source;
+        rendering::MaterialHandle material;
+        rendering::VertexBufferHandle vertexBuffer;
+        rendering::IndexBufferHandle indexBuffer;
+        uint8_t visibility;
+        // Sun cascades the item casts shadows into, one bit per cascade
+        uint8_t cascades;
+    };
+
+    // World bounds of one resolve range as streams for the frustum test
+    struct CullScratch {
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> radius;
+        std::vector<uint8_t> visibility;
+        std::vector<uint8_t> cascades;
+    };
+
+    struct CullView {
+        math::Frustum frustum;
+        uint8_t mask;
+    };
+
+    // Run of sorted items that becomes one instanced draw call
+    struct PendingDrawCall {
+        size_t first;
+        uint32_t count;
+        uint32_t firstInstance;
+    };
+
+    // Transforms of one run gathered into streams for the instance kernel, one per batching range
+    struct InstanceScratch {
+        std::array<std::array<float, rendering::MAX_BATCH_SIZE>, 10> streams;
+    };
+
+    // Draw call of the static cache. Items wait unresolved until their assets are uploaded.
+    struct StaticItem {
+        DrawCall drawCall;
+        math::BoundingSphere sphere;
+        uint32_t batch = UINT32_MAX;
+        // Position inside the batch, its instance is firstInstance + index
+        uint32_t index = 0;
+        uint8_t lod = 0;
+        // Set once resolved against a mesh with LODs, only those items take part in the LOD pass
+        bool hasLods = false;
+        bool live = false;
+    };
+
+    // Every static item sharing material and geometry, drawn as one call (or several once it exceeds MAX_BATCH_SIZE)
+    struct StaticBatch {
+        rendering::MaterialHandle material;
+        rendering::VertexBufferHandle vertexBuffer;
+        rendering::IndexBufferHandle indexBuffer;
+        std::vector<uint32_t> items;
+        // Instances [firstInstance, firstInstance + capacity) belong to the batch, it only moves once its items outgrow them
+        uint32_t firstInstance = 0;
+        uint32_t capacity = 0;
+        // Items whose instances changed since a packet last carried them, empty while dirtyBegin >= dirtyEnd
+        uint32_t dirtyBegin = UINT32_MAX;
+        uint32_t dirtyEnd = 0;
+    };
+
+    struct Occluder {
+        math::Matrix4x4 world;
+        math::BoundingBox box;
+    };
+
+    // Camera as seen by the LOD selection, scale turns radius / distance into the fraction of the view's height
+    struct LodView {
+        math::Vector3 position;
+        float scale;
+    };
+
+    using StaticBatchKey = std::tuple<rendering::MaterialHandle, rendering::VertexBufferHandle, rendering::IndexBufferHandle>;
+
+    constexpr size_t MIN_RESOLVE_RANGE = 4096;
+    constexpr size_t MIN_EMIT_RANGE = 32;
+    // Occluders only need to hide whole objects, a coarse buffer keeps rasterizing them cheap
+    constexpr uint32_t OCCLUSION_WIDTH = 256;
+    constexpr uint32_t OCCLUSION_HEIGHT = 128;
+    constexpr size_t MIN_OCCLUSION_ROWS = 16;
+    constexpr size_t MIN_LOD_RANGE = 4096;
+    // Static batches are laid out in Morton order of these cells, so visible instances form few contiguous runs
+    constexpr float STATIC_CELL_SIZE = 16.0f;
+    // Smallest range a static batch reserves, it doubles whenever the batch outgrows it
+    constexpr uint32_t MIN_STATIC_BATCH_CAPACITY = 16;
+    constexpr uint64_t REJECTED_KEY = UINT64_MAX;
+
     Allocator alloc(&arena, "Batcher Allocator");
 
     moodycamel::ConcurrentQueue<DrawCallRange> batches;
+    // Kept across frames so batching doesn't reallocate once the scene size settled
+    std::vector<DrawCallRange> ranges;
+    std::vector<size_t> rangeOffsets;
+    std::vector<ResolvedItem> resolved;
+    std::vector<shared::SortItem> sortKeys;
+    std::vector<shared::SortItem> shadowKeys;
+    std::vector<shared::SortItem> sortScratch;
+    std::vector<PendingDrawCall> pending;
+    std::vector<PendingDrawCall> shadowPending;
+    std::vector<std::unique_ptr<InstanceScratch>> instanceScratch;
+    std::vector<CullScratch> cullScratch;
+    std::vector<CullView> cullViews;
+    std::vector<rendering::PointLight> pointLights;
+    std::vector<rendering::SpotLight> spotLights;
+    rendering::LightClusterBuilder lightClusterBuilder;
+    uint32_t viewportWidth = 1920;
+    uint32_t viewportHeight = 1080;
+    float aspectRatio = 16.0f / 9.0f;
+    bool hasSun = false;
+    math::Vector3 sunDirection;
+    // Shadow casters sort front to back from the eye of the farthest cascade
+    math::Vector3 sunOrigin;
+    float sunDepthScale = 0.0f;
+    std::vector<CullView> cascadeViews;
+    eastl::vector<rendering::DrawCall> shadowScratch;
+    std::vector<StaticItem> staticItems;
+    std::vector<uint32_t> freeStaticSlots;
+    std::vector<uint32_t> unresolvedStatics;
+    std::vector<uint32_t> movedStatics;
+    std::vector<StaticBatch> staticBatches;
+    std::map<StaticBatchKey, uint32_t> staticBatchLookup;
+    // CPU copy of the static instances. The GPU buffer persists, packets only carry the ranges of dirtyStaticBatches.
+    std::vector<rendering::DrawCall::InstanceData> staticInstances;
+    std::shared_ptr<rendering::InstanceBuffer> staticInstanceBuffer;
+    // Set when the buffer was replaced, the next packet uploads every instance instead of the dirty ranges
+    bool staticBufferReplaced = false;
+    std::vector<uint32_t> dirtyStaticBatches;
+    // Ranges (first, count) left behind by batches that moved, reused by the next batch that needs room
+    std::vector<std::pair<uint32_t, uint32_t>> freeStaticRanges;
+    // Cull spheres of the static instances in instance order, patched together with the instance data
+    CullScratch staticCull;
+    std::vector<std::pair<uint32_t, uint32_t>> staticOrder;
+    // Cameras of the last Submit, dynamic draw calls pick their LOD against them while the next frame is built
+    std::vector<LodView> lodViews;
+    std::vector<float> cameraLodBiases;
+    std::vector<uint8_t> staticLods;
+    bool staticLodsDirty = false;
+    std::vector<Occluder> occluders;
+    math::OcclusionBuffer occlusionBuffer(OCCLUSION_WIDTH, OCCLUSION_HEIGHT);
+    math::Matrix4x4 occlusionViewProjection;
+    bool hasOcclusion = false;
     std::atomic<uint32_t> batchIndex = 0;
     std::mutex mutex;
     rendering::DirectionalLight sun;
@@ -78,67 +210,284 @@ namespace playground::drawcallbatcher {
         batches.enqueue(DrawCallRange{ .start = batch, .count = count });
     }
 
+    // The shadow cascades are fitted to the main camera on Submit
     void SetSun(math::Vector3 direction, math::Vector4 colour, float intensity) {
-        if (cameras.empty()) {
-            ZoneScopedN("Batcher: Set Sun - No Cameras");
+        sun = rendering::DirectionalLight{
+            .direction = math::Vector4(direction, 0),
+            .colour = math::Vector4(colour.X, colour.Y, colour.Z, intensity),
+        };
+        hasSun = true;
+        sunDirection = direction.Normalise();
+    }
+
+    void AddCamera(uint8_t order, float fov, float nearPlane, float farPlane, const math::Vector3& position, const math::Quaternion& rotation, float lodBias) {
+        ZoneScopedN("Batcher: Add Camera");
+
+        rendering::Camera camera(fov, 0, nearPlane, farPlane, position, rotation, order);
+
+        cameras.push_back(camera);
+        cameraLodBiases.push_back(lodBias);
+    }
+
+    // Fraction of the view's height the sphere covers in the camera it appears largest in
+    float LodScreenSize(const math::BoundingSphere& sphere) {
+        float size = 0.0f;
+        for (const auto& view : lodViews) {
+            float distance = (sphere.Center - view.position).Length();
+            // A camera inside the bounds (or unbounded meshes) always gets the full mesh
+            if (distance <= sphere.Radius) {
+                return std::numeric_limits<float>::max();
+            }
+
+            size = std::max(size, sphere.Radius * view.scale / distance);
+        }
+
+        return size;
+    }
+
+    uint8_t SelectLod(const DrawCall& drawCall, uint8_t current) {
+        auto modelHandle = assetmanager::GetModel(drawCall.modelHandle);
+        if (modelHandle == nullptr || modelHandle->state.load() != assetmanager::ResourceState::Uploaded || drawCall.meshId >= modelHandle->meshes.size()) {
+            return current;
+        }
+
+        const auto& mesh = modelHandle->meshes[drawCall.meshId];
+        if (mesh.lods.empty() || lodViews.empty()) {
+            return 0;
+        }
+
+        // Meshes without bounds can't be measured, they stay at full detail
+        if (drawCall.meshId >= modelHandle->bounds.size()) {
+            return 0;
+        }
+
+        auto sphere = math::TransformBounds(modelHandle->bounds[drawCall.meshId], drawCall.position, drawCall.rotation, drawCall.scale);
+
+        return rendering::SelectLod(mesh, LodScreenSize(sphere), current);
+    }
+
+    // Camera changes may move static items to another LOD, only then the static LOD pass has to run
+    void BuildLodViews() {
+        std::vector<LodView> views;
+        views.reserve(cameras.size());
+        for (size_t x = 0; x < cameras.size(); x++) {
+            float bias = x < cameraLodBiases.size() ? cameraLodBiases[x] : 0.0f;
+            float tanHalfFov = std::tan(math::DegreesToRadians(cameras[x].FOV) * 0.5f);
+            views.push_back(LodView{
+                .position = cameras[x].Position,
+                .scale = std::exp2(-bias) / std::max(tanHalfFov, 0.0001f),
+            });
+        }
+
+        if (views.size() != lodViews.size() || std::memcmp(views.data(), lodViews.data(), views.size() * sizeof(LodView)) != 0) {
+            staticLodsDirty = true;
+        }
+
+        lodViews = std::move(views);
+    }
+
+    void AddOccluder(const math::Vector3& position, const math::Quaternion& rotation, const math::Vector3& scale, const math::Vector3& center, const math::Vector3& extents) {
+        occluders.push_back(Occluder{
+            .world = math::Mat4FromPRS(position, rotation, scale),
+            .box = math::BoundingBox::FromCenterExtents(center, extents),
+        });
+    }
+
+    void AddPointLight(const math::Vector3& position, const math::Vector4& colour, float intensity, float radius) {
+        if (pointLights.size() >= rendering::MAX_POINT_LIGHTS) {
             return;
         }
 
-        math::Vector3 lightDir = direction.Normalise();
+        pointLights.emplace_back(position, math::Vector3(colour.X, colour.Y, colour.Z), intensity, radius);
+    }
 
-        math::Vector3 cameraPos = cameras.front().Position;
-        math::Vector3 target = math::Vector3(0, -15, 0);
-        math::Vector3 eye = target - lightDir * 25;
+    void AddSpotLight(const math::Vector3& position, const math::Quaternion& rotation, const math::Vector4& colour, float intensity, float range, float innerAngle, float outerAngle) {
+        if (spotLights.size() >= rendering::MAX_SPOT_LIGHTS) {
+            return;
+        }
 
-        math::Vector3 up = fabs(lightDir.Y) > 0.99f ? math::Vector3(0, 0, 1) : math::Vector3(0, 1, 0);
-        math::Matrix4x4 viewMatrix;
-        math::LookAtLH(eye, target, up, &viewMatrix);
+        float outer = math::DegreesToRadians(std::clamp(outerAngle, 0.0f, 89.0f));
+        float inner = math::DegreesToRadians(std::clamp(innerAngle, 0.0f, 89.0f));
 
-        float extent = 50;
-        float nearDist = 0.025f;
-        float farDist = 50;
+        spotLights.push_back(rendering::SpotLight{
+            .position = position,
+            .range = range,
+            .direction = rotation * math::Vector3(0, 0, 1),
+            .cosOuter = std::cos(outer),
+            .colour = math::Vector3(colour.X, colour.Y, colour.Z),
+            .intensity = intensity,
+            .cosInner = std::cos(std::min(inner, outer)),
+        });
+    }
 
-        auto ortho = math::Matrix4x4::OrthographicOffCenter(
-            -extent, +extent,
-            -extent, +extent,
-            nearDist,
-            farDist
-        );
+    void SetViewport(uint32_t width, uint32_t height) {
+        if (width > 0 && height > 0) {
+            viewportWidth = width;
+            viewportHeight = height;
+            aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+        }
+    }
 
-        sun = rendering::DirectionalLight{
-            .viewMatrix = viewMatrix,
-            .projectionMatrix = ortho,
-            .direction = math::Vector4(direction, 0),
-            .colour = math::Vector4(colour.X, colour.Y, colour.Z, intensity),
-        };
+    inline uint8_t CameraBits(const ResolvedItem& item) {
+        return item.visibility & ~rendering::SHADOW_VISIBILITY_MASK;
     }
 
-    void AddCamera(uint8_t order, float fov, float nearPlane, float farPlane, const math::Vector3& position, const math::Quaternion& rotation) {
-        ZoneScopedN("Batcher: Add Camera");
+    // Material first so state changes are minimal, then the cameras the item is visible in, then buffers, then front to back within a batch.
+    // Handles only contribute their low bits, the emit pass compares the full handles so a collision can only split a batch.
+    inline uint64_t SortKey(const ResolvedItem& item, uint16_t depth) {
+        return (static_cast<uint64_t>(item.material & 0xFFFF) << 48) |
+            (static_cast<uint64_t>(CameraBits(item)) << 40) |
+            (static_cast<uint64_t>(item.vertexBuffer & 0xFFF) << 28) |
+            (static_cast<uint64_t>(item.indexBuffer & 0xFFF) << 16) |
+            depth;
+    }
 
-        rendering::Camera camera(fov, 0, nearPlane, farPlane, position, rotation, order);
+    // Shadow casters all share the shadow material, so they only batch by the cascades they fall into and geometry, front to back from the light
+    inline uint64_t ShadowSortKey(const ResolvedItem& item, uint16_t depth) {
+        return (static_cast<uint64_t>(item.cascades & 0xF) << 60) |
+            (static_cast<uint64_t>(item.vertexBuffer & 0xFFFFF) << 40) |
+            (static_cast<uint64_t>(item.indexBuffer & 0xFFFFFF) << 16) |
+            depth;
+    }
 
-        cameras.push_back(camera);
+    inline bool SameBatch(const ResolvedItem& a, const ResolvedItem& b) {
+        return a.material == b.material && CameraBits(a) == CameraBits(b) && a.vertexBuffer == b.vertexBuffer && a.indexBuffer == b.indexBuffer;
     }
 
-    void Submit() {
-        ZoneScopedN("Batcher: Submit");
-        rendering::RenderFrame frame;
+    inline bool SameShadowBatch(const ResolvedItem& a, const ResolvedItem& b) {
+        return a.cascades == b.cascades && a.vertexBuffer == b.vertexBuffer && a.indexBuffer == b.indexBuffer;
+    }
 
-        for (auto& cam : cameras) {
-            frame.cameras.emplace_back(std::move(cam));
+    // Splits the main camera's view into the sun's cascades, each one gets its own culling volume and caster list
+    void BuildCascades(rendering::RenderFrame& frame) {
+        ZoneScopedN("Batcher: Build Cascades");
+
+        cascadeViews.clear();
+        frame.cascadeCount = 0;
+
+        if (!hasSun || frame.cameras.empty()) {
+            return;
         }
 
-        frame.sun = sun;
-        eastl::hash_map<BatchKey, uint64_t, eastl::hash<BatchKey>, eastl::equal_to<BatchKey>, Allocator, false> batchedDrawCalls(alloc);
+        auto settings = rendering::GetShadowSettings();
+        auto camera = frame.cameras.front();
+        camera.SetAspectRatio(aspectRatio);
 
-        frame.isDirty = true;
+        auto count = std::min(settings.cascadeCount, rendering::MAX_SHADOW_CASCADES);
+        if (count == 0) {
+            return;
+        }
 
-        DrawCallRange next;
-        while(batches.try_dequeue(next)) {
-            ZoneScopedN("Batcher: Process Batch");
-            for (int y = 0; y < next.count; y++) {
-                auto item = next.start[y];
+        std::array<float, rendering::MAX_SHADOW_CASCADES> splits;
+        rendering::ComputeCascadeSplits(camera.Near, std::min(camera.Far, settings.distance), count, settings.splitLambda, splits.data());
+
+        float splitNear = camera.Near;
+        for (uint8_t x = 0; x < count; x++) {
+            frame.cascades[x] = rendering::FitCascade(camera, splitNear, splits[x], sunDirection, settings.resolution, settings.casterDistance);
+            splitNear = splits[x];
+
+            // Casters between the light and the cascade still throw shadows into it, so the volume is open toward the light
+            auto frustum = math::Frustum::FromViewProjection(frame.cascades[x].viewMatrix * frame.cascades[x].projectionMatrix);
+            frustum.Planes[math::Frustum::Near].Distance = std::numeric_limits<float>::max();
+
+            cascadeViews.push_back(CullView{
+                .frustum = frustum,
+                .mask = static_cast<uint8_t>(1 << x),
+            });
+        }
+
+        frame.cascadeCount = count;
+
+        // The farthest cascade reaches past all others, its eye sits in front of every caster
+        const auto& farthest = frame.cascades[count - 1];
+        math::Matrix4x4 inverseView;
+        math::InverseAffine(farthest.viewMatrix, &inverseView);
+        sunOrigin = math::Vector3(inverseView.elements[3][0], inverseView.elements[3][1], inverseView.elements[3][2]);
+        sunDepthScale = 65535.0f * farthest.projectionMatrix.elements[2][2];
+    }
+
+    // One frustum per camera, each with the visibility bit it sets
+    void BuildCullViews(const rendering::RenderFrame& frame) {
+        cullViews.clear();
+
+        for (size_t x = 0; x < frame.cameras.size(); x++) {
+            auto camera = frame.cameras[x];
+            camera.SetAspectRatio(aspectRatio);
+
+            cullViews.push_back(CullView{
+                .frustum = math::Frustum::FromViewProjection(camera.GetViewMatrix() * camera.GetProjectionMatrix()),
+                .mask = rendering::CameraVisibilityMask(static_cast<uint8_t>(x)),
+            });
+        }
+    }
+
+    // Rasterizes the occluders as seen by the main camera, each job owns a band of rows so no two write the same pixel
+    void RasterizeOccluders(const rendering::RenderFrame& frame) {
+        ZoneScopedN("Batcher: Rasterize Occluders");
+
+        hasOcclusion = !occluders.empty() && !frame.cameras.empty();
+        if (!hasOcclusion) {
+            return;
+        }
+
+        auto camera = frame.cameras.front();
+        camera.SetAspectRatio(aspectRatio);
+        occlusionViewProjection = camera.GetViewMatrix() * camera.GetProjectionMatrix();
+
+        occlusionBuffer.Clear();
+
+        jobsystem::ParallelFor("Batcher: Rasterize Occluders", occlusionBuffer.Height(), MIN_OCCLUSION_ROWS, [&](size_t range, size_t begin, size_t end) {
+            for (const auto& occluder : occluders) {
+                occlusionBuffer.RasterizeBox(occluder.box, occluder.world * occlusionViewProjection, static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+            }
+        });
+
+        occlusionBuffer.BuildHierarchy();
+    }
+
+    // Clears the main camera's bit of spheres hidden behind the occluders, only items the frustum test kept get here
+    inline void OccludeSphere(float x, float y, float z, float radius, uint8_t& visibility) {
+        auto mainCamera = rendering::CameraVisibilityMask(0);
+        if (!hasOcclusion || !(visibility & mainCamera) || radius == std::numeric_limits<float>::max()) {
+            return;
+        }
+
+        auto box = math::BoundingBox::FromCenterExtents(math::Vector3(x, y, z), math::Vector3(radius, radius, radius));
+        if (!occlusionBuffer.IsVisible(box, occlusionViewProjection)) {
+            visibility &= ~mainCamera;
+        }
+    }
+
+    void ResolveItems(size_t count, const math::Vector3& eye, float depthScale) {
+        ZoneScopedN("Batcher: Resolve");
+
+        cullScratch.resize(std::max(cullScratch.size(), jobsystem::ParallelRanges(count, MIN_RESOLVE_RANGE)));
+
+        jobsystem::ParallelFor("Batcher: Resolve", count, MIN_RESOLVE_RANGE, [&](size_t range, size_t begin, size_t end) {
+            auto& cull = cullScratch[range];
+            auto rows = end - begin;
+            cull.centerX.resize(rows);
+            cull.centerY.resize(rows);
+            cull.centerZ.resize(rows);
+            cull.radius.resize(rows);
+            cull.visibility.assign(rows, 0);
+            cull.cascades.assign(rows, 0);
+
+            // Find the range holding the first item, the rest of the slice is walked linearly
+            auto rangeIndex = std::upper_bound(rangeOffsets.begin(), rangeOffsets.end(), begin) - rangeOffsets.begin() - 1;
+            auto rangeItem = begin - rangeOffsets[rangeIndex];
+
+            for (size_t x = begin; x < end; x++, rangeItem++) {
+                while (rangeItem >= ranges[rangeIndex].count) {
+                    rangeIndex++;
+                    rangeItem = 0;
+                }
+
+                const auto& item = ranges[rangeIndex].start[rangeItem];
+                auto& result = resolved[x];
+                result.source = nullptr;
+                sortKeys[x] = shared::SortItem{ .key = REJECTED_KEY, .value = static_cast<uint32_t>(x) };
+                shadowKeys[x] = shared::SortItem{ .key = REJECTED_KEY, .value = static_cast<uint32_t>(x) };
 
                 auto modelHandle = assetmanager::GetModel(item.modelHandle);
                 auto materialHandle = assetmanager::GetMaterial(item.materialHandle);
@@ -147,65 +496,744 @@ namespace playground::drawcallbatcher {
                     continue;
                 }
 
-                auto modelState = modelHandle->state.load();
-                auto materialState = materialHandle->state.load();
+                if (modelHandle->state.load() != assetmanager::ResourceState::Uploaded || materialHandle->state.load() != assetmanager::ResourceState::Uploaded) {
+                    continue;
+                }
+
+                // Every LOD has its own geometry, so instances batch per material and LOD
+                auto [vertexBuffer, indexBuffer] = rendering::LodBuffers(modelHandle->meshes[item.meshId], item.lod);
+                result.source = &item;
+                result.material = materialHandle->material;
+                result.vertexBuffer = vertexBuffer;
+                result.indexBuffer = indexBuffer;
 
-                if (modelState != assetmanager::ResourceState::Uploaded || materialState != assetmanager::ResourceState::Uploaded) {
+                // Meshes without bounds are never culled
+                auto row = x - begin;
+                if (item.meshId < modelHandle->bounds.size()) {
+                    auto sphere = math::TransformBounds(modelHandle->bounds[item.meshId], item.position, item.rotation, item.scale);
+                    cull.centerX[row] = sphere.Center.X;
+                    cull.centerY[row] = sphere.Center.Y;
+                    cull.centerZ[row] = sphere.Center.Z;
+                    cull.radius[row] = sphere.Radius;
+                }
+                else {
+                    cull.centerX[row] = item.position.X;
+                    cull.centerY[row] = item.position.Y;
+                    cull.centerZ[row] = item.position.Z;
+                    cull.radius[row] = std::numeric_limits<float>::max();
+                }
+            }
+
+            for (const auto& view : cullViews) {
+                math::CullSpheres(view.frustum, cull.centerX.data(), cull.centerY.data(), cull.centerZ.data(), cull.radius.data(), rows, view.mask, cull.visibility.data());
+            }
+
+            for (const auto& view : cascadeViews) {
+                math::CullSpheres(view.frustum, cull.centerX.data(), cull.centerY.data(), cull.centerZ.data(), cull.radius.data(), rows, view.mask, cull.cascades.data());
+            }
+
+            for (size_t row = 0; row < rows; row++) {
+                if (resolved[begin + row].source != nullptr) {
+                    OccludeSphere(cull.centerX[row], cull.centerY[row], cull.centerZ[row], cull.radius[row], cull.visibility[row]);
+                }
+            }
+
+            for (size_t x = begin; x < end; x++) {
+                auto& result = resolved[x];
+                result.visibility = cull.visibility[x - begin];
+                result.cascades = cull.cascades[x - begin];
+                if (result.cascades != 0) {
+                    result.visibility |= rendering::SHADOW_VISIBILITY_MASK;
+                }
+
+                // Items nobody sees don't make it into the frame at all
+                if (result.source == nullptr || result.visibility == 0) {
                     continue;
                 }
 
-                const auto& mesh = modelHandle->meshes[item.meshId];
-                BatchKey key{ materialHandle->material, mesh.vertexBuffer, mesh.indexBuffer };
+                const auto& position = result.source->position;
 
-                auto it = batchedDrawCalls.find(key);
-                if (it != batchedDrawCalls.end() && frame.drawCalls[it->second].instanceData.size() < rendering::MAX_BATCH_SIZE) {
-                    auto& existingDrawCall = frame.drawCalls[it->second];
+                if (CameraBits(result) != 0) {
+                    float dx = position.X - eye.X;
+                    float dy = position.Y - eye.Y;
+                    float dz = position.Z - eye.Z;
+                    float depth = std::min(std::sqrt(dx * dx + dy * dy + dz * dz) * depthScale, 65535.0f);
 
-                    math::Matrix3x3 normalMatrixInput = item.transform.ToMatrix3x3();
-                    math::Matrix3x3 normalMatrixInv;
-                    math::Inverse(normalMatrixInput, &normalMatrixInv);
-                    math::Matrix3x3 normalMatrixInvTranspose;
-                    math::Transpose(normalMatrixInv, &normalMatrixInvTranspose);
+                    sortKeys[x].key = SortKey(result, static_cast<uint16_t>(depth));
+                }
+
+                if (result.visibility & rendering::SHADOW_VISIBILITY_MASK) {
+                    float lightDepth = (position - sunOrigin).Dot(sunDirection) * sunDepthScale;
+                    float depth = std::clamp(lightDepth, 0.0f, 65535.0f);
 
-                    existingDrawCall.instanceData.push_back({
-                        .transform = item.transform,
-                        .normals = normalMatrixInvTranspose.ToMatrix4x4()
-                    });
+                    shadowKeys[x].key = ShadowSortKey(result, static_cast<uint16_t>(depth));
                 }
-                else {
-                    // Create new batch entry
-                    size_t newIndex = frame.drawCalls.size();
-                    rendering::DrawCall newDrawCall;
-                    newDrawCall.vertexBuffer = mesh.vertexBuffer;
-                    newDrawCall.indexBuffer = mesh.indexBuffer;
-                    newDrawCall.material = materialHandle->material;
-                    newDrawCall.instanceData.reserve(rendering::MAX_BATCH_SIZE);
+            }
+        });
+    }
+
+    // Sorted keys put equal batches next to each other, a single linear pass replaces the per item lookup.
+    // Every run gets a contiguous slice of the frame's instances starting at firstInstance, returns the end of the last slice.
+    template<typename BatchPredicate>
+    uint32_t MergeRuns(const std::vector<shared::SortItem>& keys, BatchPredicate sameBatch, std::vector<PendingDrawCall>& runs, uint32_t firstInstance) {
+        ZoneScopedN("Batcher: Merge");
+
+        // Rejected items sort last, so the first one ends the list
+        runs.clear();
+        for (size_t x = 0; x < keys.size() && keys[x].key != REJECTED_KEY; x++) {
+            const auto& item = resolved[keys[x].value];
+
+            if (!runs.empty()) {
+                auto& last = runs.back();
+                if (last.first + last.count == x && last.count < rendering::MAX_BATCH_SIZE && sameBatch(resolved[keys[last.first].value], item)) {
+                    last.count++;
+                    continue;
+                }
+
+                firstInstance += last.count;
+            }
+
+            runs.push_back(PendingDrawCall{ .first = x, .count = 1, .firstInstance = firstInstance });
+        }
+
+        return runs.empty() ? firstInstance : firstInstance + runs.back().count;
+    }
+
+    // Fills the draw calls of the runs and writes their instances straight into the frame's instance buffer
+    void BuildDrawCalls(
+        const std::vector<shared::SortItem>& keys,
+        const std::vector<PendingDrawCall>& runs,
+        uint8_t visibilityMask,
+        rendering::DrawCall::InstanceData* instances,
+        eastl::vector<rendering::DrawCall>& drawCalls
+    ) {
+        ZoneScopedN("Batcher: Build Instances");
+        drawCalls.resize(runs.size());
+
+        auto ranges = jobsystem::ParallelRanges(runs.size(), MIN_EMIT_RANGE);
+        while (instanceScratch.size() < ranges) {
+            instanceScratch.push_back(std::make_unique<InstanceScratch>());
+        }
+
+        jobsystem::ParallelFor("Batcher: Build Instances", runs.size(), MIN_EMIT_RANGE, [&](size_t range, size_t begin, size_t end) {
+            auto& streams = instanceScratch[range]->streams;
+            math::TransformStreams transforms = {
+                streams[0].data(), streams[1].data(), streams[2].data(),
+                streams[3].data(), streams[4].data(), streams[5].data(), streams[6].data(),
+                streams[7].data(), streams[8].data(), streams[9].data(),
+            };
+
+            for (size_t x = begin; x < end; x++) {
+                const auto& run = runs[x];
+                const auto& head = resolved[keys[run.first].value];
+
+                auto& drawCall = drawCalls[x];
+                drawCall.vertexBuffer = head.vertexBuffer;
+                drawCall.indexBuffer = head.indexBuffer;
+                drawCall.material = head.material;
+                drawCall.visibility = head.visibility & visibilityMask;
+                drawCall.firstInstance = run.firstInstance;
+                drawCall.instanceCount = run.count;
+
+                for (uint32_t y = 0; y < run.count; y++) {
+                    const auto& source = *resolved[keys[run.first + y].value].source;
+                    streams[0][y] = source.position.X;
+                    streams[1][y] = source.position.Y;
+                    streams[2][y] = source.position.Z;
+                    streams[3][y] = source.rotation.X;
+                    streams[4][y] = source.rotation.Y;
+                    streams[5][y] = source.rotation.Z;
+                    streams[6][y] = source.rotation.W;
+                    streams[7][y] = source.scale.X;
+                    streams[8][y] = source.scale.Y;
+                    streams[9][y] = source.scale.Z;
+                }
+
+                math::InstanceTransformsBulk(transforms, run.count, instances[run.firstInstance].transform, sizeof(rendering::DrawCall::InstanceData));
+            }
+        });
+    }
+
+    uint32_t AddStatic(const DrawCall& drawCall) {
+        uint32_t slot;
+        if (!freeStaticSlots.empty()) {
+            slot = freeStaticSlots.back();
+            freeStaticSlots.pop_back();
+        }
+        else {
+            slot = static_cast<uint32_t>(staticItems.size());
+            staticItems.emplace_back();
+        }
+
+        staticItems[slot] = StaticItem{ .drawCall = drawCall, .live = true };
+        unresolvedStatics.push_back(slot);
+
+        return slot;
+    }
+
+    void MarkStaticDirty(uint32_t batchIndex, uint32_t begin, uint32_t end) {
+        auto& batch = staticBatches[batchIndex];
+        if (batch.dirtyBegin >= batch.dirtyEnd) {
+            dirtyStaticBatches.push_back(batchIndex);
+        }
+
+        batch.dirtyBegin = std::min(batch.dirtyBegin, begin);
+        batch.dirtyEnd = std::max(batch.dirtyEnd, end);
+    }
+
+    void DetachStatic(uint32_t slot) {
+        auto& item = staticItems[slot];
+        if (item.batch == UINT32_MAX) {
+            return;
+        }
+
+        // Swap remove, the item taking the place keeps its batch but changes its instance. The rest of the batch stays where it is.
+        auto& batch = staticBatches[item.batch];
+        auto last = batch.items.back();
+        batch.items[item.index] = last;
+        staticItems[last].index = item.index;
+        batch.items.pop_back();
+
+        if (item.index < batch.items.size()) {
+            MarkStaticDirty(item.batch, item.index, item.index + 1);
+        }
 
-                    math::Matrix3x3 normalMatrixInput = item.transform.ToMatrix3x3();
-                    math::Matrix3x3 normalMatrixInv;
-                    math::Inverse(normalMatrixInput, &normalMatrixInv);
-                    math::Matrix3x3 normalMatrixInvTranspose;
-                    math::Transpose(normalMatrixInv, &normalMatrixInvTranspose);
+        item.batch = UINT32_MAX;
+    }
+
+    void UpdateStatic(uint32_t slot, const DrawCall& drawCall) {
+        if (slot >= staticItems.size() || !staticItems[slot].live) {
+            return;
+        }
+
+        auto& item = staticItems[slot];
+        bool sameAssets = item.drawCall.modelHandle == drawCall.modelHandle && item.drawCall.meshId == drawCall.meshId && item.drawCall.materialHandle == drawCall.materialHandle;
+        item.drawCall = drawCall;
+
+        // Unresolved items pick up the new values when they get resolved
+        if (item.batch == UINT32_MAX) {
+            return;
+        }
+
+        // Different assets may mean a different batch, the item is resolved again
+        if (!sameAssets) {
+            DetachStatic(slot);
+            unresolvedStatics.push_back(slot);
+            return;
+        }
+
+        movedStatics.push_back(slot);
+    }
+
+    void RemoveStatic(uint32_t slot) {
+        if (slot >= staticItems.size() || !staticItems[slot].live) {
+            return;
+        }
+
+        DetachStatic(slot);
+        staticItems[slot].live = false;
+        freeStaticSlots.push_back(slot);
+    }
+
+    math::BoundingSphere StaticBounds(const DrawCall& drawCall, const assetmanager::ModelHandle* model) {
+        // Meshes without bounds are never culled
+        if (drawCall.meshId < model->bounds.size()) {
+            return math::TransformBounds(model->bounds[drawCall.meshId], drawCall.position, drawCall.rotation, drawCall.scale);
+        }
+
+        return math::BoundingSphere(drawCall.position, std::numeric_limits<float>::max());
+    }
+
+    // Static items whose LOD changed leave their batch and get resolved again into the batch of the new LOD's geometry.
+    // Only runs after the cameras or static items moved, a still scene keeps its static batches untouched.
+    void UpdateStaticLods() {
+        ZoneScopedN("Batcher: Static LODs");
+
+        if (!staticLodsDirty || lodViews.empty()) {
+            return;
+        }
+        staticLodsDirty = false;
+
+        staticLods.resize(staticItems.size());
+
+        jobsystem::ParallelFor("Batcher: Static LODs", staticItems.size(), MIN_LOD_RANGE, [&](size_t, size_t begin, size_t end) {
+            for (size_t x = begin; x < end; x++) {
+                const auto& item = staticItems[x];
+                staticLods[x] = item.lod;
+
+                if (!item.live || !item.hasLods || item.batch == UINT32_MAX) {
+                    continue;
+                }
+
+                auto modelHandle = assetmanager::GetModel(item.drawCall.modelHandle);
+                if (modelHandle == nullptr || modelHandle->state.load() != assetmanager::ResourceState::Uploaded) {
+                    continue;
+                }
+
+                staticLods[x] = rendering::SelectLod(modelHandle->meshes[item.drawCall.meshId], LodScreenSize(item.sphere), item.lod);
+            }
+        });
+
+        for (uint32_t slot = 0; slot < staticItems.size(); slot++) {
+            if (staticLods[slot] != staticItems[slot].lod) {
+                staticItems[slot].lod = staticLods[slot];
+                DetachStatic(slot);
+                unresolvedStatics.push_back(slot);
+            }
+        }
+    }
+
+    // Moves static items whose assets finished uploading into their batch
+    void ResolveStatics() {
+        ZoneScopedN("Batcher: Resolve Statics");
+
+        size_t kept = 0;
+        for (auto slot : unresolvedStatics) {
+            auto& item = staticItems[slot];
+
+            // Removed or already resolved through an earlier entry for the same slot
+            if (!item.live || item.batch != UINT32_MAX) {
+                continue;
+            }
+
+            auto modelHandle = assetmanager::GetModel(item.drawCall.modelHandle);
+            auto materialHandle = assetmanager::GetMaterial(item.drawCall.materialHandle);
+
+            if (modelHandle == nullptr || materialHandle == nullptr ||
+                modelHandle->state.load() != assetmanager::ResourceState::Uploaded || materialHandle->state.load() != assetmanager::ResourceState::Uploaded) {
+                unresolvedStatics[kept++] = slot;
+                continue;
+            }
+
+            const auto& mesh = modelHandle->meshes[item.drawCall.meshId];
+            item.sphere = StaticBounds(item.drawCall, modelHandle);
+            item.hasLods = !mesh.lods.empty();
+            if (item.hasLods && !lodViews.empty()) {
+                item.lod = rendering::SelectLod(mesh, LodScreenSize(item.sphere), item.lod);
+            }
+
+            auto [vertexBuffer, indexBuffer] = rendering::LodBuffers(mesh, item.lod);
+            auto key = StaticBatchKey{ materialHandle->material, vertexBuffer, indexBuffer };
+
+            auto [entry, inserted] = staticBatchLookup.try_emplace(key, static_cast<uint32_t>(staticBatches.size()));
+            if (inserted) {
+                staticBatches.push_back(StaticBatch{
+                    .material = materialHandle->material,
+                    .vertexBuffer = vertexBuffer,
+                    .indexBuffer = indexBuffer,
+                });
+            }
+
+            // Appended behind the batch's items, a batch that outgrew its range moves in UpdateStaticInstances
+            auto& batch = staticBatches[entry->second];
+            item.batch = entry->second;
+            item.index = static_cast<uint32_t>(batch.items.size());
+            batch.items.push_back(slot);
+
+            MarkStaticDirty(item.batch, item.index, item.index + 1);
+        }
+
+        unresolvedStatics.resize(kept);
+    }
+
+    // Morton code of the cell the point falls into, items close to each other get close codes
+    uint32_t SpatialKey(const math::Vector3& point) {
+        auto spread = [](float value) {
+            auto cell = static_cast<uint32_t>(static_cast<int32_t>(std::clamp(std::floor(value / STATIC_CELL_SIZE), -512.0f, 511.0f))) & 0x3FF;
+            cell = (cell | (cell << 16)) & 0x030000FF;
+            cell = (cell | (cell << 8)) & 0x0300F00F;
+            cell = (cell | (cell << 4)) & 0x030C30C3;
+            cell = (cell | (cell << 2)) & 0x09249249;
+            return cell;
+        };
+
+        return spread(point.X) | (spread(point.Y) << 1) | (spread(point.Z) << 2);
+    }
+
+    // Orders the batch's items along their cells, a camera then sees a few long runs of the batch instead of scattered instances
+    void SortStaticBatch(StaticBatch& batch) {
+        staticOrder.clear();
+        for (auto slot : batch.items) {
+            staticOrder.emplace_back(SpatialKey(staticItems[slot].sphere.Center), slot);
+        }
+
+        std::sort(staticOrder.begin(), staticOrder.end());
+
+        for (uint32_t y = 0; y < staticOrder.size(); y++) {
+            batch.items[y] = staticOrder[y].second;
+            staticItems[batch.items[y]].index = y;
+        }
+    }
+
+    void WriteStaticSphere(uint32_t instance, const math::BoundingSphere& sphere) {
+        staticCull.centerX[instance] = sphere.Center.X;
+        staticCull.centerY[instance] = sphere.Center.Y;
+        staticCull.centerZ[instance] = sphere.Center.Z;
+        staticCull.radius[instance] = sphere.Radius;
+    }
+
+    void WriteStaticInstances(const StaticBatch& batch, uint32_t first, uint32_t count, InstanceScratch& scratch) {
+        auto& streams = scratch.streams;
+        math::TransformStreams transforms = {
+            streams[0].data(), streams[1].data(), streams[2].data(),
+            streams[3].data(), streams[4].data(), streams[5].data(), streams[6].data(),
+            streams[7].data(), streams[8].data(), streams[9].data(),
+        };
+
+        for (uint32_t y = 0; y < count; y++) {
+            const auto& source = staticItems[batch.items[first + y]].drawCall;
+            streams[0][y] = source.position.X;
+            streams[1][y] = source.position.Y;
+            streams[2][y] = source.position.Z;
+            streams[3][y] = source.rotation.X;
+            streams[4][y] = source.rotation.Y;
+            streams[5][y] = source.rotation.Z;
+            streams[6][y] = source.rotation.W;
+            streams[7][y] = source.scale.X;
+            streams[8][y] = source.scale.Y;
+            streams[9][y] = source.scale.Z;
+        }
+
+        math::InstanceTransformsBulk(transforms, count, staticInstances[batch.firstInstance + first].transform, sizeof(rendering::DrawCall::InstanceData));
+    }
+
+    void ResizeStaticInstances(uint32_t count) {
+        staticInstances.resize(count);
+        staticCull.centerX.resize(count);
+        staticCull.centerY.resize(count);
+        staticCull.centerZ.resize(count);
+        staticCull.radius.resize(count);
+    }
+
+    // Gives a batch that outgrew its range one twice its size, from the ranges other batches left behind or else behind every instance.
+    // Only this batch is sorted again, the others keep their instances where they are.
+    void MoveStaticBatch(StaticBatch& batch) {
+        if (batch.capacity > 0) {
+            freeStaticRanges.emplace_back(batch.firstInstance, batch.capacity);
+        }
+
+        batch.capacity = std::max(std::bit_ceil(static_cast<uint32_t>(batch.items.size())), MIN_STATIC_BATCH_CAPACITY);
+
+        auto range = std::find_if(freeStaticRanges.begin(), freeStaticRanges.end(), [&](const auto& free) { return free.second >= batch.capacity; });
+        if (range != freeStaticRanges.end()) {
+            batch.firstInstance = range->first;
+            range->first += batch.capacity;
+            range->second -= batch.capacity;
+            if (range->second == 0) {
+                *range = freeStaticRanges.back();
+                freeStaticRanges.pop_back();
+            }
+        }
+        else {
+            batch.firstInstance = static_cast<uint32_t>(staticInstances.size());
+            ResizeStaticInstances(batch.firstInstance + batch.capacity);
+        }
+
+        SortStaticBatch(batch);
+        batch.dirtyBegin = 0;
+        batch.dirtyEnd = static_cast<uint32_t>(batch.items.size());
+    }
+
+    // Brings the CPU copy of the static instances up to date. Only the dirty range of each changed batch is rewritten,
+    // the GPU buffer is only replaced once the instances no longer fit into it.
+    void UpdateStaticInstances() {
+        ZoneScopedN("Batcher: Update Statics");
+
+        if (instanceScratch.empty()) {
+            instanceScratch.push_back(std::make_unique<InstanceScratch>());
+        }
+        auto& scratch = *instanceScratch.front();
+
+        for (auto slot : movedStatics) {
+            auto& item = staticItems[slot];
+
+            // Removed or re-resolved since it moved, resolving marks its new instance
+            if (!item.live || item.batch == UINT32_MAX) {
+                continue;
+            }
+
+            auto modelHandle = assetmanager::GetModel(item.drawCall.modelHandle);
+            if (modelHandle != nullptr) {
+                item.sphere = StaticBounds(item.drawCall, modelHandle);
+            }
+
+            // The new bounds may need another LOD, the next LOD pass picks it up
+            staticLodsDirty |= item.hasLods;
+
+            MarkStaticDirty(item.batch, item.index, item.index + 1);
+        }
+        movedStatics.clear();
+
+        for (auto batchIndex : dirtyStaticBatches) {
+            auto& batch = staticBatches[batchIndex];
+            if (batch.items.size() > batch.capacity) {
+                MoveStaticBatch(batch);
+            }
 
-                    newDrawCall.instanceData.push_back({ .transform = item.transform, .normals = normalMatrixInvTranspose.ToMatrix4x4() });
+            // Items removed from the tail leave the range reaching past the batch
+            auto end = std::min(batch.dirtyEnd, static_cast<uint32_t>(batch.items.size()));
+            for (uint32_t first = batch.dirtyBegin; first < end; first += rendering::MAX_BATCH_SIZE) {
+                WriteStaticInstances(batch, first, std::min<uint32_t>(end - first, rendering::MAX_BATCH_SIZE), scratch);
+            }
+
+            for (uint32_t y = batch.dirtyBegin; y < end; y++) {
+                WriteStaticSphere(batch.firstInstance + y, staticItems[batch.items[y]].sphere);
+            }
+        }
+
+        // Frames in flight keep the buffer they were handed, a new one is only needed to grow
+        if (!staticInstances.empty() && (staticInstanceBuffer == nullptr || staticInstanceBuffer->Size() < staticInstances.size())) {
+            staticInstanceBuffer = rendering::AcquireInstanceBuffer(static_cast<uint32_t>(staticInstances.size()));
+            staticBufferReplaced = true;
+        }
+    }
 
-                    frame.drawCalls.push_back(newDrawCall);
+    // Hands the packet the instances changed since the previous one, the render thread stages and uploads only these ranges
+    void EmitStaticPatches(rendering::RenderFrame& frame) {
+        auto patch = [&](uint32_t first, uint32_t count) {
+            frame.staticPatches.push_back(rendering::StaticInstancePatch{ .first = first, .count = count });
+            frame.staticPatchData.insert(frame.staticPatchData.end(), staticInstances.data() + first, staticInstances.data() + first + count);
+        };
 
-                    batchedDrawCalls.insert_or_assign(key, newIndex);
+        if (staticBufferReplaced) {
+            patch(0, static_cast<uint32_t>(staticInstances.size()));
+        }
+        else {
+            for (auto batchIndex : dirtyStaticBatches) {
+                const auto& batch = staticBatches[batchIndex];
+                auto end = std::min(batch.dirtyEnd, static_cast<uint32_t>(batch.items.size()));
+                if (batch.dirtyBegin < end) {
+                    patch(batch.firstInstance + batch.dirtyBegin, end - batch.dirtyBegin);
                 }
             }
         }
 
+        for (auto batchIndex : dirtyStaticBatches) {
+            staticBatches[batchIndex].dirtyBegin = UINT32_MAX;
+            staticBatches[batchIndex].dirtyEnd = 0;
+        }
+        dirtyStaticBatches.clear();
+        staticBufferReplaced = false;
+    }
+
+    // Emits one draw call per run of neighbouring instances of the batch that share a non zero mask
+    template<typename Mask, typename Emit>
+    void EmitStaticRuns(const StaticBatch& batch, Mask mask, Emit emit) {
+        auto size = static_cast<uint32_t>(batch.items.size());
+        uint32_t first = 0;
+        while (first < size) {
+            auto value = mask(batch.firstInstance + first);
+            auto last = first + 1;
+            while (last < size && last - first < rendering::MAX_BATCH_SIZE && mask(batch.firstInstance + last) == value) {
+                last++;
+            }
+
+            if (value != 0) {
+                emit(rendering::DrawCall{
+                    .vertexBuffer = batch.vertexBuffer,
+                    .indexBuffer = batch.indexBuffer,
+                    .material = batch.material,
+                    .firstInstance = batch.firstInstance + first,
+                    .instanceCount = last - first,
+                }, value);
+            }
+
+            first = last;
+        }
+    }
+
+    // Culls every static instance against its cached sphere and emits the visible runs of each batch, their instances stay in the persistent buffer
+    void EmitStatics(rendering::RenderFrame& frame) {
+        ZoneScopedN("Batcher: Emit Statics");
+
+        // Without a buffer the dirty ranges wait for the next packet
+        if (staticInstanceBuffer == nullptr) {
+            return;
+        }
+
+        frame.staticInstanceBuffer = staticInstanceBuffer;
+        frame.staticInstanceCount = static_cast<uint32_t>(staticInstances.size());
+        EmitStaticPatches(frame);
+
+        auto count = staticInstances.size();
+        staticCull.visibility.assign(count, 0);
+        staticCull.cascades.assign(count, 0);
+
+        jobsystem::ParallelFor("Batcher: Cull Statics", count, MIN_RESOLVE_RANGE, [&](size_t, size_t begin, size_t end) {
+            auto rows = end - begin;
+            auto centerX = staticCull.centerX.data() + begin;
+            auto centerY = staticCull.centerY.data() + begin;
+            auto centerZ = staticCull.centerZ.data() + begin;
+            auto radius = staticCull.radius.data() + begin;
+
+            for (const auto& view : cullViews) {
+                math::CullSpheres(view.frustum, centerX, centerY, centerZ, radius, rows, view.mask, staticCull.visibility.data() + begin);
+            }
+
+            for (const auto& view : cascadeViews) {
+                math::CullSpheres(view.frustum, centerX, centerY, centerZ, radius, rows, view.mask, staticCull.cascades.data() + begin);
+            }
+
+            for (size_t x = begin; x < end; x++) {
+                OccludeSphere(staticCull.centerX[x], staticCull.centerY[x], staticCull.centerZ[x], staticCull.radius[x], staticCull.visibility[x]);
+            }
+        });
+
+        for (const auto& batch : staticBatches) {
+            EmitStaticRuns(batch, [&](uint32_t instance) { return staticCull.visibility[instance]; }, [&](rendering::DrawCall drawCall, uint8_t visibility) {
+                drawCall.visibility = visibility;
+                frame.staticDrawCalls.push_back(drawCall);
+            });
+
+            for (uint8_t cascade = 0; cascade < cascadeViews.size(); cascade++) {
+                EmitStaticRuns(batch, [&](uint32_t instance) { return static_cast<uint8_t>(staticCull.cascades[instance] & (1 << cascade)); }, [&](rendering::DrawCall drawCall, uint8_t) {
+                    drawCall.visibility = rendering::SHADOW_VISIBILITY_MASK;
+                    frame.staticShadowDrawCalls[cascade].push_back(drawCall);
+                });
+            }
+        }
+    }
+
+    // Hands every shadow draw call to the caster list of each cascade its run falls into
+    void DistributeCascades(rendering::RenderFrame& frame) {
+        for (size_t x = 0; x < shadowPending.size(); x++) {
+            auto cascades = resolved[shadowKeys[shadowPending[x].first].value].cascades;
+            for (; cascades != 0; cascades &= cascades - 1) {
+                frame.shadowDrawCalls[std::countr_zero(cascades)].push_back(shadowScratch[x]);
+            }
+        }
+    }
+
+    // Every camera gets its own froxel grid, the lights are shared
+    void BuildLightClusters(rendering::RenderFrame& frame) {
+        ZoneScopedN("Batcher: Build Light Clusters");
+
+        frame.pointLights.assign(pointLights.begin(), pointLights.end());
+        frame.spotLights.assign(spotLights.begin(), spotLights.end());
+        frame.lightClusters.resize(frame.cameras.size());
+
+        for (size_t x = 0; x < frame.cameras.size(); x++) {
+            auto camera = frame.cameras[x];
+            camera.SetAspectRatio(aspectRatio);
+
+            lightClusterBuilder.Build(camera, viewportWidth, viewportHeight, pointLights.data(), pointLights.size(), spotLights.data(), spotLights.size(), frame.lightClusters[x]);
+        }
+    }
+
+    void Submit() {
+        ZoneScopedN("Batcher: Submit");
+
+        // Every packet is still queued or drawn when the renderer fell too far behind (or isn't running), this frame is dropped
+        auto packet = rendering::AcquireFrame();
+        if (packet == nullptr) {
+            DrawCallRange dropped;
+            while (batches.try_dequeue(dropped)) {}
+
+            cameras.clear();
+            cameraLodBiases.clear();
+            occluders.clear();
+            pointLights.clear();
+            spotLights.clear();
+            arena.Reset();
+
+            return;
+        }
+
+        auto& frame = *packet;
+
+        BuildLodViews();
+
+        // Depth is measured from the main camera, without one every item sorts as if it was at the eye
+        math::Vector3 eye = cameras.empty() ? math::Vector3(0, 0, 0) : cameras.front().Position;
+        float depthScale = cameras.empty() ? 0.0f : 65535.0f / std::max(cameras.front().Far, 0.001f);
+
+        for (auto& cam : cameras) {
+            frame.cameras.emplace_back(std::move(cam));
+        }
+
+        frame.sun = sun;
+        frame.isDirty = true;
+
+        ranges.clear();
+        rangeOffsets.clear();
+
+        size_t count = 0;
+        DrawCallRange next;
+        while (batches.try_dequeue(next)) {
+            if (next.count == 0) {
+                continue;
+            }
+
+            ranges.push_back(next);
+            rangeOffsets.push_back(count);
+            count += next.count;
+        }
+
+        resolved.resize(count);
+        sortKeys.resize(count);
+        shadowKeys.resize(count);
+
+        BuildCascades(frame);
+        BuildCullViews(frame);
+        RasterizeOccluders(frame);
+        BuildLightClusters(frame);
+
+        UpdateStaticLods();
+        ResolveStatics();
+        UpdateStaticInstances();
+        EmitStatics(frame);
+
+        ResolveItems(count, eye, depthScale);
+        shared::RadixSort(sortKeys, sortScratch);
+        shared::RadixSort(shadowKeys, sortScratch);
+
+        // Camera instances come first, the shadow casters follow in the same buffer
+        auto instanceCount = MergeRuns(sortKeys, SameBatch, pending, 0);
+        instanceCount = MergeRuns(shadowKeys, SameShadowBatch, shadowPending, instanceCount);
+
+        if (instanceCount > 0) {
+            frame.instanceBuffer = rendering::AcquireInstanceBuffer(instanceCount);
+        }
+
+        // Without a running renderer there is nowhere to write to, the frame goes out empty
+        if (frame.instanceBuffer != nullptr) {
+            auto instances = static_cast<rendering::DrawCall::InstanceData*>(frame.instanceBuffer->Data());
+            frame.instanceCount = instanceCount;
+
+            BuildDrawCalls(sortKeys, pending, static_cast<uint8_t>(~rendering::SHADOW_VISIBILITY_MASK), instances, frame.drawCalls);
+            BuildDrawCalls(shadowKeys, shadowPending, rendering::SHADOW_VISIBILITY_MASK, instances, shadowScratch);
+            DistributeCascades(frame);
+        }
+
         {
             ZoneScopedN("Batcher: Queue Draw Calls");
 
-            batchedDrawCalls.clear();
-
             cameras.clear();
+            cameraLodBiases.clear();
+            occluders.clear();
+            pointLights.clear();
+            spotLights.clear();
 
-            rendering::SubmitFrame(std::move(frame));
+            rendering::SubmitFrame(packet);
 
             arena.Reset();
         }
     }
+
+    void Shutdown() {
+        staticItems.clear();
+        freeStaticSlots.clear();
+        unresolvedStatics.clear();
+        movedStatics.clear();
+        staticBatches.clear();
+        staticBatchLookup.clear();
+        staticInstances.clear();
+        staticInstanceBuffer = nullptr;
+        staticBufferReplaced = false;
+        dirtyStaticBatches.clear();
+        freeStaticRanges.clear();
+        staticLods.clear();
+        lodViews.clear();
+        occluders.clear();
+    }
 }
@@ -1,4 +1,5 @@
 #include "playground/ECS.hxx"
+#include "playground/ECSStats.hxx"
 #include "playground/PhysicsManager.hxx"
 #include "playground/Constants.hxx"
 #include "playground/systems/RenderSystem.hxx"
@@ -8,6 +9,8 @@
 #include "playground/systems/StaticBodyUpdateSystem.hxx"
 #include "playground/systems/AudioSourceSystem.hxx"
 #include "playground/systems/AudioListenerSystem.hxx"
+#include "playground/systems/SpatialIndexSystem.hxx"
+#include "playground/SpatialIndex.hxx"
 #include "playground/components/TransformComponent.hxx"
 #include "playground/components/WorldTransformComponent.hxx"
 #include "playground/components/MeshComponent.hxx"
@@ -17,7 +20,12 @@
 #include "playground/components/StaticBodyComponent.hxx"
 #include "playground/components/AudioSourceComponent.hxx"
 #include "playground/components/AudioListenerComponent.hxx"
+#include "playground/components/SpatialProxyComponent.hxx"
+#include "playground/components/StaticComponent.hxx"
+#include "playground/components/StaticBatchComponent.hxx"
+#include "playground/DrawCallBatcher.hxx"
 #include <shared/JobSystem.hxx>
+#include <chrono>
 #include <mutex>
 #include <shared_mutex>
 #include <map>
@@ -30,6 +38,9 @@
 #include <tracy/Tracy.hpp>
 
 #include "playground/components/CameraComponent.hxx"
+#include "playground/components/OccluderComponent.hxx"
+#include "playground/components/PointLightComponent.hxx"
+#include "playground/components/SpotLightComponent.hxx"
 #include "playground/components/TransformComponent.hxx"
 #include "playground/components/WorldTransformComponent.hxx"
 #include "playground/systems/CameraSystem.hxx"
@@ -51,7 +62,7 @@ namespace playground::ecs {
 
     uint64_t CreateSystem(const char* name, Filter* filter, size_t filterCount, bool isParallel, SystemTickDelegate delegate, ecs_entity_t dependsOn);
     void RegisterComponents();
-    void RegisterSystems();
+    void RegisterSystems(bool headless, bool rendering);
 
     void AttachChildrenCollidersRigid(flecs::entity e, RigidBodyComponent& body) {
         e.children([&](flecs::entity child) {
@@ -79,10 +90,30 @@ namespace playground::ecs {
         });
     }
 
+    // Drops the entity's entry from the static cache, the static system re-adds it once it has a mesh and material again
+    void ReleaseStaticBatch(flecs::entity e) {
+        if (!e.has<StaticBatchComponent>()) {
+            return;
+        }
+
+        auto batch = e.get<StaticBatchComponent>();
+        drawcallbatcher::RemoveStatic(batch.Slot);
+        batch.Slot = UINT32_MAX;
+        e.set<StaticBatchComponent>(batch);
+    }
+
     void RegisterComponents() {
         playground::ecs::GetWorld().component<WorldTransformComponent>("::WorldTransformComponent");
         playground::ecs::GetWorld().component<MeshRuntimeComponent>("::MeshRuntimeComponent");
         playground::ecs::GetWorld().component<MaterialRuntimeComponent>("::MaterialRuntimeComponent");
+        playground::ecs::GetWorld().component<SpatialProxyComponent>("::SpatialProxyComponent")
+            .on_remove([](flecs::entity e, SpatialProxyComponent& proxy) {
+                spatialindex::DestroyProxy(proxy.ProxyId);
+            });
+        playground::ecs::GetWorld().component<StaticBatchComponent>("::StaticBatchComponent")
+            .on_remove([](flecs::entity e, StaticBatchComponent& batch) {
+                drawcallbatcher::RemoveStatic(batch.Slot);
+            });
         playground::ecs::GetWorld().component<TransformComponent>("::TransformComponent")
             .on_add([](flecs::entity e, TransformComponent) {
                 e.add<WorldTransformComponent>();
@@ -92,19 +123,23 @@ namespace playground::ecs {
             .on_add([](flecs::entity e, MeshComponent component)
             {
                 e.add<MeshRuntimeComponent>();
+                e.add<SpatialProxyComponent>();
             })
             .on_set([](flecs::entity e, MeshComponent authoring)
             {
                 auto runtime = e.get<MeshRuntimeComponent>();
                 runtime.HandleId = assetmanager::LoadModel(authoring.AssetId);
                 runtime.MeshId = authoring.MeshId;
+                runtime.Lod = 0;
                 e.set<MeshRuntimeComponent>(runtime);
             })
             .on_remove([](flecs::entity e, MeshComponent)
             {
                 auto runtime = e.get<MeshRuntimeComponent>();
                 assetmanager::ReleaseModel(runtime.HandleId);
+                ReleaseStaticBatch(e);
                 e.remove<MeshRuntimeComponent>();
+                e.remove<SpatialProxyComponent>();
             });
         playground::ecs::GetWorld().component<MaterialComponent>("::MaterialComponent")
             .on_add([](flecs::entity e, MaterialComponent component)
@@ -122,25 +157,55 @@ namespace playground::ecs {
             {
                 auto runtime = e.get<MaterialRuntimeComponent>();
                 assetmanager::ReleaseMaterial(runtime.HandleId);
+                ReleaseStaticBatch(e);
                 e.remove<MaterialRuntimeComponent>();
             });
         playground::ecs::GetWorld().component<BoxColliderComponent>("::BoxColliderComponent");
         playground::ecs::GetWorld().component<RigidBodyComponent>("::RigidBodyComponent");
-        playground::ecs::GetWorld().component<StaticBodyComponent>("::StaticBodyComponent");
+        playground::ecs::GetWorld().component<StaticBodyComponent>("::StaticBodyComponent")
+            .on_add([](flecs::entity e, StaticBodyComponent) {
+                e.add<StaticBatchComponent>();
+            })
+            .on_remove([](flecs::entity e, StaticBodyComponent) {
+                if (!e.has<StaticComponent>()) {
+                    e.remove<StaticBatchComponent>();
+                }
+            });
+        playground::ecs::GetWorld().component<StaticComponent>("::StaticComponent")
+            .on_add([](flecs::entity e, StaticComponent) {
+                e.add<StaticBatchComponent>();
+            })
+            .on_remove([](flecs::entity e, StaticComponent) {
+                if (!e.has<StaticBodyComponent>()) {
+                    e.remove<StaticBatchComponent>();
+                }
+            });
         playground::ecs::GetWorld().component<AudioSourceComponent>("::AudioSourceComponent");
         playground::ecs::GetWorld().component<AudioListenerComponent>("::AudioListenerComponent");
         playground::ecs::GetWorld().component<CameraComponent>("::CameraComponent");
+        playground::ecs::GetWorld().component<OccluderComponent>("::OccluderComponent");
+        playground::ecs::GetWorld().component<PointLightComponent>("::PointLightComponent");
+        playground::ecs::GetWorld().component<SpotLightComponent>("::SpotLightComponent");
     }
 
-    void RegisterSystems() {
+    void RegisterSystems(bool headless, bool rendering) {
         playground::ecs::boxcolliderupdatesystem::Init(*world);
         playground::ecs::rigidbodyupdatesystem::Init(*world);
         playground::ecs::staticbodyupdatesystem::Init(*world);
         playground::ecs::hierarchysystem::Init(*world);
-        playground::ecs::audiosourcesystem::Init(*world);
-        playground::ecs::audiolistenersystem::Init(*world);
-        playground::ecs::rendersystem::Init(*world);
-        playground::ecs::camerasystem::Init(*world);
+        playground::ecs::spatialindexsystem::Init(*world);
+
+        // Presentation systems talk to the renderer and audio device. Headless runs have no audio device and only render on the null backend.
+#ifdef PLATFORM_MODULES
+        if (!headless) {
+            playground::ecs::audiosourcesystem::Init(*world);
+            playground::ecs::audiolistenersystem::Init(*world);
+        }
+#endif
+        if (rendering) {
+            playground::ecs::rendersystem::Init(*world);
+            playground::ecs::camerasystem::Init(*world);
+        }
     }
 
     ecs_os_thread_t SpawnTask(ecs_os_thread_callback_t callback, void* param) {
@@ -171,13 +236,17 @@ namespace playground::ecs {
         return nullptr;
     };
 
-    void Init(bool debugServer) {
+    void Init(bool debugServer, bool headless, bool rendering) {
         ecs_os_set_api_defaults();
         auto api = ecs_os_get_api();
         api.task_new_ = SpawnTask;
         api.task_join_ = JoinTask;
         api.thread_self_ = []() -> ecs_os_thread_id_t {
+#ifdef _MSC_VER
             return std::this_thread::get_id()._Get_underlying_id();
+#else
+            return std::hash<std::thread::id>{}(std::this_thread::get_id());
+#endif
             };
         ecs_os_set_api(&api);
 
@@ -218,13 +287,19 @@ namespace playground::ecs {
         jobs = {};
 
         RegisterComponents();
-        RegisterSystems();
+        RegisterSystems(headless, rendering);
+
+        stats::Init(*world);
     }
 
     void Update(double deltaTime) {
         jobs.clear();
 
+        auto start = std::chrono::steady_clock::now();
         world->progress(deltaTime);
+        std::chrono::duration<float, std::milli> tickTime = std::chrono::steady_clock::now() - start;
+
+        stats::Collect(tickTime.count(), static_cast<uint32_t>(jobs.size()));
     }
 
     void Clear() {
@@ -236,6 +311,7 @@ namespace playground::ecs {
     }
 
     void Shutdown() {
+        stats::Shutdown();
         world->quit();
 
         ecs_fini(*world);
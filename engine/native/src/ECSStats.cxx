@@ -0,0 +1,170 @@
+#include "playground/ECSStats.hxx"
+#include "playground/ECS.hxx"
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace playground::ecs::stats {
+    constexpr float AVERAGE_WEIGHT = 0.05f;
+
+    struct SystemRecord {
+        SystemStats stats;
+        uint64_t lastSeen;
+    };
+
+    flecs::world* world = nullptr;
+    flecs::query<> systemsQuery;
+    bool enabled = true;
+    FrameStats frameStats = {};
+    std::unordered_map<ecs_entity_t, SystemRecord> records;
+    std::vector<PhaseStats> phases;
+
+    void Init(flecs::world& ecsWorld) {
+        world = &ecsWorld;
+        systemsQuery = world->query_builder().with(flecs::System).build();
+        world->measure_system_time(enabled);
+    }
+
+    void Shutdown() {
+        systemsQuery = {};
+        records.clear();
+        phases.clear();
+        world = nullptr;
+    }
+
+    void Collect(float tickTime, uint32_t jobs) {
+        if (!enabled || world == nullptr) {
+            return;
+        }
+
+        ZoneScopedN("ECS: Collect Stats");
+        ecs_world_t* w = *world;
+
+        frameStats.frame++;
+        frameStats.tickTime = tickTime;
+        frameStats.systemTime = 0;
+        frameStats.jobs = jobs;
+        frameStats.systemCount = 0;
+
+        for (auto& phase : phases) {
+            phase.lastTime = 0;
+            phase.systemCount = 0;
+        }
+
+        auto stageCount = static_cast<uint32_t>(std::max(ecs_get_stage_count(w), 1));
+
+        systemsQuery.each([&](flecs::entity entity) {
+            const ecs_system_t* system = ecs_system_get(w, entity);
+            if (system == nullptr) {
+                return;
+            }
+
+            auto [it, added] = records.try_emplace(entity.id());
+            auto& record = it->second;
+            if (added) {
+                record.stats.system = entity.id();
+                record.stats.phase = ecs_get_target(w, entity, EcsDependsOn, 0);
+                record.stats.name = ecs_get_name(w, entity);
+                record.stats.fanOut = system->multi_threaded ? stageCount : 1;
+            }
+
+            // flecs accumulates in single precision, a running total would lose sub millisecond steps within minutes.
+            // Taking the total and zeroing it every sample keeps it at one frame. The first sample may hold
+            // time from before stats were enabled, so it only resets.
+            auto& timeSpent = const_cast<ecs_system_t*>(system)->time_spent;
+            auto last = added ? 0.0f : static_cast<float>(timeSpent) * 1000.0f;
+            timeSpent = 0;
+            record.lastSeen = frameStats.frame;
+
+            auto& stats = record.stats;
+            stats.lastTime = last;
+            stats.averageTime = added ? last : stats.averageTime + (last - stats.averageTime) * AVERAGE_WEIGHT;
+            stats.maxTime = std::max(stats.maxTime, last);
+
+            frameStats.systemTime += last;
+            frameStats.systemCount++;
+
+            auto phase = std::find_if(phases.begin(), phases.end(), [&](const PhaseStats& p) { return p.phase == stats.phase; });
+            if (phase == phases.end()) {
+                phases.push_back(PhaseStats{ .phase = stats.phase, .name = stats.phase != 0 ? ecs_get_name(w, stats.phase) : "None" });
+                phase = phases.end() - 1;
+            }
+
+            phase->lastTime += last;
+            phase->systemCount++;
+        });
+
+        for (auto& phase : phases) {
+            phase.averageTime += (phase.lastTime - phase.averageTime) * AVERAGE_WEIGHT;
+        }
+
+        // Systems deleted since the last sample
+        std::erase_if(records, [](const auto& record) {
+            return record.second.lastSeen != frameStats.frame;
+        });
+    }
+
+    void SetEnabled(bool value) {
+        enabled = value;
+        if (world != nullptr) {
+            world->measure_system_time(enabled);
+        }
+
+        Reset();
+    }
+
+    bool IsEnabled() {
+        return enabled;
+    }
+
+    void Reset() {
+        records.clear();
+        phases.clear();
+        frameStats = {};
+    }
+
+    size_t GetSystemStats(SystemStats* stats, size_t capacity) {
+        if (stats == nullptr) {
+            return records.size();
+        }
+
+        size_t count = 0;
+        for (auto& [entity, record] : records) {
+            if (count == capacity) {
+                break;
+            }
+
+            auto& result = stats[count++];
+            result = record.stats;
+
+            const ecs_system_t* system = world != nullptr ? ecs_system_get(*world, entity) : nullptr;
+            if (system != nullptr && system->query != nullptr) {
+                auto matched = ecs_query_count(system->query);
+                result.tables = matched.tables;
+                result.entities = matched.entities;
+            }
+        }
+
+        return count;
+    }
+
+    size_t GetPhaseStats(PhaseStats* stats, size_t capacity) {
+        if (stats == nullptr) {
+            return phases.size();
+        }
+
+        auto count = std::min(capacity, phases.size());
+        std::copy(phases.begin(), phases.begin() + count, stats);
+
+        return count;
+    }
+
+    FrameStats GetFrameStats() {
+        return frameStats;
+    }
+
+    void GetFrameStats_C(FrameStats* stats) {
+        *stats = frameStats;
+    }
+}
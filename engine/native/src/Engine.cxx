@@ -1,21 +1,32 @@
 #include "playground/Engine.hxx"
 #include "playground/AssetManager.hxx"
 #include "playground/ECS.hxx"
+#include "playground/ECSStats.hxx"
 #include "playground/DrawCallbatcher.hxx"
+#ifdef PLATFORM_MODULES
 #include "playground/InputManager.hxx"
+#endif
 #include "playground/PhysicsManager.hxx"
+#include "playground/Prefabs.hxx"
+#include "playground/SpatialIndex.hxx"
+#include "playground/WorldSnapshot.hxx"
+#include "playground/WorldStreaming.hxx"
 #include "playground/renderdoc_app.h"
 #include <chrono>
+#include <csignal>
+#include <cstring>
 #include <string>
 #include <thread>
 #include <shared/Hardware.hxx>
 #include <shared/JobSystem.hxx>
 #include <shared/Logger.hxx>
+#ifdef PLATFORM_MODULES
 #include <audio/Audio.hxx>
 #include <input/Input.hxx>
+#include <system/System.hxx>
+#endif
 #include <rendering/Rendering.hxx>
 #include <rendering/Mesh.hxx>
-#include <system/System.hxx>
 #include <events/Events.hxx>
 #include <events/Event.hxx>
 #include <events/SystemEvent.hxx>
@@ -34,6 +45,11 @@
 typedef void(*ScriptingEventCallback)(playground::events::Event* event);
 
 bool isRunning = true;
+bool isHeadless = false;
+// Headless runs only render when they select the null backend, every other run renders
+bool isRendering = true;
+uint32_t tickRate = 0;
+playground::rendering::RenderBackendType renderBackend;
 auto now = std::chrono::high_resolution_clock::now();
 std::thread renderThread;
 
@@ -48,7 +64,9 @@ void SetupPointerLookupTable(const PlaygroundConfig& config);
 #if EDITOR
 void SetupEditorPointerLookupTable(const PlaygroundConfig& config);
 #endif
+bool ParseRenderBackend(const char* name, playground::rendering::RenderBackendType& backend);
 void StartRenderThread(const PlaygroundConfig& config, void* window);
+void WaitForNextTick();
 void LoadCoreAssets();
 void SubscribeToEventsFromScripting(playground::events::EventType type, ScriptingEventCallback callback);
 void Update();
@@ -59,6 +77,8 @@ void Shutdown();
 /// 0 - OK
 /// 1 - Error (Unknown error)
 /// 2 - Error (No AVX or AVX2 support)
+/// 3 - Error (No window and no system module to create one)
+/// 4 - Error (Renderer unknown or not available on this platform)
 uint8_t PlaygroundCoreMain(const PlaygroundConfig& config) {
 #if ENABLE_PROFILER
     tracy::StartupProfiler();
@@ -74,6 +94,9 @@ uint8_t PlaygroundCoreMain(const PlaygroundConfig& config) {
     if (code == 2) {
         auto cpuName = playground::hardware::GetCPUBrandString();
         playground::logging::logger::Error(cpuName + " is not supported by this game", "core");
+        if (isHeadless) {
+            std::exit(EXIT_FAILURE);
+        }
         std::string message =
             "Your system does not meet the minimum requirements to run this game.\nAVX instructions are required.\n\n"
             + cpuName;
@@ -97,7 +120,9 @@ uint8_t PlaygroundCoreMain(const PlaygroundConfig& config) {
 
     // Register mandatory assets
 
-    LoadCoreAssets();
+    if (isRendering) {
+        LoadCoreAssets();
+    }
 
     auto cores = playground::hardware::GetCoresByEfficiency(playground::hardware::CPUEfficiencyClass::Performance);
 
@@ -131,13 +156,29 @@ double GetDeltaTime() {
 
 void Shutdown() {
     isRunning = false;
-    playground::input::Shutdown();
-    playground::rendering::Shutdown();
-    playground::audio::Shutdown();
+#ifdef PLATFORM_MODULES
+    if (!isHeadless) {
+        playground::input::Shutdown();
+    }
+#endif
+    if (isRendering) {
+        playground::drawcallbatcher::Shutdown();
+        playground::rendering::Shutdown();
+    }
+#ifdef PLATFORM_MODULES
+    if (!isHeadless) {
+        playground::audio::Shutdown();
+    }
+#endif
     playground::physicsmanager::Shutdown();
+    playground::worldstreaming::Shutdown();
+    playground::prefabs::Shutdown();
     playground::ecs::Shutdown();
+    playground::spatialindex::Shutdown();
     playground::jobsystem::Shutdown();
-    renderThread.join();
+    if (renderThread.joinable()) {
+        renderThread.join();
+    }
 
 #if ENABLE_PROFILER
     tracy::ShutdownProfiler();
@@ -150,10 +191,34 @@ uint8_t SetupSubsystems(const PlaygroundConfig& config) {
     SetupEditorPointerLookupTable(config);
 #endif
 
+    isHeadless = config.Headless;
+    tickRate = config.TickRate;
+
+    if (!ParseRenderBackend(config.Renderer, renderBackend)) {
+        playground::logging::logger::Error(std::string("Renderer ") + config.Renderer + " is not available on this platform", "core");
+
+        return 4;
+    }
+    // Headless runs stay without renderer unless the null backend was asked for
+    bool selectsNull = config.Renderer != nullptr && std::strcmp(config.Renderer, "null") == 0;
+    isRendering = !isHeadless || selectsNull;
+
     void* window = nullptr;
-    if (config.WindowHandle == nullptr) {
+    if (isHeadless) {
+        playground::logging::logger::Info(isRendering ? "Starting in headless mode with the null renderer" : "Starting in headless mode", "core");
+
+        std::signal(SIGINT, [](int) { isRunning = false; });
+        std::signal(SIGTERM, [](int) { isRunning = false; });
+    }
+    else if (config.WindowHandle == nullptr) {
+#ifdef PLATFORM_MODULES
         playground::logging::logger::Info("No window handle provided. Starting in standalone mode", "core");
         window = playground::system::Init(config.Width, config.Height, config.Fullscreen, config.Name);
+#else
+        playground::logging::logger::Error("No window handle provided and this build has no system module to create one. Run headless instead", "core");
+
+        return 3;
+#endif
     }
     else {
         playground::logging::logger::Info("Window handle provided. Starting in embedded mode", "core");
@@ -177,21 +242,31 @@ uint8_t SetupSubsystems(const PlaygroundConfig& config) {
     playground::events::Init();
 
     playground::assetloader::Init(config.Path);
-    playground::audio::Init(
-        playground::io::OpenFileFromArchive,
-        playground::io::ReadFileFromArchive,
-        playground::io::SeekFileInArchive,
-        playground::io::CloseFile
-    );
-    playground::inputmanager::Init(window);
+    playground::assetmanager::Init(isHeadless, isRendering);
+#ifdef PLATFORM_MODULES
+    if (!isHeadless) {
+        playground::audio::Init(
+            playground::io::OpenFileFromArchive,
+            playground::io::ReadFileFromArchive,
+            playground::io::SeekFileInArchive,
+            playground::io::CloseFile
+        );
+        playground::inputmanager::Init(window);
+    }
+#endif
     playground::physicsmanager::Init();
-    StartRenderThread(config, window);
+    playground::spatialindex::Init();
+    if (isRendering) {
+        playground::drawcallbatcher::SetViewport(config.Width, config.Height);
+        StartRenderThread(config, window);
+    }
 
 #ifdef ENABLE_INSPECTOR
-    playground::ecs::Init(true);
+    playground::ecs::Init(true, isHeadless, isRendering);
 #else
-    playground::ecs::Init(false);
+    playground::ecs::Init(false, isHeadless, isRendering);
 #endif
+    playground::worldstreaming::Init();
 
     return 0;
 }
@@ -232,11 +307,18 @@ void SetupPointerLookupTable(const PlaygroundConfig& config) {
     config.Delegate("ECS_DeleteAllEntitiesByTag\0", reinterpret_cast<void*>(playground::ecs::DeleteAllEntitiesByTag));
     config.Delegate("ECS_CreateTag\0", reinterpret_cast<void*>(playground::ecs::CreateTag));
     config.Delegate("ECS_AddTag\0", reinterpret_cast<void*>(playground::ecs::AddTag));
+    config.Delegate("ECS_GetSystemStats\0", reinterpret_cast<void*>(playground::ecs::stats::GetSystemStats));
+    config.Delegate("ECS_GetPhaseStats\0", reinterpret_cast<void*>(playground::ecs::stats::GetPhaseStats));
+    config.Delegate("ECS_GetFrameStats\0", reinterpret_cast<void*>(playground::ecs::stats::GetFrameStats_C));
+    config.Delegate("ECS_SetStatsEnabled\0", reinterpret_cast<void*>(playground::ecs::stats::SetEnabled));
+    config.Delegate("ECS_ResetStats\0", reinterpret_cast<void*>(playground::ecs::stats::Reset));
 
+#ifdef PLATFORM_MODULES
     config.Delegate("Input_GetAxis\0", reinterpret_cast<void*>(playground::inputmanager::GetAxis));
     config.Delegate("Input_IsButtonPressed\0", reinterpret_cast<void*>(playground::inputmanager::IsButtonPressed));
     config.Delegate("Input_IsButtonDown\0", reinterpret_cast<void*>(playground::inputmanager::IsButtonDown));
     config.Delegate("Input_IsButtonUp\0", reinterpret_cast<void*>(playground::inputmanager::IsButtonUp));
+#endif
 
     config.Delegate("Physics_CreateRigidBody\0", reinterpret_cast<void*>(playground::physicsmanager::CreateRigidBody));
     config.Delegate("Physics_CreateStaticBody\0", reinterpret_cast<void*>(playground::physicsmanager::CreateStaticBody));
@@ -247,6 +329,23 @@ void SetupPointerLookupTable(const PlaygroundConfig& config) {
     config.Delegate("Physics_GetBodyPosition\0", reinterpret_cast<void*>(playground::physicsmanager::GetBodyPosition));
     config.Delegate("Physics_GetBodyRotation\0", reinterpret_cast<void*>(playground::physicsmanager::GetBodyRotation));
 
+    config.Delegate("Spatial_QueryAABB\0", reinterpret_cast<void*>(playground::spatialindex::QueryAABB_C));
+    config.Delegate("Spatial_QuerySphere\0", reinterpret_cast<void*>(playground::spatialindex::QuerySphere_C));
+    config.Delegate("Spatial_QueryFrustum\0", reinterpret_cast<void*>(playground::spatialindex::QueryFrustum_C));
+    config.Delegate("Spatial_QueryNearest\0", reinterpret_cast<void*>(playground::spatialindex::QueryNearest_C));
+
+    config.Delegate("World_SaveSnapshot\0", reinterpret_cast<void*>(playground::worldsnapshot::Save_C));
+    config.Delegate("World_LoadSnapshot\0", reinterpret_cast<void*>(playground::worldsnapshot::Load_C));
+    config.Delegate("World_LoadWorldByName\0", reinterpret_cast<void*>(playground::worldsnapshot::LoadWorldByName));
+    config.Delegate("World_OpenStreamed\0", reinterpret_cast<void*>(playground::worldstreaming::OpenByName));
+    config.Delegate("World_CloseStreamed\0", reinterpret_cast<void*>(playground::worldstreaming::Close));
+    config.Delegate("World_SetStreamingRadii\0", reinterpret_cast<void*>(playground::worldstreaming::SetRadii));
+    config.Delegate("Prefabs_Load\0", reinterpret_cast<void*>(playground::prefabs::LoadPrefabByName));
+    config.Delegate("Prefabs_CreateFromEntity\0", reinterpret_cast<void*>(playground::prefabs::CreatePrefab));
+    config.Delegate("Prefabs_RootCount\0", reinterpret_cast<void*>(playground::prefabs::RootCount));
+    config.Delegate("Prefabs_Instantiate\0", reinterpret_cast<void*>(playground::prefabs::Instantiate_C));
+    config.Delegate("Prefabs_Release\0", reinterpret_cast<void*>(playground::prefabs::ReleasePrefab));
+
     config.Delegate("Time_GetTimeSinceStart\0", reinterpret_cast<void*>(GetTimeSinceStart));
     config.Delegate("Time_GetDeltaTime\0", reinterpret_cast<void*>(GetDeltaTime));
 
@@ -257,7 +356,9 @@ void SetupPointerLookupTable(const PlaygroundConfig& config) {
 void SetupEditorPointerLookupTable(const PlaygroundConfig& config) {
     playground::logging::logger::Info("Setting up editor pointer lookup table", "core");
 
+#ifdef PLATFORM_MODULES
     config.EditorDelegate("Input_SetCapturesInput\0", playground::inputmanager::SetCapturesInput);
+#endif
 
     config.EditorDelegate("Events_Subscribe", SubscribeToEventsFromScripting);
 
@@ -267,6 +368,32 @@ void SetupEditorPointerLookupTable(const PlaygroundConfig& config) {
 }
 #endif
 
+bool ParseRenderBackend(const char* name, playground::rendering::RenderBackendType& backend) {
+    if (name == nullptr || *name == '\0') {
+#ifdef _WIN32
+        backend = playground::rendering::RenderBackendType::D3D12;
+#else
+        // D3D12 is the only GPU backend, other platforms render through the null device
+        backend = playground::rendering::RenderBackendType::Null;
+#endif
+        return true;
+    }
+
+#ifdef _WIN32
+    if (std::strcmp(name, "d3d12") == 0) {
+        backend = playground::rendering::RenderBackendType::D3D12;
+        return true;
+    }
+#endif
+
+    if (std::strcmp(name, "null") == 0) {
+        backend = playground::rendering::RenderBackendType::Null;
+        return true;
+    }
+
+    return false;
+}
+
 void StartRenderThread(const PlaygroundConfig& config, void* window) {
     std::promise<void> rendererReadyPromise;
     std::future<void> rendererReadyFuture = rendererReadyPromise.get_future();
@@ -275,7 +402,7 @@ void StartRenderThread(const PlaygroundConfig& config, void* window) {
         auto cores = playground::hardware::GetCoresByEfficiency(playground::hardware::CPUEfficiencyClass::Performance);
 
         playground::hardware::PinCurrentThreadToCore(cores[1].id);
-        playground::rendering::Init(window, config.Width, config.Height, false, rendererReadyPromise);
+        playground::rendering::Init(window, config.Width, config.Height, false, renderBackend, rendererReadyPromise);
         });
 
     Subscribe(playground::events::EventType::System, [](playground::events::Event* event) {
@@ -299,10 +426,15 @@ void LoadCoreAssets() {
     //playground::assetmanager::LoadAudio("Dialogue.audio");
     //playground::assetmanager::LoadAudio("SFX.audio");
     //playground::assetmanager::LoadAudio("Music.audio");
-    playground::audio::SetVolume(1);
+#ifdef PLATFORM_MODULES
+    if (!isHeadless) {
+        playground::audio::SetVolume(1);
+    }
+#endif
 }
 
 uint8_t Startup(const PlaygroundConfig& config) {
+#ifdef _WIN32
     RENDERDOC_API_1_1_2* rdoc_api = nullptr;
 
     // At init, on windows
@@ -313,6 +445,7 @@ uint8_t Startup(const PlaygroundConfig& config) {
         int ret = RENDERDOC_GetAPI(eRENDERDOC_API_Version_1_1_2, reinterpret_cast<void**>(&rdoc_api));
         assert(ret == 1);
     }
+#endif
 
     auto code = SetupSubsystems(config);
 
@@ -325,10 +458,16 @@ void Update() {
     FrameMark;
     FrameMarkStart(CPU_FRAME);
 
-    {
+#ifdef PLATFORM_MODULES
+    if (!isHeadless) {
         ZoneScopedNC("Engine: Input Tick", tracy::Color::AliceBlue);
         playground::inputmanager::Update();
     }
+#endif
+    {
+        ZoneScopedNC("Engine: Streaming Tick", tracy::Color::SteelBlue);
+        playground::worldstreaming::Update();
+    }
     {
         ZoneScopedNC("Engine: ECS Tick", tracy::Color::VioletRed1);
         playground::ecs::Update(deltaTime);
@@ -337,26 +476,37 @@ void Update() {
         ZoneScopedNC("Engine: Physics Tick", tracy::Color::Salmon);
         playground::physicsmanager::Update(deltaTime);
     }
-    {
+#ifdef PLATFORM_MODULES
+    if (!isHeadless) {
         ZoneScopedNC("Engine: Audio Tick", tracy::Color::DarkSeaGreen1);
         playground::audio::Update();
     }
-    {
+#endif
+    if (isRendering) {
         ZoneScopedNC("Engine: Batcher Tick", tracy::Color::DarkSalmon);
         playground::drawcallbatcher::Submit();
     }
+    if (isHeadless && tickRate > 0) {
+        WaitForNextTick();
+    }
+
     auto next = std::chrono::high_resolution_clock::now();
     const auto int_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(next - now);
-    deltaTime = (double)int_ns.count() / 1000000000.0;
+    // Fixed ticks always advance the simulation by the same step, independent of how long the tick took
+    deltaTime = isHeadless && tickRate > 0 ? 1.0 / tickRate : (double)int_ns.count() / 1000000000.0;
     combinedDeltaTime += deltaTime;
     deltaStep++;
 
     if (deltaStep >= 60) {
         combinedDeltaTime /= 60;
         deltaStep = 0;
-        SetWindowTextA(
-            GetActiveWindow(),
-            ("Playground Core Engine - FPS: " + std::to_string(1 / combinedDeltaTime) + " - CPU Time: " + std::to_string(combinedDeltaTime) + "s - GPU Time: " + std::to_string(playground::rendering::GetGPUFrameTime()) + "s").c_str());
+#ifdef _WIN32
+        if (!isHeadless) {
+            SetWindowTextA(
+                GetActiveWindow(),
+                ("Playground Core Engine - FPS: " + std::to_string(1 / combinedDeltaTime) + " - CPU Time: " + std::to_string(combinedDeltaTime) + "s - GPU Time: " + std::to_string(playground::rendering::GetGPUFrameTime()) + "s").c_str());
+        }
+#endif
     }
 
     timeSinceStart += deltaTime;
@@ -364,6 +514,22 @@ void Update() {
     FrameMarkEnd(CPU_FRAME);
 }
 
+void WaitForNextTick() {
+    ZoneScopedNC("Engine: Tick Wait", tracy::Color::Gray);
+    static auto nextTick = std::chrono::steady_clock::now();
+
+    nextTick += std::chrono::nanoseconds(1000000000ull / tickRate);
+
+    // A tick that ran late doesn't cause a burst of catch up ticks
+    auto current = std::chrono::steady_clock::now();
+    if (nextTick < current) {
+        nextTick = current;
+        return;
+    }
+
+    std::this_thread::sleep_until(nextTick);
+}
+
 void SubscribeToEventsFromScripting(playground::events::EventType type, ScriptingEventCallback callback) {
     Subscribe(type, [callback](playground::events::Event* event) {
         callback(event);
@@ -0,0 +1,233 @@
+#include "playground/Prefabs.hxx"
+#include "playground/ECS.hxx"
+#include "playground/WorldSnapshot.hxx"
+#include "playground/components/TransformComponent.hxx"
+#include "playground/components/WorldTransformComponent.hxx"
+#include <assetloader/AssetLoader.hxx>
+#include <math/Math.hxx>
+#include <shared/Hasher.hxx>
+#include <shared/Logger.hxx>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace playground::prefabs {
+    struct Prefab {
+        uint64_t hash; // 0 for prefabs created from live entities
+        uint32_t refs;
+        worldsnapshot::Snapshot snapshot;
+    };
+
+    // Ids are the index + 1 so 0 can signal a failed load
+    std::vector<std::unique_ptr<Prefab>> prefabs;
+    std::unordered_map<uint64_t, uint32_t> prefabsByHash;
+
+    Prefab* Find(uint32_t prefabId) {
+        if (prefabId == 0 || prefabId > prefabs.size()) {
+            return nullptr;
+        }
+
+        return prefabs[prefabId - 1].get();
+    }
+
+    void TagHierarchy(flecs::entity entity, ecs_entity_t tag) {
+        entity.add(tag);
+        entity.children([tag](flecs::entity child) {
+            TagHierarchy(child, tag);
+        });
+    }
+
+    // Instances must not end up under whatever the source hierarchy was attached to, nor share names within their scope
+    void DetachRoots(worldsnapshot::Snapshot& snapshot) {
+        for (auto& table : snapshot.tables) {
+            for (size_t x = table.ids.size(); x-- > 0;) {
+                if (table.targets[x] < 0 && ECS_IS_PAIR(table.ids[x]) && ECS_PAIR_FIRST(table.ids[x]) == EcsChildOf) {
+                    table.ids.erase(table.ids.begin() + x);
+                    table.targets.erase(table.targets.begin() + x);
+                }
+            }
+        }
+
+        std::erase_if(snapshot.names, [&snapshot](const auto& name) {
+            return std::find(snapshot.roots.begin(), snapshot.roots.end(), name.first) != snapshot.roots.end();
+        });
+    }
+
+    uint32_t Add(uint64_t hash, worldsnapshot::Snapshot&& snapshot) {
+        DetachRoots(snapshot);
+
+        prefabs.push_back(std::make_unique<Prefab>(Prefab{ .hash = hash, .refs = 1, .snapshot = std::move(snapshot) }));
+        auto prefabId = static_cast<uint32_t>(prefabs.size());
+
+        if (hash != 0) {
+            prefabsByHash[hash] = prefabId;
+        }
+
+        return prefabId;
+    }
+
+    uint32_t LoadPrefab(uint64_t hash) {
+        ZoneScopedN("Prefabs: Load");
+
+        auto found = prefabsByHash.find(hash);
+        if (found != prefabsByHash.end()) {
+            prefabs[found->second - 1]->refs++;
+
+            return found->second;
+        }
+
+        auto data = assetloader::LoadPrefab(hash);
+
+        worldsnapshot::Snapshot snapshot;
+        if (!worldsnapshot::Parse(data.prefabData.data(), data.prefabData.size(), snapshot)) {
+            logging::logger::Error("Failed to parse prefab " + std::to_string(hash), "ecs");
+            return 0;
+        }
+
+        return Add(hash, std::move(snapshot));
+    }
+
+    bool SavePrefab(uint64_t root, std::vector<uint8_t>& data) {
+        auto& world = ecs::GetWorld();
+
+        if (!ecs_is_alive(world, root) || ecs_is_deferred(world)) {
+            logging::logger::Error("Prefabs can only be saved from alive entities outside of the ECS tick", "ecs");
+            return false;
+        }
+
+        auto tag = ecs_new(world);
+        TagHierarchy(world.entity(root), tag);
+
+        bool saved = worldsnapshot::Save(data, tag);
+
+        // Deleting the tag removes it from the entities again
+        ecs_delete(world, tag);
+
+        return saved;
+    }
+
+    uint32_t CreatePrefab(uint64_t root) {
+        ZoneScopedN("Prefabs: Create");
+
+        std::vector<uint8_t> data;
+        if (!SavePrefab(root, data)) {
+            return 0;
+        }
+
+        worldsnapshot::Snapshot snapshot;
+        if (!worldsnapshot::Parse(data.data(), data.size(), snapshot)) {
+            return 0;
+        }
+
+        return Add(0, std::move(snapshot));
+    }
+
+    bool InstantiatePrefab(uint32_t prefabId, uint32_t count, const TransformComponent* transforms, std::vector<uint64_t>* roots) {
+        ZoneScopedN("Prefabs: Instantiate");
+
+        auto prefab = Find(prefabId);
+        if (prefab == nullptr) {
+            logging::logger::Error("Unknown prefab " + std::to_string(prefabId), "ecs");
+            return false;
+        }
+
+        auto& snapshot = prefab->snapshot;
+
+        std::vector<uint64_t> entities;
+        if (!worldsnapshot::Instantiate(snapshot, count, 0, &entities)) {
+            return false;
+        }
+
+        if (roots != nullptr) {
+            roots->clear();
+            roots->reserve(snapshot.roots.size() * count);
+        }
+
+        ecs_world_t* world = ecs::GetWorld();
+        auto transformId = ecs::GetWorld().id<TransformComponent>();
+        auto worldTransformId = ecs::GetWorld().id<WorldTransformComponent>();
+
+        for (uint32_t copy = 0; copy < count; copy++) {
+            for (auto index : snapshot.roots) {
+                auto entity = entities[static_cast<size_t>(copy) * snapshot.entityCount + index];
+
+                if (roots != nullptr) {
+                    roots->push_back(entity);
+                }
+
+                if (transforms == nullptr || !ecs_has_id(world, entity, transformId)) {
+                    continue;
+                }
+
+                // Same composition as the hierarchy system, the placement acts as the parent of every root
+                auto& placement = transforms[copy];
+                auto transform = static_cast<TransformComponent*>(ecs_get_mut_id(world, entity, transformId));
+                transform->Position = placement.Position + (placement.Rotation * transform->Position);
+                transform->Rotation = placement.Rotation * transform->Rotation;
+                transform->Scale = transform->Scale * placement.Scale;
+
+                // Roots own their world transform, seed it so the first frame doesn't render the template pose
+                if (ecs_has_id(world, entity, worldTransformId)) {
+                    auto worldTransform = static_cast<WorldTransformComponent*>(ecs_get_mut_id(world, entity, worldTransformId));
+                    worldTransform->Position = transform->Position;
+                    worldTransform->Rotation = transform->Rotation;
+                    worldTransform->Scale = transform->Scale;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    uint32_t RootCount(uint32_t prefabId) {
+        auto prefab = Find(prefabId);
+
+        return prefab != nullptr ? static_cast<uint32_t>(prefab->snapshot.roots.size()) : 0;
+    }
+
+    void ReleasePrefab(uint32_t prefabId) {
+        auto prefab = Find(prefabId);
+        if (prefab == nullptr || --prefab->refs > 0) {
+            return;
+        }
+
+        if (prefab->hash != 0) {
+            prefabsByHash.erase(prefab->hash);
+        }
+
+        worldsnapshot::Release(prefab->snapshot);
+        prefabs[prefabId - 1].reset();
+    }
+
+    void Shutdown() {
+        for (auto& prefab : prefabs) {
+            if (prefab != nullptr) {
+                worldsnapshot::Release(prefab->snapshot);
+            }
+        }
+
+        prefabs.clear();
+        prefabsByHash.clear();
+    }
+
+    uint32_t LoadPrefabByName(const char* name) {
+        auto hash = shared::Hash(name);
+
+        return LoadPrefab(hash);
+    }
+
+    uint32_t Instantiate_C(uint32_t prefabId, uint32_t count, const TransformComponent* transforms, uint64_t* roots) {
+        std::vector<uint64_t> created;
+        if (!InstantiatePrefab(prefabId, count, transforms, &created)) {
+            return 0;
+        }
+
+        if (roots != nullptr) {
+            std::copy(created.begin(), created.end(), roots);
+        }
+
+        return static_cast<uint32_t>(created.size());
+    }
+}
@@ -0,0 +1,565 @@
+#include "playground/SpatialIndex.hxx"
+#include <shared/Job.hxx>
+#include <shared/JobHandle.hxx>
+#include <shared/JobSystem.hxx>
+#include <shared/Logger.hxx>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace playground::spatialindex {
+    // Leaves store bounds grown by this margin so small movements don't touch the tree
+    constexpr float PROXY_MARGIN = 0.25f;
+
+    struct Node {
+        math::BoundingBox bounds;
+        math::BoundingBox tightBounds; // Leaves only, the bounds without the proxy margin
+        uint64_t entityId;
+        int32_t parent; // Doubles as the next free node when the node is unused
+        int32_t left;
+        int32_t right;
+        int32_t height; // Leaf = 0, free = -1
+
+        bool IsLeaf() const {
+            return left == NULL_PROXY;
+        }
+    };
+
+    enum class Containment : uint8_t {
+        Outside,
+        Intersects,
+        Inside
+    };
+
+    std::vector<Node> nodes;
+    int32_t root = NULL_PROXY;
+    int32_t freeList = NULL_PROXY;
+    size_t proxyCount = 0;
+    std::shared_mutex treeLock;
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t nodeId);
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf);
+    int32_t Balance(int32_t nodeId);
+    Containment Classify(const math::Frustum& frustum, const math::BoundingBox& box);
+
+    template<typename Predicate>
+    void Traverse(Predicate&& overlaps, std::vector<uint64_t>& results) {
+        if (root == NULL_PROXY) {
+            return;
+        }
+
+        std::vector<int32_t> stack;
+        stack.reserve(64);
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            int32_t nodeId = stack.back();
+            stack.pop_back();
+
+            const Node& node = nodes[nodeId];
+            if (!overlaps(node.bounds)) {
+                continue;
+            }
+
+            if (node.IsLeaf()) {
+                results.push_back(node.entityId);
+                continue;
+            }
+
+            stack.push_back(node.left);
+            stack.push_back(node.right);
+        }
+    }
+
+    void CollectLeaves(int32_t nodeId, std::vector<uint64_t>& results) {
+        const Node& node = nodes[nodeId];
+        if (node.IsLeaf()) {
+            results.push_back(node.entityId);
+            return;
+        }
+
+        CollectLeaves(node.left, results);
+        CollectLeaves(node.right, results);
+    }
+
+    void QueryFrustumRecursive(int32_t nodeId, const math::Frustum& frustum, std::vector<uint64_t>& results) {
+        const Node& node = nodes[nodeId];
+        auto containment = Classify(frustum, node.bounds);
+
+        if (containment == Containment::Outside) {
+            return;
+        }
+
+        // Whole subtree is visible, skip the remaining plane tests
+        if (containment == Containment::Inside || node.IsLeaf()) {
+            CollectLeaves(nodeId, results);
+            return;
+        }
+
+        QueryFrustumRecursive(node.left, frustum, results);
+        QueryFrustumRecursive(node.right, frustum, results);
+    }
+
+    void Init() {
+        logging::logger::SetupSubsystem("spatial");
+        logging::logger::Info("Initializing spatial index", "spatial");
+
+        std::unique_lock lock(treeLock);
+        nodes.clear();
+        nodes.reserve(4096);
+        root = NULL_PROXY;
+        freeList = NULL_PROXY;
+        proxyCount = 0;
+    }
+
+    void Shutdown() {
+        std::unique_lock lock(treeLock);
+        nodes.clear();
+        nodes.shrink_to_fit();
+        root = NULL_PROXY;
+        freeList = NULL_PROXY;
+        proxyCount = 0;
+    }
+
+    int32_t CreateProxy(uint64_t entityId, const math::BoundingBox& bounds) {
+        std::unique_lock lock(treeLock);
+
+        int32_t proxyId = AllocateNode();
+        auto margin = math::Vector3(PROXY_MARGIN, PROXY_MARGIN, PROXY_MARGIN);
+        nodes[proxyId].bounds = math::BoundingBox(bounds.Min - margin, bounds.Max + margin);
+        nodes[proxyId].tightBounds = bounds;
+        nodes[proxyId].entityId = entityId;
+        nodes[proxyId].height = 0;
+
+        InsertLeaf(proxyId);
+        proxyCount++;
+
+        return proxyId;
+    }
+
+    bool MoveProxy(int32_t proxyId, const math::BoundingBox& bounds) {
+        std::unique_lock lock(treeLock);
+
+        if (proxyId < 0 || proxyId >= static_cast<int32_t>(nodes.size()) || nodes[proxyId].height != 0) {
+            return false;
+        }
+
+        // The tight bounds always follow, nearest queries rank by them
+        nodes[proxyId].tightBounds = bounds;
+
+        if (nodes[proxyId].bounds.Contains(bounds)) {
+            return false;
+        }
+
+        RemoveLeaf(proxyId);
+
+        auto margin = math::Vector3(PROXY_MARGIN, PROXY_MARGIN, PROXY_MARGIN);
+        nodes[proxyId].bounds = math::BoundingBox(bounds.Min - margin, bounds.Max + margin);
+
+        InsertLeaf(proxyId);
+
+        return true;
+    }
+
+    void DestroyProxy(int32_t proxyId) {
+        std::unique_lock lock(treeLock);
+
+        if (proxyId < 0 || proxyId >= static_cast<int32_t>(nodes.size()) || nodes[proxyId].height != 0) {
+            return;
+        }
+
+        RemoveLeaf(proxyId);
+        FreeNode(proxyId);
+        proxyCount--;
+    }
+
+    size_t ProxyCount() {
+        std::shared_lock lock(treeLock);
+
+        return proxyCount;
+    }
+
+    void QueryAABB(const math::BoundingBox& box, std::vector<uint64_t>& results) {
+        ZoneScopedN("Spatial: Query AABB");
+        std::shared_lock lock(treeLock);
+
+        Traverse([&box](const math::BoundingBox& bounds) { return bounds.Intersects(box); }, results);
+    }
+
+    void QuerySphere(const math::BoundingSphere& sphere, std::vector<uint64_t>& results) {
+        ZoneScopedN("Spatial: Query Sphere");
+        std::shared_lock lock(treeLock);
+
+        Traverse([&sphere](const math::BoundingBox& bounds) { return sphere.Intersects(bounds); }, results);
+    }
+
+    void QueryFrustum(const math::Frustum& frustum, std::vector<uint64_t>& results) {
+        ZoneScopedN("Spatial: Query Frustum");
+        std::shared_lock lock(treeLock);
+
+        if (root == NULL_PROXY) {
+            return;
+        }
+
+        QueryFrustumRecursive(root, frustum, results);
+    }
+
+    void QueryNearest(const math::Vector3& point, uint32_t count, std::vector<uint64_t>& results) {
+        ZoneScopedN("Spatial: Query Nearest");
+        std::shared_lock lock(treeLock);
+
+        if (root == NULL_PROXY || count == 0) {
+            return;
+        }
+
+        // Best first search, nodes are visited in order of the distance of their bounds to the point.
+        // Leaves are keyed by their tight bounds, which lie inside every ancestor, so a leaf that
+        // gets popped is closer than everything still queued.
+        auto distance = [&point](const Node& node) {
+            return node.IsLeaf() ? node.tightBounds.DistanceSquared(point) : node.bounds.DistanceSquared(point);
+        };
+
+        using Entry = std::pair<float, int32_t>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        queue.push({ distance(nodes[root]), root });
+
+        uint32_t found = 0;
+        while (!queue.empty() && found < count) {
+            int32_t nodeId = queue.top().second;
+            queue.pop();
+
+            const Node& node = nodes[nodeId];
+            if (node.IsLeaf()) {
+                results.push_back(node.entityId);
+                found++;
+                continue;
+            }
+
+            queue.push({ distance(nodes[node.left]), node.left });
+            queue.push({ distance(nodes[node.right]), node.right });
+        }
+    }
+
+    template<typename Shape, typename Query>
+    void QueryBatch(const char* name, const Shape* shapes, size_t count, std::vector<uint64_t>* results, Query query) {
+        if (count == 0) {
+            return;
+        }
+
+        if (count == 1) {
+            query(shapes[0], results[0]);
+            return;
+        }
+
+        std::vector<std::shared_ptr<jobsystem::JobHandle>> handles;
+        handles.reserve(count);
+
+        for (size_t x = 0; x < count; x++) {
+            handles.push_back(jobsystem::Submit(jobsystem::Job{
+                .Name = name,
+                .Priority = jobsystem::JobPriority::High,
+                .Color = tracy::Color::Orange,
+                .Dependencies = {},
+                .Task = [shapes, results, x, query](uint8_t workerId) {
+                    query(shapes[x], results[x]);
+                }
+            }));
+        }
+
+        for (auto& handle : handles) {
+            handle->Wait();
+        }
+    }
+
+    void QueryAABBs(const math::BoundingBox* boxes, size_t count, std::vector<uint64_t>* results) {
+        ZoneScopedN("Spatial: Query AABB Batch");
+        QueryBatch("SPATIAL_QUERY_AABB", boxes, count, results, [](const math::BoundingBox& box, std::vector<uint64_t>& out) { QueryAABB(box, out); });
+    }
+
+    void QuerySpheres(const math::BoundingSphere* spheres, size_t count, std::vector<uint64_t>* results) {
+        ZoneScopedN("Spatial: Query Sphere Batch");
+        QueryBatch("SPATIAL_QUERY_SPHERE", spheres, count, results, [](const math::BoundingSphere& sphere, std::vector<uint64_t>& out) { QuerySphere(sphere, out); });
+    }
+
+    void QueryFrustums(const math::Frustum* frustums, size_t count, std::vector<uint64_t>* results) {
+        ZoneScopedN("Spatial: Query Frustum Batch");
+        QueryBatch("SPATIAL_QUERY_FRUSTUM", frustums, count, results, [](const math::Frustum& frustum, std::vector<uint64_t>& out) { QueryFrustum(frustum, out); });
+    }
+
+    uint32_t CopyResults(const std::vector<uint64_t>& hits, uint64_t* results, uint32_t capacity) {
+        if (results != nullptr) {
+            std::copy_n(hits.begin(), std::min<size_t>(hits.size(), capacity), results);
+        }
+
+        return static_cast<uint32_t>(hits.size());
+    }
+
+    uint32_t QueryAABB_C(math::Vector3 min, math::Vector3 max, uint64_t* results, uint32_t capacity) {
+        std::vector<uint64_t> hits;
+        QueryAABB(math::BoundingBox(min, max), hits);
+
+        return CopyResults(hits, results, capacity);
+    }
+
+    uint32_t QuerySphere_C(math::Vector3 center, float radius, uint64_t* results, uint32_t capacity) {
+        std::vector<uint64_t> hits;
+        QuerySphere(math::BoundingSphere(center, radius), hits);
+
+        return CopyResults(hits, results, capacity);
+    }
+
+    uint32_t QueryFrustum_C(const float* viewProjection, uint64_t* results, uint32_t capacity) {
+        math::Matrix4x4 matrix;
+        for (int row = 0; row < 4; row++) {
+            for (int col = 0; col < 4; col++) {
+                matrix.elements[row][col] = viewProjection[row * 4 + col];
+            }
+        }
+
+        std::vector<uint64_t> hits;
+        QueryFrustum(math::Frustum::FromViewProjection(matrix), hits);
+
+        return CopyResults(hits, results, capacity);
+    }
+
+    uint32_t QueryNearest_C(math::Vector3 point, uint64_t* results, uint32_t count) {
+        std::vector<uint64_t> hits;
+        QueryNearest(point, count, hits);
+
+        return CopyResults(hits, results, count);
+    }
+
+    // ---- Tree ----
+    int32_t AllocateNode() {
+        if (freeList == NULL_PROXY) {
+            nodes.push_back(Node{ .bounds = {}, .tightBounds = {}, .entityId = 0, .parent = NULL_PROXY, .left = NULL_PROXY, .right = NULL_PROXY, .height = -1 });
+            freeList = static_cast<int32_t>(nodes.size() - 1);
+        }
+
+        int32_t nodeId = freeList;
+        freeList = nodes[nodeId].parent;
+
+        nodes[nodeId].parent = NULL_PROXY;
+        nodes[nodeId].left = NULL_PROXY;
+        nodes[nodeId].right = NULL_PROXY;
+        nodes[nodeId].height = 0;
+        nodes[nodeId].entityId = 0;
+
+        return nodeId;
+    }
+
+    void FreeNode(int32_t nodeId) {
+        nodes[nodeId].parent = freeList;
+        nodes[nodeId].height = -1;
+        freeList = nodeId;
+    }
+
+    void Refit(int32_t nodeId) {
+        while (nodeId != NULL_PROXY) {
+            nodeId = Balance(nodeId);
+
+            Node& node = nodes[nodeId];
+            node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+            node.bounds = math::BoundingBox::Merge(nodes[node.left].bounds, nodes[node.right].bounds);
+
+            nodeId = node.parent;
+        }
+    }
+
+    void InsertLeaf(int32_t leaf) {
+        if (root == NULL_PROXY) {
+            root = leaf;
+            nodes[root].parent = NULL_PROXY;
+            return;
+        }
+
+        // Walk down towards the sibling with the lowest surface area cost
+        const math::BoundingBox leafBounds = nodes[leaf].bounds;
+        int32_t index = root;
+
+        while (!nodes[index].IsLeaf()) {
+            const Node& node = nodes[index];
+            float area = node.bounds.SurfaceArea();
+            float combinedArea = math::BoundingBox::Merge(node.bounds, leafBounds).SurfaceArea();
+
+            // Cost of creating a new parent for this node and the leaf
+            float cost = 2.0f * combinedArea;
+            // Minimum cost of pushing the leaf further down the tree
+            float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto childCost = [&](int32_t child) {
+                float merged = math::BoundingBox::Merge(leafBounds, nodes[child].bounds).SurfaceArea();
+                if (nodes[child].IsLeaf()) {
+                    return merged + inheritanceCost;
+                }
+
+                return (merged - nodes[child].bounds.SurfaceArea()) + inheritanceCost;
+            };
+
+            float leftCost = childCost(node.left);
+            float rightCost = childCost(node.right);
+
+            if (cost < leftCost && cost < rightCost) {
+                break;
+            }
+
+            index = leftCost < rightCost ? node.left : node.right;
+        }
+
+        int32_t sibling = index;
+        int32_t oldParent = nodes[sibling].parent;
+        int32_t newParent = AllocateNode();
+
+        nodes[newParent].parent = oldParent;
+        nodes[newParent].bounds = math::BoundingBox::Merge(leafBounds, nodes[sibling].bounds);
+        nodes[newParent].height = nodes[sibling].height + 1;
+        nodes[newParent].left = sibling;
+        nodes[newParent].right = leaf;
+        nodes[sibling].parent = newParent;
+        nodes[leaf].parent = newParent;
+
+        if (oldParent != NULL_PROXY) {
+            if (nodes[oldParent].left == sibling) {
+                nodes[oldParent].left = newParent;
+            }
+            else {
+                nodes[oldParent].right = newParent;
+            }
+        }
+        else {
+            root = newParent;
+        }
+
+        Refit(nodes[leaf].parent);
+    }
+
+    void RemoveLeaf(int32_t leaf) {
+        if (leaf == root) {
+            root = NULL_PROXY;
+            return;
+        }
+
+        int32_t parent = nodes[leaf].parent;
+        int32_t grandParent = nodes[parent].parent;
+        int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+        if (grandParent != NULL_PROXY) {
+            if (nodes[grandParent].left == parent) {
+                nodes[grandParent].left = sibling;
+            }
+            else {
+                nodes[grandParent].right = sibling;
+            }
+
+            nodes[sibling].parent = grandParent;
+            FreeNode(parent);
+
+            Refit(grandParent);
+        }
+        else {
+            root = sibling;
+            nodes[sibling].parent = NULL_PROXY;
+            FreeNode(parent);
+        }
+
+        nodes[leaf].parent = NULL_PROXY;
+    }
+
+    // Rotates the subtree at a if it is imbalanced and returns the new subtree root
+    int32_t Balance(int32_t a) {
+        Node& nodeA = nodes[a];
+        if (nodeA.IsLeaf() || nodeA.height < 2) {
+            return a;
+        }
+
+        int32_t b = nodeA.left;
+        int32_t c = nodeA.right;
+        int32_t balance = nodes[c].height - nodes[b].height;
+
+        auto rotate = [a](int32_t up, int32_t down) {
+            // "up" is promoted to the position of a, a becomes its child next to "down"'s sibling
+            Node& nodeA = nodes[a];
+            Node& nodeUp = nodes[up];
+
+            int32_t f = nodeUp.left;
+            int32_t g = nodeUp.right;
+
+            nodeUp.left = a;
+            nodeUp.parent = nodeA.parent;
+            nodeA.parent = up;
+
+            if (nodeUp.parent != NULL_PROXY) {
+                if (nodes[nodeUp.parent].left == a) {
+                    nodes[nodeUp.parent].left = up;
+                }
+                else {
+                    nodes[nodeUp.parent].right = up;
+                }
+            }
+            else {
+                root = up;
+            }
+
+            // Keep the taller grandchild under "up", hand the other one down to a
+            int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+            int32_t give = keep == f ? g : f;
+
+            nodeUp.right = keep;
+            if (nodeA.left == up) {
+                nodeA.left = give;
+            }
+            else {
+                nodeA.right = give;
+            }
+            nodes[give].parent = a;
+
+            nodeA.bounds = math::BoundingBox::Merge(nodes[down].bounds, nodes[give].bounds);
+            nodeA.height = 1 + std::max(nodes[down].height, nodes[give].height);
+            nodeUp.bounds = math::BoundingBox::Merge(nodeA.bounds, nodes[keep].bounds);
+            nodeUp.height = 1 + std::max(nodeA.height, nodes[keep].height);
+
+            return up;
+        };
+
+        if (balance > 1) {
+            return rotate(c, b);
+        }
+
+        if (balance < -1) {
+            return rotate(b, c);
+        }
+
+        return a;
+    }
+
+    Containment Classify(const math::Frustum& frustum, const math::BoundingBox& box) {
+        math::Vector3 center = box.Center();
+        math::Vector3 extents = box.Extents();
+        auto result = Containment::Inside;
+
+        for (const auto& plane : frustum.Planes) {
+            float radius = extents.X * std::fabs(plane.Normal.X) +
+                extents.Y * std::fabs(plane.Normal.Y) +
+                extents.Z * std::fabs(plane.Normal.Z);
+            float distance = plane.SignedDistance(center);
+
+            if (distance < -radius) {
+                return Containment::Outside;
+            }
+
+            if (distance < radius) {
+                result = Containment::Intersects;
+            }
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,1083 @@
+#include "playground/WorldSnapshot.hxx"
+#include "playground/ECS.hxx"
+#include "playground/AssetManager.hxx"
+#include "playground/components/AudioSourceComponent.hxx"
+#include "playground/components/BoxColliderComponent.hxx"
+#include "playground/components/MaterialComponent.hxx"
+#include "playground/components/MeshComponent.hxx"
+#include "playground/components/RigidBodyComponent.hxx"
+#include "playground/components/SpatialProxyComponent.hxx"
+#include "playground/components/StaticComponent.hxx"
+#include "playground/components/StaticBatchComponent.hxx"
+#include "playground/components/StaticBodyComponent.hxx"
+#include "playground/components/TransformComponent.hxx"
+#include "playground/components/WorldTransformComponent.hxx"
+#include <assetloader/AssetLoader.hxx>
+#include <shared/Hasher.hxx>
+#include <shared/Logger.hxx>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace playground::worldsnapshot {
+    enum class IdKind : uint8_t {
+        Type = 0,           // first = type index
+        Pair = 1,           // first = type index, second = type index
+        PairWithEntity = 2  // first = type index, second = snapshot entity index
+    };
+
+    struct SnapshotHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t typeCount;
+        uint32_t tableCount;
+        uint32_t entityCount;
+        uint32_t nameCount;
+        uint32_t stringCount;
+    };
+
+    struct SnapshotId {
+        IdKind kind;
+        uint8_t transient; // Column exists in the archetype but its data is rebuilt on load
+        uint16_t reserved;
+        uint32_t first;
+        uint32_t second;
+        uint32_t size;
+    };
+
+    struct SaveContext {
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, uint32_t> stringIndices;
+
+        uint64_t Intern(const char* value) {
+            if (value == nullptr) {
+                return 0;
+            }
+
+            auto it = stringIndices.find(value);
+            if (it != stringIndices.end()) {
+                return it->second + 1;
+            }
+
+            uint32_t index = static_cast<uint32_t>(strings.size());
+            strings.emplace_back(value);
+            stringIndices.emplace(strings.back(), index);
+
+            return index + 1;
+        }
+    };
+
+    struct LoadContext {
+        std::unordered_map<uint64_t, uint32_t> models;
+        std::unordered_map<uint64_t, uint32_t> materials;
+        std::unordered_map<uint64_t, uint32_t> physicsMaterials;
+        Snapshot* snapshot;
+        std::vector<const char*> strings;
+        rendering::UploadPriority priority;
+    };
+
+    using FixupColumns = std::vector<std::pair<ecs_id_t, void*>>;
+
+    // Pointer-like and handle fields are rewritten on the copied bytes while saving and resolved once per unique value while parsing
+    struct ComponentFixup {
+        ecs_entity_t component;
+        // Runtime component the load fixup fills in, 0 if it only patches the component itself
+        ecs_entity_t output;
+        void (*save)(void* rows, int32_t count, SaveContext& context);
+        void (*load)(const FixupColumns& columns, int32_t count, LoadContext& context);
+    };
+
+    // Runtime components that get added alongside an authoring component by its on_add hook
+    struct Companion {
+        ecs_entity_t authoring;
+        std::vector<ecs_entity_t> runtime;
+    };
+
+    class Writer {
+    public:
+        explicit Writer(std::vector<uint8_t>& buffer) : _buffer(buffer) {}
+
+        template<typename T>
+        void Write(const T& value) {
+            WriteBytes(&value, sizeof(T));
+        }
+
+        void WriteBytes(const void* data, size_t size) {
+            auto offset = _buffer.size();
+            _buffer.resize(offset + size);
+            if (size > 0) {
+                std::memcpy(_buffer.data() + offset, data, size);
+            }
+        }
+
+        void WriteString(std::string_view value) {
+            Write(static_cast<uint16_t>(value.size()));
+            WriteBytes(value.data(), value.size());
+        }
+
+        size_t Size() const {
+            return _buffer.size();
+        }
+
+        uint8_t* At(size_t offset) {
+            return _buffer.data() + offset;
+        }
+
+    private:
+        std::vector<uint8_t>& _buffer;
+    };
+
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : _data(data), _size(size), _offset(0) {}
+
+        template<typename T>
+        bool Read(T& value) {
+            if (_offset + sizeof(T) > _size) {
+                return false;
+            }
+
+            std::memcpy(&value, _data + _offset, sizeof(T));
+            _offset += sizeof(T);
+
+            return true;
+        }
+
+        const uint8_t* Bytes(size_t size) {
+            if (_offset + size > _size) {
+                return nullptr;
+            }
+
+            auto ptr = _data + _offset;
+            _offset += size;
+
+            return ptr;
+        }
+
+        bool ReadString(std::string& value) {
+            uint16_t length;
+            if (!Read(length)) {
+                return false;
+            }
+
+            auto bytes = Bytes(length);
+            if (bytes == nullptr) {
+                return false;
+            }
+
+            value.assign(reinterpret_cast<const char*>(bytes), length);
+
+            return true;
+        }
+
+    private:
+        const uint8_t* _data;
+        size_t _size;
+        size_t _offset;
+    };
+
+    static_assert(sizeof(void*) == sizeof(uint64_t), "Pointer fields are stored as 64 bit values");
+
+    ecs_query_t* tablesQuery = nullptr;
+    std::vector<uint8_t> pendingSnapshot;
+    // Per component the offsets of the entity ids it holds, see RegisterEntityField
+    std::unordered_map<ecs_entity_t, std::vector<uint32_t>> entityFields;
+    // Strings referenced by loaded components need to outlive the snapshot buffer
+    std::unordered_set<std::string> internedStrings;
+
+    std::vector<ComponentFixup> GetFixups(flecs::world& world);
+    std::vector<Companion> GetCompanions(flecs::world& world);
+    std::unordered_set<ecs_entity_t> GetTransientComponents(flecs::world& world);
+
+    bool IsBuiltin(ecs_world_t* world, ecs_entity_t entity, std::unordered_map<ecs_entity_t, bool>& cache) {
+        auto it = cache.find(entity);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        bool builtin = false;
+        for (auto current = entity; current != 0; current = ecs_get_parent(world, current)) {
+            if (current == EcsFlecs) {
+                builtin = true;
+                break;
+            }
+        }
+
+        cache.emplace(entity, builtin);
+
+        return builtin;
+    }
+
+    // Tables of components, systems, modules and other engine internals are not part of the world state
+    bool IsSnapshotTable(ecs_world_t* world, ecs_table_t* table, uint64_t withTag, std::unordered_map<ecs_entity_t, bool>& cache) {
+        if (withTag != 0 && !ecs_table_has_id(world, table, withTag)) {
+            return false;
+        }
+
+        const ecs_type_t* type = ecs_table_get_type(table);
+        for (int32_t x = 0; x < type->count; x++) {
+            ecs_id_t id = type->array[x];
+
+            if (ECS_IS_PAIR(id)) {
+                auto first = ecs_pair_first(world, id);
+                auto second = ecs_pair_second(world, id);
+
+                if (first == EcsIdentifier) {
+                    continue;
+                }
+
+                if ((first != EcsChildOf && IsBuiltin(world, first, cache)) || IsBuiltin(world, second, cache)) {
+                    return false;
+                }
+            }
+            else if ((id & ECS_ID_FLAGS_MASK) == 0 && IsBuiltin(world, id, cache)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Rewrites the entity fields of count rows, remap returns 0 for ids it can't resolve
+    template<typename Remap>
+    void RemapEntityFields(uint8_t* rows, size_t count, size_t size, uint32_t offset, Remap&& remap) {
+        for (size_t row = 0; row < count; row++) {
+            uint64_t value;
+            std::memcpy(&value, rows + row * size + offset, sizeof(value));
+            value = value != 0 ? remap(value) : 0;
+            std::memcpy(rows + row * size + offset, &value, sizeof(value));
+        }
+    }
+
+    bool RegisterEntityField(uint64_t component, uint32_t offset) {
+        const ecs_type_info_t* info = ecs_get_type_info(ecs::GetWorld(), component);
+        if (info == nullptr || offset + sizeof(ecs_entity_t) > static_cast<size_t>(info->size)) {
+            logging::logger::Error("Entity field at offset " + std::to_string(offset) + " lies outside of its component", "ecs");
+            return false;
+        }
+
+        auto& offsets = entityFields[component];
+        if (std::find(offsets.begin(), offsets.end(), offset) == offsets.end()) {
+            offsets.push_back(offset);
+        }
+
+        return true;
+    }
+
+    bool Save(std::vector<uint8_t>& data, uint64_t withTag) {
+        ZoneScopedN("Snapshot: Save");
+        auto& world = ecs::GetWorld();
+        ecs_world_t* w = world;
+
+        if (tablesQuery == nullptr) {
+            ecs_query_desc_t desc = {};
+            desc.terms[0].id = EcsAny;
+            tablesQuery = ecs_query_init(w, &desc);
+        }
+
+        struct TableRange {
+            ecs_table_t* table;
+            int32_t offset;
+            std::vector<ecs_entity_t> entities;
+        };
+
+        std::unordered_map<ecs_entity_t, bool> builtinCache;
+        std::unordered_set<ecs_entity_t> schema;
+        std::vector<TableRange> ranges;
+
+        ecs_iter_t it = ecs_query_iter(w, tablesQuery);
+        while (ecs_query_next(&it)) {
+            if (!IsSnapshotTable(w, it.table, withTag, builtinCache)) {
+                continue;
+            }
+
+            ranges.push_back(TableRange{ it.table, it.offset, std::vector<ecs_entity_t>(it.entities, it.entities + it.count) });
+
+            const ecs_type_t* type = ecs_table_get_type(it.table);
+            for (int32_t x = 0; x < type->count; x++) {
+                ecs_id_t id = type->array[x];
+                schema.insert(ECS_IS_PAIR(id) ? ecs_pair_first(w, id) : (id & ECS_COMPONENT_MASK));
+            }
+        }
+
+        // Entities used as components, tags or relationships describe the world rather than being part of it
+        std::unordered_map<ecs_entity_t, uint32_t> entityIndices;
+        for (auto& range : ranges) {
+            for (auto entity : range.entities) {
+                if (!schema.contains(entity)) {
+                    auto index = static_cast<uint32_t>(entityIndices.size());
+                    entityIndices.emplace(entity, index);
+                }
+            }
+        }
+
+        SaveContext context;
+        auto fixups = GetFixups(world);
+        auto transient = GetTransientComponents(world);
+
+        std::vector<std::string> typeNames;
+        std::unordered_map<ecs_entity_t, uint32_t> typeIndices;
+        auto typeIndexFor = [&](ecs_entity_t entity, uint32_t& index) {
+            auto found = typeIndices.find(entity);
+            if (found != typeIndices.end()) {
+                index = found->second;
+                return true;
+            }
+
+            // Anonymous entities can't be resolved by name on load
+            if (ecs_get_name(w, entity) == nullptr) {
+                return false;
+            }
+
+            char* path = ecs_get_path_w_sep(w, 0, entity, ".", nullptr);
+            index = static_cast<uint32_t>(typeNames.size());
+            typeNames.emplace_back(path);
+            ecs_os_free(path);
+            typeIndices.emplace(entity, index);
+
+            return true;
+        };
+
+        std::vector<uint8_t> tableData;
+        Writer tables(tableData);
+        uint32_t tableCount = 0;
+
+        std::vector<std::pair<uint32_t, std::string>> names;
+
+        for (auto& range : ranges) {
+            std::vector<int32_t> rows;
+            std::vector<uint32_t> indices;
+            for (int32_t x = 0; x < static_cast<int32_t>(range.entities.size()); x++) {
+                auto found = entityIndices.find(range.entities[x]);
+                if (found != entityIndices.end()) {
+                    rows.push_back(range.offset + x);
+                    indices.push_back(found->second);
+
+                    if (auto name = ecs_get_name(w, range.entities[x])) {
+                        names.emplace_back(found->second, name);
+                    }
+                }
+            }
+
+            if (rows.empty()) {
+                continue;
+            }
+
+            std::vector<SnapshotId> ids;
+            std::vector<ecs_id_t> sourceIds;
+
+            const ecs_type_t* type = ecs_table_get_type(range.table);
+            for (int32_t x = 0; x < type->count; x++) {
+                ecs_id_t id = type->array[x];
+                SnapshotId snapshotId = {};
+
+                if (ECS_IS_PAIR(id)) {
+                    auto first = ecs_pair_first(w, id);
+                    auto second = ecs_pair_second(w, id);
+
+                    if (first == EcsIdentifier || !typeIndexFor(first, snapshotId.first)) {
+                        continue;
+                    }
+
+                    auto target = entityIndices.find(second);
+                    if (target != entityIndices.end()) {
+                        snapshotId.kind = IdKind::PairWithEntity;
+                        snapshotId.second = target->second;
+                    }
+                    else if (typeIndexFor(second, snapshotId.second)) {
+                        snapshotId.kind = IdKind::Pair;
+                    }
+                    else {
+                        continue;
+                    }
+                }
+                else {
+                    if ((id & ECS_ID_FLAGS_MASK) != 0 || !typeIndexFor(id, snapshotId.first)) {
+                        continue;
+                    }
+
+                    snapshotId.kind = IdKind::Type;
+                    snapshotId.transient = transient.contains(id) ? 1 : 0;
+                }
+
+                const ecs_type_info_t* info = ecs_get_type_info(w, id);
+                snapshotId.size = info != nullptr ? static_cast<uint32_t>(info->size) : 0;
+
+                ids.push_back(snapshotId);
+                sourceIds.push_back(id);
+            }
+
+            tables.Write(static_cast<uint16_t>(ids.size()));
+            tables.WriteBytes(ids.data(), ids.size() * sizeof(SnapshotId));
+            tables.Write(static_cast<uint32_t>(rows.size()));
+            tables.WriteBytes(indices.data(), indices.size() * sizeof(uint32_t));
+
+            for (size_t x = 0; x < ids.size(); x++) {
+                if (ids[x].size == 0 || ids[x].transient) {
+                    continue;
+                }
+
+                auto column = static_cast<const uint8_t*>(ecs_table_get_id(w, range.table, sourceIds[x], 0));
+                auto blobOffset = tables.Size();
+
+                // Consecutive rows are copied in one go, only filtered tables fall back to per row copies
+                if (rows.back() - rows.front() + 1 == static_cast<int32_t>(rows.size())) {
+                    tables.WriteBytes(column + static_cast<size_t>(rows.front()) * ids[x].size, rows.size() * ids[x].size);
+                }
+                else {
+                    for (auto row : rows) {
+                        tables.WriteBytes(column + static_cast<size_t>(row) * ids[x].size, ids[x].size);
+                    }
+                }
+
+                for (auto& fixup : fixups) {
+                    if (fixup.save != nullptr && fixup.component == sourceIds[x]) {
+                        fixup.save(tables.At(blobOffset), static_cast<int32_t>(rows.size()), context);
+                    }
+                }
+
+                // Live ids mean nothing to the next load, referenced entities are stored by their snapshot index
+                auto fields = entityFields.find(sourceIds[x]);
+                if (fields != entityFields.end()) {
+                    for (auto offset : fields->second) {
+                        RemapEntityFields(tables.At(blobOffset), rows.size(), ids[x].size, offset, [&](uint64_t entity) -> uint64_t {
+                            auto found = entityIndices.find(entity);
+                            return found != entityIndices.end() ? found->second + 1 : 0;
+                        });
+                    }
+                }
+            }
+
+            tableCount++;
+        }
+
+        data.clear();
+        Writer writer(data);
+        writer.Write(SnapshotHeader{
+            .magic = SNAPSHOT_MAGIC,
+            .version = SNAPSHOT_VERSION,
+            .typeCount = static_cast<uint32_t>(typeNames.size()),
+            .tableCount = tableCount,
+            .entityCount = static_cast<uint32_t>(entityIndices.size()),
+            .nameCount = static_cast<uint32_t>(names.size()),
+            .stringCount = static_cast<uint32_t>(context.strings.size()),
+        });
+
+        for (auto& name : typeNames) {
+            writer.WriteString(name);
+        }
+
+        writer.WriteBytes(tableData.data(), tableData.size());
+
+        for (auto& [index, name] : names) {
+            writer.Write(index);
+            writer.WriteString(name);
+        }
+
+        for (auto& value : context.strings) {
+            writer.WriteString(value);
+        }
+
+        return true;
+    }
+
+    bool Parse(const uint8_t* data, size_t size, Snapshot& snapshot, rendering::UploadPriority priority) {
+        ZoneScopedN("Snapshot: Parse");
+        auto& world = ecs::GetWorld();
+        ecs_world_t* w = world;
+
+        Reader reader(data, size);
+        SnapshotHeader header;
+        if (!reader.Read(header) || header.magic != SNAPSHOT_MAGIC) {
+            logging::logger::Error("Invalid world snapshot", "ecs");
+            return false;
+        }
+
+        if (header.version != SNAPSHOT_VERSION) {
+            logging::logger::Error("Unsupported world snapshot version " + std::to_string(header.version), "ecs");
+            return false;
+        }
+
+        std::vector<ecs_entity_t> types(header.typeCount, 0);
+        for (auto& type : types) {
+            std::string path;
+            if (!reader.ReadString(path)) {
+                logging::logger::Error("Truncated world snapshot", "ecs");
+                return false;
+            }
+
+            type = ecs_lookup(w, path.c_str());
+            if (type == 0) {
+                logging::logger::Warn("World snapshot references unknown type " + path, "ecs");
+            }
+        }
+
+        snapshot = {};
+        snapshot.entityCount = header.entityCount;
+        snapshot.tables.resize(header.tableCount);
+
+        std::vector<bool> isChild(header.entityCount, false);
+
+        for (auto& table : snapshot.tables) {
+            uint16_t idCount;
+            uint32_t rowCount;
+
+            std::vector<SnapshotId> snapshotIds;
+            if (!reader.Read(idCount)) {
+                logging::logger::Error("Truncated world snapshot", "ecs");
+                return false;
+            }
+
+            snapshotIds.resize(idCount);
+            auto idBytes = reader.Bytes(idCount * sizeof(SnapshotId));
+            if (idBytes == nullptr || !reader.Read(rowCount)) {
+                logging::logger::Error("Truncated world snapshot", "ecs");
+                return false;
+            }
+            std::memcpy(snapshotIds.data(), idBytes, idCount * sizeof(SnapshotId));
+
+            table.entities.resize(rowCount);
+            auto indexBytes = reader.Bytes(rowCount * sizeof(uint32_t));
+            if (indexBytes == nullptr) {
+                logging::logger::Error("Truncated world snapshot", "ecs");
+                return false;
+            }
+            std::memcpy(table.entities.data(), indexBytes, rowCount * sizeof(uint32_t));
+
+            for (auto index : table.entities) {
+                if (index >= header.entityCount) {
+                    logging::logger::Error("Corrupt world snapshot", "ecs");
+                    return false;
+                }
+            }
+
+            for (auto& snapshotId : snapshotIds) {
+                const uint8_t* column = nullptr;
+                if (snapshotId.size > 0 && !snapshotId.transient) {
+                    column = reader.Bytes(static_cast<size_t>(snapshotId.size) * rowCount);
+                    if (column == nullptr) {
+                        logging::logger::Error("Truncated world snapshot", "ecs");
+                        return false;
+                    }
+                }
+
+                if (snapshotId.first >= types.size() || types[snapshotId.first] == 0) {
+                    continue;
+                }
+
+                ecs_id_t id = 0;
+                int32_t target = -1;
+
+                switch (snapshotId.kind) {
+                case IdKind::Type:
+                    id = types[snapshotId.first];
+                    break;
+                case IdKind::Pair:
+                    if (snapshotId.second < types.size() && types[snapshotId.second] != 0) {
+                        id = ecs_pair(types[snapshotId.first], types[snapshotId.second]);
+                    }
+                    break;
+                case IdKind::PairWithEntity:
+                    // The target only exists once the snapshot gets instantiated, keep the relationship and the target index
+                    if (snapshotId.second < header.entityCount) {
+                        id = types[snapshotId.first];
+                        target = static_cast<int32_t>(snapshotId.second);
+
+                        if (id == EcsChildOf) {
+                            for (auto index : table.entities) {
+                                isChild[index] = true;
+                            }
+                        }
+                    }
+                    break;
+                }
+
+                if (id == 0) {
+                    continue;
+                }
+
+                table.ids.push_back(id);
+                table.targets.push_back(target);
+                table.hasTargets |= target >= 0;
+
+                if (column == nullptr || target >= 0) {
+                    continue;
+                }
+
+                const ecs_type_info_t* info = ecs_get_type_info(w, id);
+                if (info == nullptr || info->size != static_cast<ecs_size_t>(snapshotId.size)) {
+                    logging::logger::Warn("Component layout changed since the snapshot was written, skipping column", "ecs");
+                    continue;
+                }
+
+                table.columns.emplace_back(id, std::vector<uint8_t>(column, column + static_cast<size_t>(snapshotId.size) * rowCount));
+
+                auto fields = entityFields.find(id);
+                if (fields != entityFields.end()) {
+                    for (auto offset : fields->second) {
+                        table.entityFields.emplace_back(table.columns.size() - 1, offset);
+                    }
+                }
+            }
+        }
+
+        snapshot.names.resize(header.nameCount);
+        for (auto& [index, name] : snapshot.names) {
+            if (!reader.Read(index) || !reader.ReadString(name)) {
+                logging::logger::Error("Truncated world snapshot", "ecs");
+                return false;
+            }
+        }
+
+        LoadContext context = {};
+        context.snapshot = &snapshot;
+        context.priority = priority;
+        for (uint32_t x = 0; x < header.stringCount; x++) {
+            std::string value;
+            if (!reader.ReadString(value)) {
+                logging::logger::Error("Truncated world snapshot", "ecs");
+                return false;
+            }
+
+            context.strings.push_back(internedStrings.insert(std::move(value)).first->c_str());
+        }
+
+        for (uint32_t x = 0; x < header.entityCount; x++) {
+            if (!isChild[x]) {
+                snapshot.roots.push_back(x);
+            }
+        }
+
+        // Resolve assets and rebuild runtime data once, every instance copies the result
+        auto companions = GetCompanions(world);
+        auto fixups = GetFixups(world);
+
+        for (auto& table : snapshot.tables) {
+            for (auto& companion : companions) {
+                if (std::find(table.ids.begin(), table.ids.end(), companion.authoring) == table.ids.end()) {
+                    continue;
+                }
+
+                for (auto runtime : companion.runtime) {
+                    if (std::find(table.ids.begin(), table.ids.end(), runtime) == table.ids.end()) {
+                        table.ids.push_back(runtime);
+                        table.targets.push_back(-1);
+                    }
+                }
+            }
+
+            auto rows = static_cast<int32_t>(table.entities.size());
+            for (auto& fixup : fixups) {
+                if (fixup.load == nullptr || std::find(table.ids.begin(), table.ids.end(), fixup.component) == table.ids.end()) {
+                    continue;
+                }
+
+                if (fixup.output != 0) {
+                    auto info = ecs_get_type_info(w, fixup.output);
+                    table.columns.emplace_back(fixup.output, std::vector<uint8_t>(static_cast<size_t>(info->size) * rows, 0));
+                }
+
+                FixupColumns columns;
+                for (auto& [id, column] : table.columns) {
+                    columns.emplace_back(id, column.data());
+                }
+
+                fixup.load(columns, rows, context);
+            }
+        }
+
+        return true;
+    }
+
+    void InstantiateTable(ecs_world_t* world, const Snapshot& snapshot, const SnapshotTable& table, const std::vector<ecs_entity_t>& created, uint32_t firstCopy, uint32_t copies, uint64_t addTag) {
+        ZoneScopedN("Snapshot: Instantiate Table");
+
+        std::vector<ecs_id_t> ids;
+        ids.reserve(table.ids.size() + 1);
+        for (size_t x = 0; x < table.ids.size(); x++) {
+            if (table.targets[x] < 0) {
+                ids.push_back(table.ids[x]);
+            }
+            else {
+                // Tables with relationships inside the snapshot are instantiated one copy at a time
+                ids.push_back(ecs_pair(table.ids[x], created[firstCopy * snapshot.entityCount + table.targets[x]]));
+            }
+        }
+
+        if (addTag != 0) {
+            ids.push_back(addTag);
+        }
+
+        auto rows = table.entities.size();
+        std::vector<ecs_entity_t> rowEntities(rows * copies);
+        for (uint32_t copy = 0; copy < copies; copy++) {
+            for (size_t row = 0; row < rows; row++) {
+                rowEntities[copy * rows + row] = created[(firstCopy + copy) * snapshot.entityCount + table.entities[row]];
+            }
+        }
+
+        ecs_bulk_desc_t bulk = {};
+        bulk.entities = rowEntities.data();
+        bulk.count = static_cast<int32_t>(rowEntities.size());
+
+        // The descriptor holds a zero terminated, fixed size id list. Very wide archetypes get the remainder added per entity.
+        size_t bulkIds = std::min<size_t>(ids.size(), FLECS_ID_DESC_MAX - 1);
+        std::copy(ids.begin(), ids.begin() + bulkIds, bulk.ids);
+        ecs_bulk_init(world, &bulk);
+
+        for (size_t x = bulkIds; x < ids.size(); x++) {
+            for (auto entity : rowEntities) {
+                ecs_add_id(world, entity, ids[x]);
+            }
+        }
+
+        // Entities moved into the table as one block, so every column is one memcpy per copy
+        ecs_record_t* firstRecord = ecs_record_find(world, rowEntities.front());
+        ecs_record_t* lastRecord = ecs_record_find(world, rowEntities.back());
+        int32_t firstRow = ECS_RECORD_TO_ROW(firstRecord->row);
+        bool contiguous = firstRecord->table == lastRecord->table &&
+            ECS_RECORD_TO_ROW(lastRecord->row) - firstRow + 1 == bulk.count;
+
+        for (auto& [id, column] : table.columns) {
+            if (contiguous) {
+                auto dst = static_cast<uint8_t*>(ecs_table_get_id(world, firstRecord->table, id, firstRow));
+                for (uint32_t copy = 0; copy < copies; copy++) {
+                    std::memcpy(dst + copy * column.size(), column.data(), column.size());
+                }
+            }
+            else {
+                auto size = column.size() / rows;
+                for (size_t x = 0; x < rowEntities.size(); x++) {
+                    void* dst = ecs_get_mut_id(world, rowEntities[x], id);
+                    std::memcpy(dst, column.data() + (x % rows) * size, size);
+                }
+            }
+        }
+
+        // Every copy points its entity fields at the entities of the same copy
+        for (auto [columnIndex, offset] : table.entityFields) {
+            auto& [id, column] = table.columns[columnIndex];
+            auto size = column.size() / rows;
+
+            for (uint32_t copy = 0; copy < copies; copy++) {
+                auto firstCreated = static_cast<size_t>(firstCopy + copy) * snapshot.entityCount;
+                auto remap = [&](uint64_t index) -> uint64_t {
+                    return index <= snapshot.entityCount ? created[firstCreated + index - 1] : 0;
+                };
+
+                if (contiguous) {
+                    auto dst = static_cast<uint8_t*>(ecs_table_get_id(world, firstRecord->table, id, firstRow));
+                    RemapEntityFields(dst + copy * column.size(), rows, size, offset, remap);
+                    continue;
+                }
+
+                for (size_t row = 0; row < rows; row++) {
+                    auto dst = static_cast<uint8_t*>(ecs_get_mut_id(world, rowEntities[copy * rows + row], id));
+                    RemapEntityFields(dst, 1, size, offset, remap);
+                }
+            }
+        }
+    }
+
+    bool Instantiate(const Snapshot& snapshot, uint32_t count, uint64_t addTag, std::vector<uint64_t>* entities) {
+        ZoneScopedN("Snapshot: Instantiate");
+        ecs_world_t* w = ecs::GetWorld();
+
+        if (ecs_is_deferred(w)) {
+            logging::logger::Error("World snapshots can't be instantiated while the world is progressing", "ecs");
+            return false;
+        }
+
+        // Reserve all entities up front so relationships between them can be expressed while creating the tables
+        std::vector<ecs_entity_t> created(static_cast<size_t>(snapshot.entityCount) * count, 0);
+        if (!created.empty()) {
+            ecs_bulk_desc_t bulk = {};
+            bulk.count = static_cast<int32_t>(created.size());
+            auto ids = ecs_bulk_init(w, &bulk);
+            std::copy(ids, ids + created.size(), created.begin());
+        }
+
+        for (auto& table : snapshot.tables) {
+            if (table.entities.empty()) {
+                continue;
+            }
+
+            if (!table.hasTargets) {
+                InstantiateTable(w, snapshot, table, created, 0, count, addTag);
+                continue;
+            }
+
+            for (uint32_t copy = 0; copy < count; copy++) {
+                InstantiateTable(w, snapshot, table, created, copy, 1, addTag);
+            }
+        }
+
+        // Names have to be unique within their parent, copies only keep the names of their children
+        std::vector<bool> isRoot(snapshot.entityCount, false);
+        for (auto root : snapshot.roots) {
+            isRoot[root] = true;
+        }
+
+        for (auto& [index, name] : snapshot.names) {
+            if (index >= snapshot.entityCount || (count > 1 && isRoot[index])) {
+                continue;
+            }
+
+            for (uint32_t copy = 0; copy < count; copy++) {
+                ecs_set_name(w, created[copy * snapshot.entityCount + index], name.c_str());
+            }
+        }
+
+        for (auto [handle, refs] : snapshot.modelRefs) {
+            assetmanager::RetainModel(handle, refs * count);
+        }
+
+        for (auto [handle, refs] : snapshot.materialRefs) {
+            assetmanager::RetainMaterial(handle, refs * count);
+        }
+
+        for (auto [handle, refs] : snapshot.physicsMaterialRefs) {
+            assetmanager::RetainPhysicsMaterial(handle, refs * count);
+        }
+
+        if (entities != nullptr) {
+            entities->assign(created.begin(), created.end());
+        }
+
+        return true;
+    }
+
+    void Release(Snapshot& snapshot) {
+        // Parsing loaded every asset once on behalf of the snapshot
+        for (auto [handle, refs] : snapshot.modelRefs) {
+            assetmanager::ReleaseModel(handle);
+        }
+
+        for (auto [handle, refs] : snapshot.materialRefs) {
+            assetmanager::ReleaseMaterial(handle);
+        }
+
+        for (auto [handle, refs] : snapshot.physicsMaterialRefs) {
+            assetmanager::ReleasePhysicsMaterial(handle);
+        }
+
+        snapshot = {};
+    }
+
+    bool Load(const uint8_t* data, size_t size, uint64_t addTag, std::vector<uint64_t>* entities, rendering::UploadPriority priority) {
+        ZoneScopedN("Snapshot: Load");
+
+        Snapshot snapshot;
+        if (!Parse(data, size, snapshot, priority)) {
+            return false;
+        }
+
+        bool loaded = Instantiate(snapshot, 1, addTag, entities);
+        Release(snapshot);
+
+        return loaded;
+    }
+
+    bool LoadWorld(uint64_t hash, uint64_t addTag, rendering::UploadPriority priority) {
+        auto world = assetloader::LoadWorld(hash);
+
+        return Load(world.worldData.data(), world.worldData.size(), addTag, nullptr, priority);
+    }
+
+    void Save_C(uint8_t* data, size_t* size) {
+        // Two call pattern, the first call sizes the buffer and keeps the snapshot until it is copied out
+        if (data == nullptr) {
+            pendingSnapshot.clear();
+            Save(pendingSnapshot);
+            *size = pendingSnapshot.size();
+
+            return;
+        }
+
+        auto count = std::min(*size, pendingSnapshot.size());
+        std::memcpy(data, pendingSnapshot.data(), count);
+        *size = count;
+
+        pendingSnapshot = {};
+    }
+
+    bool Load_C(const uint8_t* data, size_t size) {
+        return Load(data, size);
+    }
+
+    bool LoadWorldByName(const char* name) {
+        auto hash = shared::Hash(name);
+
+        return LoadWorld(hash);
+    }
+
+    // ---- Fixups ----
+    template<typename T>
+    T* Column(const FixupColumns& columns) {
+        auto component = ecs::GetWorld().id<T>();
+        for (auto& [id, column] : columns) {
+            if (id == component) {
+                return static_cast<T*>(column);
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::vector<ComponentFixup> GetFixups(flecs::world& world) {
+        return {
+            ComponentFixup{
+                .component = world.id<RigidBodyComponent>(),
+                .output = 0,
+                .save = [](void* rows, int32_t count, SaveContext&) {
+                    auto bodies = static_cast<RigidBodyComponent*>(rows);
+                    for (int32_t x = 0; x < count; x++) {
+                        bodies[x].handle = UINT64_MAX;
+                        bodies[x].isDirty = true;
+                    }
+                },
+                .load = nullptr,
+            },
+            ComponentFixup{
+                .component = world.id<StaticBodyComponent>(),
+                .output = 0,
+                .save = [](void* rows, int32_t count, SaveContext&) {
+                    auto bodies = static_cast<StaticBodyComponent*>(rows);
+                    for (int32_t x = 0; x < count; x++) {
+                        bodies[x].handle = UINT64_MAX;
+                    }
+                },
+                .load = nullptr,
+            },
+            ComponentFixup{
+                .component = world.id<BoxColliderComponent>(),
+                .output = 0,
+                .save = [](void* rows, int32_t count, SaveContext&) {
+                    auto colliders = static_cast<BoxColliderComponent*>(rows);
+                    for (int32_t x = 0; x < count; x++) {
+                        uint64_t hash = colliders[x].material != nullptr ? colliders[x].material->hash : 0;
+                        std::memcpy(&colliders[x].material, &hash, sizeof(hash));
+                        colliders[x].handle = UINT64_MAX;
+                        colliders[x].bodyHandle = UINT64_MAX;
+                    }
+                },
+                .load = [](const FixupColumns& columns, int32_t count, LoadContext& context) {
+                    auto colliders = Column<BoxColliderComponent>(columns);
+                    if (colliders == nullptr) {
+                        return;
+                    }
+
+                    for (int32_t x = 0; x < count; x++) {
+                        uint64_t hash;
+                        std::memcpy(&hash, &colliders[x].material, sizeof(hash));
+                        if (hash == 0) {
+                            colliders[x].material = nullptr;
+                            continue;
+                        }
+
+                        auto it = context.physicsMaterials.find(hash);
+                        if (it == context.physicsMaterials.end()) {
+                            it = context.physicsMaterials.emplace(hash, assetmanager::LoadPhysicsMaterial(hash)).first;
+                        }
+
+                        context.snapshot->physicsMaterialRefs[it->second]++;
+                        colliders[x].material = assetmanager::GetPhysicsMaterial(it->second);
+                    }
+                },
+            },
+            ComponentFixup{
+                .component = world.id<AudioSourceComponent>(),
+                .output = 0,
+                .save = [](void* rows, int32_t count, SaveContext& context) {
+                    auto sources = static_cast<AudioSourceComponent*>(rows);
+                    for (int32_t x = 0; x < count; x++) {
+                        uint64_t index = context.Intern(sources[x].eventName);
+                        std::memcpy(&sources[x].eventName, &index, sizeof(index));
+                        sources[x].handle = UINT64_MAX;
+                    }
+                },
+                .load = [](const FixupColumns& columns, int32_t count, LoadContext& context) {
+                    auto sources = Column<AudioSourceComponent>(columns);
+                    if (sources == nullptr) {
+                        return;
+                    }
+
+                    for (int32_t x = 0; x < count; x++) {
+                        uint64_t index;
+                        std::memcpy(&index, &sources[x].eventName, sizeof(index));
+                        sources[x].eventName = index > 0 && index <= context.strings.size() ? context.strings[index - 1] : nullptr;
+                    }
+                },
+            },
+            ComponentFixup{
+                .component = world.id<MeshComponent>(),
+                .output = world.id<MeshRuntimeComponent>(),
+                .save = nullptr,
+                .load = [](const FixupColumns& columns, int32_t count, LoadContext& context) {
+                    auto meshes = Column<MeshComponent>(columns);
+                    auto runtime = Column<MeshRuntimeComponent>(columns);
+                    if (meshes == nullptr || runtime == nullptr) {
+                        return;
+                    }
+
+                    for (int32_t x = 0; x < count; x++) {
+                        auto it = context.models.find(meshes[x].AssetId);
+                        if (it == context.models.end()) {
+                            it = context.models.emplace(meshes[x].AssetId, assetmanager::LoadModel(meshes[x].AssetId, context.priority)).first;
+                        }
+
+                        context.snapshot->modelRefs[it->second]++;
+                        runtime[x].HandleId = it->second;
+                        runtime[x].MeshId = meshes[x].MeshId;
+                        runtime[x].Lod = 0;
+                    }
+                },
+            },
+            ComponentFixup{
+                .component = world.id<MaterialComponent>(),
+                .output = world.id<MaterialRuntimeComponent>(),
+                .save = nullptr,
+                .load = [](const FixupColumns& columns, int32_t count, LoadContext& context) {
+                    auto materials = Column<MaterialComponent>(columns);
+                    auto runtime = Column<MaterialRuntimeComponent>(columns);
+                    if (materials == nullptr || runtime == nullptr) {
+                        return;
+                    }
+
+                    for (int32_t x = 0; x < count; x++) {
+                        auto it = context.materials.find(materials[x].AssetId);
+                        if (it == context.materials.end()) {
+                            it = context.materials.emplace(materials[x].AssetId, assetmanager::LoadMaterial(materials[x].AssetId, nullptr, context.priority)).first;
+                        }
+
+                        context.snapshot->materialRefs[it->second]++;
+                        runtime[x].HandleId = it->second;
+                    }
+                },
+            },
+        };
+    }
+
+    std::vector<Companion> GetCompanions(flecs::world& world) {
+        return {
+            Companion{ world.id<TransformComponent>(), { world.id<WorldTransformComponent>() } },
+            Companion{ world.id<MeshComponent>(), { world.id<MeshRuntimeComponent>(), world.id<SpatialProxyComponent>() } },
+            Companion{ world.id<MaterialComponent>(), { world.id<MaterialRuntimeComponent>() } },
+            Companion{ world.id<StaticBodyComponent>(), { world.id<StaticBatchComponent>() } },
+            Companion{ world.id<StaticComponent>(), { world.id<StaticBatchComponent>() } },
+        };
+    }
+
+    std::unordered_set<ecs_entity_t> GetTransientComponents(flecs::world& world) {
+        return {
+            world.id<MeshRuntimeComponent>(),
+            world.id<MaterialRuntimeComponent>(),
+            world.id<SpatialProxyComponent>(),
+            world.id<StaticBatchComponent>(),
+        };
+    }
+}
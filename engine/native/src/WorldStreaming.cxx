@@ -0,0 +1,404 @@
+#include "playground/WorldStreaming.hxx"
+#include "playground/ECS.hxx"
+#include "playground/WorldSnapshot.hxx"
+#include "playground/components/CameraComponent.hxx"
+#include "playground/components/WorldTransformComponent.hxx"
+#include <assetloader/AssetLoader.hxx>
+#include <shared/Hasher.hxx>
+#include <shared/Job.hxx>
+#include <shared/JobHandle.hxx>
+#include <shared/JobSystem.hxx>
+#include <shared/Logger.hxx>
+#include <tracy/Tracy.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace playground::worldstreaming {
+    enum class CellState : uint8_t {
+        Unloaded,
+        Loading,
+        Loaded
+    };
+
+    struct ManifestHeader {
+        uint32_t magic;
+        uint32_t version;
+        float cellSize;
+        uint32_t cellCount;
+    };
+
+    struct ManifestEntry {
+        int32_t x;
+        int32_t z;
+        uint64_t hash;
+    };
+
+    struct Cell {
+        int32_t x;
+        int32_t z;
+        uint64_t hash;
+        CellState state = CellState::Unloaded;
+        bool wanted = false;
+        bool failed = false;
+        std::shared_ptr<jobsystem::JobHandle> job;
+        std::vector<uint8_t> data; // Written by the load job, consumed on the game thread
+        ecs_entity_t tag = 0;
+    };
+
+    struct CameraPosition {
+        float x;
+        float z;
+    };
+
+    StreamingSettings settings;
+    float cellSize = 0.0f;
+    // Node based so the load jobs can hold on to their cell
+    std::unordered_map<uint64_t, Cell> cells;
+    // Only cells that are loading or loaded are visited every frame, keeping the cost independent of the world size
+    std::vector<Cell*> residentCells;
+    uint32_t loadsInFlight = 0;
+    flecs::query<const CameraComponent, const WorldTransformComponent> cameraQuery;
+
+    inline uint64_t CellKey(int32_t x, int32_t z) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(z);
+    }
+
+    inline int32_t CellCoordinate(float value, float size) {
+        return static_cast<int32_t>(std::floor(value / size));
+    }
+
+    float DistanceSquaredToCell(const Cell& cell, const CameraPosition& camera) {
+        float minX = cell.x * cellSize;
+        float minZ = cell.z * cellSize;
+        float dx = std::max(std::max(minX - camera.x, 0.0f), camera.x - (minX + cellSize));
+        float dz = std::max(std::max(minZ - camera.z, 0.0f), camera.z - (minZ + cellSize));
+
+        return dx * dx + dz * dz;
+    }
+
+    float ClosestCameraDistanceSquared(const Cell& cell, const std::vector<CameraPosition>& cameras) {
+        float closest = std::numeric_limits<float>::max();
+        for (auto& camera : cameras) {
+            closest = std::min(closest, DistanceSquaredToCell(cell, camera));
+        }
+
+        return closest;
+    }
+
+    void StartLoading(Cell& cell) {
+        cell.state = CellState::Loading;
+        cell.wanted = true;
+        loadsInFlight++;
+        residentCells.push_back(&cell);
+
+        auto cellPtr = &cell;
+        cell.job = jobsystem::Submit(jobsystem::Job{
+            .Name = "Stream Cell",
+            .Priority = jobsystem::JobPriority::Low,
+            .Color = tracy::Color::SteelBlue,
+            .Dependencies = {},
+            .Task = [cellPtr](uint8_t workerId) {
+                try {
+                    cellPtr->data = assetloader::LoadWorld(cellPtr->hash).worldData;
+                }
+                catch (const std::exception& e) {
+                    logging::logger::Error(e.what(), "streaming");
+                    cellPtr->data.clear();
+                }
+            }
+        });
+    }
+
+    // Cells the cameras are in or next to upload first, ones that fell out of the load radius while loading go last
+    rendering::UploadPriority CellUploadPriority(const Cell& cell, const std::vector<CameraPosition>& cameras) {
+        auto distanceSquared = ClosestCameraDistanceSquared(cell, cameras);
+        if (distanceSquared <= settings.visibleRadius * settings.visibleRadius) {
+            return rendering::UploadPriority::Visible;
+        }
+        if (distanceSquared <= settings.loadRadius * settings.loadRadius) {
+            return rendering::UploadPriority::Nearby;
+        }
+
+        return rendering::UploadPriority::Prefetch;
+    }
+
+    void Instantiate(Cell& cell, rendering::UploadPriority priority) {
+        ZoneScopedNC("Streaming: Instantiate Cell", tracy::Color::SteelBlue);
+        auto& world = ecs::GetWorld();
+
+        cell.tag = ecs_new(world);
+        if (!worldsnapshot::Load(cell.data.data(), cell.data.size(), cell.tag, nullptr, priority)) {
+            logging::logger::Error("Failed to instantiate cell " + std::to_string(cell.x) + ", " + std::to_string(cell.z), "streaming");
+            ecs_delete(world, cell.tag);
+            cell.tag = 0;
+            cell.failed = true;
+            cell.state = CellState::Unloaded;
+        }
+        else {
+            cell.state = CellState::Loaded;
+        }
+
+        cell.data = {};
+    }
+
+    void Unload(Cell& cell) {
+        ZoneScopedNC("Streaming: Unload Cell", tracy::Color::SteelBlue);
+
+        // Removing the entities runs the component hooks, which release the assets the cell was holding on to
+        ecs::DeleteAllEntitiesByTag(cell.tag);
+        ecs_delete(ecs::GetWorld(), cell.tag);
+        cell.tag = 0;
+        cell.state = CellState::Unloaded;
+    }
+
+    void Init() {
+        logging::logger::SetupSubsystem("streaming");
+        logging::logger::Info("Initializing world streaming", "streaming");
+
+        cameraQuery = ecs::GetWorld().query<const CameraComponent, const WorldTransformComponent>();
+    }
+
+    void Shutdown() {
+        Close();
+        cameraQuery = {};
+    }
+
+    bool Cook(const std::string& worldName, float cellSize, std::vector<uint8_t>& manifest, std::vector<CookedCell>& cookedCells) {
+        ZoneScopedN("Streaming: Cook");
+        auto& world = ecs::GetWorld();
+
+        if (cellSize <= 0.0f || ecs_is_deferred(world)) {
+            logging::logger::Error("Worlds can only be cooked outside of the ECS tick and with a positive cell size", "streaming");
+            return false;
+        }
+
+        // Ordered so cooking the same world twice produces the same output
+        std::map<std::pair<int32_t, int32_t>, std::vector<ecs_entity_t>> members;
+
+        world.each([&](flecs::entity entity, const WorldTransformComponent&) {
+            auto root = entity;
+            for (auto parent = root.parent(); parent.is_valid() && parent.has<WorldTransformComponent>(); parent = parent.parent()) {
+                root = parent;
+            }
+
+            const auto& position = root.get<WorldTransformComponent>().Position;
+            members[{ CellCoordinate(position.X, cellSize), CellCoordinate(position.Z, cellSize) }].push_back(entity);
+        });
+
+        cookedCells.clear();
+        cookedCells.reserve(members.size());
+
+        for (auto& [coordinate, entities] : members) {
+            auto tag = ecs_new(world);
+            for (auto entity : entities) {
+                ecs_add_id(world, entity, tag);
+            }
+
+            CookedCell cell = {};
+            cell.x = coordinate.first;
+            cell.z = coordinate.second;
+            cell.name = worldName + "." + std::to_string(cell.x) + "." + std::to_string(cell.z) + ".cell";
+            cell.hash = shared::Hash(cell.name);
+            bool saved = worldsnapshot::Save(cell.data, tag);
+
+            // Deleting the tag removes it from the entities again
+            ecs_delete(world, tag);
+
+            if (!saved) {
+                return false;
+            }
+
+            cookedCells.push_back(std::move(cell));
+        }
+
+        ManifestHeader header = {
+            .magic = MANIFEST_MAGIC,
+            .version = MANIFEST_VERSION,
+            .cellSize = cellSize,
+            .cellCount = static_cast<uint32_t>(cookedCells.size()),
+        };
+
+        manifest.resize(sizeof(ManifestHeader) + cookedCells.size() * sizeof(ManifestEntry));
+        std::memcpy(manifest.data(), &header, sizeof(header));
+
+        auto entries = manifest.data() + sizeof(ManifestHeader);
+        for (auto& cell : cookedCells) {
+            ManifestEntry entry = { cell.x, cell.z, cell.hash };
+            std::memcpy(entries, &entry, sizeof(entry));
+            entries += sizeof(entry);
+        }
+
+        return true;
+    }
+
+    bool Open(uint64_t manifestHash) {
+        ZoneScopedN("Streaming: Open");
+        Close();
+
+        auto world = assetloader::LoadWorld(manifestHash);
+        auto& data = world.worldData;
+
+        ManifestHeader header;
+        if (data.size() < sizeof(header)) {
+            logging::logger::Error("Invalid world manifest", "streaming");
+            return false;
+        }
+
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != MANIFEST_MAGIC || header.version != MANIFEST_VERSION || header.cellSize <= 0.0f ||
+            data.size() < sizeof(header) + static_cast<size_t>(header.cellCount) * sizeof(ManifestEntry)) {
+            logging::logger::Error("Invalid world manifest", "streaming");
+            return false;
+        }
+
+        cellSize = header.cellSize;
+        cells.reserve(header.cellCount);
+
+        auto entries = data.data() + sizeof(header);
+        for (uint32_t x = 0; x < header.cellCount; x++) {
+            ManifestEntry entry;
+            std::memcpy(&entry, entries + x * sizeof(ManifestEntry), sizeof(entry));
+            cells.emplace(CellKey(entry.x, entry.z), Cell{ .x = entry.x, .z = entry.z, .hash = entry.hash });
+        }
+
+        logging::logger::Info("Opened streamed world with " + std::to_string(header.cellCount) + " cells", "streaming");
+
+        return true;
+    }
+
+    void Close() {
+        for (auto cell : residentCells) {
+            if (cell->job != nullptr) {
+                cell->job->Wait();
+                cell->job = nullptr;
+            }
+
+            if (cell->state == CellState::Loaded) {
+                Unload(*cell);
+            }
+        }
+
+        residentCells.clear();
+        cells.clear();
+        loadsInFlight = 0;
+        cellSize = 0.0f;
+    }
+
+    void Update() {
+        ZoneScopedN("Streaming: Update");
+        if (cells.empty()) {
+            return;
+        }
+
+        std::vector<CameraPosition> cameras;
+        cameraQuery.each([&](const CameraComponent&, const WorldTransformComponent& transform) {
+            cameras.push_back({ transform.Position.X, transform.Position.Z });
+        });
+
+        float loadRadiusSquared = settings.loadRadius * settings.loadRadius;
+        float unloadRadiusSquared = settings.unloadRadius * settings.unloadRadius;
+
+        // Unload or cancel everything that fell out of range of all cameras
+        for (auto cell : residentCells) {
+            if (ClosestCameraDistanceSquared(*cell, cameras) <= unloadRadiusSquared) {
+                continue;
+            }
+
+            if (cell->state == CellState::Loaded) {
+                Unload(*cell);
+            }
+            else if (cell->state == CellState::Loading) {
+                cell->wanted = false;
+            }
+        }
+
+        // Only the cells around each camera are candidates for loading
+        int32_t range = static_cast<int32_t>(std::ceil(settings.loadRadius / cellSize));
+        for (auto& camera : cameras) {
+            int32_t cameraX = CellCoordinate(camera.x, cellSize);
+            int32_t cameraZ = CellCoordinate(camera.z, cellSize);
+
+            for (int32_t z = cameraZ - range; z <= cameraZ + range; z++) {
+                for (int32_t x = cameraX - range; x <= cameraX + range; x++) {
+                    auto it = cells.find(CellKey(x, z));
+                    if (it == cells.end()) {
+                        continue;
+                    }
+
+                    auto& cell = it->second;
+                    if (cell.failed || DistanceSquaredToCell(cell, camera) > loadRadiusSquared) {
+                        continue;
+                    }
+
+                    if (cell.state == CellState::Loading) {
+                        cell.wanted = true;
+                    }
+                    else if (cell.state == CellState::Unloaded &&
+                        loadsInFlight < settings.maxConcurrentLoads &&
+                        residentCells.size() < settings.maxResidentCells) {
+                        StartLoading(cell);
+                    }
+                }
+            }
+        }
+
+        uint32_t instantiated = 0;
+        for (auto cell : residentCells) {
+            if (cell->state != CellState::Loading || !cell->job->IsDone()) {
+                continue;
+            }
+
+            if (!cell->wanted || cell->data.empty()) {
+                cell->failed = cell->wanted;
+                cell->data = {};
+                cell->state = CellState::Unloaded;
+            }
+            else if (instantiated < settings.maxInstantiationsPerFrame) {
+                Instantiate(*cell, CellUploadPriority(*cell, cameras));
+                instantiated++;
+            }
+            else {
+                continue;
+            }
+
+            cell->job = nullptr;
+            loadsInFlight--;
+        }
+
+        std::erase_if(residentCells, [](Cell* cell) { return cell->state == CellState::Unloaded; });
+    }
+
+    void SetSettings(const StreamingSettings& newSettings) {
+        settings = newSettings;
+        settings.unloadRadius = std::max(settings.unloadRadius, settings.loadRadius);
+        settings.visibleRadius = std::min(settings.visibleRadius, settings.loadRadius);
+    }
+
+    const StreamingSettings& GetSettings() {
+        return settings;
+    }
+
+    size_t ResidentCellCount() {
+        return residentCells.size();
+    }
+
+    bool OpenByName(const char* name) {
+        auto hash = shared::Hash(name);
+
+        return Open(hash);
+    }
+
+    void SetRadii(float loadRadius, float unloadRadius) {
+        auto newSettings = settings;
+        newSettings.loadRadius = loadRadius;
+        newSettings.unloadRadius = unloadRadius;
+
+        SetSettings(newSettings);
+    }
+}
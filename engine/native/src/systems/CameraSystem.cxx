@@ -18,7 +18,7 @@ namespace playground::ecs::camerasystem {
                     auto camera = it.field<const CameraComponent>(1);
 
                     for (int x = 0; x < it.count(); x++) {
-                        drawcallbatcher::AddCamera(camera->Order, camera->Fov, camera->NearPlane, camera->FarPlane, transform[x].Position, transform[x].Rotation);
+                        drawcallbatcher::AddCamera(camera[x].Order, camera[x].Fov, camera[x].NearPlane, camera[x].FarPlane, transform[x].Position, transform[x].Rotation, camera[x].LodBias);
                     }
                 }
             });
@@ -21,13 +21,18 @@ namespace playground::ecs::hierarchysystem {
         // Update the world components based on the local components
         e.children([t](flecs::entity child) {
             auto local = child.get<TransformComponent>();
-            child.set<WorldTransformComponent>({
+            auto world = WorldTransformComponent{
                 t.Position + (t.Rotation * local.Position ),
                 t.Rotation * local.Rotation,
                 local.Scale * t.Scale
-            });
+            };
+
+            // Only real changes are set, the spatial index and other OnSet observers rely on that
+            if (!IsSameTransform(world, child.get<WorldTransformComponent>())) {
+                child.set<WorldTransformComponent>(world);
+            }
 
-            UpdateChildren(child, child.get<WorldTransformComponent>());
+            UpdateChildren(child, world);
         });
     }
 
@@ -42,9 +47,12 @@ namespace playground::ecs::hierarchysystem {
                 WorldTransformComponent& wt
             ) {
                     ZoneScopedNC("HierarchySystem", tracy::Color::Green);
-                    wt.Position = t.Position;
-                    wt.Rotation = t.Rotation;
-                    wt.Scale = t.Scale;
+                    auto world = WorldTransformComponent{ t.Position, t.Rotation, t.Scale };
+                    if (!IsSameTransform(world, wt)) {
+                        wt = world;
+                        e.modified<WorldTransformComponent>();
+                    }
+
                     UpdateChildren(e, wt);
             });
     }
@@ -3,6 +3,10 @@
 #include "playground/components/WorldTransformComponent.hxx"
 #include "playground/components/MeshComponent.hxx"
 #include "playground/components/MaterialComponent.hxx"
+#include "playground/components/StaticBatchComponent.hxx"
+#include "playground/components/OccluderComponent.hxx"
+#include "playground/components/PointLightComponent.hxx"
+#include "playground/components/SpotLightComponent.hxx"
 #include "playground/DrawCallBatcher.hxx"
 #include <rendering/Constants.hxx>
 #include <array>
@@ -21,35 +25,123 @@ namespace playground::ecs::rendersystem {
     std::atomic<uint32_t> offset = 0;
 
     void Init(flecs::world world) {
-        world.system<const WorldTransformComponent, const MeshRuntimeComponent, const MaterialRuntimeComponent>("RenderSystem")
+        // Static entities are batched once by StaticRenderSystem, only dynamic ones are rebuilt every frame
+        // Writes the picked LOD back to MeshRuntimeComponent, the next frame's selection starts from it
+        world.system<const WorldTransformComponent, MeshRuntimeComponent, const MaterialRuntimeComponent>("RenderSystem")
             .kind(flecs::PostUpdate)
             .multi_threaded(true)
+            .without<StaticBatchComponent>()
             .run([](flecs::iter& it) {
                 while (it.next()) {
                     ZoneScopedNC("RenderSystem", tracy::Color::Green);
                     auto transform = it.field<const WorldTransformComponent>(0);
-                    auto mesh = it.field<const MeshRuntimeComponent>(1);
+                    auto mesh = it.field<MeshRuntimeComponent>(1);
                     auto material = it.field<const MaterialRuntimeComponent>(2);
                     auto startIndex = offset.fetch_add(it.count(), std::memory_order_acquire);
                     auto drawPtr = &drawCalls[startIndex];
                     for (int x = 0; x < it.count(); x++) {
-                        math::Matrix4x4 mat = math::Mat4FromPRS(
-                            transform[x].Position,
-                            transform[x].Rotation,
-                            transform[x].Scale
-                        );
-
                         drawPtr[x] = drawcallbatcher::DrawCall{
                             .modelHandle = mesh[x].HandleId,
                             .meshId = mesh[x].MeshId,
                             .materialHandle = material[x].HandleId,
-                            .transform = mat,
+                            .position = transform[x].Position,
+                            .rotation = transform[x].Rotation,
+                            .scale = transform[x].Scale,
                         };
+
+                        mesh[x].Lod = drawcallbatcher::SelectLod(drawPtr[x], mesh[x].Lod);
+                        drawPtr[x].lod = mesh[x].Lod;
                     }
                     drawcallbatcher::Batch(drawPtr, it.count());
                 }
             });
 
+        // Single threaded on purpose, the static cache is only touched when something changed
+        world.system<const WorldTransformComponent, const MeshRuntimeComponent, const MaterialRuntimeComponent, StaticBatchComponent>("StaticRenderSystem")
+            .kind(flecs::PostUpdate)
+            .run([](flecs::iter& it) {
+                while (it.next()) {
+                    ZoneScopedNC("StaticRenderSystem", tracy::Color::Green);
+                    auto transform = it.field<const WorldTransformComponent>(0);
+                    auto mesh = it.field<const MeshRuntimeComponent>(1);
+                    auto material = it.field<const MaterialRuntimeComponent>(2);
+                    auto batch = it.field<StaticBatchComponent>(3);
+
+                    for (auto x : it) {
+                        auto& entry = batch[x];
+                        bool sameAssets = entry.ModelHandle == mesh[x].HandleId && entry.MeshId == mesh[x].MeshId && entry.MaterialHandle == material[x].HandleId;
+
+                        if (entry.Slot != UINT32_MAX && sameAssets &&
+                            IsSameTransform(entry.LastTransform, transform[x])) {
+                            continue;
+                        }
+
+                        auto drawCall = drawcallbatcher::DrawCall{
+                            .modelHandle = mesh[x].HandleId,
+                            .meshId = mesh[x].MeshId,
+                            .materialHandle = material[x].HandleId,
+                            .position = transform[x].Position,
+                            .rotation = transform[x].Rotation,
+                            .scale = transform[x].Scale,
+                        };
+
+                        if (entry.Slot == UINT32_MAX) {
+                            entry.Slot = drawcallbatcher::AddStatic(drawCall);
+                        }
+                        else {
+                            drawcallbatcher::UpdateStatic(entry.Slot, drawCall);
+                        }
+
+                        entry.ModelHandle = mesh[x].HandleId;
+                        entry.MeshId = mesh[x].MeshId;
+                        entry.MaterialHandle = material[x].HandleId;
+                        entry.LastTransform = transform[x];
+                    }
+                }
+            });
+
+        world.system<const WorldTransformComponent, const OccluderComponent>("OccluderSystem")
+            .kind(flecs::PostUpdate)
+            .run([](flecs::iter& it) {
+                while (it.next()) {
+                    ZoneScopedNC("OccluderSystem", tracy::Color::Green);
+                    auto transform = it.field<const WorldTransformComponent>(0);
+                    auto occluder = it.field<const OccluderComponent>(1);
+
+                    for (auto x : it) {
+                        drawcallbatcher::AddOccluder(transform[x].Position, transform[x].Rotation, transform[x].Scale, occluder[x].Center, occluder[x].Extents);
+                    }
+                }
+            });
+
+        world.system<const WorldTransformComponent, const PointLightComponent>("PointLightSystem")
+            .kind(flecs::PostUpdate)
+            .run([](flecs::iter& it) {
+                while (it.next()) {
+                    ZoneScopedNC("PointLightSystem", tracy::Color::Green);
+                    auto transform = it.field<const WorldTransformComponent>(0);
+                    auto light = it.field<const PointLightComponent>(1);
+
+                    for (auto x : it) {
+                        drawcallbatcher::AddPointLight(transform[x].Position, light[x].Colour, light[x].Intensity, light[x].Radius);
+                    }
+                }
+            });
+
+        world.system<const WorldTransformComponent, const SpotLightComponent>("SpotLightSystem")
+            .kind(flecs::PostUpdate)
+            .run([](flecs::iter& it) {
+                while (it.next()) {
+                    ZoneScopedNC("SpotLightSystem", tracy::Color::Green);
+                    auto transform = it.field<const WorldTransformComponent>(0);
+                    auto light = it.field<const SpotLightComponent>(1);
+
+                    for (auto x : it) {
+                        drawcallbatcher::AddSpotLight(transform[x].Position, transform[x].Rotation, light[x].Colour, light[x].Intensity, light[x].Range, light[x].InnerAngle, light[x].OuterAngle);
+                    }
+                }
+            });
+
         world.system("PreRenderSystem")
             .kind(flecs::PostUpdate)
             .run([](flecs::iter& it) {
@@ -0,0 +1,106 @@
+#include "playground/systems/SpatialIndexSystem.hxx"
+#include "playground/AssetManager.hxx"
+#include "playground/SpatialIndex.hxx"
+#include "playground/components/WorldTransformComponent.hxx"
+#include "playground/components/MeshComponent.hxx"
+#include "playground/components/SpatialProxyComponent.hxx"
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include <flecs.h>
+#include <tracy/Tracy.hpp>
+#include <math/Bounds.hxx>
+#include <math/Math.hxx>
+
+namespace playground::ecs::spatialindexsystem {
+    // Entities whose transform or mesh was set since the last update, filled by the observers below
+    std::mutex dirtyMutex;
+    std::vector<flecs::entity_t> dirtyEntities;
+
+    void MarkDirty(flecs::entity e) {
+        if (!e.has<SpatialProxyComponent>()) {
+            return;
+        }
+
+        std::scoped_lock lock(dirtyMutex);
+        dirtyEntities.push_back(e.id());
+    }
+
+    void Init(flecs::world world) {
+        world.observer<const WorldTransformComponent>("SpatialIndexTransformObserver")
+            .event(flecs::OnSet)
+            .each([](flecs::entity e, const WorldTransformComponent&) { MarkDirty(e); });
+
+        world.observer<const MeshRuntimeComponent>("SpatialIndexMeshObserver")
+            .event(flecs::OnSet)
+            .each([](flecs::entity e, const MeshRuntimeComponent&) { MarkDirty(e); });
+
+        // New proxies enter the tree on the next update, the transform is usually written after the proxy was added
+        world.observer<const SpatialProxyComponent>("SpatialIndexProxyObserver")
+            .event(flecs::OnAdd)
+            .each([](flecs::entity e, const SpatialProxyComponent&) { MarkDirty(e); });
+
+        // Single threaded on purpose, tree updates are serialised by the index anyway
+        world.system("SpatialIndexSystem")
+            .kind(flecs::PostUpdate)
+            .run([](flecs::iter& it) {
+                ZoneScopedNC("SpatialIndexSystem", tracy::Color::Green);
+
+                std::vector<flecs::entity_t> dirty;
+                {
+                    std::scoped_lock lock(dirtyMutex);
+                    dirty.swap(dirtyEntities);
+                }
+
+                std::sort(dirty.begin(), dirty.end());
+                dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+                // Entities whose model hasn't loaded yet are tried again next update
+                std::vector<flecs::entity_t> pending;
+
+                for (auto id : dirty) {
+                    auto e = flecs::entity(it.world(), id);
+                    if (!e.is_alive() || !e.has<SpatialProxyComponent>() || !e.has<WorldTransformComponent>() || !e.has<MeshRuntimeComponent>()) {
+                        continue;
+                    }
+
+                    const auto& transform = e.get<WorldTransformComponent>();
+                    const auto& mesh = e.get<MeshRuntimeComponent>();
+                    auto proxy = e.get<SpatialProxyComponent>();
+
+                    // Setting a component to the value it already had doesn't need to touch the tree
+                    if (proxy.ProxyId != spatialindex::NULL_PROXY &&
+                        proxy.ModelHandle == mesh.HandleId && proxy.MeshId == mesh.MeshId &&
+                        IsSameTransform(proxy.LastTransform, transform)) {
+                        continue;
+                    }
+
+                    auto model = assetmanager::GetModel(mesh.HandleId);
+                    if (model == nullptr || mesh.MeshId >= model->bounds.size()) {
+                        pending.push_back(id);
+                        continue;
+                    }
+
+                    auto matrix = math::Mat4FromPRS(transform.Position, transform.Rotation, transform.Scale);
+                    auto bounds = math::TransformBounds(model->bounds[mesh.MeshId], matrix);
+
+                    if (proxy.ProxyId == spatialindex::NULL_PROXY) {
+                        proxy.ProxyId = spatialindex::CreateProxy(id, bounds);
+                    }
+                    else {
+                        spatialindex::MoveProxy(proxy.ProxyId, bounds);
+                    }
+
+                    proxy.ModelHandle = mesh.HandleId;
+                    proxy.MeshId = mesh.MeshId;
+                    proxy.LastTransform = transform;
+                    e.set<SpatialProxyComponent>(proxy);
+                }
+
+                if (!pending.empty()) {
+                    std::scoped_lock lock(dirtyMutex);
+                    dirtyEntities.insert(dirtyEntities.end(), pending.begin(), pending.end());
+                }
+            });
+    }
+}
@@ -0,0 +1,85 @@
+#include <GTest/GTest.h>
+
+#include <playground/ECS.hxx>
+#include <playground/WorldSnapshot.hxx>
+#include <shared/JobSystem.hxx>
+#include <shared/Logger.hxx>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace playground;
+
+namespace {
+    struct Follow {
+        uint64_t Target;
+        float Distance;
+    };
+}
+
+class WorldSnapshotTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        logging::logger::Init();
+        jobsystem::Init();
+        ecs::Init(false, true, false);
+    }
+
+    static void TearDownTestSuite() {
+        ecs::Shutdown();
+        jobsystem::Shutdown();
+    }
+};
+
+TEST_F(WorldSnapshotTest, EntityFieldsPointAtTheEntitiesOfTheirCopy) {
+    auto& world = ecs::GetWorld();
+    auto follow = world.component<Follow>();
+    ASSERT_TRUE(worldsnapshot::RegisterEntityField(follow, offsetof(Follow, Target)));
+
+    auto tag = world.entity();
+    auto leader = world.entity().add(tag);
+    world.entity().add(tag).set<Follow>({ .Target = leader, .Distance = 2.0f });
+    // The target isn't part of the snapshot, instances must not point at it
+    auto outsider = world.entity();
+    world.entity().add(tag).set<Follow>({ .Target = outsider, .Distance = 1.0f });
+
+    std::vector<uint8_t> data;
+    ASSERT_TRUE(worldsnapshot::Save(data, tag));
+
+    worldsnapshot::Snapshot snapshot;
+    ASSERT_TRUE(worldsnapshot::Parse(data.data(), data.size(), snapshot));
+    uint32_t entityCount = snapshot.entityCount;
+    ASSERT_EQ(entityCount, 3u);
+
+    std::vector<uint64_t> created;
+    ASSERT_TRUE(worldsnapshot::Instantiate(snapshot, 2, 0, &created));
+    worldsnapshot::Release(snapshot);
+
+    for (uint32_t copy = 0; copy < 2; copy++) {
+        auto first = created.begin() + copy * entityCount;
+        auto last = first + entityCount;
+
+        uint32_t followers = 0;
+        for (auto it = first; it != last; it++) {
+            auto entity = world.entity(*it);
+            if (!entity.has<Follow>()) {
+                continue;
+            }
+
+            followers++;
+            const auto& values = entity.get<Follow>();
+            if (values.Distance == 1.0f) {
+                EXPECT_EQ(values.Target, 0u);
+                continue;
+            }
+
+            // The copy of the leader made for the same instance, it is the only entity without Follow
+            ASSERT_NE(std::find(first, last, values.Target), last);
+            EXPECT_FALSE(world.entity(values.Target).has<Follow>());
+            EXPECT_NE(values.Target, leader.id());
+        }
+
+        EXPECT_EQ(followers, 2u);
+    }
+}